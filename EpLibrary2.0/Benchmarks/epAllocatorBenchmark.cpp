@@ -0,0 +1,118 @@
+#include "epl.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace epl;
+
+static const int s_allocationCount=256;
+
+static void BM_MallocFree(benchmark::State &state)
+{
+	const size_t size=(size_t)state.range(0);
+	void *ptrs[s_allocationCount];
+	for(auto _:state)
+	{
+		for(int trav=0;trav<s_allocationCount;trav++)
+			ptrs[trav]=EP_Malloc(size);
+		benchmark::DoNotOptimize(ptrs);
+		for(int trav=0;trav<s_allocationCount;trav++)
+			EP_Free(ptrs[trav]);
+	}
+	state.SetItemsProcessed(state.iterations()*s_allocationCount);
+}
+BENCHMARK(BM_MallocFree)->ArgName("size")->Arg(16)->Arg(64)->ThreadRange(1,8)->UseRealTime();
+
+template<size_t Size>
+class BenchTinyObject:public TinyObject<>
+{
+public:
+	char m_data[Size-sizeof(void*)];
+};
+
+template<size_t Size>
+class BenchObject
+{
+public:
+	virtual ~BenchObject(){}
+	char m_data[Size-sizeof(void*)];
+};
+
+template<typename ObjectType>
+static void BM_NewDelete(benchmark::State &state)
+{
+	ObjectType *objects[s_allocationCount];
+	for(auto _:state)
+	{
+		for(int trav=0;trav<s_allocationCount;trav++)
+			objects[trav]=EP_NEW ObjectType();
+		benchmark::DoNotOptimize(objects);
+		for(int trav=0;trav<s_allocationCount;trav++)
+			EP_DELETE objects[trav];
+	}
+	state.SetItemsProcessed(state.iterations()*s_allocationCount);
+}
+BENCHMARK_TEMPLATE(BM_NewDelete,BenchObject<16>)->ThreadRange(1,8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_NewDelete,BenchTinyObject<16>)->ThreadRange(1,8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_NewDelete,BenchObject<64>)->ThreadRange(1,8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_NewDelete,BenchTinyObject<64>)->ThreadRange(1,8)->UseRealTime();
+
+// the baseline for the arena, the same allocations freed one by one through the current allocator
+static void BM_ArenaBaselineMallocFree(benchmark::State &state)
+{
+	const size_t size=(size_t)state.range(0);
+	void *ptrs[s_allocationCount];
+	for(auto _:state)
+	{
+		for(int trav=0;trav<s_allocationCount;trav++)
+		{
+			ptrs[trav]=EP_Malloc(size);
+			benchmark::DoNotOptimize(ptrs[trav]);
+		}
+		for(int trav=0;trav<s_allocationCount;trav++)
+			EP_Free(ptrs[trav]);
+	}
+	state.SetItemsProcessed(state.iterations()*s_allocationCount);
+}
+BENCHMARK(BM_ArenaBaselineMallocFree)->ArgName("size")->Arg(16)->Arg(64);
+
+static void BM_ArenaAllocateReset(benchmark::State &state)
+{
+	const size_t size=(size_t)state.range(0);
+	Arena arena(ARENA_DEFAULT_BLOCK_SIZE,LOCK_POLICY_NONE);
+	for(auto _:state)
+	{
+		for(int trav=0;trav<s_allocationCount;trav++)
+			benchmark::DoNotOptimize(arena.Allocate(size));
+		arena.Reset();
+	}
+	state.SetItemsProcessed(state.iterations()*s_allocationCount);
+}
+BENCHMARK(BM_ArenaAllocateReset)->ArgName("size")->Arg(16)->Arg(64);
+
+static void BM_ArenaScopeVector(benchmark::State &state)
+{
+	Arena arena(ARENA_DEFAULT_BLOCK_SIZE,LOCK_POLICY_NONE);
+	for(auto _:state)
+	{
+		ArenaScope scope(arena,false);
+		std::vector<int,ArenaAllocator<int> > vec((ArenaAllocator<int>(arena)));
+		for(int trav=0;trav<s_allocationCount;trav++)
+			vec.push_back(trav);
+		benchmark::DoNotOptimize(vec.data());
+	}
+	state.SetItemsProcessed(state.iterations()*s_allocationCount);
+}
+BENCHMARK(BM_ArenaScopeVector);
+
+static void BM_StdVector(benchmark::State &state)
+{
+	for(auto _:state)
+	{
+		std::vector<int> vec;
+		for(int trav=0;trav<s_allocationCount;trav++)
+			vec.push_back(trav);
+		benchmark::DoNotOptimize(vec.data());
+	}
+	state.SetItemsProcessed(state.iterations()*s_allocationCount);
+}
+BENCHMARK(BM_StdVector);
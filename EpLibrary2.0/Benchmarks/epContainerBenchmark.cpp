@@ -0,0 +1,451 @@
+#include "epl.h"
+#include "epKAryHeap.h"
+#include "epPatriciaTrie.h"
+#include "epPatriciaTrieImage.h"
+#include <benchmark/benchmark.h>
+#include <map>
+#include <queue>
+#include <string>
+#include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif //defined(__GLIBC__)
+
+using namespace epl;
+
+template<typename LockType>
+static void BM_ThreadSafeQueuePushPop(benchmark::State &state)
+{
+	ThreadSafeQueue<int,LockType> queue(LOCK_POLICY_CRITICALSECTION);
+	const int batch=(int)state.range(0);
+	for(auto _:state)
+	{
+		for(int trav=0;trav<batch;trav++)
+			queue.Push(trav);
+		for(int trav=0;trav<batch;trav++)
+		{
+			benchmark::DoNotOptimize(queue.Front());
+			queue.Pop();
+		}
+	}
+	state.SetItemsProcessed(state.iterations()*batch);
+}
+BENCHMARK_TEMPLATE(BM_ThreadSafeQueuePushPop,RuntimeLock)->ArgName("batch")->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_ThreadSafeQueuePushPop,NullLock)->ArgName("batch")->Arg(64)->Arg(4096);
+
+// the previous ThreadSafeQueue, which erased the front of a vector on every Pop
+class VectorQueue
+{
+public:
+	void Push(int const &data)
+	{
+		LockObj lock(&m_lock);
+		m_queue.push_back(data);
+	}
+	int &Front()
+	{
+		LockObj lock(&m_lock);
+		return m_queue.front();
+	}
+	void Pop()
+	{
+		LockObj lock(&m_lock);
+		m_queue.erase(m_queue.begin());
+	}
+private:
+	std::vector<int> m_queue;
+	CriticalSectionEx m_lock;
+};
+typedef ThreadSafeQueue<int,StaticLock<CriticalSectionEx> > RingQueue;
+
+// one push and one pop per iteration, with the queue held at the given depth
+template<typename QueueType>
+static void BM_QueueAtDepth(benchmark::State &state)
+{
+	QueueType queue;
+	const int depth=(int)state.range(0);
+	for(int trav=0;trav<depth;trav++)
+		queue.Push(trav);
+	int value=0;
+	for(auto _:state)
+	{
+		queue.Push(value++);
+		benchmark::DoNotOptimize(queue.Front());
+		queue.Pop();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_QueueAtDepth,VectorQueue)->ArgName("depth")->RangeMultiplier(16)->Range(1,1<<16);
+BENCHMARK_TEMPLATE(BM_QueueAtDepth,RingQueue)->ArgName("depth")->RangeMultiplier(16)->Range(1,1<<16);
+
+static void BM_LockFreeQueuePushPop(benchmark::State &state)
+{
+	static LockFreeQueue<int> *queue=NULL;
+	if(state.thread_index()==0)
+		queue=EP_NEW LockFreeQueue<int>(1<<16);
+	int value=0;
+	for(auto _:state)
+	{
+		// each thread pushes then pops, so the queue never overflows
+		while(!queue->TryPush(value))
+			benchmark::DoNotOptimize(value);
+		while(!queue->TryPop(value))
+			benchmark::DoNotOptimize(value);
+	}
+	state.SetItemsProcessed(state.iterations());
+	if(state.thread_index()==0)
+	{
+		EP_DELETE queue;
+		queue=NULL;
+	}
+}
+BENCHMARK(BM_LockFreeQueuePushPop)->ThreadRange(1,64)->UseRealTime();
+
+static void BM_LockedQueuePushPop(benchmark::State &state)
+{
+	static ThreadSafeQueue<int,StaticLock<CriticalSectionEx> > *queue=NULL;
+	if(state.thread_index()==0)
+		queue=EP_NEW ThreadSafeQueue<int,StaticLock<CriticalSectionEx> >();
+	int value=0;
+	for(auto _:state)
+	{
+		queue->Push(value);
+		queue->Pop();
+	}
+	state.SetItemsProcessed(state.iterations());
+	if(state.thread_index()==0)
+	{
+		EP_DELETE queue;
+		queue=NULL;
+	}
+}
+BENCHMARK(BM_LockedQueuePushPop)->ThreadRange(1,64)->UseRealTime();
+
+static void BM_DynamicArrayAppend(benchmark::State &state)
+{
+	const int count=(int)state.range(0);
+	for(auto _:state)
+	{
+		DynamicArray<int,NullLock> arr;
+		for(int trav=0;trav<count;trav++)
+			arr.Append(trav);
+		benchmark::DoNotOptimize(arr.GetData());
+	}
+	state.SetItemsProcessed(state.iterations()*count);
+}
+BENCHMARK(BM_DynamicArrayAppend)->ArgName("count")->Arg(1<<10)->Arg(1<<16);
+
+static void BM_StdVectorPushBack(benchmark::State &state)
+{
+	const int count=(int)state.range(0);
+	for(auto _:state)
+	{
+		std::vector<int> vec;
+		for(int trav=0;trav<count;trav++)
+			vec.push_back(trav);
+		benchmark::DoNotOptimize(vec.data());
+	}
+	state.SetItemsProcessed(state.iterations()*count);
+}
+BENCHMARK(BM_StdVectorPushBack)->ArgName("count")->Arg(1<<10)->Arg(1<<16);
+
+static void BM_KAryHeapPushPop(benchmark::State &state)
+{
+	const int count=(int)state.range(0);
+	KAryHeap<int,int,4,CompClass<int>::CompFunc,KAryHeapKeyLess<int>,NullLock> heap((KaryHeapMode)state.range(1));
+	heap.Reserve(count);
+	int key,data;
+	for(auto _:state)
+	{
+		for(int trav=0;trav<count;trav++)
+			heap.Push((trav*7919)%count,trav);
+		for(int trav=0;trav<count;trav++)
+			heap.Pop(key,data);
+	}
+	state.SetItemsProcessed(state.iterations()*count);
+}
+BENCHMARK(BM_KAryHeapPushPop)->ArgNames({"count","mode"})
+	->Args({1<<12,KARY_HEAP_MODE_LOOP})->Args({1<<12,KARY_HEAP_MODE_RECURSIVE})->Args({1<<12,KARY_HEAP_MODE_INDEXED});
+
+// decrease-key workload, each iteration moves a key below all the others
+template<size_t k>
+static void BM_KAryHeapChangeKey(benchmark::State &state)
+{
+	const int count=(int)state.range(0);
+	KAryHeap<int,int,k,CompClass<int>::CompFunc,KAryHeapKeyLess<int>,NullLock> heap((KaryHeapMode)state.range(1));
+	heap.Reserve(count);
+	std::vector<int> keys;
+	for(int trav=0;trav<count;trav++)
+	{
+		keys.push_back(trav);
+		heap.Push(trav,trav);
+	}
+	int nextKey=0;
+	size_t idx=0;
+	for(auto _:state)
+	{
+		idx=(idx+7919)%keys.size();
+		heap.ChangeKey(keys[idx],--nextKey);
+		keys[idx]=nextKey;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_KAryHeapChangeKey,2)->ArgNames({"count","mode"})
+	->Args({1<<12,KARY_HEAP_MODE_LOOP})->Args({1<<12,KARY_HEAP_MODE_INDEXED})->Args({1<<16,KARY_HEAP_MODE_INDEXED});
+BENCHMARK_TEMPLATE(BM_KAryHeapChangeKey,4)->ArgNames({"count","mode"})
+	->Args({1<<12,KARY_HEAP_MODE_LOOP})->Args({1<<12,KARY_HEAP_MODE_INDEXED})->Args({1<<16,KARY_HEAP_MODE_INDEXED});
+
+static void BM_StdPriorityQueuePushPop(benchmark::State &state)
+{
+	const int count=(int)state.range(0);
+	std::priority_queue<std::pair<int,int> > heap;
+	for(auto _:state)
+	{
+		for(int trav=0;trav<count;trav++)
+			heap.push(std::make_pair(-((trav*7919)%count),trav));
+		for(int trav=0;trav<count;trav++)
+			heap.pop();
+	}
+	state.SetItemsProcessed(state.iterations()*count);
+}
+BENCHMARK(BM_StdPriorityQueuePushPop)->ArgName("count")->Arg(1<<12);
+
+typedef PatriciaTrie<char,int,'\0',CompClass<char>::CompFunc,NullLock> BenchTrie;
+typedef PatriciaTrieImage<char,int> BenchTrieImage;
+
+static std::vector<std::string> makeKeys(size_t count)
+{
+	std::vector<std::string> keys;
+	unsigned int seed=7;
+	for(size_t trav=0;trav<count;trav++)
+	{
+		std::string key;
+		for(int charTrav=0;charTrav<12;charTrav++)
+		{
+			seed=seed*1103515245+12345;
+			key.push_back((char)('a'+(seed>>16)%16));
+		}
+		keys.push_back(key);
+	}
+	return keys;
+}
+
+// the previous trie layout: virtual nodes, one node per character, the children in a vector
+// searched by BinarySearch through a void* comparator, and the leaves copying their string into a vector
+class LegacyTrie
+{
+public:
+	LegacyTrie():m_root(EP_NEW Node('\0')){}
+	~LegacyTrie(){EP_DELETE m_root;}
+	bool Insert(const char *str,int data)
+	{
+		Node *node=m_root;
+		for(const char *trav=str;*trav;trav++)
+		{
+			BaseNode *child=node->Find(*trav);
+			if(!child)
+				child=node->Add(EP_NEW Node(*trav));
+			node=static_cast<Node*>(child);
+		}
+		if(node->Find('\0'))
+			return false;
+		node->Add(EP_NEW Leaf(str,data));
+		return true;
+	}
+	bool Find(const char *str,int &retData) const
+	{
+		const Node *node=m_root;
+		for(const char *trav=str;*trav;trav++)
+		{
+			const BaseNode *child=node->Find(*trav);
+			if(!child || child->IsLeaf())
+				return false;
+			node=static_cast<const Node*>(child);
+		}
+		const BaseNode *leaf=node->Find('\0');
+		if(!leaf)
+			return false;
+		retData=static_cast<const Leaf*>(leaf)->m_data;
+		return true;
+	}
+private:
+	class BaseNode
+	{
+	public:
+		BaseNode(char c,bool isLeaf):m_character(c),m_isLeaf(isLeaf){}
+		virtual ~BaseNode(){}
+		virtual const char &GetCharacter() const{return m_character;}
+		virtual bool IsLeaf() const{return m_isLeaf;}
+	private:
+		char m_character;
+		bool m_isLeaf;
+	};
+	class Leaf:public BaseNode
+	{
+	public:
+		Leaf(const char *str,int data):BaseNode('\0',true),m_data(data),m_string(str,str+strlen(str)+1),m_terminator('\0'){}
+		int m_data;
+		std::vector<char> m_string;
+		char m_terminator;
+	};
+	class Node:public BaseNode
+	{
+	public:
+		Node(char c):BaseNode(c,false),m_terminator('\0'){}
+		~Node()
+		{
+			for(size_t trav=0;trav<m_charList.size();trav++)
+				EP_DELETE m_charList[trav];
+		}
+		BaseNode *Find(char c) const
+		{
+			if(m_charList.empty())
+				return NULL;
+			size_t retIdx;
+			BaseNode *const *found=BinarySearch(c,&m_charList.at(0),m_charList.size(),nodeCompareFunc,retIdx);
+			return found?*found:NULL;
+		}
+		BaseNode *Add(BaseNode *node)
+		{
+			size_t retIdx=0;
+			if(!m_charList.empty())
+				BinarySearch(node->GetCharacter(),&m_charList.at(0),m_charList.size(),nodeCompareFunc,retIdx);
+			m_charList.insert(m_charList.begin()+retIdx,node);
+			return node;
+		}
+	private:
+		static CompResultType __cdecl nodeCompareFunc(const void *a,const void *b)
+		{
+			return CompClass<char>::CompFunc(a,&(*reinterpret_cast<BaseNode *const *>(b))->GetCharacter());
+		}
+		std::vector<BaseNode*> m_charList;
+		char m_terminator;
+	};
+	Node *m_root;
+};
+
+// the bytes allocated from the heap, 0 where the allocator cannot report it
+static size_t heapBytesInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__>2 || (__GLIBC__==2 && __GLIBC_MINOR__>=33))
+	return mallinfo2().uordblks;
+#else //defined(__GLIBC__) && (__GLIBC__>2 || (__GLIBC__==2 && __GLIBC_MINOR__>=33))
+	return 0;
+#endif //defined(__GLIBC__) && (__GLIBC__>2 || (__GLIBC__==2 && __GLIBC_MINOR__>=33))
+}
+
+template<typename TrieType>
+static void BM_PatriciaTrieFind(benchmark::State &state)
+{
+	std::vector<std::string> keys=makeKeys((size_t)state.range(0));
+	size_t heapBefore=heapBytesInUse();
+	TrieType trie;
+	for(size_t trav=0;trav<keys.size();trav++)
+		trie.Insert(keys[trav].c_str(),(int)trav);
+	size_t heapAfter=heapBytesInUse();
+	size_t idx=0;
+	int data=0;
+	for(auto _:state)
+	{
+		benchmark::DoNotOptimize(trie.Find(keys[idx].c_str(),data));
+		if(++idx==keys.size())
+			idx=0;
+	}
+	state.SetItemsProcessed(state.iterations());
+	if(heapAfter>heapBefore)
+		state.counters["bytes_per_key"]=(double)(heapAfter-heapBefore)/keys.size();
+}
+BENCHMARK_TEMPLATE(BM_PatriciaTrieFind,LegacyTrie)->ArgName("keys")->Arg(1<<10)->Arg(1<<16);
+BENCHMARK_TEMPLATE(BM_PatriciaTrieFind,BenchTrie)->ArgName("keys")->Arg(1<<10)->Arg(1<<16);
+
+// read scalability of the shared trie, each thread finds the keys under the shared access
+template<typename LockType>
+static void BM_PatriciaTrieConcurrentFind(benchmark::State &state)
+{
+	static PatriciaTrie<char,int,'\0',CompClass<char>::CompFunc,LockType> *trie=NULL;
+	static std::vector<std::string> *keys=NULL;
+	if(state.thread_index()==0)
+	{
+		keys=EP_NEW std::vector<std::string>(makeKeys(1<<12));
+		trie=EP_NEW PatriciaTrie<char,int,'\0',CompClass<char>::CompFunc,LockType>(PATRICIA_TRIE_MODE_LOOP,LOCK_POLICY_READWRITE);
+		for(size_t trav=0;trav<keys->size();trav++)
+			trie->Insert(keys->at(trav).c_str(),(int)trav);
+	}
+	size_t idx=(size_t)state.thread_index()*7919;
+	int data=0;
+	for(auto _:state)
+	{
+		idx=(idx+1)%keys->size();
+		benchmark::DoNotOptimize(trie->Find(keys->at(idx).c_str(),data));
+	}
+	state.SetItemsProcessed(state.iterations());
+	if(state.thread_index()==0)
+	{
+		EP_DELETE trie;
+		trie=NULL;
+		EP_DELETE keys;
+		keys=NULL;
+	}
+}
+BENCHMARK_TEMPLATE(BM_PatriciaTrieConcurrentFind,RuntimeLock)->ThreadRange(1,64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PatriciaTrieConcurrentFind,StaticLock<DistributedReadWriteLock>)->ThreadRange(1,64)->UseRealTime();
+
+static void BM_PatriciaTrieImageFind(benchmark::State &state)
+{
+	std::vector<std::string> keys=makeKeys((size_t)state.range(0));
+	BenchTrie trie;
+	for(size_t trav=0;trav<keys.size();trav++)
+		trie.Insert(keys[trav].c_str(),(int)trav);
+	Stream stream(LOCK_POLICY_NONE);
+	trie.WriteImage(stream);
+	std::vector<unsigned long long> buffer((stream.GetStreamSize()+sizeof(unsigned long long)-1)/sizeof(unsigned long long));
+	memcpy(&buffer.at(0),stream.GetBuffer(),stream.GetStreamSize());
+	BenchTrieImage image;
+	if(!image.Attach(&buffer.at(0),stream.GetStreamSize()))
+	{
+		state.SkipWithError("cannot attach the image");
+		return;
+	}
+	size_t idx=0;
+	int data=0;
+	for(auto _:state)
+	{
+		benchmark::DoNotOptimize(image.Find(keys[idx].c_str(),data));
+		if(++idx==keys.size())
+			idx=0;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PatriciaTrieImageFind)->ArgName("keys")->Arg(1<<10)->Arg(1<<16);
+
+template<typename TrieType>
+static void BM_PatriciaTrieInsert(benchmark::State &state)
+{
+	std::vector<std::string> keys=makeKeys((size_t)state.range(0));
+	for(auto _:state)
+	{
+		TrieType trie;
+		for(size_t trav=0;trav<keys.size();trav++)
+			benchmark::DoNotOptimize(trie.Insert(keys[trav].c_str(),(int)trav));
+	}
+	state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_PatriciaTrieInsert,LegacyTrie)->ArgName("keys")->Arg(1<<10);
+BENCHMARK_TEMPLATE(BM_PatriciaTrieInsert,BenchTrie)->ArgName("keys")->Arg(1<<10);
+
+static void BM_StdMapFind(benchmark::State &state)
+{
+	std::vector<std::string> keys=makeKeys((size_t)state.range(0));
+	std::map<std::string,int> map;
+	for(size_t trav=0;trav<keys.size();trav++)
+		map[keys[trav]]=(int)trav;
+	size_t idx=0;
+	for(auto _:state)
+	{
+		benchmark::DoNotOptimize(map.find(keys[idx]));
+		if(++idx==keys.size())
+			idx=0;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StdMapFind)->ArgName("keys")->Arg(1<<10)->Arg(1<<16);
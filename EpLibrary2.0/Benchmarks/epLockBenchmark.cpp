@@ -0,0 +1,100 @@
+#include "epl.h"
+#include <benchmark/benchmark.h>
+
+using namespace epl;
+
+// shared by the benchmark threads
+static BaseLock *s_lock=NULL;
+static volatile long s_counter=0;
+
+template<typename LockType>
+static void BM_LockUnlock(benchmark::State &state)
+{
+	if(state.thread_index()==0)
+	{
+		s_lock=EP_NEW LockType();
+		s_counter=0;
+	}
+	const int workCount=(int)state.range(0);
+	for(auto _:state)
+	{
+		s_lock->Lock();
+		// critical section of the given length
+		for(int trav=0;trav<workCount;trav++)
+			s_counter=s_counter+1;
+		s_lock->Unlock();
+	}
+	state.SetItemsProcessed(state.iterations());
+	if(state.thread_index()==0)
+	{
+		EP_DELETE s_lock;
+		s_lock=NULL;
+	}
+}
+BENCHMARK_TEMPLATE(BM_LockUnlock,NoLock)->ArgName("work")->Arg(0)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockUnlock,CriticalSectionEx)->ArgName("work")->Arg(0)->Arg(64)->ThreadRange(1,8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockUnlock,Mutex)->ArgName("work")->Arg(0)->Arg(64)->ThreadRange(1,8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockUnlock,SpinLock)->ArgName("work")->Arg(0)->Arg(64)->ThreadRange(1,8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockUnlock,TicketLock)->ArgName("work")->Arg(0)->Arg(64)->ThreadRange(1,8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockUnlock,InterlockedEx)->ArgName("work")->Arg(0)->Arg(64)->ThreadRange(1,8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockUnlock,ReadWriteLock)->ArgName("work")->Arg(0)->Arg(64)->ThreadRange(1,8)->UseRealTime();
+
+// every thread writes once per the given number of reads
+template<typename LockType>
+static void BM_ReadMostly(benchmark::State &state)
+{
+	if(state.thread_index()==0)
+	{
+		s_lock=EP_NEW LockType();
+		s_counter=0;
+	}
+	const int readsPerWrite=(int)state.range(0);
+	int opCount=0;
+	long value=0;
+	for(auto _:state)
+	{
+		if(++opCount==readsPerWrite)
+		{
+			opCount=0;
+			LockObj lock(s_lock);
+			s_counter=s_counter+1;
+		}
+		else
+		{
+			SharedLockObj lock(s_lock);
+			value+=s_counter;
+		}
+	}
+	benchmark::DoNotOptimize(value);
+	state.SetItemsProcessed(state.iterations());
+	if(state.thread_index()==0)
+	{
+		EP_DELETE s_lock;
+		s_lock=NULL;
+	}
+}
+BENCHMARK_TEMPLATE(BM_ReadMostly,CriticalSectionEx)->ArgName("readsPerWrite")->Arg(100)->Arg(10000)->ThreadRange(1,8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ReadMostly,SpinLock)->ArgName("readsPerWrite")->Arg(100)->Arg(10000)->ThreadRange(1,8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ReadMostly,InterlockedEx)->ArgName("readsPerWrite")->Arg(100)->Arg(10000)->ThreadRange(1,8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ReadMostly,ReadWriteLock)->ArgName("readsPerWrite")->Arg(100)->Arg(10000)->ThreadRange(1,8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ReadMostly,DistributedReadWriteLock)->ArgName("readsPerWrite")->Arg(100)->Arg(10000)->ThreadRange(1,8)->UseRealTime();
+
+static void BM_InterlockedIncrement(benchmark::State &state)
+{
+	for(auto _:state)
+		InterlockedIncrement(&s_counter);
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InterlockedIncrement)->ThreadRange(1,8)->UseRealTime();
+
+static void BM_EventSignalWait(benchmark::State &state)
+{
+	EventEx event(false,false);
+	for(auto _:state)
+	{
+		event.SetEvent();
+		event.WaitForEvent(0);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventSignalWait);
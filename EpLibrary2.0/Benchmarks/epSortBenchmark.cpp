@@ -0,0 +1,89 @@
+#include "epl.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <vector>
+
+using namespace epl;
+
+static std::vector<int> makeList(size_t listSize)
+{
+	std::vector<int> list(listSize);
+	unsigned int seed=42;
+	for(size_t trav=0;trav<listSize;trav++)
+	{
+		seed=seed*1103515245+12345;
+		list[trav]=(int)(seed>>8);
+	}
+	return list;
+}
+
+static void BM_QuickSort(benchmark::State &state)
+{
+	std::vector<int> source=makeList((size_t)state.range(0));
+	std::vector<int> list;
+	QSortMode mode=(QSortMode)state.range(1);
+	for(auto _:state)
+	{
+		state.PauseTiming();
+		list=source;
+		state.ResumeTiming();
+		QuickSort<int>(&list.at(0),list.size(),CompClass<int>::CompFunc,mode);
+		benchmark::DoNotOptimize(list.data());
+	}
+	state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_QuickSort)->ArgNames({"size","mode"})
+	->Args({1<<10,QSORT_MODE_STL})->Args({1<<10,QSORT_MODE_RECURSIVE})->Args({1<<10,QSORT_MODE_LOOP})
+	->Args({1<<16,QSORT_MODE_STL})->Args({1<<16,QSORT_MODE_RECURSIVE})->Args({1<<16,QSORT_MODE_LOOP});
+
+static void BM_MergeSort(benchmark::State &state)
+{
+	std::vector<int> source=makeList((size_t)state.range(0));
+	std::vector<int> list;
+	MSortMode mode=(MSortMode)state.range(1);
+	for(auto _:state)
+	{
+		state.PauseTiming();
+		list=source;
+		state.ResumeTiming();
+		MergeSort<int>(&list.at(0),list.size(),CompClass<int>::CompFunc,mode);
+		benchmark::DoNotOptimize(list.data());
+	}
+	state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_MergeSort)->ArgNames({"size","mode"})
+	->Args({1<<10,MSORT_MODE_RECURSIVE})->Args({1<<10,MSORT_MODE_LOOP})
+	->Args({1<<16,MSORT_MODE_RECURSIVE})->Args({1<<16,MSORT_MODE_LOOP});
+
+static void BM_InsertionSort(benchmark::State &state)
+{
+	std::vector<int> source=makeList((size_t)state.range(0));
+	std::vector<int> list;
+	for(auto _:state)
+	{
+		state.PauseTiming();
+		list=source;
+		state.ResumeTiming();
+		InsertionSort<int>(&list.at(0),0,list.size()-1,CompClass<int>::CompFunc);
+		benchmark::DoNotOptimize(list.data());
+	}
+	state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_InsertionSort)->ArgName("size")->Arg(16)->Arg(64)->Arg(256);
+
+// baseline with the inlined comparison
+static void BM_StdSort(benchmark::State &state)
+{
+	std::vector<int> source=makeList((size_t)state.range(0));
+	std::vector<int> list;
+	for(auto _:state)
+	{
+		state.PauseTiming();
+		list=source;
+		state.ResumeTiming();
+		std::sort(list.begin(),list.end());
+		benchmark::DoNotOptimize(list.data());
+	}
+	state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_StdSort)->ArgName("size")->Arg(1<<10)->Arg(1<<16);
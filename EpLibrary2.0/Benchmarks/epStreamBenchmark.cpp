@@ -0,0 +1,60 @@
+#include "epl.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace epl;
+
+static void BM_StreamWriteReadInt(benchmark::State &state)
+{
+	Stream stream((LockPolicy)state.range(0));
+	const int count=1024;
+	int value=0;
+	for(auto _:state)
+	{
+		stream.SetSeek(Stream::STREAM_SEEK_TYPE_SEEK_SET);
+		for(int trav=0;trav<count;trav++)
+			stream.WriteInt(trav);
+		stream.SetSeek(Stream::STREAM_SEEK_TYPE_SEEK_SET);
+		for(int trav=0;trav<count;trav++)
+			stream.ReadInt(value);
+		benchmark::DoNotOptimize(value);
+	}
+	state.SetItemsProcessed(state.iterations()*count*2);
+}
+BENCHMARK(BM_StreamWriteReadInt)->ArgName("lockPolicy")->Arg(LOCK_POLICY_NONE)->Arg(LOCK_POLICY_CRITICALSECTION)->Arg(LOCK_POLICY_MUTEX);
+
+static void BM_StreamWriteBytes(benchmark::State &state)
+{
+	Stream stream(LOCK_POLICY_NONE);
+	std::vector<unsigned char> block((size_t)state.range(0),0xAB);
+	const int count=64;
+	for(auto _:state)
+	{
+		stream.Clear();
+		for(int trav=0;trav<count;trav++)
+			stream.WriteBytes(&block.at(0),block.size());
+		benchmark::DoNotOptimize(stream.GetBuffer());
+	}
+	state.SetBytesProcessed(state.iterations()*count*state.range(0));
+}
+BENCHMARK(BM_StreamWriteBytes)->ArgName("blockSize")->Arg(16)->Arg(4096);
+
+static void BM_StreamWriteReadString(benchmark::State &state)
+{
+	Stream stream(LOCK_POLICY_NONE);
+	EpString value="The quick brown fox jumps over the lazy dog";
+	EpString retValue;
+	const int count=256;
+	for(auto _:state)
+	{
+		stream.Clear();
+		for(int trav=0;trav<count;trav++)
+			stream.WriteString(value);
+		stream.SetSeek(Stream::STREAM_SEEK_TYPE_SEEK_SET);
+		for(int trav=0;trav<count;trav++)
+			stream.ReadString(retValue);
+		benchmark::DoNotOptimize(retValue.data());
+	}
+	state.SetItemsProcessed(state.iterations()*count*2);
+}
+BENCHMARK(BM_StreamWriteReadString);
@@ -0,0 +1,280 @@
+#include "epl.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace epl;
+
+class BenchJob:public BaseJob
+{
+public:
+	BenchJob():BaseJob(){}
+};
+
+class BenchJobProcessor:public BaseJobProcessor
+{
+public:
+	BenchJobProcessor():BaseJobProcessor(),m_processedCount(0){}
+	volatile long m_processedCount;
+	virtual void DoJob(BaseWorkerThread * /*workerThread*/,BaseJob* const /*data*/)
+	{
+		InterlockedIncrement(&m_processedCount);
+	}
+};
+
+static void waitForJobs(BenchJobProcessor *processor,long count)
+{
+	while(processor->m_processedCount<count)
+		SwitchToThread();
+}
+
+// range(0): the number of the workers, range(1): the batch size (1 to push one by one)
+static void BM_ThreadPoolThroughput(benchmark::State &state)
+{
+	const unsigned int workerCount=(unsigned int)state.range(0);
+	const size_t batchSize=(size_t)state.range(1);
+	const long jobCount=1<<14;
+	BenchJobProcessor *processor=EP_NEW BenchJobProcessor();
+	BenchJob *job=EP_NEW BenchJob();
+	BaseJob *batch[256];
+	for(size_t trav=0;trav<batchSize;trav++)
+		batch[trav]=job;
+	{
+		ThreadPool pool(processor,workerCount);
+		long expected=0;
+		for(auto _:state)
+		{
+			if(batchSize==1)
+			{
+				for(long trav=0;trav<jobCount;trav++)
+					pool.Push(job);
+			}
+			else
+			{
+				for(long trav=0;trav<jobCount;trav+=(long)batchSize)
+					pool.PushBatch(batch,batchSize);
+			}
+			expected+=jobCount;
+			waitForJobs(processor,expected);
+		}
+		pool.TerminatePool();
+	}
+	state.SetItemsProcessed(state.iterations()*jobCount);
+	job->ReleaseObj();
+	processor->ReleaseObj();
+}
+BENCHMARK(BM_ThreadPoolThroughput)->ArgNames({"workers","batch"})
+	->Args({1,1})->Args({2,1})->Args({4,1})->Args({8,1})
+	->Args({4,64})->Args({8,64})
+	->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+static void BM_WorkerThreadLatency(benchmark::State &state)
+{
+	BenchJobProcessor *processor=EP_NEW BenchJobProcessor();
+	BenchJob *job=EP_NEW BenchJob();
+	WorkerThreadInfinite worker(BaseWorkerThread::THREAD_LIFE_INFINITE,(unsigned int)state.range(0));
+	worker.SetJobProcessor(processor);
+	worker.Start();
+	long expected=0;
+	for(auto _:state)
+	{
+		// round trip of a single job
+		worker.Push(job);
+		waitForJobs(processor,++expected);
+	}
+	worker.TerminateWorker();
+	state.SetItemsProcessed(state.iterations());
+	job->ReleaseObj();
+	processor->ReleaseObj();
+}
+BENCHMARK(BM_WorkerThreadLatency)->ArgName("spinCount")->Arg(0)->Arg(1000)->UseRealTime();
+
+// the job owns a buffer which the first worker running it allocates and touches, so the pages are on that worker's node
+class MemoryJob:public BaseJob
+{
+public:
+	MemoryJob(size_t elementCount):BaseJob(),m_elementCount(elementCount),m_homeNode(0),m_sum(0){}
+	std::vector<long> m_data;
+	size_t m_elementCount;
+	unsigned int m_homeNode;
+	volatile long m_sum;
+};
+
+class MemoryJobProcessor:public BenchJobProcessor
+{
+public:
+	virtual void DoJob(BaseWorkerThread *workerThread,BaseJob* const data)
+	{
+		MemoryJob *job=static_cast<MemoryJob*>(data);
+		if(job->m_data.empty())
+		{
+			job->m_data.resize(job->m_elementCount);
+			for(size_t trav=0;trav<job->m_elementCount;trav++)
+				job->m_data[trav]=(long)trav;
+			job->m_homeNode=CPU_TOPOLOGY_INSTANCE.GetCurrentNumaNode();
+		}
+		else
+		{
+			long sum=0;
+			for(size_t trav=0;trav<job->m_elementCount;trav++)
+				sum+=job->m_data[trav];
+			job->m_sum=sum;
+		}
+		BenchJobProcessor::DoJob(workerThread,data);
+	}
+};
+
+// range(0): WorkerThreadFactory::WorkerPlacement
+// the memory-bound jobs are pushed back to the node which first touched their buffers
+static void BM_ThreadPoolPlacement(benchmark::State &state)
+{
+	const WorkerThreadFactory::WorkerPlacement placement=(WorkerThreadFactory::WorkerPlacement)state.range(0);
+	const unsigned int workerCount=CPU_TOPOLOGY_INSTANCE.GetProcessorCount();
+	const size_t elementCount=(1<<20)/sizeof(long);
+	const unsigned int jobCount=workerCount*2;
+	MemoryJobProcessor *processor=EP_NEW MemoryJobProcessor();
+	std::vector<MemoryJob*> jobs;
+	for(unsigned int trav=0;trav<jobCount;trav++)
+		jobs.push_back(EP_NEW MemoryJob(elementCount));
+	{
+		ThreadPool pool(processor,workerCount,EP_LOCK_POLICY,placement);
+		for(unsigned int trav=0;trav<jobCount;trav++)
+			pool.Push(jobs[trav]);
+		long expected=jobCount;
+		waitForJobs(processor,expected);
+		for(auto _:state)
+		{
+			for(unsigned int trav=0;trav<jobCount;trav++)
+				pool.PushToNode(jobs[trav],jobs[trav]->m_homeNode);
+			expected+=jobCount;
+			waitForJobs(processor,expected);
+		}
+		pool.TerminatePool();
+	}
+	state.SetBytesProcessed(state.iterations()*jobCount*elementCount*sizeof(long));
+	state.counters["nodes"]=CPU_TOPOLOGY_INSTANCE.GetNumaNodeCount();
+	for(unsigned int trav=0;trav<jobCount;trav++)
+		jobs[trav]->ReleaseObj();
+	processor->ReleaseObj();
+}
+BENCHMARK(BM_ThreadPoolPlacement)->ArgName("placement")
+	->Arg(WorkerThreadFactory::WORKER_PLACEMENT_NONE)
+	->Arg(WorkerThreadFactory::WORKER_PLACEMENT_COMPACT)
+	->Arg(WorkerThreadFactory::WORKER_PLACEMENT_SCATTER)
+	->Arg(WorkerThreadFactory::WORKER_PLACEMENT_NUMA_NODE)
+	->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+class CountJob:public BaseJob
+{
+public:
+	CountJob(volatile long *count):BaseJob(),m_count(count){}
+	volatile long *m_count;
+};
+
+class CountJobProcessor:public BaseJobProcessor
+{
+public:
+	virtual void DoJob(BaseWorkerThread * /*workerThread*/,BaseJob* const data)
+	{
+		InterlockedIncrement(static_cast<CountJob*>(data)->m_count);
+	}
+};
+
+static void countJobFunc(void *arg)
+{
+	InterlockedIncrement(reinterpret_cast<volatile long*>(arg));
+}
+
+static void waitForCount(volatile long &count,long expected)
+{
+	while(count<expected)
+		SwitchToThread();
+}
+
+// range(0): the number of the workers
+// every tiny job is allocated and deleted
+static void BM_HeapJobThroughput(benchmark::State &state)
+{
+	const long jobCount=1<<14;
+	CountJobProcessor *processor=EP_NEW CountJobProcessor();
+	volatile long count=0;
+	{
+		ThreadPool pool(processor,(unsigned int)state.range(0));
+		long expected=0;
+		for(auto _:state)
+		{
+			for(long trav=0;trav<jobCount;trav++)
+			{
+				CountJob *job=EP_NEW CountJob(&count);
+				pool.Push(job);
+				job->ReleaseObj();
+			}
+			expected+=jobCount;
+			waitForCount(count,expected);
+		}
+		pool.TerminatePool();
+	}
+	state.SetItemsProcessed(state.iterations()*jobCount);
+	processor->ReleaseObj();
+}
+BENCHMARK(BM_HeapJobThroughput)->ArgName("workers")->Arg(1)->Arg(4)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// range(0): the number of the workers
+// the tiny jobs are taken from the free list of LightJobPool
+static void BM_LightJobThroughput(benchmark::State &state)
+{
+	const long jobCount=1<<14;
+	LightJobPool jobPool;
+	LightJobProcessor *processor=EP_NEW LightJobProcessor();
+	volatile long count=0;
+	{
+		ThreadPool pool(processor,(unsigned int)state.range(0));
+		long expected=0;
+		for(auto _:state)
+		{
+			for(long trav=0;trav<jobCount;trav++)
+			{
+				LightJob *job=jobPool.Get();
+				job->SetFunc(countJobFunc,(void*)&count);
+				pool.Push(job);
+				job->ReleaseObj();
+			}
+			expected+=jobCount;
+			waitForCount(count,expected);
+		}
+		pool.TerminatePool();
+	}
+	state.SetItemsProcessed(state.iterations()*jobCount);
+	state.counters["jobsCreated"]=(double)jobPool.GetJobCount();
+	processor->ReleaseObj();
+}
+BENCHMARK(BM_LightJobThroughput)->ArgName("workers")->Arg(1)->Arg(4)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// the cost of a job's life without the workers: create, set and release
+static void BM_HeapJobNewRelease(benchmark::State &state)
+{
+	volatile long count=0;
+	for(auto _:state)
+	{
+		CountJob *job=EP_NEW CountJob(&count);
+		benchmark::DoNotOptimize(job);
+		job->ReleaseObj();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HeapJobNewRelease);
+
+static void BM_LightJobGetRelease(benchmark::State &state)
+{
+	volatile long count=0;
+	LightJobPool jobPool(1);
+	for(auto _:state)
+	{
+		LightJob *job=jobPool.Get();
+		job->SetFunc(countJobFunc,(void*)&count);
+		benchmark::DoNotOptimize(job);
+		job->ReleaseObj();
+	}
+	state.SetItemsProcessed(state.iterations());
+	state.counters["jobsCreated"]=(double)jobPool.GetJobCount();
+}
+BENCHMARK(BM_LightJobGetRelease);
@@ -187,6 +187,8 @@ namespace epl
 		LOCK_POLICY_CRITICALSECTION,
 		/// a multi process environment
 		LOCK_POLICY_MUTEX,
+		/// a multi thread environment with the concurrent readers (the classes without the shared access use CriticalSectionEx)
+		LOCK_POLICY_READWRITE,
 	}LockPolicy;
 
 	/// Console Priority
@@ -0,0 +1,418 @@
+/*! 
+@file epArena.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief Arena Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Arena (Monotonic Memory Allocator).
+
+*/
+#ifndef __EP_ARENA_H__
+#define __EP_ARENA_H__
+#include "epLib.h"
+#include "epMemory.h"
+#include "epSystem.h"
+#include "epCriticalSectionEx.h"
+#include "epMutex.h"
+#include "epNoLock.h"
+#include <vector>
+#include <new>
+
+/// Default size of the memory block of the arena in bytes
+#define ARENA_DEFAULT_BLOCK_SIZE 65536
+/// Default alignment of the memory allocated from the arena in bytes
+#define ARENA_DEFAULT_ALIGNMENT 16
+
+namespace epl
+{
+	/*! 
+	@class Arena epArena.h
+	@brief A class that implements the monotonic (bump pointer) memory allocator.
+
+	The memory is carved out from the chained memory blocks, and individual deallocation is ignored.
+	The memory is reclaimed at once by Reset or Rewind, and the memory blocks are kept for the reuse.
+	@remark The destructors of the objects allocated from the arena are not called by the arena.
+	*/
+	class EP_LIBRARY Arena:public BaseMemoryAllocator
+	{
+	public:
+		/*!
+		@struct Marker epArena.h
+		@brief A position of the arena to rewind to.
+		*/
+		struct Marker
+		{
+			/// the index of the memory block
+			size_t m_blockIdx;
+			/// the offset within the memory block
+			size_t m_offset;
+			/// the used size of the arena
+			size_t m_usedSize;
+		};
+
+		/*!
+		Default Constructor
+
+		Initializes the arena
+		@param[in] blockSize the size of the memory block in bytes.
+		@param[in] lockPolicyType The lock policy
+		@remark the memory block is allocated on the first allocation.
+		*/
+		Arena(size_t blockSize=ARENA_DEFAULT_BLOCK_SIZE,LockPolicy lockPolicyType=EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+
+		Frees all the memory blocks of the arena
+		*/
+		virtual ~Arena();
+
+		/*!
+		Allocate the memory with given size aligned to ARENA_DEFAULT_ALIGNMENT.
+		@param[in] size the size of the memory to allocate in bytes.
+		@return the pointer to the memory allocated, or NULL if failed.
+		*/
+		virtual void *Allocate(size_t size);
+
+		/*!
+		Allocate the memory with given size and alignment.
+		@param[in] size the size of the memory to allocate in bytes.
+		@param[in] alignment the alignment of the memory. (must be power of 2)
+		@return the pointer to the memory allocated, or NULL if failed.
+		*/
+		void *Allocate(size_t size,size_t alignment);
+
+		/*!
+		Deallocate the memory allocated by this arena.
+		@param[in] ptr the pointer to the memory to deallocate.
+		@param[in] size the size of the memory given when allocated.
+		@remark this does nothing, since the memory is reclaimed by Reset or Rewind.
+		*/
+		virtual void Deallocate(void *ptr,size_t size);
+
+		/*!
+		Return the current position of the arena.
+		@return the current position of the arena.
+		*/
+		Marker GetMarker() const;
+
+		/*!
+		Reclaim all the memory allocated after the given position.
+		@param[in] marker the position returned by GetMarker.
+		*/
+		void Rewind(const Marker &marker);
+
+		/*!
+		Reclaim all the memory allocated, and keep the memory blocks for the reuse.
+		*/
+		void Reset();
+
+		/*!
+		Reclaim all the memory allocated, and free all the memory blocks.
+		*/
+		void Release();
+
+		/*!
+		Return the size of the memory allocated from the arena including the alignment paddings.
+		@return the size of the memory allocated in bytes.
+		*/
+		size_t GetUsedSize() const;
+
+		/*!
+		Return the total size of the memory blocks of the arena.
+		@return the total size of the memory blocks in bytes.
+		*/
+		size_t GetReservedSize() const;
+
+		/*!
+		Return the size of the memory block of the arena.
+		@return the size of the memory block in bytes.
+		*/
+		size_t GetBlockSize() const
+		{
+			return m_blockSize;
+		}
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Cannot be Used.
+		*/
+		Arena(const Arena & /*b*/){EP_ASSERT(0);}
+
+		/*!
+		Assignment operator overloading
+
+		*Cannot be Used.
+		*/
+		Arena &operator=(const Arena & /*b*/){EP_ASSERT(0);return *this;}
+
+		/*!
+		Actually allocate the memory without the lock.
+		@param[in] size the size of the memory to allocate in bytes.
+		@param[in] alignment the alignment of the memory.
+		@return the pointer to the memory allocated, or NULL if failed.
+		*/
+		void *allocate(size_t size,size_t alignment);
+
+		/*!
+		@struct Block epArena.h
+		@brief A memory block of the arena.
+		*/
+		struct Block
+		{
+			/// the memory of the block
+			char *m_memory;
+			/// the size of the memory
+			size_t m_size;
+		};
+
+		/// the memory blocks
+		std::vector<Block> m_blocks;
+		/// the index of the memory block currently used
+		size_t m_currentBlock;
+		/// the offset within the memory block currently used
+		size_t m_currentOffset;
+		/// the size of the memory allocated
+		size_t m_usedSize;
+		/// the size of the memory block
+		size_t m_blockSize;
+		/// lock
+		BaseLock *m_lock;
+	};
+
+	/*! 
+	@class ArenaScope epArena.h
+	@brief A class that rewinds the arena when the scope ends.
+
+	While the scope is alive, the arena is also set to MemoryHook as the allocator of the calling thread,
+	so EP_Malloc (with EP_ENABLE_MEMORY_HOOK defined) allocates from the arena.
+	@remark All the memory allocated from the arena within the scope must not be used after the scope ends.
+	*/
+	class EP_LIBRARY ArenaScope
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Marks the current position of the arena
+		@param[in] arena the arena to rewind when the scope ends.
+		@param[in] isThreadAllocator if true, set the arena as the allocator of the calling thread within the scope.
+		*/
+		ArenaScope(Arena &arena,bool isThreadAllocator=true);
+
+		/*!
+		Default Destructor
+
+		Restores the allocator of the calling thread, and rewinds the arena
+		*/
+		virtual ~ArenaScope();
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Cannot be Used.
+		*/
+		ArenaScope(const ArenaScope & b):m_arena(b.m_arena){EP_ASSERT(0);}
+
+		/*!
+		Assignment operator overloading
+
+		*Cannot be Used.
+		*/
+		ArenaScope &operator=(const ArenaScope & /*b*/){EP_ASSERT(0);return *this;}
+
+		/// the arena
+		Arena &m_arena;
+		/// the position of the arena when the scope started
+		Arena::Marker m_marker;
+		/// the allocator of the calling thread before the scope started
+		BaseMemoryAllocator *m_prevAllocator;
+		/// flag whether the arena is set as the allocator of the calling thread
+		bool m_isThreadAllocator;
+	};
+
+	/*! 
+	@class ArenaAllocator epArena.h
+	@brief A STL compatible allocator which allocates from the Arena.
+
+	i.e. std::vector<int,ArenaAllocator<int> > vec(ArenaAllocator<int>(arena));
+	*/
+	template<typename T>
+	class ArenaAllocator
+	{
+	public:
+		typedef T value_type;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		/*!
+		@struct rebind epArena.h
+		@brief The allocator for the other type.
+		*/
+		template<typename U>
+		struct rebind
+		{
+			typedef ArenaAllocator<U> other;
+		};
+
+		/*!
+		Default Constructor
+
+		Initializes the allocator
+		@param[in] arena the arena to allocate from.
+		*/
+		ArenaAllocator(Arena &arena):m_arena(&arena)
+		{
+		}
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the allocator
+		@param[in] b the second object
+		*/
+		ArenaAllocator(const ArenaAllocator &b):m_arena(b.m_arena)
+		{
+		}
+
+		/*!
+		Copy Constructor from the allocator of the other type
+
+		Initializes the allocator
+		@param[in] b the second object
+		*/
+		template<typename U>
+		ArenaAllocator(const ArenaAllocator<U> &b):m_arena(b.GetArena())
+		{
+		}
+
+		pointer address(reference x) const
+		{
+			return &x;
+		}
+
+		const_pointer address(const_reference x) const
+		{
+			return &x;
+		}
+
+		pointer allocate(size_type n,const void * /*hint*/=0)
+		{
+			void *ptr=m_arena->Allocate(n*sizeof(T),ARENA_DEFAULT_ALIGNMENT);
+			if(!ptr)
+				throw std::bad_alloc();
+			return reinterpret_cast<pointer>(ptr);
+		}
+
+		void deallocate(pointer p,size_type n)
+		{
+			m_arena->Deallocate(p,n*sizeof(T));
+		}
+
+		size_type max_size() const
+		{
+			return ((size_type)-1)/sizeof(T);
+		}
+
+		void construct(pointer p,const_reference val)
+		{
+			::new((void*)p) T(val);
+		}
+
+		void destroy(pointer p)
+		{
+			p->~T();
+		}
+
+		/*!
+		Return the arena of this allocator.
+		@return the arena of this allocator.
+		*/
+		Arena *GetArena() const
+		{
+			return m_arena;
+		}
+
+	private:
+		/// the arena
+		Arena *m_arena;
+	};
+
+	template<typename T,typename U>
+	bool operator==(const ArenaAllocator<T> &a,const ArenaAllocator<U> &b)
+	{
+		return a.GetArena()==b.GetArena();
+	}
+
+	template<typename T,typename U>
+	bool operator!=(const ArenaAllocator<T> &a,const ArenaAllocator<U> &b)
+	{
+		return a.GetArena()!=b.GetArena();
+	}
+}
+
+/*!
+Placement new operator to construct the object on the arena.
+
+i.e. MyClass *obj=EP_ARENA_NEW(arena) MyClass();
+@param[in] size the size of the object.
+@param[in] arena the arena to allocate from.
+@return the pointer to the memory allocated.
+@remark the destructor of the object must be called explicitly if needed.
+*/
+inline void *operator new(size_t size,epl::Arena &arena)
+{
+	void *ptr=arena.Allocate(size);
+	if(!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+/*!
+Placement delete operator called when the constructor throws.
+@param[in] ptr the pointer to the memory.
+@param[in] arena the arena allocated from.
+*/
+inline void operator delete(void *ptr,epl::Arena &arena)
+{
+	arena.Deallocate(ptr,0);
+}
+
+#define EP_ARENA_NEW(arena) new(arena)
+
+#endif //__EP_ARENA_H__
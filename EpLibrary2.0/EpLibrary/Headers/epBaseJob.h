@@ -49,6 +49,8 @@ namespace epl
 	/// Normal Priority is 0
 	#define PRIORITY_NORMAL 0
 
+	class JobScheduleQueue;
+
 	/*! 
 	@class BaseJob epBaseJob.h
 	@brief A base class for Job Objects.
@@ -61,6 +63,9 @@ namespace epl
 		friend class WorkerThreadSingle;
 		friend class ThreadSafePQueue<BaseJob*,BaseJob>;
 		friend class JobScheduleQueue;
+		friend class WorkStealingWorkerThread;
+		friend class ThreadPool;
+		friend class LightJob;
 
 		/// Enumeration for Job Status
 		enum JobStatus{
@@ -118,7 +123,10 @@ namespace epl
 
 		/*!
 		Set the priority of this job
+
+		If the job is in the Job Schedule Queue, the job is re-prioritized within the queue.
 		@param[in] newPrio new priority of this job
+		@remark the queue holding this job must not be destroyed while this is called.
 		*/
 		void SetPriority(Priority newPrio);
 
@@ -142,6 +150,9 @@ namespace epl
 		{
 			m_status=b.m_status;
 			m_priority=m_priority;
+			m_scheduleQueue=NULL;
+			m_scheduleIdx=0;
+			m_scheduleSeq=0;
 		}
 
 		/*!
@@ -173,6 +184,13 @@ namespace epl
 		/// priority of the Job
 		Priority m_priority;
 
+		/// the schedule queue currently holding this Job (set and cleared under the queue lock, read by SetPriority without it)
+		JobScheduleQueue *m_scheduleQueue;
+		/// the index of this Job within the schedule queue
+		size_t m_scheduleIdx;
+		/// the insertion sequence of this Job within the schedule queue
+		unsigned __int64 m_scheduleSeq;
+
 
 	};
 }
@@ -94,6 +94,29 @@ namespace epl
 		*/
 		virtual void Unlock()=0;
 
+		/*!
+		Locks for the shared access
+
+		The lock which does not support the shared access locks exclusively.
+		@return true if locked, false otherwise
+		*/
+		virtual bool LockShared();
+
+		/*!
+		Try to Lock for the shared access
+
+		If other thread holds the exclusive access, it just returns false and continue, otherwise obtain the shared access.
+		@return true if the lock is succeeded, otherwise false.
+		*/
+		virtual long TryLockShared();
+
+		/*!
+		Leave the shared access
+
+		The LockShared and UnlockShared has to be matched.
+		*/
+		virtual void UnlockShared();
+
 
 		/*! 
 		@class BaseLockObj epBaseLock.h
@@ -139,7 +162,57 @@ namespace epl
 
 			*Cannot be Used.
 			*/
-			BaseLockObj(const BaseLockObj & b){EP_ASSERT(0);m_lock=NULL;}
+			BaseLockObj(const BaseLockObj & /*b*/){EP_ASSERT(0);m_lock=NULL;}
+
+			/// The pointer to the lock used.
+			BaseLock *m_lock;
+		};
+
+
+		/*! 
+		@class BaseSharedLockObj epBaseLock.h
+		@brief A class that handles the shared lock.
+		*/
+		class EP_LIBRARY BaseSharedLockObj
+		{
+		public:
+			/*!
+			Default Constructor
+
+			Locks for the shared access where this object instantiated.
+			@param[in] lock the pointer to the lock to lock.
+			*/
+			BaseSharedLockObj(BaseLock *lock);
+
+			/*!
+			Default Destructor
+
+			Unlock the shared access when this object destroyed.
+			*/
+			virtual ~BaseSharedLockObj();
+
+		private:
+
+			/*!
+			Default Constructor
+
+			*Cannot be Used.
+			*/
+			BaseSharedLockObj();
+
+			/*!
+			Default Copy Constructor
+
+			*Cannot be Used.
+			*/
+			BaseSharedLockObj(const BaseSharedLockObj & /*b*/){EP_ASSERT(0);m_lock=NULL;}
+
+			/*!
+			Assignment operator overloading
+
+			*Cannot be Used.
+			*/
+			BaseSharedLockObj &operator=(const BaseSharedLockObj & /*b*/){EP_ASSERT(0);return *this;}
 
 			/// The pointer to the lock used.
 			BaseLock *m_lock;
@@ -149,6 +222,9 @@ namespace epl
 
 	/// type definition  for lock object
 	typedef BaseLock::BaseLockObj LockObj;
+
+	/// type definition  for shared lock object
+	typedef BaseLock::BaseSharedLockObj SharedLockObj;
 }
 
 #endif //__EP_BASE_LOCK_H__
\ No newline at end of file
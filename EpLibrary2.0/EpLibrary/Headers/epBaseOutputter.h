@@ -43,6 +43,7 @@ An Interface for Outputting data Template class.
 #include "epCriticalSectionEx.h"
 #include "epMutex.h"
 #include "epNoLock.h"
+#include "epReadWriteLock.h"
 
 namespace epl
 {
@@ -113,7 +114,7 @@ namespace epl
 			@param[in] b the second object
 			@return the new copied object
 			*/
-			OutputNode & operator=(const OutputNode&b)
+			OutputNode & operator=(const OutputNode&/*b*/)
 			{
 				return *this;
 			}
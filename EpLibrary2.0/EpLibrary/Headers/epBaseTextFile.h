@@ -44,6 +44,7 @@ An Interface for the Base Text File Class.
 #include "epCriticalSectionEx.h"
 #include "epMutex.h"
 #include "epNoLock.h"
+#include "epReadWriteLock.h"
 
 using namespace std;
 
@@ -94,13 +94,29 @@ namespace epl
 		Push in the new work to the work pool.
 		@param[in] work the new work to put into the work pool.
 		*/
-		void Push(BaseJob * const  work);
+		virtual void Push(BaseJob * const  work);
+
+		/*!
+		Push in the given works to the work pool under a single lock.
+		@param[in] works the array of the new works to put into the work pool.
+		@param[in] count the number of the works in the array.
+		*/
+		virtual void PushBatch(BaseJob * const *works,size_t count);
 
 		/*!
 		Pop a work from the work pool.
 		*/
 		void Pop();
 
+		/*!
+		Pop up to given number of works from the work pool under a single lock.
+		@param[out] retWorks the array to hold the works popped in the priority order.
+		@param[in] maxCount the maximum number of the works to pop.
+		@return the number of the works popped.
+		@remark the caller must call ReleaseObj for each of the returned works.
+		*/
+		size_t PopBatch(BaseJob **retWorks,size_t maxCount);
+
 		/*!
 		Get First Job in the Job Queue.
 		*/
@@ -133,7 +149,7 @@ namespace epl
 		Get job count in work pool.
 		@return the job count in work pool.
 		*/
-		size_t GetJobCount() const;
+		virtual size_t GetJobCount() const;
 
 		/*!
 		Set new Job Processor.
@@ -0,0 +1,154 @@
+/*! 
+@file epCpuTopology.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief CPU Topology Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for the CPU Topology (processors and NUMA nodes).
+
+*/
+#ifndef __EP_CPU_TOPOLOGY_H__
+#define __EP_CPU_TOPOLOGY_H__
+
+#include "epLib.h"
+#include "epSingletonHolder.h"
+#include <vector>
+
+#define CPU_TOPOLOGY_INSTANCE epl::SingletonHolder<epl::CpuTopology>::Instance()
+namespace epl
+{
+	/*!
+	@class CpuTopology epCpuTopology.h
+	@brief A class that describes the processors and the NUMA nodes of the system.
+
+	The topology is read once when the instance is created.
+	The processors are identified by their processor number, which is the bit index of the affinity mask,
+	so only the processors available to the process within the bits of DWORD_PTR are described.
+	If the system has no NUMA information, all processors belong to the node 0.
+	*/
+	class EP_LIBRARY CpuTopology
+	{
+	public:
+		friend class SingletonHolder<CpuTopology>;
+
+		/*!
+		Return the number of the processors available to the process.
+		@return the number of the processors available to the process.
+		*/
+		unsigned int GetProcessorCount() const;
+
+		/*!
+		Return the number of the NUMA nodes which have the available processors.
+		@return the number of the NUMA nodes.
+		*/
+		unsigned int GetNumaNodeCount() const;
+
+		/*!
+		Return the NUMA node index of the given processor.
+		@param[in] processor the processor number
+		@return the NUMA node index of the given processor. (0 if unknown)
+		*/
+		unsigned int GetProcessorNumaNode(unsigned int processor) const;
+
+		/*!
+		Return the affinity mask of the available processors of the given NUMA node.
+		@param[in] nodeIdx the NUMA node index (0 to GetNumaNodeCount()-1)
+		@return the affinity mask of the given NUMA node, or 0 if the node does not exist.
+		*/
+		DWORD_PTR GetNumaNodeAffinityMask(unsigned int nodeIdx) const;
+
+		/*!
+		Return the number of the available processors of the given NUMA node.
+		@param[in] nodeIdx the NUMA node index (0 to GetNumaNodeCount()-1)
+		@return the number of the available processors of the given NUMA node.
+		*/
+		unsigned int GetNumaNodeProcessorCount(unsigned int nodeIdx) const;
+
+		/*!
+		Return the NUMA node index of the processor which the calling thread is running on.
+		@return the NUMA node index of the current processor.
+		*/
+		unsigned int GetCurrentNumaNode() const;
+
+		/*!
+		Return the processor for the given order in compact placement.
+
+		The compact order fills a node before the next node, and the hardware threads of a core before the next core.
+		@param[in] order the order of the placement (wraps around the processor count)
+		@return the processor number.
+		*/
+		unsigned int GetCompactProcessor(unsigned int order) const;
+
+		/*!
+		Return the processor for the given order in scatter placement.
+
+		The scatter order spreads over the nodes first, and then over the cores before using the second hardware thread of a core.
+		@param[in] order the order of the placement (wraps around the processor count)
+		@return the processor number.
+		*/
+		unsigned int GetScatterProcessor(unsigned int order) const;
+
+	private:
+		/*!
+		Default Constructor
+
+		Reads the topology of the system.
+		*/
+		CpuTopology();
+
+		/*!
+		Default Destructor
+		*/
+		~CpuTopology();
+
+		/*!
+		Read the NUMA node and the core of each available processor.
+		@param[out] retCoreIds the core identifier of each processor in m_compactOrder before sorting.
+		*/
+		void readTopology(std::vector<unsigned int> &retCoreIds);
+
+		/*!
+		Build the compact and scatter orders from the nodes and the cores of the processors.
+		@param[in] coreIds the core identifier of each processor in m_compactOrder.
+		*/
+		void buildOrders(const std::vector<unsigned int> &coreIds);
+
+		/// the processors in compact order
+		std::vector<unsigned int> m_compactOrder;
+		/// the processors in scatter order
+		std::vector<unsigned int> m_scatterOrder;
+		/// the NUMA node index of each processor number
+		std::vector<unsigned int> m_processorNode;
+		/// the affinity mask of each NUMA node
+		std::vector<DWORD_PTR> m_nodeMasks;
+	};
+}
+#endif //__EP_CPU_TOPOLOGY_H__
@@ -113,7 +113,11 @@ namespace epl
 
 	private:
 		/// the actual lock member.
+#if defined(_WIN32) || defined(_WIN64)
 		CRITICAL_SECTION m_criticalSection;
+#else //defined(_WIN32) || defined(_WIN64)
+		pthread_mutex_t m_criticalSection;
+#endif //defined(_WIN32) || defined(_WIN64)
 		/// lock counter
 		int m_lockCounter;
 
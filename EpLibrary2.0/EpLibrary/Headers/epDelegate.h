@@ -43,6 +43,7 @@ An Interface for C# Style Delegate Class.
 #include "epCriticalSectionEx.h"
 #include "epMutex.h"
 #include "epNoLock.h"
+#include "epRuntimeLock.h"
 
 using namespace std;
 
@@ -51,8 +52,10 @@ namespace epl
 	/*! 
 	@class Delegate epDelegate.h
 	@brief A class for C# Style Delegate.
+
+	With NullLock as LockType, the delegate does not lock at all regardless of the lock policy.
 	*/
-	template<typename RetType,typename ArgType=void>
+	template<typename RetType,typename ArgType=void,typename LockType=RuntimeLock>
 	class Delegate{
 	public:
 		/// Function Pointer Type Definition
@@ -67,21 +70,7 @@ namespace epl
 		Delegate(LockPolicy lockPolicyType=EP_LOCK_POLICY)
 		{
 			m_lockPolicy=lockPolicyType;
-			switch(lockPolicyType)
-			{
-			case LOCK_POLICY_CRITICALSECTION:
-				m_delegateLock=EP_NEW CriticalSectionEx();
-				break;
-			case LOCK_POLICY_MUTEX:
-				m_delegateLock=EP_NEW Mutex();
-				break;
-			case LOCK_POLICY_NONE:
-				m_delegateLock=EP_NEW NoLock();
-				break;
-			default:
-				m_delegateLock=NULL;
-				break;
-			}
+			m_delegateLock.Reset(lockPolicyType);
 		}
 
 		/*!
@@ -95,21 +84,7 @@ namespace epl
 		{
 			m_lockPolicy=lockPolicyType;
 			m_funcList.push_back(func);
-			switch(lockPolicyType)
-			{
-			case LOCK_POLICY_CRITICALSECTION:
-				m_delegateLock=EP_NEW CriticalSectionEx();
-				break;
-			case LOCK_POLICY_MUTEX:
-				m_delegateLock=EP_NEW Mutex();
-				break;
-			case LOCK_POLICY_NONE:
-				m_delegateLock=EP_NEW NoLock();
-				break;
-			default:
-				m_delegateLock=NULL;
-				break;
-			}
+			m_delegateLock.Reset(lockPolicyType);
 		}
 
 		/*!
@@ -118,26 +93,12 @@ namespace epl
 		Initializes the delegate with given delegate
 		@param[in] orig the delegate
 		*/
-		Delegate(const Delegate<RetType,ArgType> &orig)
+		Delegate(const Delegate<RetType,ArgType,LockType> &orig)
 		{
 			m_lockPolicy=orig.m_lockPolicy;
-			switch(m_lockPolicy)
-			{
-			case LOCK_POLICY_CRITICALSECTION:
-				m_delegateLock=EP_NEW CriticalSectionEx();
-				break;
-			case LOCK_POLICY_MUTEX:
-				m_delegateLock=EP_NEW Mutex();
-				break;
-			case LOCK_POLICY_NONE:
-				m_delegateLock=EP_NEW NoLock();
-				break;
-			default:
-				m_delegateLock=NULL;
-				break;
-			}
-			LockObj lock(b.m_delegateLock);
-			m_funcList=b.m_funcList;
+			m_delegateLock.Reset(m_lockPolicy);
+			LockGuard<LockType> lock(orig.m_delegateLock);
+			m_funcList=orig.m_funcList;
 		}
 
 		/*!
@@ -147,8 +108,6 @@ namespace epl
 		*/
 		virtual ~Delegate()
 		{
-			if(m_delegateLock)
-				EP_DELETE m_delegateLock;
 		}	
 		
 		/*!
@@ -158,33 +117,14 @@ namespace epl
 		@param[in] b right side of packet
 		@return this object
 		*/
-		Delegate<RetType,ArgType> & operator=(const Delegate<RetType,ArgType>&b)
+		Delegate<RetType,ArgType,LockType> & operator=(const Delegate<RetType,ArgType,LockType>&b)
 		{
 			if(this!=&b)
 			{
-				if(m_delegateLock)
-				{
-					EP_DELETE m_delegateLock;
-					m_delegateLock=NULL;
-				}
 				
 				m_lockPolicy=b.m_lockPolicy;
-				switch(m_lockPolicy)
-				{
-				case LOCK_POLICY_CRITICALSECTION:
-					m_delegateLock=EP_NEW CriticalSectionEx();
-					break;
-				case LOCK_POLICY_MUTEX:
-					m_delegateLock=EP_NEW Mutex();
-					break;
-				case LOCK_POLICY_NONE:
-					m_delegateLock=EP_NEW NoLock();
-					break;
-				default:
-					m_delegateLock=NULL;
-					break;
-				}
-				LockObj lock(b.m_delegateLock);
+				m_delegateLock.Reset(m_lockPolicy);
+				LockGuard<LockType> lock(b.m_delegateLock);
 				m_funcList=b.m_funcList;
 			}
 			return *this;
@@ -196,7 +136,7 @@ namespace epl
 		*/
 		bool IsEmpty() const
 		{
-			LockObj lock(m_delegateLock);
+			LockGuard<LockType> lock(m_delegateLock);
 			return m_funcList.empty();
 		}
 
@@ -206,7 +146,7 @@ namespace epl
 		*/
 		int Size() const
 		{
-			LockObj lock(m_delegateLock);
+			LockGuard<LockType> lock(m_delegateLock);
 			return m_funcList.size();
 		}
 
@@ -215,7 +155,7 @@ namespace epl
 		*/
 		void Clear()
 		{
-			LockObj lock(m_delegateLock);
+			LockGuard<LockType> lock(m_delegateLock);
 			m_funcList.clear();
 		}
 
@@ -224,9 +164,9 @@ namespace epl
 		@param[in] func The initial function pointer
 		@return reference to this delegate
 		*/
-		virtual Delegate<RetType,ArgType> & operator =(RetType (*func)(ArgType))
+		virtual Delegate<RetType,ArgType,LockType> & operator =(RetType (*func)(ArgType))
 		{
-			LockObj lock(m_delegateLock);
+			LockGuard<LockType> lock(m_delegateLock);
 			m_funcList.clear();
 			m_funcList.push_back(func);
 			return *this;
@@ -237,9 +177,9 @@ namespace epl
 		@param[in] func The function pointer to append
 		@return reference to this delegate
 		*/
-		virtual Delegate<RetType,ArgType> & operator +=(RetType (*func)(ArgType))
+		virtual Delegate<RetType,ArgType,LockType> & operator +=(RetType (*func)(ArgType))
 		{
-			LockObj lock(m_delegateLock);
+			LockGuard<LockType> lock(m_delegateLock);
 			m_funcList.push_back(func);
 			return *this;
 		}
@@ -249,9 +189,9 @@ namespace epl
 		@param[in] func The function pointer to append
 		@return the delegate with the function pointers from this delegate and given function pointer
 		*/
-		virtual Delegate<RetType,ArgType> operator +(RetType (*func)(ArgType)) const
+		virtual Delegate<RetType,ArgType,LockType> operator +(RetType (*func)(ArgType)) const
 		{
-			Delegate<RetType,ArgType> ret(*this);
+			Delegate<RetType,ArgType,LockType> ret(*this);
 			ret+=func;
 			return ret;
 		}
@@ -261,13 +201,13 @@ namespace epl
 		@param[in] right The delegate to append
 		@return reference to this delegate
 		*/
-		virtual Delegate<RetType,ArgType> & operator +=(const Delegate<RetType,ArgType> &right)
+		virtual Delegate<RetType,ArgType,LockType> & operator +=(const Delegate<RetType,ArgType,LockType> &right)
 		{
-			LockObj lock(m_delegateLock);
-			vector<RetType (*)(ArgType)>::const_iterator iter;
+			LockGuard<LockType> lock(m_delegateLock);
+			typename vector<RetType (*)(ArgType)>::const_iterator iter;
 			if(this==&right)
 			{
-				Delegate<RetType,ArgType> tempDel(right);
+				Delegate<RetType,ArgType,LockType> tempDel(right);
 				for(iter=tempDel.m_funcList.begin();iter!=tempDel.m_funcList.end();iter++)
 				{
 					m_funcList.push_back(*iter);
@@ -287,9 +227,9 @@ namespace epl
 		@param[in] right The delegate to append
 		@return the delegate with the function pointers from this delegate and given delegate
 		*/
-		virtual Delegate<RetType,ArgType> operator +(const Delegate<RetType,ArgType> &right) const
+		virtual Delegate<RetType,ArgType,LockType> operator +(const Delegate<RetType,ArgType,LockType> &right) const
 		{
-			Delegate<RetType,ArgType> ret(*this);
+			Delegate<RetType,ArgType,LockType> ret(*this);
 			ret+=right;
 			return ret;
 		}
@@ -299,10 +239,10 @@ namespace epl
 		@param[in] func The function pointer to remove
 		@return reference to this delegate
 		*/
-		virtual Delegate<RetType,ArgType> & operator -=(RetType (*func)(ArgType))
+		virtual Delegate<RetType,ArgType,LockType> & operator -=(RetType (*func)(ArgType))
 		{
-			LockObj lock(m_delegateLock);
-			vector<RetType (*)(ArgType)>::iterator iter;
+			LockGuard<LockType> lock(m_delegateLock);
+			typename vector<RetType (*)(ArgType)>::iterator iter;
 			for(iter=m_funcList.begin();iter!=m_funcList.end();)
 			{
 				if(*iter==func)
@@ -321,9 +261,9 @@ namespace epl
 		@param[in] func The function pointer to remove
 		@return the delegate with given function pointer extracted from this delegate
 		*/
-		virtual Delegate<RetType,ArgType> operator -(RetType (*func)(ArgType)) const
+		virtual Delegate<RetType,ArgType,LockType> operator -(RetType (*func)(ArgType)) const
 		{
-			Delegate<RetType,ArgType> ret(*this);
+			Delegate<RetType,ArgType,LockType> ret(*this);
 			ret-=func;
 			return ret;
 		}
@@ -333,15 +273,15 @@ namespace epl
 		@param[in] right The delegate to remove
 		@return reference to this delegate
 		*/
-		virtual Delegate<RetType,ArgType> & operator -=(const Delegate<RetType,ArgType> &right)
+		virtual Delegate<RetType,ArgType,LockType> & operator -=(const Delegate<RetType,ArgType,LockType> &right)
 		{
-			LockObj lock(m_delegateLock);
+			LockGuard<LockType> lock(m_delegateLock);
 
-			vector<RetType (*)(ArgType)>::const_iterator rightIter;
-			vector<RetType (*)(ArgType)>::iterator iter;
+			typename vector<RetType (*)(ArgType)>::const_iterator rightIter;
+			typename vector<RetType (*)(ArgType)>::iterator iter;
 			if(this==&right)
 			{
-				Delegate<RetType,ArgType> tempDel(right);
+				Delegate<RetType,ArgType,LockType> tempDel(right);
 				for(rightIter=tempDel.m_funcList.begin();rightIter!=tempDel.m_funcList.end();rightIter++)
 				{
 					for(iter=m_funcList.begin();iter!=m_funcList.end();)
@@ -376,9 +316,9 @@ namespace epl
 		@param[in] right The delegate to remove
 		@return the delegate with the function pointers of given delegate extracted from this delegate
 		*/
-		virtual Delegate<RetType,ArgType> operator -(const Delegate<RetType,ArgType> &right) const
+		virtual Delegate<RetType,ArgType,LockType> operator -(const Delegate<RetType,ArgType,LockType> &right) const
 		{
-			Delegate<RetType,ArgType> ret(*this);
+			Delegate<RetType,ArgType,LockType> ret(*this);
 			ret-=right;
 			return ret;
 		}
@@ -391,7 +331,7 @@ namespace epl
 		virtual FuncType operator [](size_t idx) const
 		{
 			EP_ASSERT(idx<m_funcList.size());
-			vector<RetType (*)(ArgType)>::const_iterator iter=m_funcList.begin();
+			typename vector<RetType (*)(ArgType)>::const_iterator iter=m_funcList.begin();
 			iter+=idx;
 			return *iter;
 		
@@ -405,8 +345,8 @@ namespace epl
 		virtual RetType operator ()(ArgType arg)
 		{
 			EP_ASSERT(m_funcList.size());
-			vector<RetType (*)(ArgType)>::iterator iter;
-			vector<RetType (*)(ArgType)>::iterator lastIterCheck;
+			typename vector<RetType (*)(ArgType)>::iterator iter;
+			typename vector<RetType (*)(ArgType)>::iterator lastIterCheck;
 			for(iter=m_funcList.begin();iter!=m_funcList.end();iter++)
 			{
 				lastIterCheck=iter;
@@ -423,7 +363,7 @@ namespace epl
 		/// function pointer list
 		vector<RetType (*)(ArgType)> m_funcList;
 		/// lock
-		BaseLock *m_delegateLock;
+		mutable LockType m_delegateLock;
 		/// Lock Policy
 		LockPolicy m_lockPolicy;
 	};
@@ -432,8 +372,8 @@ namespace epl
 	@class Delegate epDelegate.h
 	@brief A partial specialization class for C# Style Delegate with void argument.
 	*/
-	template<typename RetType>
-	class Delegate<RetType,void>{
+	template<typename RetType,typename LockType>
+	class Delegate<RetType,void,LockType>{
 	public:
 		/// Function Pointer Type Definition
 		typedef RetType (*FuncType) (void);
@@ -447,21 +387,7 @@ namespace epl
 		Delegate(LockPolicy lockPolicyType=EP_LOCK_POLICY)
 		{
 			m_lockPolicy=lockPolicyType;
-			switch(lockPolicyType)
-			{
-			case LOCK_POLICY_CRITICALSECTION:
-				m_delegateLock=EP_NEW CriticalSectionEx();
-				break;
-			case LOCK_POLICY_MUTEX:
-				m_delegateLock=EP_NEW Mutex();
-				break;
-			case LOCK_POLICY_NONE:
-				m_delegateLock=EP_NEW NoLock();
-				break;
-			default:
-				m_delegateLock=NULL;
-				break;
-			}
+			m_delegateLock.Reset(lockPolicyType);
 		}
 
 		/*!
@@ -475,21 +401,7 @@ namespace epl
 		{
 			m_lockPolicy=lockPolicyType;
 			m_funcList.push_back(func);
-			switch(lockPolicyType)
-			{
-			case LOCK_POLICY_CRITICALSECTION:
-				m_delegateLock=EP_NEW CriticalSectionEx();
-				break;
-			case LOCK_POLICY_MUTEX:
-				m_delegateLock=EP_NEW Mutex();
-				break;
-			case LOCK_POLICY_NONE:
-				m_delegateLock=EP_NEW NoLock();
-				break;
-			default:
-				m_delegateLock=NULL;
-				break;
-			}
+			m_delegateLock.Reset(lockPolicyType);
 		}
 
 		/*!
@@ -498,26 +410,12 @@ namespace epl
 		Initializes the delegate with given delegate
 		@param[in] orig the delegate
 		*/
-		Delegate(const Delegate<RetType,void> &orig)
+		Delegate(const Delegate<RetType,void,LockType> &orig)
 		{
 
 			m_lockPolicy=orig.m_lockPolicy;
-			switch(m_lockPolicy)
-			{
-			case LOCK_POLICY_CRITICALSECTION:
-				m_delegateLock=EP_NEW CriticalSectionEx();
-				break;
-			case LOCK_POLICY_MUTEX:
-				m_delegateLock=EP_NEW Mutex();
-				break;
-			case LOCK_POLICY_NONE:
-				m_delegateLock=EP_NEW NoLock();
-				break;
-			default:
-				m_delegateLock=NULL;
-				break;
-			}
-			LockObj lock(b.m_delegateLock);
+			m_delegateLock.Reset(m_lockPolicy);
+			LockGuard<LockType> lock(orig.m_delegateLock);
 			m_funcList=orig.m_funcList;
 		}
 
@@ -528,8 +426,6 @@ namespace epl
 		*/
 		virtual ~Delegate()
 		{
-			if(m_delegateLock)
-				EP_DELETE m_delegateLock;
 		}
 
 		/*!
@@ -539,33 +435,14 @@ namespace epl
 		@param[in] b right side of packet
 		@return this object
 		*/
-		Delegate<RetType,void> & operator=(const Delegate<RetType,void>&b)
+		Delegate<RetType,void,LockType> & operator=(const Delegate<RetType,void,LockType>&b)
 		{
 			if(this!=&b)
 			{
-				if(m_delegateLock)
-				{
-					EP_DELETE m_delegateLock;
-					m_delegateLock=NULL;
-				}
 				
 				m_lockPolicy=b.m_lockPolicy;
-				switch(m_lockPolicy)
-				{
-				case LOCK_POLICY_CRITICALSECTION:
-					m_delegateLock=EP_NEW CriticalSectionEx();
-					break;
-				case LOCK_POLICY_MUTEX:
-					m_delegateLock=EP_NEW Mutex();
-					break;
-				case LOCK_POLICY_NONE:
-					m_delegateLock=EP_NEW NoLock();
-					break;
-				default:
-					m_delegateLock=NULL;
-					break;
-				}
-				LockObj lock(b.m_delegateLock);
+				m_delegateLock.Reset(m_lockPolicy);
+				LockGuard<LockType> lock(b.m_delegateLock);
 				m_funcList=b.m_funcList;
 			}
 			return *this;
@@ -577,7 +454,7 @@ namespace epl
 		*/
 		bool IsEmpty() const
 		{
-			LockObj lock(m_delegateLock);
+			LockGuard<LockType> lock(m_delegateLock);
 			return m_funcList.empty();
 		}
 
@@ -587,7 +464,7 @@ namespace epl
 		*/
 		int Size() const
 		{
-			LockObj lock(m_delegateLock);
+			LockGuard<LockType> lock(m_delegateLock);
 			return m_funcList.size();
 		}
 
@@ -596,7 +473,7 @@ namespace epl
 		*/
 		void Clear()
 		{
-			LockObj lock(m_delegateLock);
+			LockGuard<LockType> lock(m_delegateLock);
 			m_funcList.clear();
 		}
 
@@ -605,9 +482,9 @@ namespace epl
 		@param[in] func The initial function pointer
 		@return reference to this delegate
 		*/
-		virtual Delegate<RetType,void> & operator =(RetType (*func)(void))
+		virtual Delegate<RetType,void,LockType> & operator =(RetType (*func)(void))
 		{
-			LockObj lock(m_delegateLock);
+			LockGuard<LockType> lock(m_delegateLock);
 			m_funcList.clear();
 			m_funcList.push_back(func);
 			return *this;
@@ -618,9 +495,9 @@ namespace epl
 		@param[in] func The function pointer to append
 		@return reference to this delegate
 		*/
-		virtual Delegate<RetType,void> & operator +=(RetType (*func)(void))
+		virtual Delegate<RetType,void,LockType> & operator +=(RetType (*func)(void))
 		{
-			LockObj lock(m_delegateLock);
+			LockGuard<LockType> lock(m_delegateLock);
 			m_funcList.push_back(func);
 			return *this;
 		}
@@ -630,9 +507,9 @@ namespace epl
 		@param[in] func The function pointer to append
 		@return the delegate with the function pointers from this delegate and given function pointer
 		*/
-		virtual Delegate<RetType,void> operator +(RetType (*func)(void)) const
+		virtual Delegate<RetType,void,LockType> operator +(RetType (*func)(void)) const
 		{
-			Delegate<RetType,void> ret(*this);
+			Delegate<RetType,void,LockType> ret(*this);
 			ret+=func;
 			return ret;
 		}
@@ -642,13 +519,13 @@ namespace epl
 		@param[in] right The delegate to append
 		@return reference to this delegate
 		*/
-		virtual Delegate<RetType,void> & operator +=(const Delegate<RetType,void> &right)
+		virtual Delegate<RetType,void,LockType> & operator +=(const Delegate<RetType,void,LockType> &right)
 		{
-			LockObj lock(m_delegateLock);
-			vector<RetType (*)(void)>::const_iterator iter;
+			LockGuard<LockType> lock(m_delegateLock);
+			typename vector<RetType (*)(void)>::const_iterator iter;
 			if(this==&right)
 			{
-				Delegate<RetType,void> tempDel(right);
+				Delegate<RetType,void,LockType> tempDel(right);
 				for(iter=tempDel.m_funcList.begin();iter!=tempDel.m_funcList.end();iter++)
 				{
 					m_funcList.push_back(*iter);
@@ -668,9 +545,9 @@ namespace epl
 		@param[in] right The delegate to append
 		@return the delegate with the function pointers from this delegate and given delegate
 		*/
-		virtual Delegate<RetType,void> operator +(const Delegate<RetType,void> &right) const
+		virtual Delegate<RetType,void,LockType> operator +(const Delegate<RetType,void,LockType> &right) const
 		{
-			Delegate<RetType,void> ret(*this);
+			Delegate<RetType,void,LockType> ret(*this);
 			ret+=right;
 			return ret;
 		}
@@ -680,10 +557,10 @@ namespace epl
 		@param[in] func The function pointer to remove
 		@return reference to this delegate
 		*/
-		virtual Delegate<RetType,void> & operator -=(RetType (*func)(void))
+		virtual Delegate<RetType,void,LockType> & operator -=(RetType (*func)(void))
 		{
-			LockObj lock(m_delegateLock);
-			vector<RetType (*)(void)>::iterator iter;
+			LockGuard<LockType> lock(m_delegateLock);
+			typename vector<RetType (*)(void)>::iterator iter;
 			for(iter=m_funcList.begin();iter!=m_funcList.end();)
 			{
 				if(*iter==func)
@@ -702,9 +579,9 @@ namespace epl
 		@param[in] func The function pointer to remove
 		@return the delegate with given function pointer extracted from this delegate
 		*/
-		virtual Delegate<RetType,void> operator -(RetType (*func)(void)) const
+		virtual Delegate<RetType,void,LockType> operator -(RetType (*func)(void)) const
 		{
-			Delegate<RetType,void> ret(*this);
+			Delegate<RetType,void,LockType> ret(*this);
 			ret-=func;
 			return ret;
 		}
@@ -714,15 +591,15 @@ namespace epl
 		@param[in] right The delegate to remove
 		@return reference to this delegate
 		*/
-		virtual Delegate<RetType,void> & operator -=(const Delegate<RetType,void> &right)
+		virtual Delegate<RetType,void,LockType> & operator -=(const Delegate<RetType,void,LockType> &right)
 		{
-			LockObj lock(m_delegateLock);
+			LockGuard<LockType> lock(m_delegateLock);
 
-			vector<RetType (*)(void)>::const_iterator rightIter;
-			vector<RetType (*)(void)>::iterator iter;
+			typename vector<RetType (*)(void)>::const_iterator rightIter;
+			typename vector<RetType (*)(void)>::iterator iter;
 			if(this==&right)
 			{
-				Delegate<RetType,void> tempDel(right);
+				Delegate<RetType,void,LockType> tempDel(right);
 				for(rightIter=tempDel.m_funcList.begin();rightIter!=tempDel.m_funcList.end();rightIter++)
 				{
 					for(iter=m_funcList.begin();iter!=m_funcList.end();)
@@ -757,9 +634,9 @@ namespace epl
 		@param[in] right The delegate to remove
 		@return the delegate with the function pointers of given delegate extracted from this delegate
 		*/
-		virtual Delegate<RetType,void> operator -(const Delegate<RetType,void> &right) const
+		virtual Delegate<RetType,void,LockType> operator -(const Delegate<RetType,void,LockType> &right) const
 		{
-			Delegate<RetType,void> ret(*this);
+			Delegate<RetType,void,LockType> ret(*this);
 			ret-=right;
 			return ret;
 		}
@@ -772,7 +649,7 @@ namespace epl
 		virtual FuncType operator [](size_t idx) const
 		{
 			EP_ASSERT(idx<m_funcList.size());
-			vector<RetType (*)(void)>::const_iterator iter=m_funcList.begin();
+			typename vector<RetType (*)(void)>::const_iterator iter=m_funcList.begin();
 			iter+=idx;
 			return *iter;
 
@@ -785,8 +662,8 @@ namespace epl
 		virtual RetType operator ()()
 		{
 			EP_ASSERT(m_funcList.size());
-			vector<RetType (*)(void)>::iterator iter;
-			vector<RetType (*)(void)>::iterator lastIterCheck;
+			typename vector<RetType (*)(void)>::iterator iter;
+			typename vector<RetType (*)(void)>::iterator lastIterCheck;
 			for(iter=m_funcList.begin();iter!=m_funcList.end();iter++)
 			{
 				lastIterCheck=iter;
@@ -803,23 +680,23 @@ namespace epl
 		/// function pointer list
 		vector<RetType (*)(void)> m_funcList;
 		/// lock
-		BaseLock *m_delegateLock;
+		mutable LockType m_delegateLock;
 		/// Lock Policy
 		LockPolicy m_lockPolicy;
 	};
 
-	template<typename RetType,typename ArgType>
-	Delegate<RetType,ArgType> operator +(RetType (*func)(ArgType),const Delegate<RetType,ArgType>& right)
+	template<typename RetType,typename ArgType,typename LockType>
+	Delegate<RetType,ArgType,LockType> operator +(RetType (*func)(ArgType),const Delegate<RetType,ArgType,LockType>& right)
 	{
-		Delegate<RetType,ArgType> ret(func);
+		Delegate<RetType,ArgType,LockType> ret(func);
 		ret+=right;
 		return ret;
 	}
 
 // 	template<typename RetType,typename ArgType>
-// 	Delegate<RetType,ArgType> operator +(RetType (*func)(ArgType),RetType (*func2)(ArgType))
+// 	Delegate<RetType,ArgType,LockType> operator +(RetType (*func)(ArgType),RetType (*func2)(ArgType))
 // 	{
-// 		Delegate<RetType,ArgType> ret(func);
+// 		Delegate<RetType,ArgType,LockType> ret(func);
 // 		ret+=func2;
 // 		return ret;
 // 	}
@@ -0,0 +1,226 @@
+/*! 
+@file epDistributedReadWriteLock.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief DistributedReadWriteLock Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Reader-Writer Lock with Distributed Reader Counters.
+
+*/
+#ifndef __EP_DISTRIBUTED_READ_WRITE_LOCK_H__
+#define __EP_DISTRIBUTED_READ_WRITE_LOCK_H__
+#include "epLib.h"
+#include "epSystem.h"
+#include "epBaseLock.h"
+#include "epCriticalSectionEx.h"
+#include "epEventEx.h"
+
+/*!
+@def EP_CACHE_LINE_SIZE
+@brief Cache line size used to pad the reader slots
+*/
+#ifndef EP_CACHE_LINE_SIZE
+#define EP_CACHE_LINE_SIZE 64
+#endif //EP_CACHE_LINE_SIZE
+
+/*!
+@def DISTRIBUTED_READ_WRITE_LOCK_MAX_SLOT_COUNT
+@brief Maximum number of the reader slots
+*/
+#define DISTRIBUTED_READ_WRITE_LOCK_MAX_SLOT_COUNT 64
+
+namespace epl
+{
+	/*!
+	@class DistributedReadWriteLock epDistributedReadWriteLock.h
+	@brief A class that handles the reader-writer lock with the distributed reader counters.
+
+	The reader count is split into the cache line padded slots (as many as the cores by default),
+	and each reader only touches the slot of its thread, so the readers on the different cores do not contend.
+	The writer raises the writer flag and waits until every slot drains, so locking the exclusive access is
+	more expensive than ReadWriteLock; use this lock for the structures which are rarely written.
+	Once a writer is waiting, the new readers wait until the writer is done (writer-preferring).
+	@remark The exclusive access is recursive, but the shared access is not recursive,
+	        and the thread holding the exclusive access must not lock the shared access.
+	*/
+	class EP_LIBRARY DistributedReadWriteLock :public BaseLock
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the lock
+		@param[in] slotCount the number of the reader slots (0 to use the number of the cores)
+		*/
+		DistributedReadWriteLock(unsigned int slotCount=0);
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the DistributedReadWriteLock
+		@param[in] b the second object
+		*/
+		DistributedReadWriteLock(const DistributedReadWriteLock& b);
+
+		/*!
+		Default Destructor
+
+		Deletes the lock
+		*/
+		virtual ~DistributedReadWriteLock();
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		*/
+		DistributedReadWriteLock & operator=(const DistributedReadWriteLock&b);
+
+		/*!
+		Locks for the exclusive access
+		@return true if locked, false otherwise
+		*/
+		virtual bool Lock();
+
+		/*!
+		Try to Lock for the exclusive access
+
+		If other thread holds the lock, it just returns false and continue, otherwise obtain the exclusive access.
+		@return true if the lock is succeeded, otherwise false.
+		*/
+		virtual long TryLock();
+
+		/*!
+		Locks for the exclusive access
+
+		if other thread holds the lock,
+		and if it fails to lock in given time, it returns false, otherwise lock and return true.
+		@param[in] dwMilliSecond the wait time.
+		@return true if the lock is succeeded, otherwise false.
+		*/
+		virtual long TryLockFor(const unsigned int dwMilliSecond);
+
+		/*!
+		Leave the exclusive access
+
+		The Lock and Unlock has to be matched.
+		*/
+		virtual void Unlock();
+
+		/*!
+		Locks for the shared access
+		@return true if locked, false otherwise
+		*/
+		virtual bool LockShared();
+
+		/*!
+		Try to Lock for the shared access
+
+		If other thread holds or waits for the exclusive access, it just returns false and continue, otherwise obtain the shared access.
+		@return true if the lock is succeeded, otherwise false.
+		*/
+		virtual long TryLockShared();
+
+		/*!
+		Leave the shared access
+
+		The LockShared and UnlockShared has to be matched.
+		*/
+		virtual void UnlockShared();
+
+		/*!
+		Return the number of the reader slots
+		@return the number of the reader slots
+		*/
+		unsigned int GetSlotCount() const;
+
+	private:
+		/*!
+		@struct ReaderSlot epDistributedReadWriteLock.h
+		@brief The reader counter padded to the cache line.
+		*/
+		struct ReaderSlot
+		{
+			/// the number of the readers holding the shared access through this slot
+			volatile long m_readerCount;
+			/// padding to the cache line
+			char m_padding[EP_CACHE_LINE_SIZE-sizeof(long)];
+		};
+
+		/*!
+		Allocate the reader slots
+		@param[in] slotCount the number of the reader slots (0 to use the number of the cores)
+		*/
+		void createSlots(unsigned int slotCount);
+
+		/*!
+		Return the reader slot of the calling thread
+		@return the reader slot of the calling thread
+		*/
+		ReaderSlot &currentSlot();
+
+		/*!
+		Check if any reader holds the shared access
+		@return true if any slot is not empty, otherwise false.
+		*/
+		bool hasReader() const;
+
+		/*!
+		Raise the writer flag
+		*/
+		void beginWrite();
+
+		/*!
+		Lower the writer flag and wake the readers waiting
+		*/
+		void endWrite();
+
+		/// the reader slots aligned to the cache line
+		ReaderSlot *m_slots;
+		/// the buffer holding the reader slots
+		char *m_slotBuffer;
+		/// the number of the reader slots (power of 2)
+		unsigned int m_slotCount;
+		/// 1 while a writer holds or waits for the lock
+		volatile long m_writerFlag;
+		/// the number of the exclusive access obtained by the current writer
+		int m_writerRecursion;
+		/// the lock serializing the writers
+		CriticalSectionEx m_writerLock;
+		/// auto-reset event signaled when a reader leaves while a writer is waiting
+		EventEx m_noReaderEvent;
+		/// manual-reset event raised while no writer holds or waits for the lock
+		EventEx m_writerDoneEvent;
+	};
+
+}
+
+#endif //__EP_DISTRIBUTED_READ_WRITE_LOCK_H__
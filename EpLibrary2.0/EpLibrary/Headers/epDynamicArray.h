@@ -42,15 +42,26 @@ An Interface for Dynamic Array Data Structure.
 #include "epCriticalSectionEx.h"
 #include "epMutex.h"
 #include "epNoLock.h"
+#include "epRuntimeLock.h"
 #include "epException.h"
 
+/// the capacity of the Dynamic Array allocated by the first growth
+#define DYNAMIC_ARRAY_MIN_CAPACITY 4
+
 namespace epl
 {
 	/*! 
 	@class DynamicArray epDynamicArray.h
 	@brief A template class for Dynamic Array.
+
+	The capacity grows geometrically (doubles) when the elements are appended or accessed beyond the size,
+	so appending the elements one by one costs amortized constant time.
+	The elements are relocated by EP_Realloc (bitwise move), so DataType must be a plain data type.
+	If the memory cannot be allocated, the array keeps its elements, Append and Reserve return false,
+	and At, operator[] and operator+= throw ExceptionBadAlloc.
+	LockType is RuntimeLock by default, and NullLock makes the single-threaded array lock-free at the compile time.
 	*/
-	template <typename DataType>
+	template <typename DataType, typename LockType=RuntimeLock>
 	class DynamicArray
 	{
 	public:
@@ -69,7 +80,7 @@ namespace epl
 		Initializes the Dynamic Array with given array
 		@param[in] dArr the Dynamic Array Object to copy from
 		*/
-		DynamicArray(const DynamicArray<DataType> &dArr);
+		DynamicArray(const DynamicArray<DataType,LockType> &dArr);
 
 		/*!
 		Default Destructor
@@ -108,6 +119,40 @@ namespace epl
 		*/
 		bool Resize(size_t newSize);
 
+		/*!
+		Reserve the capacity of the given array to hold at least the given number of elements.
+		(Does Not change the number of elements)
+		@param[in] capacity The number of elements to reserve.
+		@return true if the array can hold the given number of elements, false if the memory cannot be allocated.
+		*/
+		bool Reserve(size_t capacity);
+
+		/*!
+		Return the number of elements the given array can hold without growing.
+		@return the capacity of the given array.
+		*/
+		size_t Capacity() const;
+
+		/*!
+		Return the pointer to the elements of the given array without locking.
+
+		For the hot loops, the elements from index 0 to Size()-1 can be accessed through the pointer without the lock call per element.
+		@remark The pointer is invalidated when the array grows,
+		        so the caller must make sure that no other thread modifies the array while using the pointer.
+		@return the pointer to the elements.
+		*/
+		DataType *GetData();
+
+		/*!
+		Return the pointer to the elements of the given array without locking.
+
+		For the hot loops, the elements from index 0 to Size()-1 can be accessed through the pointer without the lock call per element.
+		@remark The pointer is invalidated when the array grows,
+		        so the caller must make sure that no other thread modifies the array while using the pointer.
+		@return the pointer to the elements.
+		*/
+		const DataType *GetData() const;
+
 		/*!
 		Return the element at the given index of the given array.
 		@param[in] idx The index to return the element.
@@ -118,23 +163,23 @@ namespace epl
 		/*!
 		Append the element given to the dynamic array given.
 		@param[in] data The data to append at the end.
-		@return the result dynamic array
+		@return true if appended, false if the memory cannot be allocated.
 		*/
-		DynamicArray<DataType> &Append(const DataType &data);
+		bool Append(const DataType &data);
 
 		/*!
 		Append the given dynamic array to the this dynamic array.
 		@param[in] dArr The dynamic array structure to append.
-		@return the result dynamic array
+		@return true if appended, false if the memory cannot be allocated.
 		*/
-		DynamicArray<DataType> &Append(const DynamicArray<DataType> &dArr);
+		bool Append(const DynamicArray<DataType,LockType> &dArr);
 
 		/*!
 		Initialize this array to given array
 		@param[in] b the dynamic array structure to initialize this array
 		@return the result dynamic array
 		*/
-		DynamicArray<DataType> &operator=(const DynamicArray<DataType>& b);
+		DynamicArray<DataType,LockType> &operator=(const DynamicArray<DataType,LockType>& b);
 
 		/*!
 		Return the element at the given index of the given array.
@@ -157,48 +202,58 @@ namespace epl
 		@param[in] b The dynamic array structure to append.
 		@return the result dynamic array
 		*/
-		DynamicArray<DataType>& operator+=(const DynamicArray<DataType>& b);
+		DynamicArray<DataType,LockType>& operator+=(const DynamicArray<DataType,LockType>& b);
 
 		/*!
 		Return new array by appending the given dynamic array to the this dynamic array.
 		@param[in] b The dynamic array structure to append.
 		@return the new result dynamic array
 		*/
-		DynamicArray<DataType> operator+(const DynamicArray<DataType>& b) const;
+		DynamicArray<DataType,LockType> operator+(const DynamicArray<DataType,LockType>& b) const;
 
 		/*!
 		Append the given element to the this dynamic array.
 		@param[in] b The element to append.
 		@return the result dynamic array
 		*/
-		DynamicArray<DataType>& operator+=(const DataType& b);
+		DynamicArray<DataType,LockType>& operator+=(const DataType& b);
 
 		/*!
 		Return new array by appending the given element to the this dynamic array.
 		@param[in] b The element to append.
 		@return the new result dynamic array
 		*/
-		DynamicArray<DataType> operator+(const DataType& b) const;
+		DynamicArray<DataType,LockType> operator+(const DataType& b) const;
 	private:
 		/*!
 		Actual resize the given array to given size.
 		@param[in] newSize The new size to resize.
+		@return true if resized, false if the array is large enough already or the memory cannot be allocated.
+		@remark the array keeps its elements if the memory cannot be allocated.
 		*/
 		bool resize(size_t newSize);
 
+		/*!
+		Grow the capacity geometrically to hold at least the given number of elements.
+		@param[in] minSize The number of elements to hold.
+		@return true if the capacity is enough, false if the memory cannot be allocated.
+		*/
+		bool grow(size_t minSize);
+
 		/*!
 		Actual append the element given to the dynamic array given.
 		@param[in] data The data to append at the end.
-		@return the result dynamic array
+		@return true if appended, false if the memory cannot be allocated.
 		*/
-		DynamicArray<DataType> &append(const DataType &data);
+		bool append(const DataType &data);
 
 		/*!
 		Actual append the given dynamic array to the this dynamic array.
 		@param[in] dArr The dynamic array structure to append.
-		@return the result dynamic array
+		@return true if appended, false if the memory cannot be allocated.
+		@remark the caller must hold the lock of this array and the shared lock of dArr (unless dArr is this array).
 		*/
-		DynamicArray<DataType> &append(const DynamicArray<DataType> &dArr);
+		bool append(const DynamicArray<DataType,LockType> &dArr);
 
 		/*!
 		Actual delete the given array.
@@ -213,31 +268,17 @@ namespace epl
 		/// number of element
 		size_t m_numOfElements;
 		/// lock
-		BaseLock *m_arrayLock;
+		mutable LockType m_arrayLock;
 		/// Lock Policy
 		LockPolicy m_lockPolicy;
 
 	};
 
-	template <typename DataType>
-	DynamicArray<DataType>::DynamicArray(size_t initialSize,LockPolicy lockPolicyType)
+	template <typename DataType, typename LockType>
+	DynamicArray<DataType,LockType>::DynamicArray(size_t initialSize,LockPolicy lockPolicyType)
 	{
 		m_lockPolicy=lockPolicyType;
-		switch(lockPolicyType)
-		{
-		case LOCK_POLICY_CRITICALSECTION:
-			m_arrayLock=EP_NEW CriticalSectionEx();
-			break;
-		case LOCK_POLICY_MUTEX:
-			m_arrayLock=EP_NEW Mutex();
-			break;
-		case LOCK_POLICY_NONE:
-			m_arrayLock=EP_NEW NoLock();
-			break;
-		default:
-			m_arrayLock=NULL;
-			break;
-		}
+		m_arrayLock.Reset(lockPolicyType);
 		m_actualSize=initialSize;
 		m_numOfElements=initialSize;
 		if(m_actualSize)
@@ -249,26 +290,12 @@ namespace epl
 			m_head=NULL;
 		
 	}
-	template <typename DataType>
-	DynamicArray<DataType>::DynamicArray(const DynamicArray<DataType> &dArr)
+	template <typename DataType, typename LockType>
+	DynamicArray<DataType,LockType>::DynamicArray(const DynamicArray<DataType,LockType> &dArr)
 	{
 		m_lockPolicy=dArr.m_lockPolicy;
-		switch(m_lockPolicy)
-		{
-		case LOCK_POLICY_CRITICALSECTION:
-			m_arrayLock=EP_NEW CriticalSectionEx();
-			break;
-		case LOCK_POLICY_MUTEX:
-			m_arrayLock=EP_NEW Mutex();
-			break;
-		case LOCK_POLICY_NONE:
-			m_arrayLock=EP_NEW NoLock();
-			break;
-		default:
-			m_arrayLock=NULL;
-			break;
-		}
-		LockObj lock(dArr.m_arrayLock);
+		m_arrayLock.Reset(m_lockPolicy);
+		LockGuard<LockType> lock(dArr.m_arrayLock);
 		m_actualSize=dArr.m_actualSize;
 		m_numOfElements=dArr.m_numOfElements;
 		if(m_actualSize)
@@ -282,26 +309,24 @@ namespace epl
 
 	}
 
-	template <typename DataType>
-	DynamicArray<DataType>::~DynamicArray()
+	template <typename DataType, typename LockType>
+	DynamicArray<DataType,LockType>::~DynamicArray()
 	{
-		m_arrayLock->Lock();
+		m_arrayLock.Lock();
 		if(m_head)
 			EP_Free(m_head);
-		m_arrayLock->Unlock();
-		if(m_arrayLock)
-			EP_DELETE m_arrayLock;
+		m_arrayLock.Unlock();
 	}
 
-	template <typename DataType>
-	void DynamicArray<DataType>::Delete()
+	template <typename DataType, typename LockType>
+	void DynamicArray<DataType,LockType>::Delete()
 	{
-		LockObj lock(m_arrayLock);
+		LockGuard<LockType> lock(m_arrayLock);
 		deleteArr();
 	}
 
-	template <typename DataType>
-	void DynamicArray<DataType>::deleteArr()
+	template <typename DataType, typename LockType>
+	void DynamicArray<DataType,LockType>::deleteArr()
 	{
 		if(m_head)
 			EP_Free(m_head);
@@ -310,197 +335,231 @@ namespace epl
 		m_numOfElements=0;
 	}
 
-	template <typename DataType>
-	void DynamicArray<DataType>::Clear()
+	template <typename DataType, typename LockType>
+	void DynamicArray<DataType,LockType>::Clear()
 	{
-		LockObj lock(m_arrayLock);
+		LockGuard<LockType> lock(m_arrayLock);
 		System::Memset(m_head,0,sizeof(DataType)*m_actualSize);
 		m_numOfElements=0;
 	}
 
-	template <typename DataType>
-	bool DynamicArray<DataType>::IsEmpty() const
+	template <typename DataType, typename LockType>
+	bool DynamicArray<DataType,LockType>::IsEmpty() const
 	{
-		LockObj lock(m_arrayLock);
-		if(m_numOfElements)
-			return true;
-		return false;
+		LockGuard<LockType> lock(m_arrayLock);
+		return m_numOfElements==0;
 	}
 
-	template <typename DataType>
-	size_t DynamicArray<DataType>::Size() const
+	template <typename DataType, typename LockType>
+	size_t DynamicArray<DataType,LockType>::Size() const
 	{
-		LockObj lock(m_arrayLock);
+		LockGuard<LockType> lock(m_arrayLock);
 		return m_numOfElements;
 	}
 
-	template <typename DataType>
-	bool DynamicArray<DataType>::Resize(size_t newSize)
+	template <typename DataType, typename LockType>
+	bool DynamicArray<DataType,LockType>::Resize(size_t newSize)
 	{
-		LockObj lock(m_arrayLock);
+		LockGuard<LockType> lock(m_arrayLock);
 		return resize(newSize);
 	}
 
-	template <typename DataType>
-	bool DynamicArray<DataType>::resize(size_t newSize)
+	template <typename DataType, typename LockType>
+	bool DynamicArray<DataType,LockType>::resize(size_t newSize)
 	{
 		if(m_actualSize>=newSize)
 			return false;
+		DataType *newHead;
 		if(m_head)
-		{
-			m_head=reinterpret_cast<DataType*>(EP_Realloc(m_head,newSize*sizeof(DataType)));
-			System::Memset(m_head+m_actualSize,0,(newSize-m_actualSize)*sizeof(DataType));
-			m_actualSize=newSize;
-		}
+			newHead=reinterpret_cast<DataType*>(EP_Realloc(m_head,newSize*sizeof(DataType)));
 		else
-		{
-			m_head=reinterpret_cast<DataType*>(EP_Malloc(newSize*sizeof(DataType)));
-			System::Memset(m_head,0,newSize*sizeof(DataType));
-			m_actualSize=newSize;
-		}
-		EP_ASSERT(m_head);
+			newHead=reinterpret_cast<DataType*>(EP_Malloc(newSize*sizeof(DataType)));
+		// the old block is still valid if the reallocation failed
+		if(!newHead)
+			return false;
+		m_head=newHead;
+		System::Memset(m_head+m_actualSize,0,(newSize-m_actualSize)*sizeof(DataType));
+		m_actualSize=newSize;
 		return true;
 	}
 
-	template <typename DataType>
-	DataType &DynamicArray<DataType>::At(size_t idx)
+	template <typename DataType, typename LockType>
+	bool DynamicArray<DataType,LockType>::grow(size_t minSize)
+	{
+		if(m_actualSize>=minSize)
+			return true;
+		size_t newSize=m_actualSize*2;
+		if(newSize<DYNAMIC_ARRAY_MIN_CAPACITY)
+			newSize=DYNAMIC_ARRAY_MIN_CAPACITY;
+		if(newSize<minSize)
+			newSize=minSize;
+		return resize(newSize);
+	}
+
+	template <typename DataType, typename LockType>
+	bool DynamicArray<DataType,LockType>::Reserve(size_t capacity)
+	{
+		LockGuard<LockType> lock(m_arrayLock);
+		if(m_actualSize>=capacity)
+			return true;
+		return resize(capacity);
+	}
+
+	template <typename DataType, typename LockType>
+	size_t DynamicArray<DataType,LockType>::Capacity() const
+	{
+		LockGuard<LockType> lock(m_arrayLock);
+		return m_actualSize;
+	}
+
+	template <typename DataType, typename LockType>
+	DataType *DynamicArray<DataType,LockType>::GetData()
 	{
-		LockObj lock(m_arrayLock);
+		return m_head;
+	}
+
+	template <typename DataType, typename LockType>
+	const DataType *DynamicArray<DataType,LockType>::GetData() const
+	{
+		return m_head;
+	}
+
+	template <typename DataType, typename LockType>
+	DataType &DynamicArray<DataType,LockType>::At(size_t idx)
+	{
+		LockGuard<LockType> lock(m_arrayLock);
 		if(m_numOfElements<=idx)
 		{
-			resize(idx+1);
+			EP_VERIFY_BAD_ALLOC(grow(idx+1));
 			m_numOfElements=idx+1;
 		}
 		return *(m_head+idx);
 	}
 
 
-	template <typename DataType>
-	DynamicArray<DataType> &DynamicArray<DataType>::Append(const DataType &data)
+	template <typename DataType, typename LockType>
+	bool DynamicArray<DataType,LockType>::Append(const DataType &data)
 	{
-		LockObj lock(m_arrayLock);
-		append(data);
+		LockGuard<LockType> lock(m_arrayLock);
+		return append(data);
 	}
 
-	template <typename DataType>
-	DynamicArray<DataType> &DynamicArray<DataType>::Append(const DynamicArray<DataType> &dArr)
+	template <typename DataType, typename LockType>
+	bool DynamicArray<DataType,LockType>::Append(const DynamicArray<DataType,LockType> &dArr)
 	{
-		LockObj lock(m_arrayLock);
+		if(&dArr==this)
+		{
+			LockGuard<LockType> lock(m_arrayLock);
+			return append(dArr);
+		}
+		// lock the arrays in the order of their addresses, so two arrays appending each other do not deadlock
+		if(this<&dArr)
+		{
+			LockGuard<LockType> lock(m_arrayLock);
+			SharedLockGuard<LockType> sharedLock(dArr.m_arrayLock);
+			return append(dArr);
+		}
+		SharedLockGuard<LockType> sharedLock(dArr.m_arrayLock);
+		LockGuard<LockType> lock(m_arrayLock);
 		return append(dArr);
 	}
 
-	template <typename DataType>
-	DynamicArray<DataType> &DynamicArray<DataType>::append(const DataType &data)
+	template <typename DataType, typename LockType>
+	bool DynamicArray<DataType,LockType>::append(const DataType &data)
 	{
-		if(m_actualSize<m_numOfElements+1)
-		{
-			resize(m_numOfElements+1);
-		}
+		if(!grow(m_numOfElements+1))
+			return false;
 		*(m_head+m_numOfElements)=data;
 		m_numOfElements++;
+		return true;
 	}
 
-	template <typename DataType>
-	DynamicArray<DataType> &DynamicArray<DataType>::append(const DynamicArray<DataType> &dArr)
+	template <typename DataType, typename LockType>
+	bool DynamicArray<DataType,LockType>::append(const DynamicArray<DataType,LockType> &dArr)
 	{
-		if(m_actualSize < m_numOfElements+dArr.m_numOfElements)
-		{
-			resize(m_numOfElements+dArr.m_numOfElements);
-		}
-		if(m_head && dArr.m_head && dArr.m_actualSize)
-			System::Memcpy(m_head+m_numOfElements,dArr.m_numOfElements*sizeof(DataType),dArr.m_head,dArr.m_numOfElements*sizeof(DataType));
-		m_numOfElements+=dArr.m_numOfElements;
-		return *this;
+		size_t count=dArr.m_numOfElements;
+		if(!grow(m_numOfElements+count))
+			return false;
+		// dArr.m_head is read after the growth, since dArr may be this array
+		if(count)
+			System::Memcpy(m_head+m_numOfElements,count*sizeof(DataType),dArr.m_head,count*sizeof(DataType));
+		m_numOfElements+=count;
+		return true;
 	}
 
-	template <typename DataType>
-	DynamicArray<DataType> &DynamicArray<DataType>::operator=(const DynamicArray<DataType>& b)
+	template <typename DataType, typename LockType>
+	DynamicArray<DataType,LockType> &DynamicArray<DataType,LockType>::operator=(const DynamicArray<DataType,LockType>& b)
 	{
 		if(this != &b)
 		{
-			m_arrayLock->Lock();
+			m_arrayLock.Lock();
 			if(m_head)
 				EP_Free(m_head);
 			m_head=NULL;
-			m_arrayLock->Unlock();
-			if(m_arrayLock)
-				EP_DELETE m_arrayLock;
-			m_arrayLock=NULL;
+			m_arrayLock.Unlock();
 
 		
-			m_lockPolicy=dArr.m_lockPolicy;
-			switch(m_lockPolicy)
-			{
-			case LOCK_POLICY_CRITICALSECTION:
-				m_arrayLock=EP_NEW CriticalSectionEx();
-				break;
-			case LOCK_POLICY_MUTEX:
-				m_arrayLock=EP_NEW Mutex();
-				break;
-			case LOCK_POLICY_NONE:
-				m_arrayLock=EP_NEW NoLock();
-				break;
-			default:
-				m_arrayLock=NULL;
-				break;
-			}
-			LockObj lock(dArr.m_arrayLock);
-			m_actualSize=dArr.m_actualSize;
-			m_numOfElements=dArr.m_numOfElements;
+			m_lockPolicy=b.m_lockPolicy;
+			m_arrayLock.Reset(m_lockPolicy);
+			LockGuard<LockType> lock(b.m_arrayLock);
+			m_actualSize=b.m_actualSize;
+			m_numOfElements=b.m_numOfElements;
 			if(m_actualSize)
+			{
 				m_head=reinterpret_cast<DataType*>(EP_Malloc(sizeof(DataType)*m_actualSize));
+				EP_ASSERT(m_head);
+				System::Memcpy(m_head,sizeof(DataType)*m_actualSize,b.m_head,sizeof(DataType)*m_actualSize);
+			}
 			else
 				m_head=NULL;
-			EP_ASSERT(m_head);
-			System::Memcpy(m_head,sizeof(DataType)*m_actualSize,dArr.m_head,sizeof(DataType)*m_actualSize);
 
 
 		}
 		return *this;
 	}
 
-	template <typename DataType>
-	DataType& DynamicArray<DataType>::operator[](size_t idx)
+	template <typename DataType, typename LockType>
+	DataType& DynamicArray<DataType,LockType>::operator[](size_t idx)
 	{
 		return At(idx);
 	}
 
-	template <typename DataType>
-	const DataType& DynamicArray<DataType>::operator[](size_t idx) const	
+	template <typename DataType, typename LockType>
+	const DataType& DynamicArray<DataType,LockType>::operator[](size_t idx) const	
 	{
-		LockObj lock(m_arrayLock);
+		LockGuard<LockType> lock(m_arrayLock);
 		EP_ASSERT(m_numOfElements>idx);
 		return *(m_head+idx);
 	}
-	template <typename DataType>
-	DynamicArray<DataType>& DynamicArray<DataType>::operator+=(const DynamicArray<DataType>& b)
+	template <typename DataType, typename LockType>
+	DynamicArray<DataType,LockType>& DynamicArray<DataType,LockType>::operator+=(const DynamicArray<DataType,LockType>& b)
 	{
-		LockObj lock(m_arrayLock);
-		return append(b);
+		EP_VERIFY_BAD_ALLOC(Append(b));
+		return *this;
 	}
 
-	template <typename DataType>
-	DynamicArray<DataType> DynamicArray<DataType>::operator+(const DynamicArray<DataType>& b) const
+	template <typename DataType, typename LockType>
+	DynamicArray<DataType,LockType> DynamicArray<DataType,LockType>::operator+(const DynamicArray<DataType,LockType>& b) const
 	{
-		DynamicArray<DataType> retArr;
-		retArr.Append(*this);
-		retArr.Append(b);
+		DynamicArray<DataType,LockType> retArr;
+		EP_VERIFY_BAD_ALLOC(retArr.Append(*this));
+		EP_VERIFY_BAD_ALLOC(retArr.Append(b));
 		return retArr;
 	}
 
-	template <typename DataType>
-	DynamicArray<DataType>& DynamicArray<DataType>::operator+=(const DataType& b)
+	template <typename DataType, typename LockType>
+	DynamicArray<DataType,LockType>& DynamicArray<DataType,LockType>::operator+=(const DataType& b)
 	{
-		LockObj lock(m_arrayLock);
-		return append(b);
+		EP_VERIFY_BAD_ALLOC(Append(b));
+		return *this;
 	}
 
-	template <typename DataType>
-	DynamicArray<DataType> DynamicArray<DataType>::operator+(const DataType& b) const
+	template <typename DataType, typename LockType>
+	DynamicArray<DataType,LockType> DynamicArray<DataType,LockType>::operator+(const DataType& b) const
 	{
-		DynamicArray<DataType> retArr;
-		retArr.Append(*this);
-		retArr.Append(b);
+		DynamicArray<DataType,LockType> retArr;
+		EP_VERIFY_BAD_ALLOC(retArr.Append(*this));
+		EP_VERIFY_BAD_ALLOC(retArr.Append(b));
 		return retArr;				
 	}
 }
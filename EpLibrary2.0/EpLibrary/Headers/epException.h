@@ -39,6 +39,7 @@ An Interface for Exception.
 #define __EP_EXCEPTION_H__
 #include "epLib.h"
 #include <exception>
+#include <stdexcept>
 
 /*!
 @def EP_VERIFY_EXCEPTION_W_MSG
@@ -283,7 +284,7 @@ An Interface for Exception.
 		*/
 		virtual ~ExceptionThreadDeadLockError() throw()
 		{}
-#if !_HAS_EXCEPTIONS
+#if defined(_HAS_EXCEPTIONS) && !_HAS_EXCEPTIONS
 	protected:
 		/*!
 		Raise the exception
@@ -351,7 +352,7 @@ An Interface for Exception.
 		*/
 		virtual ~ExceptionThreadCreationError() throw()
 		{}
-#if !_HAS_EXCEPTIONS
+#if defined(_HAS_EXCEPTIONS) && !_HAS_EXCEPTIONS
 	protected:
 		/*!
 		Raise the exception
@@ -420,7 +421,7 @@ An Interface for Exception.
 		*/
 		virtual ~ExceptionThreadTerminationError() throw()
 		{}
-#if !_HAS_EXCEPTIONS
+#if defined(_HAS_EXCEPTIONS) && !_HAS_EXCEPTIONS
 	protected:
 		/*!
 		Raise the exception
@@ -80,4 +80,4 @@ namespace epl
 
 	};
 }
-#endif __EP_FAST_SQRT_H__
\ No newline at end of file
+#endif //__EP_FAST_SQRT_H__
\ No newline at end of file
@@ -48,6 +48,7 @@ namespace epl
 	/*! 
 	@class InterlockedEx epInterlockedEx.h
 	@brief A class that handles the Interlocked functionality.
+	@remark The waiting thread only yields its time slice, so SpinLock is preferable when the lock is contended.
 	*/
 	class EP_LIBRARY InterlockedEx :public BaseLock
 	{
@@ -38,7 +38,7 @@ An Interface for Job Scheudle Queue.
 #ifndef __EP_JOB_SCHEDULE_QUEUE_H__
 #define __EP_JOB_SCHEDULE_QUEUE_H__
 #include "epLib.h"
-#include "epThreadSafePQueue.h"
+#include "epThreadSafeQueue.h"
 #include "epBaseJob.h"
 
 namespace epl
@@ -46,10 +46,15 @@ namespace epl
 	/*! 
 	@class JobScheduleQueue epJobScheduleQueue.h
 	@brief A class for Thread Safe Priority Queue.
+
+	The jobs are kept in the binary heap ordered by the priority, and the jobs with same priority are in FIFO order.
+	Each job holds its index within the heap, so Push, Pop, Erase and re-prioritization are O(log n).
 	*/
-	class EP_LIBRARY JobScheduleQueue :public ThreadSafePQueue<BaseJob*, BaseJob>
+	class EP_LIBRARY JobScheduleQueue :public ThreadSafeQueue<BaseJob*>
 	{
 	public:
+		friend class BaseJob;
+
 		/*!
 		Default Constructor
 
@@ -63,8 +68,9 @@ namespace epl
 		Initializes the Semaphore
 		@param[in] b the second object
 		*/
-		JobScheduleQueue(const JobScheduleQueue& b):ThreadSafePQueue<BaseJob*, BaseJob>(b)
+		JobScheduleQueue(const JobScheduleQueue& b):ThreadSafeQueue<BaseJob*>(b)
 		{
+			m_pushCount=b.m_pushCount;
 		}
 		/*!
 		Default Destructor
@@ -82,7 +88,8 @@ namespace epl
 		{
 			if(this!=&b)
 			{
-				ThreadSafePQueue::operator =((const ThreadSafePQueue<BaseJob*, BaseJob>&)b);
+				ThreadSafeQueue<BaseJob*>::operator =(b);
+				m_pushCount=b.m_pushCount;
 			}
 			return *this;
 		}
@@ -93,11 +100,42 @@ namespace epl
 		*/
 		virtual void Push(BaseJob* const &data,const BaseJob::JobStatus status=BaseJob::JOB_STATUS_IN_QUEUE);
 
+		/*!
+		Insert the given items into the schedule queue under a single lock.
+		@param[in] datas The array of the inserting data.
+		@param[in] count the number of the data in the array.
+		@param[in] status the status to set for the data
+		*/
+		void PushBatch(BaseJob* const *datas,size_t count,const BaseJob::JobStatus status=BaseJob::JOB_STATUS_IN_QUEUE);
+
 		/*!
 		Remove the first item from the queue.
 		*/
 		virtual void Pop();
 
+		/*!
+		Return the item which will be removed last from the queue.
+		@return the last element of the queue in the priority order.
+		@remark the heap does not keep the last item in place, so this searches the leaves of the heap.
+		*/
+		BaseJob* &Back();
+
+		/*!
+		Clear the queue.
+		@remark the references held by the queue are released.
+		*/
+		void Clear();
+
+		/*!
+		Remove up to given number of the first items from the queue under a single lock.
+		@param[out] retDatas the array to hold the removed data in the priority order.
+		@param[in] maxCount the maximum number of the data to remove.
+		@return the number of the data removed.
+		@remark the reference held by the queue is passed to the caller,
+		        so the caller must call ReleaseObj for each of the returned data.
+		*/
+		size_t PopBatch(BaseJob **retDatas,size_t maxCount);
+
 		/*!
 		Erase the element with given schedule policy holder
 		@param[in] object the schedule policy holder to erase
@@ -110,6 +148,60 @@ namespace epl
 		@param[in] status the status to give to all element in the queue
 		*/
 		void ReportAllJob(const BaseJob::JobStatus status);
+
+	private:
+		/*!
+		Change the priority of the given job and re-position within the queue.
+		@param[in] object the job to change the priority
+		@param[in] newPrio the new priority of the job
+		@return false if the job is no longer in this queue, otherwise true.
+		*/
+		bool changePriority(BaseJob * const object, Priority newPrio);
+
+		/*!
+		Find the index of the given job within the queue.
+		@param[in] object the job to find
+		@return the index of the job if found, otherwise the size of the queue.
+		*/
+		size_t findIndex(BaseJob * const object) const;
+
+		/*!
+		Remove the job at the given index from the heap.
+		@param[in] idx the index of the job to remove
+		*/
+		void removeAt(size_t idx);
+
+		/*!
+		Check if job a should be processed before job b.
+		@param[in] a the job to compare
+		@param[in] b the other job to compare
+		@return true if job a is prior to job b, otherwise false.
+		*/
+		static bool isPrior(const BaseJob *a, const BaseJob *b);
+
+		/*!
+		Set the job at the given index and update its index.
+		@param[in] idx the index to set
+		@param[in] object the job to set
+		*/
+		void setAt(size_t idx, BaseJob * const object);
+
+		/*!
+		Move up the job at the given index until the heap property is satisfied.
+		@param[in] idx the index of the job
+		@return the new index of the job
+		*/
+		size_t heapifyUp(size_t idx);
+
+		/*!
+		Move down the job at the given index until the heap property is satisfied.
+		@param[in] idx the index of the job
+		@return the new index of the job
+		*/
+		size_t heapifyDown(size_t idx);
+
+		/// the number of jobs pushed so far (used for FIFO order among same priority)
+		unsigned __int64 m_pushCount;
 	};
 }
 #endif //__EP_JOB_SCHEDULE_QUEUE_H__
\ No newline at end of file
@@ -38,9 +38,14 @@ An Interface for K-ary Heap Template class.
 #ifndef __EP_KARYHEAP_H__
 #define __EP_KARYHEAP_H__
 #include "epLib.h"
-#include "epDynamicArray.h"
+#include "epCriticalSectionEx.h"
+#include "epMutex.h"
+#include "epNoLock.h"
+#include "epRuntimeLock.h"
 #include "epException.h"
 #include <stack>
+#include <vector>
+#include <map>
 using namespace std;
 
 namespace epl
@@ -50,14 +55,46 @@ namespace epl
 		/// K-ary Heap Mode using Recursive operation
 		KARY_HEAP_MODE_RECURSIVE,
 		/// K-ary Heap Mode using Loop operation
-		KARY_HEAP_MODE_LOOP
+		KARY_HEAP_MODE_LOOP,
+		/// K-ary Heap Mode using key to node index map
+		KARY_HEAP_MODE_INDEXED
 	}KaryHeapMode;
 
-	/*! 
+	/*!
+	@class KAryHeapKeyLess epKAryHeap.h
+	@brief A default key comparison functor for K-ary Heap which uses the given Compare Function.
+	*/
+	template <typename KeyType, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *)=CompClass<KeyType>::CompFunc >
+	class KAryHeapKeyLess
+	{
+	public:
+		/*!
+		Check if key a is less than key b
+		@param[in] a the key to compare
+		@param[in] b the other key to compare
+		@return true if a is less than b, otherwise false.
+		*/
+		bool operator()(const KeyType &a, const KeyType &b) const
+		{
+			return KeyCompareFunc(&a,&b)==COMP_RESULT_LESSTHAN;
+		}
+	};
+
+	/*!
 	@class KAryHeap epKAryHeap.h
 	@brief A K-ary Heap Template class.
+
+	The keys and the data are stored by value in the separate contiguous arrays,
+	so the child scan only touches the key array, and push/pop do not allocate once the arrays have grown.
+	The key comparison is done by KeyLess functor, which can be replaced with the functor that can be inlined
+	(default functor calls KeyCompareFunc).
+	The lock is chosen by LockType (StaticLock or NullLock) at the compile time, or by the lock policy with RuntimeLock (default).
+
+	With KARY_HEAP_MODE_INDEXED, the heap maintains the map from the key to the node,
+	so the key-addressed operations (GetData, ChangeKey, ChangeData, Erase, operator[])
+	do not need to walk the heap.
 	*/
-	template <typename KeyType,typename DataType, size_t k=5, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *)=CompClass<KeyType>::CompFunc >
+	template <typename KeyType,typename DataType, size_t k=5, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *)=CompClass<KeyType>::CompFunc, typename KeyLess=KAryHeapKeyLess<KeyType,KeyCompareFunc>, typename LockType=RuntimeLock >
 	class KAryHeap
 	{
 	public:
@@ -69,7 +106,7 @@ namespace epl
 		@param[in] lockPolicyType The lock policy
 		*/
 		KAryHeap(KaryHeapMode mode=KARY_HEAP_MODE_LOOP,LockPolicy lockPolicyType=EP_LOCK_POLICY);
-		
+
 		/*!
 		Default Copy Constructor
 
@@ -84,7 +121,7 @@ namespace epl
 		Destroys the K-ary Heap
 		*/
 		virtual ~KAryHeap();
-		
+
 
 		/*!
 		Initialize this heap to given heap
@@ -145,7 +182,7 @@ namespace epl
 		@return true if succeeded otherwise false.
 		*/
 		bool GetData(const KeyType &key,DataType &retData) const;
-		
+
 		/*!
 		Get the data of the node with given key.
 		@param[in] key The index of the node to get the data.
@@ -181,6 +218,7 @@ namespace epl
 
 		/*!
 		Clear the heap
+		(Does Not Free the memory)
 		*/
 		void Clear();
 
@@ -203,8 +241,14 @@ namespace epl
 		@return the number of element in the heap
 		*/
 		size_t Size() const;
-			
-		
+
+		/*!
+		Reserve the memory for the given number of elements.
+		@param[in] capacity the number of elements to reserve.
+		*/
+		void Reserve(size_t capacity);
+
+
 
 	protected:
 
@@ -219,8 +263,9 @@ namespace epl
 		Actually insert the key with given data to the heap
 		@param[in] key The key value to insert.
 		@param[in] data the data with the given key
+		@return the index of the inserted node
 		*/
-		void push(const KeyType &key, const DataType &data);
+		int push(const KeyType &key, const DataType &data);
 
 		/*!
 		Actually change the key of the node with given index with new key.
@@ -241,18 +286,20 @@ namespace epl
 		@param[in] index The index of the node to remove.
 		*/
 		void erase(int index);
-		
+
 		/*!
 		Heapify up the node with given index
 		@param[in] idx The index for the node to heapify up.
+		@return the new index of the node
 		*/
-		void heapifyUp(int idx);
+		int heapifyUp(int idx);
 
 		/*!
 		Heapify down the node with given index
 		@param[in] idx The index for the node to heapify down.
+		@return the new index of the node
 		*/
-		void heapifyDown(int idx);
+		int heapifyDown(int idx);
 
 		/*!
 		Return the minimum child of the given node index
@@ -279,7 +326,7 @@ namespace epl
 		*/
 		int findIndex(const KeyType &key, int rootIdx=0) const;
 
-		
+
 		/*!
 		Find the node index with given key by loop
 		@param[in] key The key of the node to find index.
@@ -289,12 +336,60 @@ namespace epl
 		*/
 		int findIndexLoop(const KeyType &key, int rootIdx) const;
 
-		///  K-ary heap
-		DynamicArray<Pair<KeyType,DataType> *> m_heap;
-		/// the actual heap size
-		size_t m_heapSize;
+		/*!
+		Check if the given two keys are equal.
+		@param[in] a the key to compare
+		@param[in] b the other key to compare
+		@return true if the keys are equal, otherwise false.
+		*/
+		bool isEqual(const KeyType &a, const KeyType &b) const
+		{
+			return !m_keyLess(a,b) && !m_keyLess(b,a);
+		}
+
+		/*!
+		Move the node from the given index to the other index.
+		@param[in] toIdx the index to move the node to.
+		@param[in] fromIdx the index to move the node from.
+		*/
+		void moveNode(int toIdx, int fromIdx)
+		{
+			m_keys[toIdx]=m_keys[fromIdx];
+			m_datas[toIdx]=m_datas[fromIdx];
+			if(m_mode==KARY_HEAP_MODE_INDEXED)
+			{
+				m_handles[toIdx]=m_handles[fromIdx];
+				m_handlePositions[m_handles[toIdx]]=toIdx;
+			}
+		}
+
+		/// the snapshot for the loop mode search
+		struct SnapShotStruct
+		{
+			size_t rootIdx;
+			size_t trav;
+			int stage;
+		};
+
+		/// type definition for the index map
+		typedef std::map<KeyType,int,KeyLess> IndexMap;
+
+		/// the keys of the heap
+		std::vector<KeyType> m_keys;
+		/// the data of the heap (parallel to m_keys)
+		std::vector<DataType> m_datas;
+		/// the handle of each node (used in KARY_HEAP_MODE_INDEXED)
+		std::vector<int> m_handles;
+		/// the index of the node for each handle (used in KARY_HEAP_MODE_INDEXED)
+		std::vector<int> m_handlePositions;
+		/// the free handles (used in KARY_HEAP_MODE_INDEXED)
+		std::vector<int> m_freeHandles;
+		/// the map from key to handle (used in KARY_HEAP_MODE_INDEXED)
+		IndexMap m_indexMap;
+		/// the key comparison functor
+		KeyLess m_keyLess;
 		/// lock
-		BaseLock *m_heapLock;
+		mutable LockType m_heapLock;
 		/// Lock Policy
 		LockPolicy m_lockPolicy;
 		/// K-ary Heap Mode
@@ -302,229 +397,158 @@ namespace epl
 
 	};
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *)>  
-	KAryHeap<KeyType,DataType,k,KeyCompareFunc>::KAryHeap(KaryHeapMode mode,LockPolicy lockPolicyType)
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::KAryHeap(KaryHeapMode mode,LockPolicy lockPolicyType)
 	{
 		EP_ASSERT_EXPR(k>0,_T("Template Declaration Error: k cannnot be less than/equal to 0"));
 
-		m_heap=DynamicArray<Pair<KeyType,DataType> *>(lockPolicyType);
-		m_heapSize=0;
 		m_lockPolicy=lockPolicyType;
 		m_mode=mode;
-		switch(lockPolicyType)
-		{
-		case LOCK_POLICY_CRITICALSECTION:
-			m_heapLock=EP_NEW CriticalSectionEx();
-			break;
-		case LOCK_POLICY_MUTEX:
-			m_heapLock=EP_NEW Mutex();
-			break;
-		case LOCK_POLICY_NONE:
-			m_heapLock=EP_NEW NoLock();
-			break;
-		default:
-			m_heapLock=NULL;
-		}
+		m_heapLock.Reset(lockPolicyType);
 
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *)>  
-	KAryHeap<KeyType,DataType,k,KeyCompareFunc>::KAryHeap(const KAryHeap<KeyType,DataType,k,KeyCompareFunc> & b)
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::KAryHeap(const KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType> & b)
 	{
 		EP_ASSERT_EXPR(k>0,_T("Template Declaration Error: k cannnot be less than/equal to 0"));
 		m_lockPolicy=b.m_lockPolicy;
-		switch(m_lockPolicy)
-		{
-		case LOCK_POLICY_CRITICALSECTION:
-			m_heapLock=EP_NEW CriticalSectionEx();
-			break;
-		case LOCK_POLICY_MUTEX:
-			m_heapLock=EP_NEW Mutex();
-			break;
-		case LOCK_POLICY_NONE:
-			m_heapLock=EP_NEW NoLock();
-			break;
-		default:
-			m_heapLock=NULL;
-			break;
-		}
-		LockObj lock(b.m_heapLock);
+		m_heapLock.Reset(m_lockPolicy);
+		LockGuard<LockType> lock(b.m_heapLock);
 		m_mode=b.m_mode;
-		m_heap.Resize(b.m_heap.Size());
-		for(int trav=0;trav<b.m_heap.Size();trav++)
-		{
-			m_heap[trav]=EP_NEW Pair<KeyType,DataType>();
-			m_heap[trav]->first=b.m_heap[trav]->first;
-			m_heap[trav]->second=b.m_heap[trav]->second;
-
-		}
-		m_heapSize=b.m_heapSize;
-	
-
+		m_keys=b.m_keys;
+		m_datas=b.m_datas;
+		m_handles=b.m_handles;
+		m_handlePositions=b.m_handlePositions;
+		m_freeHandles=b.m_freeHandles;
+		m_indexMap=b.m_indexMap;
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	KAryHeap<KeyType,DataType,k,KeyCompareFunc>::~KAryHeap()
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::~KAryHeap()
 	{
-		m_heapLock->Lock();
-		for(int trav=0;trav<m_heapSize;trav++)
-		{
-			if(m_heap[trav])	
-				EP_DELETE m_heap[trav];
-
-		}
-		m_heap.Delete();
-		m_heapLock->Unlock();
-		if(m_heapLock)
-			EP_DELETE m_heapLock;
+		m_heapLock.Lock();
+		m_keys.clear();
+		m_datas.clear();
+		m_indexMap.clear();
+		m_heapLock.Unlock();
 	}
 
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *)>  
-	KAryHeap<KeyType,DataType,k,KeyCompareFunc> &KAryHeap<KeyType,DataType,k,KeyCompareFunc>::operator=(const KAryHeap<KeyType,DataType,k,KeyCompareFunc> & b)
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType> &KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::operator=(const KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType> & b)
 	{
 		if(this!=&b)
 		{
-			m_heapLock->Lock();
-			for(int trav=0;trav<m_heapSize;trav++)
-			{
-				if(m_heap[trav])	
-					EP_DELETE m_heap[trav];
-
-			}
-			m_heap.Delete();
-			m_heapLock->Unlock();
-			if(m_heapLock)
-				EP_DELETE m_heapLock;
-			m_heapLock=NULL;
+			m_heapLock.Lock();
+			m_keys.clear();
+			m_datas.clear();
+			m_indexMap.clear();
+			m_heapLock.Unlock();
 
-			EP_ASSERT_EXPR(k>0,_T("Template Declaration Error: k cannnot be less than/equal to 0"));
 			m_lockPolicy=b.m_lockPolicy;
-			switch(m_lockPolicy)
-			{
-			case LOCK_POLICY_CRITICALSECTION:
-				m_heapLock=EP_NEW CriticalSectionEx();
-				break;
-			case LOCK_POLICY_MUTEX:
-				m_heapLock=EP_NEW Mutex();
-				break;
-			case LOCK_POLICY_NONE:
-				m_heapLock=EP_NEW NoLock();
-				break;
-			default:
-				m_heapLock=NULL;
-				break;
-			}
-			LockObj lock(b.m_heapLock);
+			m_heapLock.Reset(m_lockPolicy);
+			LockGuard<LockType> lock(b.m_heapLock);
 			m_mode=b.m_mode;
-			m_heap.Resize(b.m_heap.Size());
-			for(int trav=0;trav<b.m_heap.Size();trav++)
-			{
-				m_heap[trav]=EP_NEW Pair<KeyType,DataType>();
-				m_heap[trav]->first=b.m_heap[trav]->first;
-				m_heap[trav]->second=b.m_heap[trav]->second;
-
-			}
-			m_heapSize=b.m_heapSize;
+			m_keys=b.m_keys;
+			m_datas=b.m_datas;
+			m_handles=b.m_handles;
+			m_handlePositions=b.m_handlePositions;
+			m_freeHandles=b.m_freeHandles;
+			m_indexMap=b.m_indexMap;
 		}
 		return *this;
 	}
-	
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *)>  
-	DataType &KAryHeap<KeyType,DataType,k,KeyCompareFunc>::operator[](const KeyType & key)
+
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	DataType &KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::operator[](const KeyType & key)
 	{
-		LockObj lock(m_heapLock);
+		LockGuard<LockType> lock(m_heapLock);
 		int idx=findIndex(key, 0);
-		if(idx>=0)
-			return m_heap[idx]->second;
-		push(key,reinterpret_cast<DataType>(0));
-		idx=findIndex(key,0);
-		EP_ASSERT(idx>=0);
-		return m_heap[idx]->second;
-		
+		if(idx<0)
+			idx=push(key,DataType());
+		return m_datas[idx];
+
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *)>  
-	const DataType &KAryHeap<KeyType,DataType,k,KeyCompareFunc>::operator[](const KeyType & key) const
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	const DataType &KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::operator[](const KeyType & key) const
 	{
-		LockObj lock(m_heapLock);
+		LockGuard<LockType> lock(m_heapLock);
 		int idx=findIndex(key, 0);
 		EP_ASSERT(idx>=0);
-		return m_heap[idx]->second;
+		return m_datas[idx];
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *)>  
-	DataType &KAryHeap<KeyType,DataType,k,KeyCompareFunc>::GetData(const KeyType &key)
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	DataType &KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::GetData(const KeyType &key)
 	{
-		LockObj lock(m_heapLock);
+		LockGuard<LockType> lock(m_heapLock);
 		int idx=findIndex(key, 0);
 		EP_ASSERT_EXPR(idx>=0,_T("The given key does not exist in the heap"));
-		return m_heap[idx]->second;
+		return m_datas[idx];
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *)>  
-	const DataType &KAryHeap<KeyType,DataType,k,KeyCompareFunc>::GetData(const KeyType &key) const
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	const DataType &KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::GetData(const KeyType &key) const
 	{
-		LockObj lock(m_heapLock);
+		LockGuard<LockType> lock(m_heapLock);
 		int idx=findIndex(key, 0);
 		EP_ASSERT_EXPR(idx>=0,_T("The given key does not exist in the heap"));
-		return m_heap[idx]->second;
+		return m_datas[idx];
 	}
-	
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *)>  
-	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc>::GetData(const KeyType &key,DataType &retData) const
+
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::GetData(const KeyType &key,DataType &retData) const
 	{
-		LockObj lock(m_heapLock);
+		LockGuard<LockType> lock(m_heapLock);
 		int idx=findIndex(key, 0);
 		if(idx>=0)
 		{
-			retData=m_heap[idx]->second;
+			retData=m_datas[idx];
 			return true;
 		}
 		return false;
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc>::Pop( KeyType &retKey, DataType &retData )
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::Pop( KeyType &retKey, DataType &retData )
 	{
-		LockObj lock(m_heapLock);
-		Pair<KeyType,DataType> retMin;
-		if(pop(retMin))
-		{
-			retKey=retMin.first;
-			retData=retMin.second;
-			return true;
-		}
-		return false;
-				
+		LockGuard<LockType> lock(m_heapLock);
+		if(m_keys.empty())
+			return false;
+		retKey=m_keys[0];
+		retData=m_datas[0];
+		erase(0);
+		return true;
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc>::Front( KeyType &retKey, DataType &retData ) const
-	{		
-		LockObj lock(m_heapLock);
-		if(m_heapSize>0)
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::Front( KeyType &retKey, DataType &retData ) const
+	{
+		LockGuard<LockType> lock(m_heapLock);
+		if(!m_keys.empty())
 		{
-			retKey=m_heap[0]->first;
-			retData=m_heap[0]->second;
+			retKey=m_keys[0];
+			retData=m_datas[0];
 			return true;
 		}
 		return false;
 	}
 
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *)>  
-	Pair<KeyType,DataType> KAryHeap<KeyType,DataType,k,KeyCompareFunc>::Front() const
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	Pair<KeyType,DataType> KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::Front() const
 	{
-		LockObj lock(m_heapLock);
-		EP_ASSERT_EXPR(m_heapSize>0,_T("The heap is empty."));
-		return Pair(m_heap[0]->first,m_heap[0]->second);
+		LockGuard<LockType> lock(m_heapLock);
+		EP_ASSERT_EXPR(!m_keys.empty(),_T("The heap is empty."));
+		return Pair<KeyType,DataType>(m_keys[0],m_datas[0]);
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *)>  
-	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc>::ChangeKey(const KeyType &key, const KeyType &newKey)
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::ChangeKey(const KeyType &key, const KeyType &newKey)
 	{
-		LockObj lock(m_heapLock);
+		LockGuard<LockType> lock(m_heapLock);
 		int idx=findIndex(key, 0);
 		if(idx>=0)
 		{
@@ -534,11 +558,11 @@ namespace epl
 		return false;
 	}
 
-	
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc>::ChangeData(const KeyType &key, const DataType &newData)
+
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::ChangeData(const KeyType &key, const DataType &newData)
 	{
-		LockObj lock(m_heapLock);
+		LockGuard<LockType> lock(m_heapLock);
 		int idx=findIndex(key, 0);
 		if(idx>=0)
 		{
@@ -548,229 +572,252 @@ namespace epl
 		return false;
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	void KAryHeap<KeyType,DataType,k,KeyCompareFunc>::Clear()
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	void KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::Clear()
 	{
-		for(int trav=0;trav<m_heapSize;trav++)
-		{
-			if(m_heap[trav])	
-				EP_DELETE m_heap[trav];
-			m_heap[trav]=NULL;
-		}
-		m_heapSize=0;
+		LockGuard<LockType> lock(m_heapLock);
+		m_keys.clear();
+		m_datas.clear();
+		m_handles.clear();
+		m_handlePositions.clear();
+		m_freeHandles.clear();
+		m_indexMap.clear();
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *)>  
-	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc>::Erase(const KeyType &key)
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::Erase(const KeyType &key)
 	{
-		LockObj lock(m_heapLock);
+		LockGuard<LockType> lock(m_heapLock);
 		int idx=findIndex(key,0);
 		if(idx>=0)
 		{
-			erase(key);
+			erase(idx);
+			return true;
 		}
 		return false;
 	}
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc>::IsEmpty() const
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::IsEmpty() const
 	{
-		LockObj lock(m_heapLock);
-		if(m_heapSize)
-			return true;
-		return false;
+		LockGuard<LockType> lock(m_heapLock);
+		return m_keys.empty();
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	size_t KAryHeap<KeyType,DataType,k,KeyCompareFunc>::Size() const
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	size_t KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::Size() const
 	{
-		LockObj lock(m_heapLock);
-		return m_heapSize;
+		LockGuard<LockType> lock(m_heapLock);
+		return m_keys.size();
 	}
 
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	void KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::Reserve(size_t capacity)
+	{
+		LockGuard<LockType> lock(m_heapLock);
+		m_keys.reserve(capacity);
+		m_datas.reserve(capacity);
+		if(m_mode==KARY_HEAP_MODE_INDEXED)
+		{
+			m_handles.reserve(capacity);
+			m_handlePositions.reserve(capacity);
+			m_freeHandles.reserve(capacity);
+		}
+	}
 
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	DataType &KAryHeap<KeyType,DataType,k,KeyCompareFunc>::Push(const KeyType &key, const DataType &data)
-	{	
-		LockObj lock(m_heapLock);
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	DataType &KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::Push(const KeyType &key, const DataType &data)
+	{
+		LockGuard<LockType> lock(m_heapLock);
 		int index=findIndex(key,0);
 		EP_ASSERT_EXPR(index==-1,_T("Given key already exists in the K-ary heap. Duplicated insertion is not allowed."));
-		push(key,data);
-		index=findIndex(key,0);
-		return m_heap[index]->second;
+		index=push(key,data);
+		return m_datas[index];
 	}
 
 
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc>::pop( Pair<KeyType,DataType> &retMin )
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	bool KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::pop( Pair<KeyType,DataType> &retMin )
 	{
-		if(m_heap.Size()> 0 && m_heapSize >0)
+		if(!m_keys.empty())
 		{
-			retMin.first=m_heap[0]->first;
-			retMin.second=m_heap[0]->second;
-			EP_DELETE m_heap[0];
-			m_heap[0]= m_heap[m_heapSize-1];
-			m_heap[m_heapSize-1]=NULL;
-			m_heapSize--;
-			heapifyDown(0);
+			retMin.first=m_keys[0];
+			retMin.second=m_datas[0];
+			erase(0);
 			return true;
 		}
 		return false;
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	void KAryHeap<KeyType,DataType,k,KeyCompareFunc>::push(const KeyType &key, const DataType &data)
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	int KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::push(const KeyType &key, const DataType &data)
 	{
-	
-		if(m_heapSize+1>m_heap.Size())
+		int idx=(int)m_keys.size();
+		m_keys.push_back(key);
+		m_datas.push_back(data);
+		if(m_mode==KARY_HEAP_MODE_INDEXED)
 		{
-			long newSize=m_heap.Size()+m_heap.Size()/2;
-			newSize=(m_heap.Size()==newSize)?m_heap.Size()+1:newSize;
-			m_heap.Resize(newSize);
+			int handle;
+			if(!m_freeHandles.empty())
+			{
+				handle=m_freeHandles.back();
+				m_freeHandles.pop_back();
+			}
+			else
+			{
+				handle=(int)m_handlePositions.size();
+				m_handlePositions.push_back(idx);
+			}
+			m_handles.push_back(handle);
+			m_handlePositions[handle]=idx;
+			m_indexMap[key]=handle;
 		}
-		m_heap[m_heapSize]=EP_NEW Pair<KeyType,DataType>(key,data);
-		m_heapSize++;
-		heapifyUp(m_heapSize-1);
-
+		return heapifyUp(idx);
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	void KAryHeap<KeyType,DataType,k,KeyCompareFunc>::changeKey(int index, const KeyType &newKey)
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	void KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::changeKey(int index, const KeyType &newKey)
 	{
 
-		if(index<m_heapSize)
+		if(index<(int)m_keys.size())
 		{
-			if(KeyCompareFunc(&(m_heap[index]->first),&newKey)==COMP_RESULT_LESSTHAN)
-			{	
-				m_heap[index]->first=newKey;
-				heapifyDown(index);
+			if(m_mode==KARY_HEAP_MODE_INDEXED)
+			{
+				m_indexMap.erase(m_keys[index]);
+				m_indexMap[newKey]=m_handles[index];
 			}
+			bool isIncreased=m_keyLess(m_keys[index],newKey);
+			m_keys[index]=newKey;
+			if(isIncreased)
+				heapifyDown(index);
 			else
-			{
-				m_heap[index]->first=newKey;
 				heapifyUp(index);
-			}
 		}
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	void KAryHeap<KeyType,DataType,k,KeyCompareFunc>::changeData(int index, const DataType &newData)
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	void KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::changeData(int index, const DataType &newData)
 	{
 
-		if(index<m_heapSize)
+		if(index<(int)m_datas.size())
 		{
-			m_heap[index]->second=data;
+			m_datas[index]=newData;
 		}
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	void KAryHeap<KeyType,DataType,k,KeyCompareFunc>::erase(int index)
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	void KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::erase(int index)
 	{
+		int lastIdx=(int)m_keys.size()-1;
+		if(index>lastIdx)
+			return;
 
-		if(index<m_heapSize)
+		if(m_mode==KARY_HEAP_MODE_INDEXED)
 		{
-			Pair<KeyType,DataType> * tmp=m_heap[m_heapSize-1];
-			m_heap[m_heapSize-1]=m_heap[index];
-			m_heap[index]=tmp;
-			EP_DELETE m_heap[m_heapSize-1];
-			m_heap[m_heapSize-1]=NULL;
-			m_heapSize--;
-			heapifyDown(index);
+			m_indexMap.erase(m_keys[index]);
+			m_freeHandles.push_back(m_handles[index]);
+		}
+		if(index!=lastIdx)
+			moveNode(index,lastIdx);
+		m_keys.pop_back();
+		m_datas.pop_back();
+		if(m_mode==KARY_HEAP_MODE_INDEXED)
+			m_handles.pop_back();
+
+		if(index<lastIdx)
+		{
+			if(heapifyDown(index)==index)
+				heapifyUp(index);
 		}
 	}
 
 
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	void KAryHeap<KeyType,DataType,k,KeyCompareFunc>::heapifyUp(int idx)
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	int KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::heapifyUp(int idx)
 	{
-		if(m_heap.Size()>0)
+		int currentIdx=idx;
+		int parentIdx=getParentIdx(currentIdx);
+		if(parentIdx==-1 || !m_keyLess(m_keys[currentIdx],m_keys[parentIdx]))
+			return currentIdx;
+
+		KeyType key=m_keys[currentIdx];
+		DataType data=m_datas[currentIdx];
+		int handle=(m_mode==KARY_HEAP_MODE_INDEXED)?m_handles[currentIdx]:-1;
+		while(parentIdx!=-1 && m_keyLess(key,m_keys[parentIdx]))
 		{
-			int currentIdx=idx;//size-1;
-			int parentIdx=getParentIdx(currentIdx);
-			Pair<KeyType,DataType> *tmp;
-			while(parentIdx!=-1)
-			{
-				if(KeyCompareFunc(&(m_heap[parentIdx]->first) ,&(m_heap[currentIdx]->first))==COMP_RESULT_GREATERTHAN)
-				{
-					tmp = m_heap[currentIdx];
-					m_heap[currentIdx]=m_heap[parentIdx];
-					m_heap[parentIdx]=tmp;
-					currentIdx=parentIdx;
-					parentIdx=getParentIdx(currentIdx);
-				}
-				else
-				{
-					break;
-				}
-			}
+			moveNode(currentIdx,parentIdx);
+			currentIdx=parentIdx;
+			parentIdx=getParentIdx(currentIdx);
+		}
+		m_keys[currentIdx]=key;
+		m_datas[currentIdx]=data;
+		if(handle!=-1)
+		{
+			m_handles[currentIdx]=handle;
+			m_handlePositions[handle]=currentIdx;
 		}
+		return currentIdx;
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	void KAryHeap<KeyType,DataType,k,KeyCompareFunc>::heapifyDown(int idx)
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	int KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::heapifyDown(int idx)
 	{
-		if(m_heap.Size()>0)
+		int parentIdx=idx;
+		int minChildIdx=findMinChild(parentIdx);
+		if(minChildIdx==-1 || !m_keyLess(m_keys[minChildIdx],m_keys[parentIdx]))
+			return parentIdx;
+
+		KeyType key=m_keys[parentIdx];
+		DataType data=m_datas[parentIdx];
+		int handle=(m_mode==KARY_HEAP_MODE_INDEXED)?m_handles[parentIdx]:-1;
+		while(minChildIdx!=-1 && m_keyLess(m_keys[minChildIdx],key))
 		{
-			
-			int parentIdx=idx;//0;
-			int minChildIdx=findMinChild(parentIdx);
-			Pair<KeyType,DataType> *tmp;
-			while(minChildIdx!=-1)
-			{
-				if(KeyCompareFunc(&(m_heap[parentIdx]->first ), &(m_heap[minChildIdx]->first))!=COMP_RESULT_LESSTHAN)
-				{
-					tmp = m_heap[parentIdx];
-					m_heap[parentIdx]=m_heap[minChildIdx];
-					m_heap[minChildIdx]=tmp;
-					parentIdx= minChildIdx;
-					minChildIdx=findMinChild(parentIdx);
-				}
-				else
-				{
-					break;
-				}
-			}
+			moveNode(parentIdx,minChildIdx);
+			parentIdx=minChildIdx;
+			minChildIdx=findMinChild(parentIdx);
 		}
+		m_keys[parentIdx]=key;
+		m_datas[parentIdx]=data;
+		if(handle!=-1)
+		{
+			m_handles[parentIdx]=handle;
+			m_handlePositions[handle]=parentIdx;
+		}
+		return parentIdx;
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	int KAryHeap<KeyType,DataType,k,KeyCompareFunc>::findMinChild(int parentIdx) const
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	int KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::findMinChild(int parentIdx) const
 	{
-		int arrTrav;
-		if(k*parentIdx+1<m_heapSize)
+		size_t firstChildIdx=k*parentIdx+1;
+		size_t heapSize=m_keys.size();
+		if(firstChildIdx<heapSize)
 		{
-			Pair<KeyType,DataType> *minNode=m_heap[k*parentIdx+1];
-			int minIdx=k*parentIdx+1;
-			for(arrTrav=k*parentIdx+2; arrTrav<=k*parentIdx+k;arrTrav++)
+			size_t lastChildIdx=firstChildIdx+k;
+			if(lastChildIdx>heapSize)
+				lastChildIdx=heapSize;
+			size_t minIdx=firstChildIdx;
+			for(size_t arrTrav=firstChildIdx+1; arrTrav<lastChildIdx;arrTrav++)
 			{
-				if(arrTrav<m_heapSize && KeyCompareFunc(&(minNode->first) , &(m_heap[arrTrav]->first))==COMP_RESULT_GREATERTHAN)
-				{
-					minNode=m_heap[arrTrav];
+				if(m_keyLess(m_keys[arrTrav],m_keys[minIdx]))
 					minIdx=arrTrav;
-				}
 			}
-			return minIdx;
+			return (int)minIdx;
 		}
 		return -1;
 
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	int KAryHeap<KeyType,DataType,k,KeyCompareFunc>::findIndexLoop(const KeyType &key, int rootIdx) const
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	int KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::findIndexLoop(const KeyType &key, int rootIdx) const
 	{
-		struct SnapShotStruct
-		{
-			int rootIdx;
-			int trav;
-			int stage;
-		};
-
+		size_t heapSize=m_keys.size();
 		int retValue=-1;
 		stack<SnapShotStruct> snapshotStack;
 		SnapShotStruct currentSnaptshot;
-		currentSnaptshot.rootIdx=rootIdx;
+		currentSnaptshot.rootIdx=(size_t)rootIdx;
 		currentSnaptshot.trav=0;
 		currentSnaptshot.stage=0;
 		snapshotStack.push(currentSnaptshot);
@@ -779,26 +826,26 @@ namespace epl
 		{
 			currentSnaptshot=snapshotStack.top();
 			snapshotStack.pop();
-			int trav;
+			size_t trav;
 			switch(currentSnaptshot.stage)
 			{
 			case 0:
-				if(currentSnaptshot.rootIdx<m_heapSize)
+				if(currentSnaptshot.rootIdx<heapSize)
 				{
-					Pair<KeyType,DataType> *pair=m_heap[currentSnaptshot.rootIdx];
+					const KeyType &nodeKey=m_keys[currentSnaptshot.rootIdx];
 
 
-					if(KeyCompareFunc(&(pair->first), &(key))==COMP_RESULT_EQUAL)
-					{	
-						retValue=currentSnaptshot.rootIdx;
+					if(isEqual(nodeKey,key))
+					{
+						retValue=(int)currentSnaptshot.rootIdx;
 						continue;
 					}
 
-					if(KeyCompareFunc(&(pair->first) ,&(key))!=COMP_RESULT_GREATERTHAN)
+					if(m_keyLess(nodeKey,key))
 					{
 
 						trav=1;
-						if(trav<=k &&currentSnaptshot.rootIdx*k+trav<m_heapSize)
+						if(trav<=k &&currentSnaptshot.rootIdx*k+trav<heapSize)
 						{
 							currentSnaptshot.trav=trav;
 							currentSnaptshot.stage=2;
@@ -816,7 +863,7 @@ namespace epl
 				break;
 			case 1:
 				trav=currentSnaptshot.trav+1;
-				if(trav<=k &&currentSnaptshot.rootIdx*k+trav<m_heapSize)
+				if(trav<=k &&currentSnaptshot.rootIdx*k+trav<heapSize)
 				{
 					currentSnaptshot.trav=trav;
 					currentSnaptshot.stage=2;
@@ -846,30 +893,38 @@ namespace epl
 		return retValue;
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	int KAryHeap<KeyType,DataType,k,KeyCompareFunc>::findIndex(const KeyType &key, int rootIdx) const
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	int KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::findIndex(const KeyType &key, int rootIdx) const
 	{
-		if(m_mode==KARY_HEAP_MODE_RECURSIVE)
+		if(m_mode==KARY_HEAP_MODE_INDEXED)
+		{
+			typename IndexMap::const_iterator iter=m_indexMap.find(key);
+			if(iter!=m_indexMap.end())
+				return m_handlePositions[iter->second];
+			return -1;
+		}
+		else if(m_mode==KARY_HEAP_MODE_RECURSIVE)
 		{
-			if(rootIdx<m_heapSize)
+			size_t heapSize=m_keys.size();
+			if((size_t)rootIdx<heapSize)
 			{
-				Pair<KeyType,DataType> *pair=m_heap[rootIdx];
+				const KeyType &nodeKey=m_keys[rootIdx];
 
 
-				if(KeyCompareFunc(&(pair->first), &(key))==COMP_RESULT_EQUAL)
-				{	
+				if(isEqual(nodeKey,key))
+				{
 					return rootIdx;
 				}
 
-				if(KeyCompareFunc(&(pair->first) ,&(key))!=COMP_RESULT_GREATERTHAN)
+				if(m_keyLess(nodeKey,key))
 				{
 
-					int trav;
+					size_t trav;
 					for(trav=1; trav<=k; trav++)
 					{
-						if(rootIdx*k+trav<m_heapSize)
+						if(rootIdx*k+trav<heapSize)
 						{
-							int retIdx = findIndex(key,rootIdx*k+trav);
+							int retIdx = findIndex(key,(int)(rootIdx*k+trav));
 							if(retIdx!=-1)
 							{
 								return retIdx;
@@ -889,18 +944,12 @@ namespace epl
 
 	}
 
-	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *) >  
-	int KAryHeap<KeyType,DataType,k,KeyCompareFunc>::getParentIdx(int childIdx) const
-	{
-// 		if(childIdx%k ==0)
-// 		{
-// 			return childIdx/k-1;
-// 		}
-// 		else
-// 		{
-// 			return childIdx/k;
-// 		}
-		return (childIdx-1)/k;
+	template <typename KeyType,typename DataType,size_t k, CompResultType (__cdecl *KeyCompareFunc)(const void *,const void *), typename KeyLess, typename LockType>
+	int KAryHeap<KeyType,DataType,k,KeyCompareFunc,KeyLess,LockType>::getParentIdx(int childIdx) const
+	{
+		if(childIdx<=0)
+			return -1;
+		return (childIdx-1)/(int)k;
 	}
 }
 #endif //__EP_KARYHEAP_H__
@@ -71,6 +71,14 @@ An Interface for EpLibrary.
 
 #endif //_DEBUG
 
+/// Routes EP_Malloc/EP_Realloc/EP_Free through epl::MemoryHook (i.e. to use Arena)<br/>
+/// Uncomment below line and recompile if you want this functionality
+// #define EP_ENABLE_MEMORY_HOOK
+
+/// Tracks EP_Malloc/EP_Realloc/EP_Free per call site through epl::MemoryTracker (i.e. to use MemoryProfileManager)<br/>
+/// Uncomment below line and recompile if you want this functionality
+// #define EP_ENABLE_MEMORY_TRACKING
+
 #define WIDEN2(x) L ## x
 #define WIDEN(x) WIDEN2(x)
 #define __WFILE__ WIDEN(__FILE__)
@@ -0,0 +1,343 @@
+/*! 
+@file epLightJob.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief Light Job Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for the Light Job (allocation-free pooled job).
+
+*/
+#ifndef __EP_LIGHT_JOB_H__
+#define __EP_LIGHT_JOB_H__
+#include "epLib.h"
+#include "epBaseJob.h"
+#include "epBaseJobProcessor.h"
+#include <new>
+
+/*!
+@def LIGHT_JOB_STORAGE_SIZE
+@brief the size of the inline storage for the callable of LightJob
+
+Macro for the inline storage size of LightJob in bytes.
+*/
+#ifndef LIGHT_JOB_STORAGE_SIZE
+#define LIGHT_JOB_STORAGE_SIZE 48
+#endif //LIGHT_JOB_STORAGE_SIZE
+
+namespace epl
+{
+	class LightJobPool;
+
+	/*!
+	@class LightJob epLightJob.h
+	@brief A class for the small job which runs a callable stored inline.
+
+	The callable (a function object or a function pointer with an argument) is copied into the inline storage of the job,
+	so setting the callable does not allocate. The jobs are taken from LightJobPool,
+	and return to the free list of the pool when the last reference is released, instead of being deleted.
+	The job is processed by LightJobProcessor through the same worker threads and ThreadPool as the other jobs,
+	so once the pool has as many jobs as the jobs in flight, no memory is allocated per job.
+	@remark the status callback is optional, and it is called at each status change of the job from the reporting thread.
+	*/
+	class EP_LIBRARY LightJob:public BaseJob
+	{
+	public:
+		friend class LightJobPool;
+		friend class LightJobProcessor;
+
+		/*!
+		Status Callback Function Type
+		@param[in] job the job which the status changed
+		@param[in] status the new status of the job
+		@param[in] userData the user data given with the callback
+		*/
+		typedef void (*StatusCallback)(LightJob *job,const JobStatus status,void *userData);
+
+		/*!
+		Set the function object to run.
+		@param[in] func the function object which is callable with no argument.
+		@remark the size of the function object must be less than or equal to LIGHT_JOB_STORAGE_SIZE.
+		*/
+		template<typename Functor>
+		void SetFunc(const Functor &func)
+		{
+			// the function object must fit in the inline storage
+			typedef char FunctorFitsInStorage[(sizeof(Functor)<=LIGHT_JOB_STORAGE_SIZE)?1:-1];
+			(void)sizeof(FunctorFitsInStorage);
+			resetFunc();
+			::new((void*)m_storage.m_bytes) Functor(func);
+			m_invokeFunc=&invokeFunctor<Functor>;
+			m_destroyFunc=&destroyFunctor<Functor>;
+		}
+
+		/*!
+		Set the function to run with the given argument.
+		@param[in] func the function to run.
+		@param[in] arg the argument for the function.
+		*/
+		void SetFunc(void (*func)(void *),void *arg);
+
+		/*!
+		Set the status callback of the job.
+		@param[in] callback the callback to call when the status changed. (NULL for no callback)
+		@param[in] userData the user data given to the callback.
+		*/
+		void SetStatusCallback(StatusCallback callback,void *userData=NULL);
+
+		/*!
+		Return the pool which owns this job.
+		@return the pool which owns this job.
+		*/
+		LightJobPool *GetPool() const
+		{
+			return m_pool;
+		}
+
+	protected:
+		/*!
+		Calls the status callback when the status changed.
+		@param[in] status The Status of the Job
+		*/
+		virtual void handleReport(const JobStatus status);
+
+		/*!
+		Return this job to the free list of the pool when the last reference is released.
+		*/
+		virtual void deleteObj();
+
+	private:
+		/*!
+		Default Constructor
+		@param[in] pool the pool which owns this job.
+		@param[in] lockPolicyType The lock policy
+		*/
+		LightJob(LightJobPool *pool,LockPolicy lockPolicyType=EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+		*/
+		virtual ~LightJob();
+
+		/*!
+		Default Copy Constructor
+
+		*Cannot be Used.
+		*/
+		LightJob(const LightJob & b):BaseJob(b){EP_ASSERT(0);}
+
+		/*!
+		Assignment operator overloading
+
+		*Cannot be Used.
+		*/
+		LightJob &operator=(const LightJob & /*b*/){EP_ASSERT(0);return *this;}
+
+		/*!
+		Run the callable of the job.
+		*/
+		void run();
+
+		/*!
+		Destroy the callable of the job.
+		*/
+		void resetFunc();
+
+		/*!
+		Reset the job to be taken from the pool.
+		@param[in] priority the priority of the job
+		*/
+		void resetJob(Priority priority);
+
+		/*!
+		Call the function object in the given storage.
+		@param[in] storage the storage holding the function object.
+		*/
+		template<typename Functor>
+		static void invokeFunctor(void *storage)
+		{
+			(*reinterpret_cast<Functor*>(storage))();
+		}
+
+		/*!
+		Destroy the function object in the given storage.
+		@param[in] storage the storage holding the function object.
+		*/
+		template<typename Functor>
+		static void destroyFunctor(void *storage)
+		{
+			reinterpret_cast<Functor*>(storage)->~Functor();
+		}
+
+		/*!
+		Call the function pointer in the given storage.
+		@param[in] storage the storage holding the function pointer and the argument.
+		*/
+		static void invokeFuncPtr(void *storage);
+
+		/// the inline storage aligned for the callable
+		union Storage
+		{
+			/// the bytes of the storage
+			char m_bytes[LIGHT_JOB_STORAGE_SIZE];
+			/// alignment
+			double m_alignDouble;
+			/// alignment
+			__int64 m_alignInt;
+			/// alignment
+			void *m_alignPtr;
+		} m_storage;
+
+		/// the function calling the callable in the storage
+		void (*m_invokeFunc)(void *);
+		/// the function destroying the callable in the storage (NULL if trivial)
+		void (*m_destroyFunc)(void *);
+		/// the status callback
+		StatusCallback m_statusCallback;
+		/// the user data for the status callback
+		void *m_callbackUserData;
+		/// the pool which owns this job
+		LightJobPool *m_pool;
+		/// the next job in the free list of the pool
+		LightJob *m_nextFree;
+	};
+
+	/*!
+	@class LightJobPool epLightJob.h
+	@brief A class that keeps the free list of LightJob.
+
+	Get takes a job from the free list, or creates a new job if the free list is empty.
+	The job returns to the pool when its last reference is released.
+	The jobs released are pushed to the recycled list without the lock (usually from the worker threads),
+	and Get takes the whole recycled list at once when its free list is empty.
+	@remark all the jobs must be returned to the pool before the pool is destroyed.
+	*/
+	class EP_LIBRARY LightJobPool
+	{
+	public:
+		friend class LightJob;
+
+		/*!
+		Default Constructor
+
+		Initializes the pool with the given number of the jobs
+		@param[in] initialCount the number of the jobs to create in advance.
+		@param[in] lockPolicyType The lock policy
+		*/
+		LightJobPool(size_t initialCount=0,LockPolicy lockPolicyType=EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+
+		Deletes the jobs in the free list
+		*/
+		virtual ~LightJobPool();
+
+		/*!
+		Take a job from the pool.
+		@param[in] priority the priority of the job
+		@return the job with the reference count of 1, which the caller releases after pushing it.
+		*/
+		LightJob *Get(Priority priority=PRIORITY_NORMAL);
+
+		/*!
+		Return the number of the jobs in the pool.
+		@return the number of the jobs in the free list and the recycled list.
+		@remark this walks the lists under the lock, so it is meant for the diagnostics.
+		*/
+		size_t GetFreeCount() const;
+
+		/*!
+		Return the number of the jobs created by the pool.
+		@return the number of the jobs created by the pool.
+		*/
+		size_t GetJobCount() const;
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Cannot be Used.
+		*/
+		LightJobPool(const LightJobPool & /*b*/){EP_ASSERT(0);}
+
+		/*!
+		Assignment operator overloading
+
+		*Cannot be Used.
+		*/
+		LightJobPool &operator=(const LightJobPool & /*b*/){EP_ASSERT(0);return *this;}
+
+		/*!
+		Put the given job back to the recycled list.
+		@param[in] job the job to put back.
+		*/
+		void recycle(LightJob *job);
+
+		/// the head of the free list (taken under the lock)
+		LightJob *m_freeList;
+		/// the head of the recycled list (pushed without the lock)
+		LightJob * volatile m_recycledList;
+		/// the number of the jobs created
+		volatile long m_jobCount;
+		/// the lock policy of the jobs
+		LockPolicy m_lockPolicy;
+		/// the free list lock
+		BaseLock *m_lock;
+	};
+
+	/*!
+	@class LightJobProcessor epLightJob.h
+	@brief A class for the Job Processor which runs the callable of LightJob.
+	@remark all the jobs given to the workers using this processor must be LightJob.
+	*/
+	class EP_LIBRARY LightJobProcessor:public BaseJobProcessor
+	{
+	public:
+		/*!
+		Default Constructor
+		@param[in] lockPolicyType The lock policy
+		*/
+		LightJobProcessor(LockPolicy lockPolicyType=EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+		*/
+		virtual ~LightJobProcessor();
+
+		/*!
+		Run the callable of the given LightJob.
+		@param[in] workerThread Worker Thread Object
+		@param[in] data the LightJob to run
+		*/
+		virtual void DoJob(BaseWorkerThread *workerThread,BaseJob* const data);
+	};
+}
+#endif //__EP_LIGHT_JOB_H__
@@ -0,0 +1,326 @@
+/*! 
+@file epLockFreeQueue.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief LockFreeQueue Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for bounded multi-producer/multi-consumer Lock-Free Queue.
+
+*/
+#ifndef __EP_LOCK_FREE_QUEUE_H__
+#define __EP_LOCK_FREE_QUEUE_H__
+#include "epLib.h"
+#include "epSystem.h"
+
+/*!
+@def EP_CACHE_LINE_SIZE
+@brief The size of the cache line in bytes.
+
+Macro for the cache line size used to pad the shared variables.
+*/
+#ifndef EP_CACHE_LINE_SIZE
+#define EP_CACHE_LINE_SIZE 64
+#endif //EP_CACHE_LINE_SIZE
+
+namespace epl
+{
+	/*!
+	@class LockFreeQueue epLockFreeQueue.h
+	@brief A template class for the bounded multi-producer/multi-consumer Lock-Free Queue.
+
+	Each cell of the ring has its own sequence number, so producers and consumers only
+	contend on the enqueue/dequeue position with a single CAS and never take a lock.
+	The DataType must be default constructible and assignable.
+	*/
+	template <typename DataType>
+	class LockFreeQueue
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the queue
+		@param[in] capacity the maximum number of elements (rounded up to power of two)
+		*/
+		LockFreeQueue(size_t capacity=1024);
+
+		/*!
+		Default Destructor
+
+		Destroy the queue
+		*/
+		virtual ~LockFreeQueue();
+
+		/*!
+		Try to insert the new item into the queue.
+		@param[in] data The inserting data.
+		@return true if inserted, false if the queue is full.
+		*/
+		bool TryPush(DataType const &data);
+
+		/*!
+		Try to remove the first item from the queue.
+		@param[out] retData the removed data.
+		@return true if removed, false if the queue is empty.
+		*/
+		bool TryPop(DataType &retData);
+
+		/*!
+		Insert the new item into the queue.
+
+		If the queue is full, it waits until a slot is available or the time-out.
+		@param[in] data The inserting data.
+		@param[in] waitTimeInMilliSec the time-out interval, in milliseconds.
+		@return true if inserted, false if timed out.
+		*/
+		bool Push(DataType const &data,unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE);
+
+		/*!
+		Remove the first item from the queue.
+
+		If the queue is empty, it waits until an item is available or the time-out.
+		@param[out] retData the removed data.
+		@param[in] waitTimeInMilliSec the time-out interval, in milliseconds.
+		@return true if removed, false if timed out.
+		*/
+		bool Pop(DataType &retData,unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE);
+
+		/*!
+		Check if the queue is empty.
+		@remark the result is only a snapshot while other threads are working on the queue.
+		@returns Returns true if the queue is empty, otherwise false.
+		*/
+		bool IsEmpty() const;
+
+		/*!
+		Return the size of the queue.
+		@remark the result is only a snapshot while other threads are working on the queue.
+		@return the size of the queue.
+		*/
+		size_t Size() const;
+
+		/*!
+		Return the maximum number of elements of the queue.
+		@return the maximum number of elements of the queue.
+		*/
+		size_t GetCapacity() const
+		{
+			return m_bufferMask+1;
+		}
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Cannot be Used.
+		*/
+		LockFreeQueue(const LockFreeQueue& b){EP_ASSERT(0);}
+
+		/*!
+		Assignment Operator Overloading
+
+		*Cannot be Used.
+		*/
+		LockFreeQueue & operator=(const LockFreeQueue&b){EP_ASSERT(0);return *this;}
+
+		/*!
+		Back off while waiting for other threads.
+		@param[in] spinCount the number of times waited so far.
+		*/
+		static void backOff(unsigned int spinCount)
+		{
+			if(spinCount<16)
+				YieldProcessor();
+			else if(spinCount<64)
+				SwitchToThread();
+			else
+				Sleep(0);
+		}
+
+		/*!
+		@struct Cell epLockFreeQueue.h
+		@brief the cell of the ring buffer.
+		*/
+		struct Cell
+		{
+			/// the sequence number of the cell
+			volatile long m_sequence;
+			/// the data
+			DataType m_data;
+		};
+
+		/// padding to prevent false sharing
+		char m_pad0[EP_CACHE_LINE_SIZE];
+		/// the ring buffer
+		Cell *m_buffer;
+		/// the mask for the index of the ring buffer
+		size_t m_bufferMask;
+		/// padding to prevent false sharing
+		char m_pad1[EP_CACHE_LINE_SIZE-sizeof(Cell*)-sizeof(size_t)];
+		/// the enqueue position
+		volatile long m_enqueuePos;
+		/// padding to prevent false sharing
+		char m_pad2[EP_CACHE_LINE_SIZE-sizeof(long)];
+		/// the dequeue position
+		volatile long m_dequeuePos;
+		/// padding to prevent false sharing
+		char m_pad3[EP_CACHE_LINE_SIZE-sizeof(long)];
+	};
+
+	template <typename DataType>
+	LockFreeQueue<DataType>::LockFreeQueue(size_t capacity)
+	{
+		size_t bufferSize=2;
+		while(bufferSize<capacity)
+			bufferSize<<=1;
+		m_buffer=EP_NEW Cell[bufferSize];
+		m_bufferMask=bufferSize-1;
+		for(size_t trav=0;trav<bufferSize;trav++)
+		{
+			m_buffer[trav].m_sequence=(long)trav;
+		}
+		m_enqueuePos=0;
+		m_dequeuePos=0;
+	}
+
+	template <typename DataType>
+	LockFreeQueue<DataType>::~LockFreeQueue()
+	{
+		if(m_buffer)
+			EP_DELETE[] m_buffer;
+	}
+
+	template <typename DataType>
+	bool LockFreeQueue<DataType>::TryPush(DataType const &data)
+	{
+		Cell *cell;
+		unsigned long pos=(unsigned long)m_enqueuePos;
+		while(true)
+		{
+			cell=&m_buffer[pos&m_bufferMask];
+			unsigned long seq=(unsigned long)cell->m_sequence;
+			long diff=(long)(seq-pos);
+			if(diff==0)
+			{
+				if((unsigned long)InterlockedCompareExchange(&m_enqueuePos,(long)(pos+1),(long)pos)==pos)
+					break;
+				pos=(unsigned long)m_enqueuePos;
+			}
+			else if(diff<0)
+			{
+				// the queue is full
+				return false;
+			}
+			else
+			{
+				pos=(unsigned long)m_enqueuePos;
+			}
+		}
+		cell->m_data=data;
+		InterlockedExchange(&cell->m_sequence,(long)(pos+1));
+		return true;
+	}
+
+	template <typename DataType>
+	bool LockFreeQueue<DataType>::TryPop(DataType &retData)
+	{
+		Cell *cell;
+		unsigned long pos=(unsigned long)m_dequeuePos;
+		while(true)
+		{
+			cell=&m_buffer[pos&m_bufferMask];
+			unsigned long seq=(unsigned long)cell->m_sequence;
+			long diff=(long)(seq-(pos+1));
+			if(diff==0)
+			{
+				if((unsigned long)InterlockedCompareExchange(&m_dequeuePos,(long)(pos+1),(long)pos)==pos)
+					break;
+				pos=(unsigned long)m_dequeuePos;
+			}
+			else if(diff<0)
+			{
+				// the queue is empty
+				return false;
+			}
+			else
+			{
+				pos=(unsigned long)m_dequeuePos;
+			}
+		}
+		retData=cell->m_data;
+		InterlockedExchange(&cell->m_sequence,(long)(pos+m_bufferMask+1));
+		return true;
+	}
+
+	template <typename DataType>
+	bool LockFreeQueue<DataType>::Push(DataType const &data,unsigned int waitTimeInMilliSec)
+	{
+		unsigned int startTime=System::GetTickCount();
+		unsigned int spinCount=0;
+		while(!TryPush(data))
+		{
+			if(waitTimeInMilliSec!=WAITTIME_INIFINITE && System::GetTickCount()-startTime>=waitTimeInMilliSec)
+				return false;
+			backOff(spinCount++);
+		}
+		return true;
+	}
+
+	template <typename DataType>
+	bool LockFreeQueue<DataType>::Pop(DataType &retData,unsigned int waitTimeInMilliSec)
+	{
+		unsigned int startTime=System::GetTickCount();
+		unsigned int spinCount=0;
+		while(!TryPop(retData))
+		{
+			if(waitTimeInMilliSec!=WAITTIME_INIFINITE && System::GetTickCount()-startTime>=waitTimeInMilliSec)
+				return false;
+			backOff(spinCount++);
+		}
+		return true;
+	}
+
+	template <typename DataType>
+	bool LockFreeQueue<DataType>::IsEmpty() const
+	{
+		return Size()==0;
+	}
+
+	template <typename DataType>
+	size_t LockFreeQueue<DataType>::Size() const
+	{
+		long size=(long)((unsigned long)m_enqueuePos-(unsigned long)m_dequeuePos);
+		if(size<0)
+			return 0;
+		return (size_t)size;
+	}
+}
+#endif //__EP_LOCK_FREE_QUEUE_H__
@@ -38,10 +38,205 @@ An Interface for Memory Dependencies.
 
 #ifndef __EP_MEMORY_H__
 #define __EP_MEMORY_H__
+#include "epLib.h"
+#include <stdlib.h>
 
+/// the maximum number of call sites MemoryTracker tracks (the rest are merged into a single entry)
+#define MEMORY_TRACKER_MAX_SITE_COUNT 1024
+
+namespace epl
+{
+	/*! 
+	@class BaseMemoryAllocator epMemory.h
+	@brief A base class for the memory allocators which can be plugged into MemoryHook.
+	*/
+	class EP_LIBRARY BaseMemoryAllocator
+	{
+	public:
+		/*!
+		Default Destructor
+		*/
+		virtual ~BaseMemoryAllocator(){}
+
+		/*!
+		Allocate the memory with given size.
+		@param[in] size the size of the memory to allocate in bytes.
+		@return the pointer to the memory allocated, or NULL if failed.
+		*/
+		virtual void *Allocate(size_t size)=0;
+
+		/*!
+		Deallocate the memory allocated by this allocator.
+		@param[in] ptr the pointer to the memory to deallocate.
+		@param[in] size the size of the memory given when allocated.
+		*/
+		virtual void Deallocate(void *ptr, size_t size)=0;
+	};
+
+	/*! 
+	@class MemoryHook epMemory.h
+	@brief A class that routes EP_Malloc, EP_Realloc and EP_Free to the allocator set for the calling thread.
+
+	Each memory block carries a small header which records the allocator it came from,
+	so the block is always returned to its own allocator even if the thread's allocator changed since.
+	@remark EP_Malloc, EP_Realloc and EP_Free are routed to this class only when EP_ENABLE_MEMORY_HOOK is defined.
+	        EP_ENABLE_MEMORY_HOOK must be defined for the library and all of its users.
+	*/
+	class EP_LIBRARY MemoryHook
+	{
+	public:
+		/*!
+		Allocate the memory from the allocator of the calling thread.
+		@param[in] size the size of the memory to allocate in bytes.
+		@return the pointer to the memory allocated, or NULL if failed.
+		*/
+		static void *Malloc(size_t size);
+
+		/*!
+		Reallocate the given memory with given size.
+		@param[in] ptr the pointer to the memory to reallocate. (NULL to allocate)
+		@param[in] size the new size of the memory in bytes.
+		@return the pointer to the memory reallocated, or NULL if failed.
+		*/
+		static void *Realloc(void *ptr, size_t size);
+
+		/*!
+		Free the given memory.
+		@param[in] ptr the pointer to the memory to free.
+		*/
+		static void Free(void *ptr);
+
+		/*!
+		Set the allocator for the calling thread.
+		@param[in] allocator the allocator to use. (NULL for the heap)
+		@return the allocator set for the calling thread before.
+		*/
+		static BaseMemoryAllocator *SetThreadAllocator(BaseMemoryAllocator *allocator);
+
+		/*!
+		Return the allocator for the calling thread.
+		@return the allocator for the calling thread. (NULL for the heap)
+		*/
+		static BaseMemoryAllocator *GetThreadAllocator();
+
+	private:
+		/*!
+		Default Constructor
+
+		*Cannot be Used.
+		*/
+		MemoryHook();
+	};
+
+	/*! 
+	@class MemoryTracker epMemory.h
+	@brief A class that tracks the memory allocated by EP_Malloc, EP_Realloc and EP_Free per call site.
+
+	The allocation count, allocated bytes, live allocations and peak live bytes are counted per call site
+	with the interlocked operations, and 1 in every SampleRate allocations of each thread is tracked
+	with the weight of SampleRate to lower the overhead.
+	@remark EP_Malloc, EP_Realloc and EP_Free are routed to this class only when EP_ENABLE_MEMORY_TRACKING is defined.
+	        EP_ENABLE_MEMORY_TRACKING must be defined for the library and all of its users.
+	        MemoryProfileManager outputs the report.
+	*/
+	class EP_LIBRARY MemoryTracker
+	{
+	public:
+		/*!
+		@struct SiteReport epMemory.h
+		@brief The allocation statistics of a call site.
+		*/
+		struct SiteReport
+		{
+			/// the file name of the call site
+			const char *m_fileName;
+			/// the line number of the call site
+			unsigned int m_lineNum;
+			/// the number of allocations
+			__int64 m_allocCount;
+			/// the number of deallocations
+			__int64 m_freeCount;
+			/// the total bytes allocated
+			__int64 m_allocBytes;
+			/// the number of live allocations
+			__int64 m_liveCount;
+			/// the live bytes
+			__int64 m_liveBytes;
+			/// the peak of the live bytes
+			__int64 m_peakLiveBytes;
+		};
+
+		/*!
+		Allocate the memory and track it for the given call site.
+		@param[in] size the size of the memory to allocate in bytes.
+		@param[in] fileName the file name of the call site.
+		@param[in] lineNum the line number of the call site.
+		@return the pointer to the memory allocated, or NULL if failed.
+		*/
+		static void *Malloc(size_t size,const char *fileName,unsigned int lineNum);
+
+		/*!
+		Reallocate the given memory and track it for the given call site.
+		@param[in] ptr the pointer to the memory to reallocate. (NULL to allocate)
+		@param[in] size the new size of the memory in bytes.
+		@param[in] fileName the file name of the call site.
+		@param[in] lineNum the line number of the call site.
+		@return the pointer to the memory reallocated, or NULL if failed.
+		*/
+		static void *Realloc(void *ptr,size_t size,const char *fileName,unsigned int lineNum);
+
+		/*!
+		Free the given memory and untrack it from the call site allocated it.
+		@param[in] ptr the pointer to the memory to free.
+		*/
+		static void Free(void *ptr);
+
+		/*!
+		Set the sample rate of the tracking.
+		@param[in] sampleRate 1 in every sampleRate allocations of each thread is tracked. (1 to track all)
+		*/
+		static void SetSampleRate(unsigned int sampleRate);
+
+		/*!
+		Return the sample rate of the tracking.
+		@return the sample rate of the tracking.
+		*/
+		static unsigned int GetSampleRate();
+
+		/*!
+		Copy the statistics of the call sites tracked to the given array.
+		@param[out] retReports the array to copy the statistics.
+		@param[in] maxCount the number of elements of the array.
+		@return the number of the call sites tracked.
+		@remark the number returned can be greater than maxCount.
+		        The call site reached from several translation units (i.e. in a header) is tracked separately
+		        for each of them, and merged here, so its peak live bytes is the sum of their peaks.
+		*/
+		static size_t GetSiteReports(SiteReport *retReports,size_t maxCount);
+
+	private:
+		/*!
+		Default Constructor
+
+		*Cannot be Used.
+		*/
+		MemoryTracker();
+	};
+}
+
+#if defined(EP_ENABLE_MEMORY_TRACKING)
+#define EP_Malloc(size)      epl::MemoryTracker::Malloc(size,__FILE__,__LINE__)
+#define EP_Realloc(ptr,size) epl::MemoryTracker::Realloc(ptr,size,__FILE__,__LINE__)
+#define EP_Free(ptr)         epl::MemoryTracker::Free(ptr)
+#elif defined(EP_ENABLE_MEMORY_HOOK)
+#define EP_Malloc  epl::MemoryHook::Malloc
+#define EP_Realloc epl::MemoryHook::Realloc
+#define EP_Free    epl::MemoryHook::Free
+#else //defined(EP_ENABLE_MEMORY_TRACKING)
 #define EP_Malloc  malloc
 #define EP_Realloc realloc
 #define EP_Free    free
+#endif //defined(EP_ENABLE_MEMORY_TRACKING)
 #define EP_NEW     new
 #define EP_DELETE  delete
 
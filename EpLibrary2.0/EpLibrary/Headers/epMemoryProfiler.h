@@ -0,0 +1,164 @@
+/*! 
+@file epMemoryProfiler.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief MemoryProfiler Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Memory Profile Manager.
+
+*/
+#ifndef __EP_MEMORY_PROFILER_H__
+#define __EP_MEMORY_PROFILER_H__
+#include "epLib.h"
+#include "epMemory.h"
+#include "epBaseOutputter.h"
+#include "epSingletonHolder.h"
+
+/*!
+@def MEMORY_PROFILE_INSTANCE
+@brief A Simple Macro to get the Memory Profile Manager Instance
+
+Macro that returns the reference of Memory Profile Manager Instance.
+*/
+#define MEMORY_PROFILE_INSTANCE epl::SingletonHolder<epl::MemoryProfileManager>::Instance()
+
+namespace epl
+{
+	/*! 
+	@class MemoryProfileManager epMemoryProfiler.h
+	@brief A class that outputs the allocation statistics of MemoryTracker.
+
+	i.e. MEMORY_PROFILE_INSTANCE.Update(); MEMORY_PROFILE_INSTANCE.Print();
+	@remark The statistics are collected only when EP_ENABLE_MEMORY_TRACKING is defined.
+	*/
+	class EP_LIBRARY MemoryProfileManager:public BaseOutputter
+	{
+	public:
+		friend class SingletonHolder<MemoryProfileManager>;
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		*/
+		MemoryProfileManager & operator=(const MemoryProfileManager&b);
+
+		/*!
+		Take the snapshot of the statistics of MemoryTracker, sorted by the peak live bytes.
+		*/
+		void Update();
+
+		/*!
+		Take the snapshot of the statistics and write the all data to the file.
+		*/
+		virtual void FlushToFile();
+
+	private:
+		/*!
+		Default Constructor
+		@param[in] lockPolicyType The lock policy
+		*/
+		MemoryProfileManager(LockPolicy lockPolicyType=EP_LOCK_POLICY);
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the MemoryProfileManager
+		@param[in] b the second object
+		*/
+		MemoryProfileManager(const MemoryProfileManager& b);
+
+		/*!
+		Default Destructor
+		*/
+		virtual ~MemoryProfileManager();
+
+		/*! 
+		@class MemoryProfileNode epMemoryProfiler.h
+		@brief A class to hold the allocation statistics of a call site.
+		*/
+		class EP_LIBRARY MemoryProfileNode:public BaseOutputter::OutputNode
+		{
+		public:
+			friend class MemoryProfileManager;
+
+			/*!
+			Default Constructor
+			@param[in] report the allocation statistics of a call site.
+			*/
+			MemoryProfileNode(const MemoryTracker::SiteReport &report);
+
+			/*!
+			Default Copy Constructor
+
+			Initializes the MemoryProfileNode
+			@param[in] b the second object
+			*/
+			MemoryProfileNode(const MemoryProfileNode& b);
+
+			/*!
+			Default Destructor
+			*/
+			virtual ~MemoryProfileNode();
+
+			/*!
+			Assignment operator overloading
+			@param[in] b the second object
+			@return the new copied object
+			*/
+			MemoryProfileNode & operator=(const MemoryProfileNode&b);
+
+			/*!
+			It prints the data in format,
+			*/
+			virtual void Print() const;
+
+			/*!
+			Write the data to file in format,
+			@param[in] file the file to output the data.
+			*/
+			virtual void Write(EpFile* const file);
+
+			/*!
+			Compare two MemoryProfileNode objects by the peak live bytes in descending order.
+			@param[in] a the first MemoryProfileNode object.
+			@param[in] b the second MemoryProfileNode object.
+			@return true if a comes before b, otherwise false.
+			*/
+			static bool IsPrior(const OutputNode *a,const OutputNode *b);
+
+		private:
+			/// the allocation statistics of the call site
+			MemoryTracker::SiteReport m_report;
+		};
+	};
+}
+#endif //__EP_MEMORY_PROFILER_H__
@@ -51,6 +51,11 @@ namespace epl
 		MSORT_MODE_LOOP
 	}MSortMode;
 
+	template<typename T>
+	inline T* subMergeSortRecursive(T *sortList, size_t listSize, T* workSpace,CompResultType (__cdecl *SortFunc)(const void * , const void *));
+	template<typename T>
+	inline T* subMergeSortLoop(T *sortList, size_t listSize, T* workSpace,CompResultType (__cdecl *SortFunc)(const void * , const void *));
+
 	/*!
 	Template Insertion Sort Function
 
@@ -67,11 +72,10 @@ namespace epl
 			return;
 		T* mergeSpace=reinterpret_cast<T*>(EP_Malloc(sizeof(T)*listSize));
 
-		T* sortedList;
 		if(mode==MSORT_MODE_RECURSIVE)
-			sortedList=subMergeSortRecursive<T>(sortList,listSize,mergeSpace,SortFunc);
+			subMergeSortRecursive<T>(sortList,listSize,mergeSpace,SortFunc);
 		else if(mode==MSORT_MODE_LOOP)
-			sortedList=subMergeSortLoop<T>(sortList,listSize,mergeSpace,SortFunc);
+			subMergeSortLoop<T>(sortList,listSize,mergeSpace,SortFunc);
 
 		EP_Free(mergeSpace);
 		return;
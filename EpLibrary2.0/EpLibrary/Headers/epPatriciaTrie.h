@@ -40,9 +40,16 @@ An Interface for Patricia Trie Template class.
 
 #include "epLib.h"
 #include "epBinarySearch.h"
+#include "epRuntimeLock.h"
+#include "epStream.h"
+#include "epPatriciaTrieImage.h"
 #include <vector>
+#include <new>
 using namespace std;
 
+/// the number of the children kept inline within the Patricia Trie Node
+#define PATRICIA_TRIE_NODE_INLINE_COUNT 4
+
 namespace epl
 {
 	/// Enumeration Type for Patricia Trie Mode
@@ -56,8 +63,13 @@ namespace epl
 	/*! 
 	@class PatriciaTrie epPatriciaTrie.h
 	@brief A Patricia Trie Template class.
+
+	With LOCK_POLICY_READWRITE, Find, FindAll, IsEmpty, Size and const operator[] are processed concurrently,
+	while Insert, Erase, Clear and non-const operator[] hold the exclusive access.
+	LockType can be StaticLock<ReadWriteLock> or NullLock instead of RuntimeLock to avoid the lock allocation and the virtual calls.
+	@remark the reference returned by operator[] is not protected after the call returns.
 	*/
-	template<typename CharacterType, typename DataType , CharacterType Terminator=(CharacterType)0, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)=CompClass<CharacterType>::CompFunc>
+	template<typename CharacterType, typename DataType , CharacterType Terminator=(CharacterType)0, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)=CompClass<CharacterType>::CompFunc, typename LockType=RuntimeLock>
 	class PatriciaTrie
 	{
 	public:
@@ -155,11 +167,68 @@ namespace epl
 		@return the number of element in the trie
 		*/
 		size_t Size() const;
+
+		class Cursor;
+
+		/*!
+		Open the given cursor on the strings starting with the given string in the order of the strings
+		@param[out] cursor the cursor to open
+		@param[in] str The string value to find
+		@param[in] limit the maximum number of the strings to visit (0 for no limit)
+		@remark the cursor holds the shared access of the trie until it is closed or reaches the end.
+		@return true if succeeded otherwise false
+		*/
+		bool OpenPrefix(Cursor &cursor,const CharacterType* str,size_t limit=0) const;
+
+		/*!
+		Open the given cursor on the strings in [fromStr,toStr) in the order of the strings
+		@param[out] cursor the cursor to open
+		@param[in] fromStr the first string of the range (NULL for the first string of the trie)
+		@param[in] toStr the string right after the range (NULL for no upper bound)
+		@param[in] limit the maximum number of the strings to visit (0 for no limit)
+		@remark the cursor holds the shared access of the trie until it is closed or reaches the end.
+		@return true if succeeded otherwise false
+		*/
+		bool OpenRange(Cursor &cursor,const CharacterType* fromStr,const CharacterType* toStr,size_t limit=0) const;
+
+		/*!
+		Open the given cursor on all the strings in the order of the strings
+		@param[out] cursor the cursor to open
+		@param[in] limit the maximum number of the strings to visit (0 for no limit)
+		@remark the cursor holds the shared access of the trie until it is closed or reaches the end.
+		@return true if succeeded otherwise false
+		*/
+		bool OpenAll(Cursor &cursor,size_t limit=0) const;
+
+		/*!
+		Find the first strings starting with given string from the trie and return the string and data pairs
+
+		Only the nodes on the way to the given number of strings are visited.
+		@param[in] str The string value to find
+		@param[out] retStrDataPairList the string and data pairs found
+		@param[in] limit the maximum number of the string and data pairs to return
+		@return true if succeeded otherwise false
+		*/
+		bool FindAll(const CharacterType* str, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList,size_t limit) const;
+
+		/*!
+		Write the read-only image of the trie to the given stream
+
+		The image can be saved to a file (i.e. by BinaryFile) and queried in place by PatriciaTrieImage.
+		@param[in] stream the stream to write the image to
+		@remark DataType is written byte by byte, so it must be a plain data type without pointers,
+		        and the image must be smaller than 4GB.
+		@return true if succeeded otherwise false
+		*/
+		bool WriteImage(Stream &stream) const;
+
 	protected:
 
 		/*! 
 		@class BasePatriciaTrieNode epPatriciaTrie.h
 		@brief A Base Patricia Trie Node class.
+
+		The nodes do not have virtual functions, and the actual type of the node is decided by IsLeaf.
 		*/
 		class BasePatriciaTrieNode
 		{
@@ -186,7 +255,7 @@ namespace epl
 
 			Destroys the Base Patricia Trie Node
 			*/
-			virtual ~BasePatriciaTrieNode();
+			~BasePatriciaTrieNode();
 
 			/*!
 			Initialize this node to given node
@@ -213,6 +282,18 @@ namespace epl
 			*/
 			bool IsLeaf() const;
 
+			/*!
+			Create the copy of the given node with all its descendants
+			@param[in] node the node to copy
+			@return the new copied node
+			*/
+			static BasePatriciaTrieNode *Clone(const BasePatriciaTrieNode *node);
+
+			/*!
+			Destroy the given node with all its descendants
+			@param[in] node the node to destroy
+			*/
+			static void Destroy(BasePatriciaTrieNode *node);
 
 		protected:
 			/// the character of this node
@@ -224,40 +305,32 @@ namespace epl
 		/*! 
 		@class PatriciaTrieLeaf epPatriciaTrie.h
 		@brief A Patricia Trie Leaf class.
+
+		The leaf and its string are allocated as a single memory block by Create.
 		*/
 		class PatriciaTrieLeaf: public BasePatriciaTrieNode
 		{
 		public:
 			/*!
-			Default Constructor
-
-			Initializes the Patricia Trie Leaf
-			@param[in] str the string of this node
-			@param[in] data the data of this node holding
+			Create the new leaf with the given string and data
+			@param[in] str the string of the leaf
+			@param[in] data the data of the leaf holding
+			@return the new leaf
 			*/
-			PatriciaTrieLeaf(const CharacterType *str,const DataType &data);
+			static PatriciaTrieLeaf *Create(const CharacterType *str,const DataType &data);
 
 			/*!
-			Default Copy Constructor
-
-			Initializes the Patricia Trie Leaf with given leaf
+			Create the copy of the given leaf
 			@param[in] b the Patricia Trie Leaf Object to copy from
+			@return the new copied leaf
 			*/
-			PatriciaTrieLeaf(const PatriciaTrieLeaf &b);
+			static PatriciaTrieLeaf *Create(const PatriciaTrieLeaf &b);
 
 			/*!
-			Default Destructor
-
-			Destroys the Patricia Trie Leaf
+			Destroy the given leaf created by Create
+			@param[in] leaf the leaf to destroy
 			*/
-			virtual ~PatriciaTrieLeaf();
-
-			/*!
-			Initialize this leaf to given leaf
-			@param[in] b the Patricia Trie Leaf structure to initialize this leaf
-			@return the result Patricia Trie Leaf
-			*/
-			PatriciaTrieLeaf &operator=(const PatriciaTrieLeaf & b);
+			static void Destroy(PatriciaTrieLeaf *leaf);
 
 			/*!
 			Return this node's data
@@ -283,18 +356,58 @@ namespace epl
 			*/
 			const CharacterType *GetString() const;
 
-		protected:
+			/*!
+			Return the length of this node's string without the terminator
+			@return the length of the string of this node
+			*/
+			size_t GetLength() const;
+
+		private:
+			/*!
+			Default Constructor
+
+			Initializes the Patricia Trie Leaf
+			@param[in] data the data of this node holding
+			@param[in] length the length of the string without the terminator
+			*/
+			PatriciaTrieLeaf(const DataType &data,size_t length);
+
+			/*!
+			Default Destructor
+
+			Destroys the Patricia Trie Leaf
+			*/
+			~PatriciaTrieLeaf();
+
+			/*!
+			Default Copy Constructor
+
+			*Cannot be Used.
+			*/
+			PatriciaTrieLeaf(const PatriciaTrieLeaf &b):BasePatriciaTrieNode(b){EP_ASSERT(0);}
+
+			/*!
+			Assignment operator overloading
+
+			*Cannot be Used.
+			*/
+			PatriciaTrieLeaf &operator=(const PatriciaTrieLeaf & b){EP_ASSERT(0);return *this;}
+
 			/// data of this node
 			DataType m_data;
-			/// string of this node
-			vector<CharacterType> m_string;
-			/// string terminator character holder
-			CharacterType m_terminator;
+			/// length of the string of this node without the terminator (the string follows this leaf)
+			size_t m_length;
 		};
 
 		/*! 
 		@class PatriciaTrieNode epPatriciaTrie.h
 		@brief A Patricia Trie Node class.
+
+		The characters of the children are kept sorted in a contiguous array, apart from the child pointers,
+		so a lookup only touches the characters until it hits.
+		The arrays grow and shrink through the capacities of 4 (inline within the node), 16, 48 and 256 (and doubles beyond).
+		The node keeps no pointers to the arrays, their place is decided by the capacity,
+		so the node takes 48 bytes for char (64 bytes for 4-byte characters) on 64-bit.
 		*/
 		class PatriciaTrieNode: public BasePatriciaTrieNode
 		{
@@ -321,7 +434,7 @@ namespace epl
 
 			Destroys the Patricia Trie Node
 			*/
-			virtual ~PatriciaTrieNode();
+			~PatriciaTrieNode();
 
 			/*!
 			Initialize this node to given node
@@ -331,16 +444,17 @@ namespace epl
 			PatriciaTrieNode &operator=(const PatriciaTrieNode & b);
 
 			/*!
-			Return the character list of this node holding
-			@return the character list of this node
+			Return the number of the children of this node
+			@return the number of the children of this node
 			*/
-			const vector<BasePatriciaTrieNode *> &GetList() const;
+			size_t GetChildCount() const;
 
 			/*!
-			Return the character list of this node holding
-			@return the character list of this node
+			Return the child at the given index in the order of the character
+			@param[in] idx the index of the child
+			@return the child at the given index
 			*/
-			vector<BasePatriciaTrieNode *> &GetList();
+			BasePatriciaTrieNode *GetChild(size_t idx) const;
 
 			/*!
 			Add a new node with given character to the list of this node
@@ -383,13 +497,231 @@ namespace epl
 			*/
 			const BasePatriciaTrieNode *operator[](const CharacterType &character) const;
 
-		protected:
-			/// character list of this node
-			vector<BasePatriciaTrieNode*> m_charList;
-			/// string terminator character holder
-			CharacterType m_terminator;
+			/*!
+			Return the index of the first child with the character not less than the given character
+			@param[in] c the character to find
+			@return the index of the first child not less than the given character (the child count if none)
+			*/
+			size_t LowerBound(const CharacterType &c) const;
+
+		private:
+			/*!
+			Find the index of the child with the given character
+			@param[in] c the character to find
+			@param[out] retIdx the index of the child found, or the index to insert if not found
+			@return true if found otherwise false.
+			*/
+			bool findIndex(const CharacterType &c,size_t &retIdx) const;
+
+			/*!
+			Insert the given child at the given index
+			@param[in] idx the index to insert
+			@param[in] node the child to insert
+			@return true if succeeded otherwise false.
+			*/
+			bool insertChild(size_t idx,BasePatriciaTrieNode *node);
+
+			/*!
+			Remove the child at the given index
+			@param[in] idx the index to remove
+			*/
+			void removeChild(size_t idx);
+
+			/*!
+			Move the children to the arrays of the given capacity
+			@param[in] capacity the new capacity
+			@return true if succeeded otherwise false.
+			*/
+			bool resize(size_t capacity);
+
+			/*!
+			Remove all the children
+			*/
+			void clear();
+
+			/*!
+			Return the capacity class to grow to from the given capacity
+			@param[in] capacity the current capacity
+			@return the capacity to grow to
+			*/
+			static size_t nextCapacity(size_t capacity);
+
+			/*!
+			Return the capacity class to shrink to from the given capacity
+			@param[in] capacity the current capacity
+			@return the capacity to shrink to
+			*/
+			static size_t prevCapacity(size_t capacity);
+
+			/*!
+			Return the sorted characters of the children
+			@return the array of the characters
+			*/
+			CharacterType *getKeys();
+
+			/*!
+			Return the sorted characters of the children
+			@return the array of the characters
+			*/
+			const CharacterType *getKeys() const;
+
+			/*!
+			Return the children in the order of the characters
+			@return the array of the children
+			*/
+			BasePatriciaTrieNode **getChildren();
+
+			/*!
+			Return the children in the order of the characters
+			@return the array of the children
+			*/
+			BasePatriciaTrieNode *const *getChildren() const;
+
+			/// the number of the children
+			unsigned int m_childCount;
+			/// the capacity of the arrays, which also tells whether the arrays are inline or in m_block
+			unsigned int m_capacity;
+			/// the inline characters used while the capacity is PATRICIA_TRIE_NODE_INLINE_COUNT
+			CharacterType m_inlineKeys[PATRICIA_TRIE_NODE_INLINE_COUNT];
+			union
+			{
+				/// the inline children used while the capacity is PATRICIA_TRIE_NODE_INLINE_COUNT
+				BasePatriciaTrieNode *m_inlineChildren[PATRICIA_TRIE_NODE_INLINE_COUNT];
+				/// the block of the children followed by their characters, used while the capacity is larger
+				void *m_block;
+			};
+		};
+
+	public:
+		/*! 
+		@class Cursor epPatriciaTrie.h
+		@brief A lazy cursor class which visits the strings of the Patricia Trie in the order of the strings.
+
+		The cursor is opened by OpenPrefix, OpenRange or OpenAll, and visits the next string on each Next call,
+		so the strings after the current string are not touched until they are needed.
+		@code
+		PatriciaTrie<TCHAR,int>::Cursor cursor;
+		trie.OpenPrefix(cursor,_T("ab"),10);
+		while(cursor.Next())
+		{
+			// cursor.GetString(), cursor.GetData()
+		}
+		@endcode
+		@remark While the cursor is open, the trie must not be modified, and with LOCK_POLICY_READWRITE,
+		        the thread holding the cursor must not call the other functions of the trie.
+		*/
+		class Cursor
+		{
+			friend class PatriciaTrie;
+		public:
+			/*!
+			Default Constructor
+
+			Initializes the closed cursor
+			*/
+			Cursor();
+
+			/*!
+			Default Destructor
+
+			Closes the cursor
+			*/
+			~Cursor();
+
+			/*!
+			Move to the next string
+			@return true if moved to the next string, false if reached the end.
+			*/
+			bool Next();
+
+			/*!
+			Return the string of the current position
+			@return the string of the current position
+			*/
+			const CharacterType *GetString() const;
+
+			/*!
+			Return the data of the current position
+			@return the data of the current position
+			*/
+			const DataType &GetData() const;
+
+			/*!
+			Return the number of the strings visited so far
+			@return the number of the strings visited so far
+			*/
+			size_t GetCount() const;
+
+			/*!
+			Check if the cursor is open
+			@return true if the cursor is open otherwise false
+			*/
+			bool IsOpen() const;
+
+			/*!
+			Close the cursor and release the shared access of the trie
+			*/
+			void Close();
+
+		private:
+			/*!
+			Default Copy Constructor
+
+			*Cannot be Used.
+			*/
+			Cursor(const Cursor & b){EP_ASSERT(0);}
+
+			/*!
+			Assignment operator overloading
+
+			*Cannot be Used.
+			*/
+			Cursor &operator=(const Cursor & b){EP_ASSERT(0);return *this;}
+
+			/*!
+			Open the cursor on the given trie and take the shared access of the trie
+			@param[in] trie the trie to visit
+			@param[in] limit the maximum number of the strings to visit (0 for no limit)
+			*/
+			void open(const PatriciaTrie *trie,size_t limit);
+
+			/*!
+			Check if the given string is before the upper bound
+			@param[in] str the string to check
+			@return true if the given string is before the upper bound otherwise false
+			*/
+			bool isBeforeUpperBound(const CharacterType *str) const;
+
+			/*! 
+			@struct CursorFrame epPatriciaTrie.h
+			@brief A node and the index of its next child to visit.
+			*/
+			struct CursorFrame
+			{
+				/// the node
+				const PatriciaTrieNode *node;
+				/// the index of the next child to visit
+				size_t childIdx;
+			};
+
+			/// the trie visiting
+			const PatriciaTrie *m_trie;
+			/// the path of the nodes to the next string
+			vector<CursorFrame> m_frames;
+			/// the leaf of the current position
+			const PatriciaTrieLeaf *m_current;
+			/// the upper bound with the terminator
+			vector<CharacterType> m_upperBound;
+			/// flag whether the upper bound exists
+			bool m_hasUpperBound;
+			/// the maximum number of the strings to visit (0 for no limit)
+			size_t m_limit;
+			/// the number of the strings visited so far
+			size_t m_count;
 		};
 
+	protected:
+
 		/*!
 		Actually insert the string with given data to the trie by recursive
 		@param[in] root the root of the trie
@@ -489,23 +821,24 @@ namespace epl
 		*/
 		void traverseAllLoop(BasePatriciaTrieNode *root, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList) const;
 
-
-
+		/*!
+		Append the record of the given node to the given image
+		@param[in] image the image to append to
+		@param[in] node the node to append
+		@param[in] childOffsets the offsets of the children of the node within the image
+		@return the offset of the record appended
+		*/
+		static size_t writeImageNode(vector<unsigned char> &image,const PatriciaTrieNode *node,const unsigned int *childOffsets);
 
 		/*!
-		Compare the given character with the character of the node
-		@param[in] a the pointer to the character
-		@param[in] b the pointer to the node
-		@return compare result of character and character of the node.
+		Append the record of the given leaf to the given image
+		@param[in] image the image to append to
+		@param[in] leaf the leaf to append
+		@return the offset of the record appended
 		*/
-		static CompResultType NodeCompareFunc(const void *a, const void *b)
-		{
-			void *_vA=const_cast<void*>(a);
-			void *_vB=const_cast<void*>(b);
-			CharacterType* _a=reinterpret_cast<CharacterType*>(_vA);
-			BasePatriciaTrieNode **_b=reinterpret_cast<BasePatriciaTrieNode**>(_vB);
-			return CharCompareFunc(_a,&((*_b)->GetCharacter()));
-		}
+		static size_t writeImageLeaf(vector<unsigned char> &image,const PatriciaTrieLeaf *leaf);
+
+
 
 
 		/// Root of the trie
@@ -515,7 +848,7 @@ namespace epl
 		/// String Terminator holder
 		CharacterType m_terminator;
 		/// lock
-		BaseLock *m_trieLock;
+		mutable LockType m_trieLock;
 		/// Lock Policy
 		LockPolicy m_lockPolicy;
 		/// Patricia Trie Mode
@@ -526,51 +859,24 @@ namespace epl
 
 
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrie(PatriciaTrieMode mode,LockPolicy lockPolicyType)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrie(PatriciaTrieMode mode,LockPolicy lockPolicyType)
 	{
 		m_totalCount=0;
 		m_root=EP_NEW PatriciaTrieNode(Terminator);
 		m_terminator=Terminator;
 		m_lockPolicy=lockPolicyType;
 		m_mode=mode;
-		switch(lockPolicyType)
-		{
-		case LOCK_POLICY_CRITICALSECTION:
-			m_trieLock=EP_NEW CriticalSectionEx();
-			break;
-		case LOCK_POLICY_MUTEX:
-			m_trieLock=EP_NEW Mutex();
-			break;
-		case LOCK_POLICY_NONE:
-			m_trieLock=EP_NEW NoLock();
-			break;
-		default:
-			m_trieLock=NULL;
-		}
+		m_trieLock.Reset(lockPolicyType);
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrie(const PatriciaTrie & b)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrie(const PatriciaTrie & b)
 	{
 		m_lockPolicy=b.m_lockPolicy;
-		switch(m_lockPolicy)
-		{
-		case LOCK_POLICY_CRITICALSECTION:
-			m_trieLock=EP_NEW CriticalSectionEx();
-			break;
-		case LOCK_POLICY_MUTEX:
-			m_trieLock=EP_NEW Mutex();
-			break;
-		case LOCK_POLICY_NONE:
-			m_trieLock=EP_NEW NoLock();
-			break;
-		default:
-			m_trieLock=NULL;
-			break;
-		}
+		m_trieLock.Reset(m_lockPolicy);
 		m_root=EP_NEW PatriciaTrieNode(Terminator);
-		LockObj lock(b.m_trieLock);
+		SharedLockGuard<LockType> lock(b.m_trieLock);
 		m_totalCount=b.m_totalCount;
 		*m_root=*(b.m_root);
 		m_mode=b.m_mode;
@@ -579,50 +885,31 @@ namespace epl
 
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::~PatriciaTrie()
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::~PatriciaTrie()
 	{
-		m_trieLock->Lock();
+		m_trieLock.Lock();
 		if(m_root)
 			EP_DELETE m_root;
-		m_trieLock->Unlock();
-		if(m_trieLock)
-			EP_DELETE m_trieLock;
+		m_trieLock.Unlock();
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc> &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::operator=(const PatriciaTrie & b)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType> &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::operator=(const PatriciaTrie & b)
 	{
 		if(this!=&b)
 		{
-			m_trieLock->Lock();
+			m_trieLock.Lock();
 			if(m_root)
 				EP_DELETE m_root;
 			m_root=NULL;
-			m_trieLock->Unlock();
-			if(m_trieLock)
-				EP_DELETE m_trieLock;
-			m_trieLock=NULL;
+			m_trieLock.Unlock();
 
 
 			m_lockPolicy=b.m_lockPolicy;
-			switch(m_lockPolicy)
-			{
-			case LOCK_POLICY_CRITICALSECTION:
-				m_trieLock=EP_NEW CriticalSectionEx();
-				break;
-			case LOCK_POLICY_MUTEX:
-				m_trieLock=EP_NEW Mutex();
-				break;
-			case LOCK_POLICY_NONE:
-				m_trieLock=EP_NEW NoLock();
-				break;
-			default:
-				m_trieLock=NULL;
-				break;
-			}
+			m_trieLock.Reset(m_lockPolicy);
 			m_root=EP_NEW PatriciaTrieNode(Terminator);
-			LockObj lock(b.m_trieLock);
+			SharedLockGuard<LockType> lock(b.m_trieLock);
 			m_totalCount=b.m_totalCount;
 			*m_root=*(b.m_root);
 			m_mode=b.m_mode;
@@ -631,13 +918,13 @@ namespace epl
 		return *this;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	DataType &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::operator[](const CharacterType * str)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	DataType &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::operator[](const CharacterType * str)
 	{
 
 		EP_ASSERT_EXPR(str,_T("String is NULL"));
 		DataType retData;
-		LockObj lock(m_trieLock);
+		LockGuard<LockType> lock(m_trieLock);
 		PatriciaTrieLeaf *foundNode=find(m_root,str,0,retData);
 		if(foundNode)
 		{
@@ -652,50 +939,50 @@ namespace epl
 		}
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	const DataType &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::operator[](const CharacterType * str) const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	const DataType &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::operator[](const CharacterType * str) const
 	{
 		EP_ASSERT_EXPR(str,_T("String is NULL"));
 		DataType retData;
-		LockObj lock(m_trieLock);
+		SharedLockGuard<LockType> lock(m_trieLock);
 		PatriciaTrieLeaf *foundNode=find(m_root,str,0,retData);
 		EP_ASSERT(foundNode);
 		return foundNode->GetData();
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::Clear()
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Clear()
 	{
-		LockObj lock(m_trieLock);
+		LockGuard<LockType> lock(m_trieLock);
 		m_totalCount=0;	
 		if(m_root)
 			EP_DELETE m_root;
 		m_root=EP_NEW PatriciaTrieNode(Terminator);
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::IsEmpty() const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::IsEmpty() const
 	{
-		LockObj lock(m_trieLock);
+		SharedLockGuard<LockType> lock(m_trieLock);
 		if(m_totalCount)
 			return true;
 		return false;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	size_t PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::Size() const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	size_t PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Size() const
 	{
-		LockObj lock(m_trieLock);
+		SharedLockGuard<LockType> lock(m_trieLock);
 		return m_totalCount;
 	}
 
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::Insert(const CharacterType* str,const DataType &data)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Insert(const CharacterType* str,const DataType &data)
 	{
 		if(str!=NULL )
 		{		
-			LockObj lock(m_trieLock);
+			LockGuard<LockType> lock(m_trieLock);
 			if(insert(m_root,str,0,data))
 			{
 				m_totalCount++;
@@ -705,12 +992,12 @@ namespace epl
 		return false;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::Erase(const CharacterType* str)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Erase(const CharacterType* str)
 	{
 		if(str!=NULL)
 		{
-			LockObj lock(m_trieLock);
+			LockGuard<LockType> lock(m_trieLock);
 			if(erase(m_root,str,0))
 			{
 				m_totalCount--;
@@ -720,12 +1007,12 @@ namespace epl
 		return false;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::Find(const CharacterType* str, DataType &retData) const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Find(const CharacterType* str, DataType &retData) const
 	{
 		if(str!=NULL)
 		{
-			LockObj lock(m_trieLock);
+			SharedLockGuard<LockType> lock(m_trieLock);
 			if(find(m_root,str,0,retData))
 			{
 				return true;
@@ -734,12 +1021,12 @@ namespace epl
 		return false;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::FindAll(const CharacterType* str, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList) const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::FindAll(const CharacterType* str, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList) const
 	{
 		if(str!=NULL)
 		{
-			LockObj lock(m_trieLock);
+			SharedLockGuard<LockType> lock(m_trieLock);
 			if(findAll(m_root,str,0,retStrDataPairList))
 			{
 				return true;
@@ -749,8 +1036,156 @@ namespace epl
 	}
 
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieLeaf *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::insert(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav,const DataType &data)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::OpenPrefix(Cursor &cursor,const CharacterType* str,size_t limit) const
+	{
+		cursor.Close();
+		if(str==NULL)
+			return false;
+		cursor.open(this,limit);
+		const PatriciaTrieNode *node=m_root;
+		for(size_t strTrav=0;CharCompareFunc(&str[strTrav],&m_terminator)!=COMP_RESULT_EQUAL;strTrav++)
+		{
+			const BasePatriciaTrieNode *child=(*node)[str[strTrav]];
+			if(!child || child->IsLeaf())
+			{
+				cursor.Close();
+				return false;
+			}
+			node=static_cast<const PatriciaTrieNode*>(child);
+		}
+		typename Cursor::CursorFrame frame;
+		frame.node=node;
+		frame.childIdx=0;
+		cursor.m_frames.push_back(frame);
+		return true;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::OpenRange(Cursor &cursor,const CharacterType* fromStr,const CharacterType* toStr,size_t limit) const
+	{
+		cursor.Close();
+		cursor.open(this,limit);
+		if(toStr)
+		{
+			size_t strTrav=0;
+			for(;CharCompareFunc(&toStr[strTrav],&m_terminator)!=COMP_RESULT_EQUAL;strTrav++)
+				cursor.m_upperBound.push_back(toStr[strTrav]);
+			cursor.m_upperBound.push_back(m_terminator);
+			cursor.m_hasUpperBound=true;
+		}
+
+		// push the path to the first string not less than fromStr
+		typename Cursor::CursorFrame frame;
+		frame.node=m_root;
+		frame.childIdx=0;
+		if(fromStr)
+		{
+			for(size_t strTrav=0;;strTrav++)
+			{
+				frame.childIdx=frame.node->LowerBound(fromStr[strTrav]);
+				if(frame.childIdx>=frame.node->GetChildCount() || frame.node->GetChild(frame.childIdx)->IsLeaf()
+					|| CharCompareFunc(&fromStr[strTrav],&frame.node->GetChild(frame.childIdx)->GetCharacter())!=COMP_RESULT_EQUAL)
+					break;
+				const PatriciaTrieNode *child=static_cast<const PatriciaTrieNode*>(frame.node->GetChild(frame.childIdx));
+				frame.childIdx++;
+				cursor.m_frames.push_back(frame);
+				frame.node=child;
+			}
+		}
+		cursor.m_frames.push_back(frame);
+		return true;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::OpenAll(Cursor &cursor,size_t limit) const
+	{
+		return OpenRange(cursor,NULL,NULL,limit);
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::FindAll(const CharacterType* str, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList,size_t limit) const
+	{
+		if(limit==0)
+			return false;
+		Cursor cursor;
+		if(!OpenPrefix(cursor,str,limit))
+			return false;
+		bool retBool=false;
+		while(cursor.Next())
+		{
+			Pair<const CharacterType*,DataType> newPair(cursor.GetString(),cursor.GetData());
+			retStrDataPairList.push_back(newPair);
+			retBool=true;
+		}
+		return retBool;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::WriteImage(Stream &stream) const
+	{
+		SharedLockGuard<LockType> lock(m_trieLock);
+		vector<unsigned char> image(sizeof(PatriciaTrieImageHeader),0);
+
+		// write the children before their parent, so the offsets of the children are known
+		struct SnapShotStruct
+		{
+			const PatriciaTrieNode *node;
+			size_t childIdx;
+			size_t offsetIdx;
+		};
+
+		vector<unsigned int> offsetList;
+		stack<SnapShotStruct> snapshotStack;
+		SnapShotStruct currentSnaptshot;
+		currentSnaptshot.node=m_root;
+		currentSnaptshot.childIdx=0;
+		currentSnaptshot.offsetIdx=0;
+		snapshotStack.push(currentSnaptshot);
+		while(!snapshotStack.empty())
+		{
+			SnapShotStruct &topSnapshot=snapshotStack.top();
+			if(topSnapshot.childIdx<topSnapshot.node->GetChildCount())
+			{
+				const BasePatriciaTrieNode *child=topSnapshot.node->GetChild(topSnapshot.childIdx);
+				topSnapshot.childIdx++;
+				if(child->IsLeaf())
+				{
+					offsetList.push_back((unsigned int)writeImageLeaf(image,static_cast<const PatriciaTrieLeaf*>(child)));
+				}
+				else
+				{
+					SnapShotStruct newSnapshot;
+					newSnapshot.node=static_cast<const PatriciaTrieNode*>(child);
+					newSnapshot.childIdx=0;
+					newSnapshot.offsetIdx=offsetList.size();
+					snapshotStack.push(newSnapshot);
+				}
+				continue;
+			}
+			size_t offsetIdx=topSnapshot.offsetIdx;
+			size_t nodeOffset=writeImageNode(image,topSnapshot.node,offsetList.size()>offsetIdx?&offsetList[offsetIdx]:NULL);
+			snapshotStack.pop();
+			offsetList.resize(offsetIdx);
+			offsetList.push_back((unsigned int)nodeOffset);
+		}
+
+		if(image.size()>0xFFFFFFFF)
+			return false;
+		PatriciaTrieImageHeader *header=reinterpret_cast<PatriciaTrieImageHeader*>(&image[0]);
+		header->magic=PATRICIA_TRIE_IMAGE_MAGIC;
+		header->version=PATRICIA_TRIE_IMAGE_VERSION;
+		header->characterSize=sizeof(CharacterType);
+		header->dataSize=sizeof(DataType);
+		header->count=(unsigned int)m_totalCount;
+		header->rootOffset=offsetList[0];
+		header->imageSize=(unsigned int)image.size();
+		header->reserved=0;
+		return stream.WriteBytes(&image[0],image.size());
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::insert(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav,const DataType &data)
 	{
 		if(m_mode==PATRICIA_TRIE_MODE_RECURSIVE)
 		{
@@ -786,8 +1221,8 @@ namespace epl
 		}
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieLeaf *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::insertLoop(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav,const DataType &data)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::insertLoop(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav,const DataType &data)
 	{
 		struct SnapShotStruct
 		{
@@ -846,8 +1281,8 @@ namespace epl
 	}
 
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::erase(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::erase(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav)
 	{
 		if(m_mode==PATRICIA_TRIE_MODE_RECURSIVE)
 		{
@@ -878,8 +1313,8 @@ namespace epl
 
 
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::eraseLoop(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::eraseLoop(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav)
 	{
 		struct SnapShotStruct
 		{
@@ -943,8 +1378,8 @@ namespace epl
 		return retBool;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieLeaf *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::find(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav, DataType &retData) const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::find(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav, DataType &retData) const
 	{
 		if(m_mode==PATRICIA_TRIE_MODE_RECURSIVE)
 		{
@@ -975,8 +1410,8 @@ namespace epl
 	}
 
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieLeaf *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::findLoop(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav, DataType &retData) const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::findLoop(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav, DataType &retData) const
 	{
 		struct SnapShotStruct
 		{
@@ -1025,8 +1460,8 @@ namespace epl
 		return retNode;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::findAll(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList) const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::findAll(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList) const
 	{
 		if(m_mode==PATRICIA_TRIE_MODE_RECURSIVE)
 		{
@@ -1047,10 +1482,10 @@ namespace epl
 				}
 				if(CharCompareFunc(&str[strTrav],&m_terminator)==COMP_RESULT_EQUAL)
 				{
-					for(int trav=0;trav<rootNode->GetList().size();trav++)
+					for(size_t trav=0;trav<rootNode->GetChildCount();trav++)
 					{
-						if(NodeCompareFunc(&m_terminator,&rootNode->GetList().at(trav))!=COMP_RESULT_EQUAL)
-							traverseAll(rootNode->GetList().at(trav),retStrDataPairList);
+						if(CharCompareFunc(&m_terminator,&rootNode->GetChild(trav)->GetCharacter())!=COMP_RESULT_EQUAL)
+							traverseAll(rootNode->GetChild(trav),retStrDataPairList);
 					}
 					
 				}
@@ -1066,8 +1501,8 @@ namespace epl
 	}
 
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::findAllLoop(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList) const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::findAllLoop(BasePatriciaTrieNode *root,const CharacterType* str,size_t strTrav, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList) const
 	{
 		struct SnapShotStruct
 		{
@@ -1123,10 +1558,10 @@ namespace epl
 
 					if(CharCompareFunc(&str[currentSnaptshot.strTrav],&m_terminator)==COMP_RESULT_EQUAL)
 					{
-						for(int trav=0;trav<rootNode->GetList().size();trav++)
+						for(size_t trav=0;trav<rootNode->GetChildCount();trav++)
 						{
-							if(NodeCompareFunc(&m_terminator,&rootNode->GetList().at(trav))!=COMP_RESULT_EQUAL)
-								traverseAll(rootNode->GetList().at(trav),retStrDataPairList);
+							if(CharCompareFunc(&m_terminator,&rootNode->GetChild(trav)->GetCharacter())!=COMP_RESULT_EQUAL)
+								traverseAll(rootNode->GetChild(trav),retStrDataPairList);
 						}
 
 					}
@@ -1143,10 +1578,10 @@ namespace epl
 				PatriciaTrieNode *rootNode=static_cast<PatriciaTrieNode*>(currentSnaptshot.root);
 				if(CharCompareFunc(&str[currentSnaptshot.strTrav],&m_terminator)==COMP_RESULT_EQUAL)
 				{
-					for(int trav=0;trav<rootNode->GetList().size();trav++)
+					for(size_t trav=0;trav<rootNode->GetChildCount();trav++)
 					{
-						if(NodeCompareFunc(&m_terminator,&rootNode->GetList().at(trav))!=COMP_RESULT_EQUAL)
-							traverseAll(rootNode->GetList().at(trav),retStrDataPairList);
+						if(CharCompareFunc(&m_terminator,&rootNode->GetChild(trav)->GetCharacter())!=COMP_RESULT_EQUAL)
+							traverseAll(rootNode->GetChild(trav),retStrDataPairList);
 					}
 
 				}
@@ -1165,8 +1600,8 @@ namespace epl
 	}
 
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::traverseAll(BasePatriciaTrieNode *root, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList) const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::traverseAll(BasePatriciaTrieNode *root, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList) const
 	{
 		if(m_mode==PATRICIA_TRIE_MODE_RECURSIVE)
 		{
@@ -1180,9 +1615,9 @@ namespace epl
 			else
 			{
 				PatriciaTrieNode *rootNode=static_cast<PatriciaTrieNode*>(root);
-				for(int trav=0;trav<rootNode->GetList().size();trav++)
+				for(size_t trav=0;trav<rootNode->GetChildCount();trav++)
 				{
-					traverseAll(rootNode->GetList().at(trav),retStrDataPairList);
+					traverseAll(rootNode->GetChild(trav),retStrDataPairList);
 				}
 			}
 		}
@@ -1192,8 +1627,8 @@ namespace epl
 		}
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::traverseAllLoop(BasePatriciaTrieNode *root, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList) const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::traverseAllLoop(BasePatriciaTrieNode *root, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList) const
 	{
 
 
@@ -1223,33 +1658,69 @@ namespace epl
 			{
 				PatriciaTrieNode *rootNode=static_cast<PatriciaTrieNode*>(currentSnaptshot.root);
 				SnapShotStruct newSnapshot;
-				for(int trav=0;trav<rootNode->GetList().size();trav++)
+				for(size_t trav=0;trav<rootNode->GetChildCount();trav++)
 				{
-					newSnapshot.root=rootNode->GetList().at(trav);
+					newSnapshot.root=rootNode->GetChild(trav);
 					snapshotStack.push(newSnapshot);
 				}
 			}
 		}
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::BasePatriciaTrieNode::BasePatriciaTrieNode(CharacterType c, bool isLeaf)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	size_t PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::writeImageNode(vector<unsigned char> &image,const PatriciaTrieNode *node,const unsigned int *childOffsets)
+	{
+		// the child count, the offsets of the children and the characters of the children
+		size_t nodeOffset=PATRICIA_TRIE_IMAGE_ALIGN(image.size(),PATRICIA_TRIE_IMAGE_ALIGNMENT);
+		unsigned int childCount=(unsigned int)node->GetChildCount();
+		image.resize(nodeOffset+sizeof(unsigned int)*(childCount+1)+sizeof(CharacterType)*childCount,0);
+		unsigned char *record=&image[nodeOffset];
+		memcpy(record,&childCount,sizeof(unsigned int));
+		record+=sizeof(unsigned int);
+		if(childCount)
+			memcpy(record,childOffsets,sizeof(unsigned int)*childCount);
+		record+=sizeof(unsigned int)*childCount;
+		for(unsigned int trav=0;trav<childCount;trav++)
+		{
+			memcpy(record,&node->GetChild(trav)->GetCharacter(),sizeof(CharacterType));
+			record+=sizeof(CharacterType);
+		}
+		return nodeOffset;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	size_t PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::writeImageLeaf(vector<unsigned char> &image,const PatriciaTrieLeaf *leaf)
+	{
+		// the data, the length of the string and the string with the terminator
+		size_t leafOffset=PATRICIA_TRIE_IMAGE_ALIGN(image.size(),PATRICIA_TRIE_IMAGE_ALIGNMENT);
+		size_t lengthOffset=PATRICIA_TRIE_IMAGE_ALIGN(sizeof(DataType),sizeof(unsigned int));
+		unsigned int length=(unsigned int)leaf->GetLength();
+		image.resize(leafOffset+lengthOffset+sizeof(unsigned int)+sizeof(CharacterType)*(length+1),0);
+		unsigned char *record=&image[leafOffset];
+		memcpy(record,&leaf->GetData(),sizeof(DataType));
+		memcpy(record+lengthOffset,&length,sizeof(unsigned int));
+		memcpy(record+lengthOffset+sizeof(unsigned int),leaf->GetString(),sizeof(CharacterType)*(length+1));
+		return leafOffset;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode::BasePatriciaTrieNode(CharacterType c, bool isLeaf)
 	{
 		m_character=c;
 		m_isLeaf=isLeaf;
 	}
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::BasePatriciaTrieNode::BasePatriciaTrieNode(const BasePatriciaTrieNode &b)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode::BasePatriciaTrieNode(const BasePatriciaTrieNode &b)
 	{
 		m_character=b.m_character;
 		m_isLeaf=b.m_isLeaf;
 	}
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::BasePatriciaTrieNode::~BasePatriciaTrieNode()
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode::~BasePatriciaTrieNode()
 	{
 	}
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::BasePatriciaTrieNode &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::BasePatriciaTrieNode::operator=(const BasePatriciaTrieNode & b)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode::operator=(const BasePatriciaTrieNode & b)
 	{
 
 		if(this!=&b)
@@ -1260,289 +1731,559 @@ namespace epl
 		return *this;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	const CharacterType &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::BasePatriciaTrieNode::GetCharacter() const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	const CharacterType &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode::GetCharacter() const
 	{
 		return m_character;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::BasePatriciaTrieNode::SetCharacter(const CharacterType & c)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode::SetCharacter(const CharacterType & c)
 	{
 		m_character=c;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::BasePatriciaTrieNode::IsLeaf() const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode::IsLeaf() const
 	{
 		return m_isLeaf;
 	}
 
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode::Clone(const BasePatriciaTrieNode *node)
+	{
+		if(node->IsLeaf())
+			return PatriciaTrieLeaf::Create(*static_cast<const PatriciaTrieLeaf*>(node));
+		return EP_NEW PatriciaTrieNode(*static_cast<const PatriciaTrieNode*>(node));
+	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieLeaf::PatriciaTrieLeaf(const CharacterType *str,const DataType &data):BasePatriciaTrieNode(Terminator,true)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode::Destroy(BasePatriciaTrieNode *node)
 	{
-		m_data=data;
-		m_terminator=Terminator;
-		if(str!=NULL)
-		{
-			int trav=0;
-			while(CharCompareFunc(&str[trav],&m_terminator)!=COMP_RESULT_EQUAL)
-			{
-				m_string.push_back(str[trav]);
-				trav++;
-			}
-			m_string.push_back(m_terminator);
-		}
+		if(!node)
+			return;
+		if(node->IsLeaf())
+			PatriciaTrieLeaf::Destroy(static_cast<PatriciaTrieLeaf*>(node));
+		else
+			EP_DELETE static_cast<PatriciaTrieNode*>(node);
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieLeaf::PatriciaTrieLeaf(const PatriciaTrieLeaf &b):BasePatriciaTrieNode(b)
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf::PatriciaTrieLeaf(const DataType &data,size_t length):BasePatriciaTrieNode(Terminator,true)
 	{
-		m_data=b.m_data;
-		m_string=b.m_string;
+		m_data=data;
+		m_length=length;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieLeaf::~PatriciaTrieLeaf()
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf::~PatriciaTrieLeaf()
 	{
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieLeaf &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieLeaf::operator=(const PatriciaTrieLeaf & b)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf::Create(const CharacterType *str,const DataType &data)
 	{
-		if(this!=&b)
+		CharacterType terminator=Terminator;
+		size_t length=0;
+		if(str!=NULL)
 		{
-			BasePatriciaTrieNode::operator =(b);
-			m_data=b.m_data;
-			m_string=b.m_string;
+			while(CharCompareFunc(&str[length],&terminator)!=COMP_RESULT_EQUAL)
+				length++;
 		}
-		return *this;
+		void *block=EP_Malloc(sizeof(PatriciaTrieLeaf)+(length+1)*sizeof(CharacterType));
+		if(!block)
+			return NULL;
+		PatriciaTrieLeaf *leaf=::new(block) PatriciaTrieLeaf(data,length);
+		CharacterType *leafString=reinterpret_cast<CharacterType*>(leaf+1);
+		for(size_t trav=0;trav<length;trav++)
+		{
+			leafString[trav]=str[trav];
+		}
+		leafString[length]=terminator;
+		return leaf;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf::Create(const PatriciaTrieLeaf &b)
+	{
+		return Create(b.GetString(),b.m_data);
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf::Destroy(PatriciaTrieLeaf *leaf)
+	{
+		if(!leaf)
+			return;
+		leaf->~PatriciaTrieLeaf();
+		EP_Free(leaf);
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	const DataType &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieLeaf::GetData() const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	const DataType &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf::GetData() const
 	{
 		return m_data;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	DataType &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieLeaf::GetData()
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	DataType &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf::GetData()
 	{
 		return m_data;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieLeaf::SetData(const DataType &data)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf::SetData(const DataType &data)
 	{
 		m_data=data;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	const CharacterType *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieLeaf::GetString() const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	const CharacterType *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf::GetString() const
 	{
-		if(m_string.size())
-		{
-			return &m_string.at(0);
-		}
-		return NULL;
+		return reinterpret_cast<const CharacterType*>(this+1);
 	}
 
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	size_t PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf::GetLength() const
+	{
+		return m_length;
+	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieNode::PatriciaTrieNode(CharacterType c):BasePatriciaTrieNode(c)
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::PatriciaTrieNode(CharacterType c):BasePatriciaTrieNode(c)
 	{
-		m_terminator=Terminator;
+		m_childCount=0;
+		m_capacity=PATRICIA_TRIE_NODE_INLINE_COUNT;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieNode::PatriciaTrieNode(const PatriciaTrieNode &b):BasePatriciaTrieNode(b)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::PatriciaTrieNode(const PatriciaTrieNode &b):BasePatriciaTrieNode(b)
 	{
-		BasePatriciaTrieNode *tmpNode=NULL;
-		m_terminator=b.m_terminator;
-		for(int listTrav=0;listTrav<b.m_charList.size();listTrav++)
+		m_childCount=0;
+		m_capacity=PATRICIA_TRIE_NODE_INLINE_COUNT;
+		*this=b;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::~PatriciaTrieNode()
+	{
+		clear();
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::operator=(const PatriciaTrieNode & b)
+	{
+		if(this!=&b)
 		{
-			tmpNode=b.m_charList.at(listTrav);
-			if(tmpNode)
+			BasePatriciaTrieNode::operator =(b);
+			clear();
+			if(b.m_childCount>m_capacity && !resize(b.m_capacity))
+				return *this;
+			const CharacterType *bKeys=b.getKeys();
+			BasePatriciaTrieNode *const *bChildren=b.getChildren();
+			CharacterType *keys=getKeys();
+			BasePatriciaTrieNode **children=getChildren();
+			for(size_t trav=0;trav<b.m_childCount;trav++)
 			{
-				if(tmpNode->IsLeaf())
-				{
-					PatriciaTrieLeaf *node=EP_NEW PatriciaTrieLeaf(*static_cast<PatriciaTrieLeaf*>(tmpNode));
-					*node=*static_cast<PatriciaTrieLeaf*>(tmpNode);
-					m_charList.push_back(node);
-				}
-				else
-				{
-					PatriciaTrieNode *node=EP_NEW PatriciaTrieNode(*static_cast<PatriciaTrieNode*>(tmpNode));
-					*node=*static_cast<PatriciaTrieNode*>(tmpNode);
-					m_charList.push_back(node);
-				}
+				BasePatriciaTrieNode *node=BasePatriciaTrieNode::Clone(bChildren[trav]);
+				if(!node)
+					break;
+				keys[m_childCount]=bKeys[trav];
+				children[m_childCount]=node;
+				m_childCount++;
 			}
 		}
+		return *this;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	size_t PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::GetChildCount() const
+	{
+		return m_childCount;
+	}
 
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::GetChild(size_t idx) const
+	{
+		EP_ASSERT_EXPR(idx<m_childCount,_T("Index out of range! (idx: %d, count: %d)"),idx,m_childCount);
+		return getChildren()[idx];
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieNode::~PatriciaTrieNode()
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::AddNode(const CharacterType c)
 	{
-		BasePatriciaTrieNode *tmpNode=NULL;
-		for(int listTrav=0;listTrav<m_charList.size();listTrav++)
+		size_t retIdx;
+		if(findIndex(c,retIdx))
+			return NULL;
+		PatriciaTrieNode *newNode=EP_NEW PatriciaTrieNode(c);
+		if(!insertChild(retIdx,newNode))
 		{
-			tmpNode=m_charList.at(listTrav);
-			if(tmpNode)
-				EP_DELETE tmpNode;
-			tmpNode=NULL;
+			EP_DELETE newNode;
+			return NULL;
 		}
+		return newNode;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieNode &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieNode::operator=(const PatriciaTrieNode & b)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieLeaf *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::AddLeaf(const CharacterType *str,const DataType& data)
 	{
-		if(this!=&b)
+		size_t retIdx;
+		if(findIndex(Terminator,retIdx))
+			return NULL;
+		PatriciaTrieLeaf *newNode=PatriciaTrieLeaf::Create(str,data);
+		if(!newNode)
+			return NULL;
+		if(!insertChild(retIdx,newNode))
 		{
-			BasePatriciaTrieNode::operator =(b);
-			m_terminator=b.m_terminator;
-			BasePatriciaTrieNode *tmpNode=NULL;
-			for(int listTrav=0;listTrav<b.m_charList.size();listTrav++)
-			{
-				tmpNode=b.m_charList.at(listTrav);
-				if(tmpNode)
-				{
-					if(tmpNode->IsLeaf())
-					{
-						PatriciaTrieLeaf *node=EP_NEW PatriciaTrieLeaf(*static_cast<PatriciaTrieLeaf*>(tmpNode));
-						*node=*static_cast<PatriciaTrieLeaf*>(tmpNode);
-						m_charList.push_back(node);
-					}
-					else
-					{
-						PatriciaTrieNode *node=EP_NEW PatriciaTrieNode(*static_cast<PatriciaTrieNode*>(tmpNode));
-						*node=*static_cast<PatriciaTrieNode*>(tmpNode);
-						m_charList.push_back(node);
-					}
-				}
-			}
+			PatriciaTrieLeaf::Destroy(newNode);
+			return NULL;
 		}
-		return *this;
+		return newNode;
 	}
 
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::RemoveNode(CharacterType c)
+	{
+		size_t retIdx;
+		if(!findIndex(c,retIdx))
+			return false;
+		BasePatriciaTrieNode *existNode=getChildren()[retIdx];
+		if(!existNode->IsLeaf() && static_cast<PatriciaTrieNode*>(existNode)->GetChildCount()!=0)
+			return false;
+		BasePatriciaTrieNode::Destroy(existNode);
+		removeChild(retIdx);
+		return true;
+	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	const vector<typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::BasePatriciaTrieNode *> &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieNode::GetList() const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::operator[](const CharacterType &character)
 	{
-		return m_charList;	
+		size_t retIdx;
+		if(findIndex(character,retIdx))
+			return getChildren()[retIdx];
+		return NULL;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	vector<typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::BasePatriciaTrieNode *> &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieNode::GetList()
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	const typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::operator[](const CharacterType &character) const
 	{
-		return m_charList;	
+		size_t retIdx;
+		if(findIndex(character,retIdx))
+			return getChildren()[retIdx];
+		return NULL;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::BasePatriciaTrieNode *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieNode::AddNode(const CharacterType c)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::findIndex(const CharacterType &c,size_t &retIdx) const
 	{
-		if(m_charList.size())
+		const CharacterType *keys=getKeys();
+		CompResultType result;
+		if(m_childCount<=16)
 		{
-			int retIdx;
-			BasePatriciaTrieNode **existNode=BinarySearch(c,&(m_charList.at(0)),m_charList.size(),NodeCompareFunc,retIdx);
-			if(existNode)
-				return NULL;
-			else
+			// the characters fit in a few cache lines, so the linear scan is faster than the binary search
+			for(size_t trav=0;trav<m_childCount;trav++)
 			{
-				PatriciaTrieNode *newNode=EP_NEW PatriciaTrieNode(c);		
-				m_charList.insert(m_charList.begin()+retIdx,newNode);
-				return newNode;
+				result=CharCompareFunc(&c,&keys[trav]);
+				if(result!=COMP_RESULT_GREATERTHAN)
+				{
+					retIdx=trav;
+					return result==COMP_RESULT_EQUAL;
+				}
 			}
+			retIdx=m_childCount;
+			return false;
 		}
-		else
+
+		size_t low=0;
+		size_t high=m_childCount;
+		while(low<high)
 		{
-			PatriciaTrieNode *newNode=EP_NEW PatriciaTrieNode(c);
-			m_charList.push_back(newNode);
-			return newNode;
+			size_t mid=low+(high-low)/2;
+			result=CharCompareFunc(&c,&keys[mid]);
+			if(result==COMP_RESULT_EQUAL)
+			{
+				retIdx=mid;
+				return true;
+			}
+			if(result==COMP_RESULT_GREATERTHAN)
+				low=mid+1;
+			else
+				high=mid;
 		}
+		retIdx=low;
+		return false;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieLeaf *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieNode::AddLeaf(const CharacterType *str,const DataType& data)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::insertChild(size_t idx,BasePatriciaTrieNode *node)
 	{
-		if(m_charList.size())
+		if(m_childCount==m_capacity && !resize(nextCapacity(m_capacity)))
+			return false;
+		CharacterType *keys=getKeys();
+		BasePatriciaTrieNode **children=getChildren();
+		for(size_t trav=m_childCount;trav>idx;trav--)
 		{
-			int retIdx;
-			BasePatriciaTrieNode **existNode= BinarySearch(m_terminator,&(m_charList.at(0)),m_charList.size(),NodeCompareFunc,retIdx);
-			if(existNode)
-				return NULL;
-			else
-			{
-				PatriciaTrieLeaf *newNode=EP_NEW PatriciaTrieLeaf(str,data);		
-				m_charList.insert(m_charList.begin()+retIdx,newNode);
-				return newNode;
-			}
+			keys[trav]=keys[trav-1];
+			children[trav]=children[trav-1];
 		}
-		else
+		keys[idx]=node->GetCharacter();
+		children[idx]=node;
+		m_childCount++;
+		return true;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::removeChild(size_t idx)
+	{
+		CharacterType *keys=getKeys();
+		BasePatriciaTrieNode **children=getChildren();
+		for(size_t trav=idx+1;trav<m_childCount;trav++)
 		{
-			PatriciaTrieLeaf *newNode=EP_NEW PatriciaTrieLeaf(str,data);		
-			m_charList.push_back(newNode);
-			return newNode;
+			keys[trav-1]=keys[trav];
+			children[trav-1]=children[trav];
 		}
+		m_childCount--;
+		if(m_capacity>PATRICIA_TRIE_NODE_INLINE_COUNT && m_childCount<=prevCapacity(m_capacity)/2)
+			resize(prevCapacity(m_capacity));
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieNode::RemoveNode(CharacterType c)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::resize(size_t capacity)
 	{
-		if(m_charList.size())
+		EP_ASSERT(capacity>=m_childCount);
+		if(capacity<PATRICIA_TRIE_NODE_INLINE_COUNT)
+			capacity=PATRICIA_TRIE_NODE_INLINE_COUNT;
+		if(capacity==m_capacity)
+			return true;
+		void *oldBlock=NULL;
+		if(m_capacity>PATRICIA_TRIE_NODE_INLINE_COUNT)
+			oldBlock=m_block;
+		const CharacterType *oldKeys=getKeys();
+		BasePatriciaTrieNode *const *oldChildren=getChildren();
+
+		void *newBlock=NULL;
+		CharacterType *newKeys=m_inlineKeys;
+		BasePatriciaTrieNode **newChildren=m_inlineChildren;
+		if(capacity>PATRICIA_TRIE_NODE_INLINE_COUNT)
 		{
-			int retIdx;
-			BasePatriciaTrieNode **existNode= BinarySearch(c,&(m_charList.at(0)),m_charList.size(),PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::NodeCompareFunc,retIdx);
-			if(existNode)
-			{
-				if((*existNode)->IsLeaf())
-				{
-					EP_DELETE *existNode;
-					m_charList.erase(m_charList.begin()+retIdx);
-					return true;
-				}
-				else
-				{
-					PatriciaTrieNode *checkNode=static_cast<PatriciaTrieNode*>((*existNode));
-					if(checkNode->GetList().size()==0)
-					{
-						EP_DELETE *existNode;
-						m_charList.erase(m_charList.begin()+retIdx);
-						return true;
-					}
-				}
+			// the children and the characters share a single memory block
+			newBlock=EP_Malloc(capacity*(sizeof(BasePatriciaTrieNode*)+sizeof(CharacterType)));
+			if(!newBlock)
+				return false;
+			newChildren=reinterpret_cast<BasePatriciaTrieNode**>(newBlock);
+			newKeys=reinterpret_cast<CharacterType*>(newChildren+capacity);
+		}
+		// m_block shares its place with the inline children, so it is only set after the copy
+		for(size_t trav=0;trav<m_childCount;trav++)
+		{
+			newKeys[trav]=oldKeys[trav];
+			newChildren[trav]=oldChildren[trav];
+		}
+		if(oldBlock)
+			EP_Free(oldBlock);
+		if(newBlock)
+			m_block=newBlock;
+		m_capacity=(unsigned int)capacity;
+		return true;
+	}
 
-			}
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::clear()
+	{
+		BasePatriciaTrieNode **children=getChildren();
+		for(size_t trav=0;trav<m_childCount;trav++)
+		{
+			BasePatriciaTrieNode::Destroy(children[trav]);
+		}
+		m_childCount=0;
+		if(m_capacity>PATRICIA_TRIE_NODE_INLINE_COUNT)
+			EP_Free(m_block);
+		m_capacity=PATRICIA_TRIE_NODE_INLINE_COUNT;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	CharacterType *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::getKeys()
+	{
+		if(m_capacity>PATRICIA_TRIE_NODE_INLINE_COUNT)
+			return reinterpret_cast<CharacterType*>(reinterpret_cast<BasePatriciaTrieNode**>(m_block)+m_capacity);
+		return m_inlineKeys;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	const CharacterType *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::getKeys() const
+	{
+		if(m_capacity>PATRICIA_TRIE_NODE_INLINE_COUNT)
+			return reinterpret_cast<const CharacterType*>(reinterpret_cast<BasePatriciaTrieNode *const *>(m_block)+m_capacity);
+		return m_inlineKeys;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode **PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::getChildren()
+	{
+		if(m_capacity>PATRICIA_TRIE_NODE_INLINE_COUNT)
+			return reinterpret_cast<BasePatriciaTrieNode**>(m_block);
+		return m_inlineChildren;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::BasePatriciaTrieNode *const *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::getChildren() const
+	{
+		if(m_capacity>PATRICIA_TRIE_NODE_INLINE_COUNT)
+			return reinterpret_cast<BasePatriciaTrieNode *const *>(m_block);
+		return m_inlineChildren;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	size_t PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::nextCapacity(size_t capacity)
+	{
+		if(capacity<16)
+			return 16;
+		if(capacity<48)
+			return 48;
+		if(capacity<256)
+			return 256;
+		return capacity*2;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	size_t PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::prevCapacity(size_t capacity)
+	{
+		if(capacity>256)
+			return capacity/2;
+		if(capacity>48)
+			return 48;
+		if(capacity>16)
+			return 16;
+		return PATRICIA_TRIE_NODE_INLINE_COUNT;
+	}
 
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	size_t PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::PatriciaTrieNode::LowerBound(const CharacterType &c) const
+	{
+		size_t retIdx;
+		findIndex(c,retIdx);
+		return retIdx;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Cursor::Cursor():m_frames(),m_upperBound()
+	{
+		m_trie=NULL;
+		m_current=NULL;
+		m_hasUpperBound=false;
+		m_limit=0;
+		m_count=0;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Cursor::~Cursor()
+	{
+		Close();
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Cursor::Next()
+	{
+		m_current=NULL;
+		if(!m_trie)
+			return false;
+		if(m_limit && m_count>=m_limit)
+		{
+			Close();
+			return false;
+		}
+		while(!m_frames.empty())
+		{
+			CursorFrame &frame=m_frames.back();
+			if(frame.childIdx>=frame.node->GetChildCount())
+			{
+				m_frames.pop_back();
+				continue;
+			}
+			const BasePatriciaTrieNode *child=frame.node->GetChild(frame.childIdx);
+			frame.childIdx++;
+			if(child->IsLeaf())
+			{
+				const PatriciaTrieLeaf *leaf=static_cast<const PatriciaTrieLeaf*>(child);
+				if(!isBeforeUpperBound(leaf->GetString()))
+					break;
+				m_current=leaf;
+				m_count++;
+				return true;
+			}
+			CursorFrame newFrame;
+			newFrame.node=static_cast<const PatriciaTrieNode*>(child);
+			newFrame.childIdx=0;
+			m_frames.push_back(newFrame);
 		}
+		Close();
 		return false;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	typename PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::BasePatriciaTrieNode *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieNode::operator[](const CharacterType &character)
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	const CharacterType *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Cursor::GetString() const
+	{
+		EP_ASSERT_EXPR(m_current,_T("Cursor is not on a string!"));
+		return m_current->GetString();
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	const DataType &PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Cursor::GetData() const
+	{
+		EP_ASSERT_EXPR(m_current,_T("Cursor is not on a string!"));
+		return m_current->GetData();
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	size_t PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Cursor::GetCount() const
+	{
+		return m_count;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Cursor::IsOpen() const
 	{
-		if(m_charList.size())
+		return m_trie!=NULL;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Cursor::Close()
+	{
+		m_frames.clear();
+		m_upperBound.clear();
+		m_hasUpperBound=false;
+		if(m_trie)
 		{
-			int retIdx;
-			BasePatriciaTrieNode ** retNode=BinarySearch(character,&(m_charList.at(0)),m_charList.size(),NodeCompareFunc,retIdx);
-			if(retNode)
-				return *retNode;
+			m_trie->m_trieLock.UnlockShared();
+			m_trie=NULL;
 		}
-		return NULL;
 	}
 
-	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
-	typename const PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::BasePatriciaTrieNode *PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieNode::operator[](const CharacterType &character) const
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	void PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Cursor::open(const PatriciaTrie *trie,size_t limit)
 	{
-		if(m_charList.size())
+		trie->m_trieLock.LockShared();
+		m_trie=trie;
+		m_current=NULL;
+		m_limit=limit;
+		m_count=0;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *), typename LockType>
+	bool PatriciaTrie<CharacterType,DataType,Terminator,CharCompareFunc,LockType>::Cursor::isBeforeUpperBound(const CharacterType *str) const
+	{
+		if(!m_hasUpperBound)
+			return true;
+		for(size_t strTrav=0;strTrav<m_upperBound.size();strTrav++)
 		{
-			int retIdx;
-			BasePatriciaTrieNode ** retNode=BinarySearch(character,&(m_charList.at(0)),m_charList.size(),NodeCompareFunc,retIdx);
-			if(retNode)
-				return *retNode;
+			CompResultType result=CharCompareFunc(&str[strTrav],&m_upperBound[strTrav]);
+			if(result!=COMP_RESULT_EQUAL)
+				return result==COMP_RESULT_LESSTHAN;
+			if(CharCompareFunc(&str[strTrav],&m_trie->m_terminator)==COMP_RESULT_EQUAL)
+				break;
 		}
-		return NULL;
+		return false;
 	}
 }
 #endif //__EP_PATRICIA_TRIE_H__
@@ -0,0 +1,516 @@
+/*! 
+@file epPatriciaTrieImage.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief Patricia Trie Image Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Read-only Patricia Trie Image.
+
+*/
+#ifndef __EP_PATRICIA_TRIE_IMAGE_H__
+#define __EP_PATRICIA_TRIE_IMAGE_H__
+
+#include "epLib.h"
+#include "epSystem.h"
+#include "epBinarySearch.h"
+#include <vector>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif //!defined(_WIN32) && !defined(_WIN64)
+using namespace std;
+
+/// the magic number of the Patricia Trie image ("EPTI")
+#define PATRICIA_TRIE_IMAGE_MAGIC 0x49545045
+/// the version of the Patricia Trie image format
+#define PATRICIA_TRIE_IMAGE_VERSION 1
+/// the alignment of the records within the Patricia Trie image
+#define PATRICIA_TRIE_IMAGE_ALIGNMENT 8
+/// round up the given offset to the given alignment
+#define PATRICIA_TRIE_IMAGE_ALIGN(offset,alignment) (((offset)+(alignment)-1)&~((size_t)(alignment)-1))
+
+namespace epl
+{
+	/*! 
+	@struct PatriciaTrieImageHeader epPatriciaTrieImage.h
+	@brief The header at the start of the Patricia Trie image.
+
+	The image is a single read-only block without pointers, and all the offsets are from the start of the image.
+	Each node record consists of the child count, the offsets of the children and the sorted characters of the children.
+	The child with the terminator is a leaf record, which consists of the data, the length of the string and the string with the terminator.
+	All the records start at PATRICIA_TRIE_IMAGE_ALIGNMENT, and the root node is written last.
+	*/
+	struct PatriciaTrieImageHeader
+	{
+		/// the magic number (PATRICIA_TRIE_IMAGE_MAGIC)
+		unsigned int magic;
+		/// the version of the image format (PATRICIA_TRIE_IMAGE_VERSION)
+		unsigned int version;
+		/// the byte size of the character
+		unsigned int characterSize;
+		/// the byte size of the data
+		unsigned int dataSize;
+		/// the number of the strings
+		unsigned int count;
+		/// the offset of the root node
+		unsigned int rootOffset;
+		/// the byte size of the image
+		unsigned int imageSize;
+		/// reserved
+		unsigned int reserved;
+	};
+
+	/*! 
+	@class PatriciaTrieImage epPatriciaTrieImage.h
+	@brief A read-only Patricia Trie Template class which queries the image written by PatriciaTrie::WriteImage in place.
+
+	The image can be memory-mapped by LoadFromFile, so the pages are shared across the processes and loaded on demand,
+	or attached from the memory such as the buffer of Stream.
+	Since the image is never modified, the queries are processed concurrently without any lock.
+	@remark The template arguments must be the same as the PatriciaTrie which wrote the image,
+	        and DataType must be a plain data type without pointers since it is copied byte by byte.
+	*/
+	template<typename CharacterType, typename DataType , CharacterType Terminator=(CharacterType)0, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)=CompClass<CharacterType>::CompFunc>
+	class PatriciaTrieImage
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the empty Patricia Trie Image
+		*/
+		PatriciaTrieImage();
+
+		/*!
+		Default Destructor
+
+		Closes the Patricia Trie Image
+		*/
+		virtual ~PatriciaTrieImage();
+
+		/*!
+		Attach the given image in the memory
+		@param[in] image the pointer to the image (aligned to PATRICIA_TRIE_IMAGE_ALIGNMENT)
+		@param[in] imageSize the byte size of the memory holding the image
+		@remark the memory must be kept until the image is closed.
+		@return true if succeeded otherwise false
+		*/
+		bool Attach(const void *image,size_t imageSize);
+
+		/*!
+		Memory-map the image file read-only and attach it
+		@param[in] fileName the name of the image file
+		@return true if succeeded otherwise false
+		*/
+		bool LoadFromFile(const TCHAR *fileName);
+
+		/*!
+		Detach the image and unmap the image file if mapped
+		*/
+		void Close();
+
+		/*!
+		Check if the image is attached
+		@return true if the image is attached otherwise false
+		*/
+		bool IsOpen() const;
+
+		/*!
+		Find the given string from the image and return the data with the given string
+		@param[in] str The string value to find
+		@param[out] retData the data with the given string
+		@return true if succeeded otherwise false
+		*/
+		bool Find(const CharacterType* str, DataType &retData) const;
+
+		/*!
+		Find the all strings starting with given string from the image and return the string and data pairs
+		@param[in] str The string value to find
+		@param[out] retStrDataPairList the string and data pairs found (the strings point into the image)
+		@return true if succeeded otherwise false
+		*/
+		bool FindAll(const CharacterType* str, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList) const;
+
+		/*!
+		Check if the image is empty
+		@return true if the image is empty otherwise false
+		*/
+		bool IsEmpty() const;
+
+		/*!
+		return the number of element in the image.
+		@return the number of element in the image
+		*/
+		size_t Size() const;
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Cannot be Used.
+		*/
+		PatriciaTrieImage(const PatriciaTrieImage & b){EP_ASSERT(0);}
+
+		/*!
+		Assignment operator overloading
+
+		*Cannot be Used.
+		*/
+		PatriciaTrieImage &operator=(const PatriciaTrieImage & b){EP_ASSERT(0);return *this;}
+
+		/*!
+		Return the number of the children of the node at the given offset
+		@param[in] nodeOffset the offset of the node
+		@return the number of the children of the node
+		*/
+		unsigned int getChildCount(unsigned int nodeOffset) const;
+
+		/*!
+		Return the offsets of the children of the node at the given offset
+		@param[in] nodeOffset the offset of the node
+		@return the offsets of the children of the node
+		*/
+		const unsigned int *getChildOffsets(unsigned int nodeOffset) const;
+
+		/*!
+		Return the characters of the children of the node at the given offset
+		@param[in] nodeOffset the offset of the node
+		@return the sorted characters of the children of the node
+		*/
+		const CharacterType *getChildKeys(unsigned int nodeOffset) const;
+
+		/*!
+		Return the offset of the child with the given character
+		@param[in] nodeOffset the offset of the node
+		@param[in] c the character of the child
+		@remark returns 0 if the child does not exist.
+		@return the offset of the child with the given character
+		*/
+		unsigned int findChild(unsigned int nodeOffset,const CharacterType &c) const;
+
+		/*!
+		Return the data of the leaf at the given offset
+		@param[in] leafOffset the offset of the leaf
+		@return the data of the leaf
+		*/
+		const DataType &getLeafData(unsigned int leafOffset) const;
+
+		/*!
+		Return the string of the leaf at the given offset
+		@param[in] leafOffset the offset of the leaf
+		@return the string of the leaf
+		*/
+		const CharacterType *getLeafString(unsigned int leafOffset) const;
+
+		/// the image
+		const unsigned char *m_image;
+		/// the header of the image
+		const PatriciaTrieImageHeader *m_header;
+		/// String Terminator holder
+		CharacterType m_terminator;
+#if defined(_WIN32) || defined(_WIN64)
+		/// the handle of the image file mapped
+		HANDLE m_file;
+		/// the handle of the file mapping
+		HANDLE m_fileMapping;
+#else //defined(_WIN32) || defined(_WIN64)
+		/// the image file mapped
+		void *m_mappedImage;
+		/// the size of the image file mapped
+		size_t m_mappedSize;
+#endif //defined(_WIN32) || defined(_WIN64)
+	};
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::PatriciaTrieImage()
+	{
+		m_image=NULL;
+		m_header=NULL;
+		m_terminator=Terminator;
+#if defined(_WIN32) || defined(_WIN64)
+		m_file=INVALID_HANDLE_VALUE;
+		m_fileMapping=NULL;
+#else //defined(_WIN32) || defined(_WIN64)
+		m_mappedImage=NULL;
+		m_mappedSize=0;
+#endif //defined(_WIN32) || defined(_WIN64)
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::~PatriciaTrieImage()
+	{
+		Close();
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	bool PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::Attach(const void *image,size_t imageSize)
+	{
+		Close();
+		if(!image || imageSize<sizeof(PatriciaTrieImageHeader))
+			return false;
+		if(((size_t)image)%PATRICIA_TRIE_IMAGE_ALIGNMENT)
+			return false;
+		const PatriciaTrieImageHeader *header=reinterpret_cast<const PatriciaTrieImageHeader*>(image);
+		if(header->magic!=PATRICIA_TRIE_IMAGE_MAGIC || header->version!=PATRICIA_TRIE_IMAGE_VERSION)
+			return false;
+		if(header->characterSize!=sizeof(CharacterType) || header->dataSize!=sizeof(DataType))
+			return false;
+		if(header->imageSize>imageSize || header->rootOffset<sizeof(PatriciaTrieImageHeader) || header->rootOffset>=header->imageSize)
+			return false;
+		m_image=reinterpret_cast<const unsigned char*>(image);
+		m_header=header;
+		return true;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	bool PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::LoadFromFile(const TCHAR *fileName)
+	{
+		Close();
+#if defined(_WIN32) || defined(_WIN64)
+		HANDLE file=CreateFile(fileName,GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,NULL);
+		if(file==INVALID_HANDLE_VALUE)
+			return false;
+		LARGE_INTEGER fileSize;
+		if(!GetFileSizeEx(file,&fileSize) || fileSize.QuadPart<(LONGLONG)sizeof(PatriciaTrieImageHeader) || fileSize.QuadPart>(LONGLONG)0xFFFFFFFF)
+		{
+			CloseHandle(file);
+			return false;
+		}
+		HANDLE fileMapping=CreateFileMapping(file,NULL,PAGE_READONLY,0,0,NULL);
+		if(!fileMapping)
+		{
+			CloseHandle(file);
+			return false;
+		}
+		const void *image=MapViewOfFile(fileMapping,FILE_MAP_READ,0,0,0);
+		if(!image)
+		{
+			CloseHandle(fileMapping);
+			CloseHandle(file);
+			return false;
+		}
+		if(!Attach(image,(size_t)fileSize.QuadPart))
+		{
+			UnmapViewOfFile(image);
+			CloseHandle(fileMapping);
+			CloseHandle(file);
+			return false;
+		}
+		m_file=file;
+		m_fileMapping=fileMapping;
+		return true;
+#else //defined(_WIN32) || defined(_WIN64)
+		EpFile *file=NULL;
+		if(System::FTOpen(file,fileName,_T("rb"))!=0 || !file)
+			return false;
+		struct stat fileStat;
+		if(fstat(fileno(file),&fileStat)!=0 || fileStat.st_size<(off_t)sizeof(PatriciaTrieImageHeader) || (unsigned long long)fileStat.st_size>0xFFFFFFFFULL)
+		{
+			System::FClose(file);
+			return false;
+		}
+		// the mapping stays valid after the file is closed
+		void *image=mmap(NULL,(size_t)fileStat.st_size,PROT_READ,MAP_SHARED,fileno(file),0);
+		System::FClose(file);
+		if(image==MAP_FAILED)
+			return false;
+		if(!Attach(image,(size_t)fileStat.st_size))
+		{
+			munmap(image,(size_t)fileStat.st_size);
+			return false;
+		}
+		m_mappedImage=image;
+		m_mappedSize=(size_t)fileStat.st_size;
+		return true;
+#endif //defined(_WIN32) || defined(_WIN64)
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	void PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::Close()
+	{
+#if defined(_WIN32) || defined(_WIN64)
+		if(m_fileMapping)
+		{
+			UnmapViewOfFile(m_image);
+			CloseHandle(m_fileMapping);
+			m_fileMapping=NULL;
+		}
+		if(m_file!=INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(m_file);
+			m_file=INVALID_HANDLE_VALUE;
+		}
+#else //defined(_WIN32) || defined(_WIN64)
+		if(m_mappedImage)
+		{
+			munmap(m_mappedImage,m_mappedSize);
+			m_mappedImage=NULL;
+			m_mappedSize=0;
+		}
+#endif //defined(_WIN32) || defined(_WIN64)
+		m_image=NULL;
+		m_header=NULL;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	bool PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::IsOpen() const
+	{
+		return m_image!=NULL;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	bool PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::Find(const CharacterType* str, DataType &retData) const
+	{
+		if(str==NULL || m_image==NULL)
+			return false;
+		unsigned int nodeOffset=m_header->rootOffset;
+		for(size_t strTrav=0;;strTrav++)
+		{
+			nodeOffset=findChild(nodeOffset,str[strTrav]);
+			if(!nodeOffset)
+				return false;
+			if(CharCompareFunc(&str[strTrav],&m_terminator)==COMP_RESULT_EQUAL)
+			{
+				retData=getLeafData(nodeOffset);
+				return true;
+			}
+		}
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	bool PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::FindAll(const CharacterType* str, vector<Pair<const CharacterType*,DataType> > &retStrDataPairList) const
+	{
+		if(str==NULL || m_image==NULL)
+			return false;
+		unsigned int nodeOffset=m_header->rootOffset;
+		for(size_t strTrav=0;CharCompareFunc(&str[strTrav],&m_terminator)!=COMP_RESULT_EQUAL;strTrav++)
+		{
+			nodeOffset=findChild(nodeOffset,str[strTrav]);
+			if(!nodeOffset)
+				return false;
+		}
+
+		// visit the subtree in the order of the strings
+		// (the records are aligned, so the lowest bit of the offset marks the leaf)
+		size_t prevSize=retStrDataPairList.size();
+		vector<unsigned int> offsetStack;
+		offsetStack.push_back(nodeOffset);
+		while(!offsetStack.empty())
+		{
+			unsigned int offset=offsetStack.back();
+			offsetStack.pop_back();
+			if(offset&1)
+			{
+				Pair<const CharacterType*,DataType> newPair(getLeafString(offset&~1U),getLeafData(offset&~1U));
+				retStrDataPairList.push_back(newPair);
+				continue;
+			}
+			unsigned int childCount=getChildCount(offset);
+			const unsigned int *childOffsets=getChildOffsets(offset);
+			const CharacterType *childKeys=getChildKeys(offset);
+			for(unsigned int trav=childCount;trav>0;trav--)
+			{
+				if(CharCompareFunc(&childKeys[trav-1],&m_terminator)==COMP_RESULT_EQUAL)
+					offsetStack.push_back(childOffsets[trav-1]|1);
+				else
+					offsetStack.push_back(childOffsets[trav-1]);
+			}
+		}
+		return retStrDataPairList.size()>prevSize;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	bool PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::IsEmpty() const
+	{
+		return Size()==0;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	size_t PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::Size() const
+	{
+		if(!m_header)
+			return 0;
+		return m_header->count;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	unsigned int PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::getChildCount(unsigned int nodeOffset) const
+	{
+		return *reinterpret_cast<const unsigned int*>(m_image+nodeOffset);
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	const unsigned int *PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::getChildOffsets(unsigned int nodeOffset) const
+	{
+		return reinterpret_cast<const unsigned int*>(m_image+nodeOffset)+1;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	const CharacterType *PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::getChildKeys(unsigned int nodeOffset) const
+	{
+		return reinterpret_cast<const CharacterType*>(getChildOffsets(nodeOffset)+getChildCount(nodeOffset));
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	unsigned int PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::findChild(unsigned int nodeOffset,const CharacterType &c) const
+	{
+		size_t low=0;
+		size_t high=getChildCount(nodeOffset);
+		const CharacterType *childKeys=getChildKeys(nodeOffset);
+		while(low<high)
+		{
+			size_t mid=low+(high-low)/2;
+			CompResultType result=CharCompareFunc(&c,&childKeys[mid]);
+			if(result==COMP_RESULT_EQUAL)
+				return getChildOffsets(nodeOffset)[mid];
+			if(result==COMP_RESULT_GREATERTHAN)
+				low=mid+1;
+			else
+				high=mid;
+		}
+		return 0;
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	const DataType &PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::getLeafData(unsigned int leafOffset) const
+	{
+		return *reinterpret_cast<const DataType*>(m_image+leafOffset);
+	}
+
+	template<typename CharacterType, typename DataType , CharacterType Terminator, CompResultType (__cdecl *CharCompareFunc)(const void *,const void *)>
+	const CharacterType *PatriciaTrieImage<CharacterType,DataType,Terminator,CharCompareFunc>::getLeafString(unsigned int leafOffset) const
+	{
+		// the data, the length of the string and the string
+		return reinterpret_cast<const CharacterType*>(m_image+leafOffset+PATRICIA_TRIE_IMAGE_ALIGN(sizeof(DataType),sizeof(unsigned int))+sizeof(unsigned int));
+	}
+}
+
+#endif //__EP_PATRICIA_TRIE_IMAGE_H__
@@ -132,13 +132,11 @@ An Interface for the Platform Dependencies.
 
 #else //defined(_WIN32) || defined(_WIN64)
 
-#ifndef TCHAR
 #if defined(_UNICODE) || defined(UNICODE)
-typedef unsigned short TCHAR 
+typedef wchar_t TCHAR;
 #else// defined(_UNICODE) || defined(UNICODE)
-#define char TCHAR 
+typedef char TCHAR;
 #endif// defined(_UNICODE) || defined(UNICODE)
-#endif// TCHAR
 
 #ifndef _T
 #if defined(_UNICODE) || defined(UNICODE)
@@ -147,6 +145,52 @@ typedef unsigned short TCHAR
 #define _T(x) x
 #endif//defined(_UNICODE) || defined(UNICODE)
 #endif// _T(x)
+
+#include "epPlatformPosix.h"
+
+#endif //defined(_WIN32) || defined(_WIN64)
+
+namespace epl
+{
+	/*!
+	Load the given variable with the acquire semantics.
+
+	The loads and stores after this are not reordered before the load.
+	@param[in] target the variable to load
+	@return the value of the variable
+	@remark the variable must be a word or smaller to be loaded in one piece.
+	*/
+	template<typename ValueType>
+	inline ValueType LoadAcquire(ValueType const volatile *target)
+	{
+#if defined(_WIN32) || defined(_WIN64)
+		// the volatile read alone is acquire only with /volatile:ms, which is not the default on ARM
+		ValueType value=*target;
+		MemoryBarrier();
+		return value;
+#else //defined(_WIN32) || defined(_WIN64)
+		return __atomic_load_n(target,__ATOMIC_ACQUIRE);
+#endif //defined(_WIN32) || defined(_WIN64)
+	}
+
+	/*!
+	Store the given value to the given variable with the release semantics.
+
+	The loads and stores before this are not reordered after the store.
+	@param[in] target the variable to store to
+	@param[in] value the value to store
+	@remark the variable must be a word or smaller to be stored in one piece.
+	*/
+	template<typename ValueType>
+	inline void StoreRelease(ValueType volatile *target,ValueType value)
+	{
+#if defined(_WIN32) || defined(_WIN64)
+		MemoryBarrier();
+		*target=value;
+#else //defined(_WIN32) || defined(_WIN64)
+		__atomic_store_n(target,value,__ATOMIC_RELEASE);
 #endif //defined(_WIN32) || defined(_WIN64)
+	}
+}
 
 #endif //__EP_PLATFORM_H__
\ No newline at end of file
@@ -0,0 +1,654 @@
+/*! 
+@file epPlatformPosix.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief POSIX Platform Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for the POSIX Platform Dependencies.
+
+*/
+#ifndef __EP_PLATFORM_POSIX_H__
+#define __EP_PLATFORM_POSIX_H__
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <sched.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <wchar.h>
+#include <wctype.h>
+#include <ctype.h>
+#include <assert.h>
+#include <stddef.h>
+#include <limits.h>
+#include <stdint.h>
+
+/*!
+@def EP_PLATFORM_POSIX
+@brief Defined when the library is built on the POSIX platform (pthread backend)
+*/
+#define EP_PLATFORM_POSIX
+
+#define __int64 long long
+#define __forceinline inline __attribute__((always_inline))
+#define __declspec(x)
+#define __stdcall
+#define __cdecl
+#define WINAPI
+
+typedef int BOOL;
+#ifndef TRUE
+#define TRUE 1
+#endif //TRUE
+#ifndef FALSE
+#define FALSE 0
+#endif //FALSE
+
+typedef unsigned char BYTE;
+typedef unsigned char byte;
+typedef unsigned short WORD;
+typedef unsigned int UINT;
+typedef unsigned int DWORD;
+typedef long LONG;
+typedef long long LONGLONG;
+typedef unsigned long long ULONGLONG;
+typedef void *LPVOID;
+typedef void *HANDLE;
+typedef DWORD *LPDWORD;
+typedef unsigned long DWORD_PTR;
+typedef long LONG_PTR;
+typedef unsigned long ULONG_PTR;
+typedef DWORD (*LPTHREAD_START_ROUTINE)(LPVOID);
+typedef void (*PFLS_CALLBACK_FUNCTION)(LPVOID);
+typedef DWORD LCID;
+typedef int errno_t;
+
+/// Security attributes are ignored on the POSIX platform
+typedef struct _SECURITY_ATTRIBUTES
+{
+	DWORD nLength;
+	LPVOID lpSecurityDescriptor;
+	BOOL bInheritHandle;
+} SECURITY_ATTRIBUTES, *LPSECURITY_ATTRIBUTES;
+
+typedef union _LARGE_INTEGER
+{
+	struct
+	{
+		DWORD LowPart;
+		int HighPart;
+	} u;
+	LONGLONG QuadPart;
+} LARGE_INTEGER;
+
+typedef union _ULARGE_INTEGER
+{
+	struct
+	{
+		DWORD LowPart;
+		DWORD HighPart;
+	} u;
+	ULONGLONG QuadPart;
+} ULARGE_INTEGER;
+
+typedef struct _SYSTEM_INFO
+{
+	DWORD dwPageSize;
+	DWORD dwNumberOfProcessors;
+} SYSTEM_INFO;
+
+typedef struct _SYSTEMTIME
+{
+	WORD wYear;
+	WORD wMonth;
+	WORD wDayOfWeek;
+	WORD wDay;
+	WORD wHour;
+	WORD wMinute;
+	WORD wSecond;
+	WORD wMilliseconds;
+} SYSTEMTIME;
+
+typedef struct _FILETIME
+{
+	DWORD dwLowDateTime;
+	DWORD dwHighDateTime;
+} FILETIME;
+
+#define WAIT_OBJECT_0 0x00000000L
+#define WAIT_ABANDONED 0x00000080L
+#define WAIT_TIMEOUT 0x00000102L
+#define WAIT_FAILED 0xFFFFFFFFL
+#define INFINITE 0xFFFFFFFF
+
+#define CREATE_SUSPENDED 0x00000004
+
+#define THREAD_PRIORITY_IDLE (-15)
+#define THREAD_PRIORITY_LOWEST (-2)
+#define THREAD_PRIORITY_BELOW_NORMAL (-1)
+#define THREAD_PRIORITY_NORMAL 0
+#define THREAD_PRIORITY_ABOVE_NORMAL 1
+#define THREAD_PRIORITY_HIGHEST 2
+#define THREAD_PRIORITY_TIME_CRITICAL 15
+#define THREAD_PRIORITY_ERROR_RETURN 0x7fffffff
+
+#define LOCALE_USER_DEFAULT 0x0400
+
+#define TLS_OUT_OF_INDEXES ((DWORD)0xFFFFFFFF)
+#define FLS_OUT_OF_INDEXES ((DWORD)0xFFFFFFFF)
+
+#define CP_ACP 0
+#define CP_UTF8 65001
+
+#define _TRUNCATE ((size_t)-1)
+
+#ifndef _ASSERT
+#define _ASSERT(expr) assert(expr)
+#endif //_ASSERT
+
+// Interlocked functions (full barrier as on Windows)
+
+inline long InterlockedIncrement(volatile long *addend)
+{
+	return __atomic_add_fetch(addend,1,__ATOMIC_SEQ_CST);
+}
+inline long InterlockedDecrement(volatile long *addend)
+{
+	return __atomic_sub_fetch(addend,1,__ATOMIC_SEQ_CST);
+}
+inline long InterlockedExchange(volatile long *target,long value)
+{
+	return __atomic_exchange_n(target,value,__ATOMIC_SEQ_CST);
+}
+inline long InterlockedExchangeAdd(volatile long *addend,long value)
+{
+	return __atomic_fetch_add(addend,value,__ATOMIC_SEQ_CST);
+}
+inline long InterlockedCompareExchange(volatile long *destination,long exchange,long comparand)
+{
+	__atomic_compare_exchange_n(destination,&comparand,exchange,false,__ATOMIC_SEQ_CST,__ATOMIC_SEQ_CST);
+	return comparand;
+}
+inline long long InterlockedIncrement64(volatile long long *addend)
+{
+	return __atomic_add_fetch(addend,1,__ATOMIC_SEQ_CST);
+}
+inline long long InterlockedDecrement64(volatile long long *addend)
+{
+	return __atomic_sub_fetch(addend,1,__ATOMIC_SEQ_CST);
+}
+inline long long InterlockedExchange64(volatile long long *target,long long value)
+{
+	return __atomic_exchange_n(target,value,__ATOMIC_SEQ_CST);
+}
+inline long long InterlockedExchangeAdd64(volatile long long *addend,long long value)
+{
+	return __atomic_fetch_add(addend,value,__ATOMIC_SEQ_CST);
+}
+inline long long InterlockedCompareExchange64(volatile long long *destination,long long exchange,long long comparand)
+{
+	__atomic_compare_exchange_n(destination,&comparand,exchange,false,__ATOMIC_SEQ_CST,__ATOMIC_SEQ_CST);
+	return comparand;
+}
+inline void *InterlockedExchangePointer(void * volatile *target,void *value)
+{
+	return __atomic_exchange_n(target,value,__ATOMIC_SEQ_CST);
+}
+inline void *InterlockedCompareExchangePointer(void * volatile *destination,void *exchange,void *comparand)
+{
+	__atomic_compare_exchange_n(destination,&comparand,exchange,false,__ATOMIC_SEQ_CST,__ATOMIC_SEQ_CST);
+	return comparand;
+}
+#define MemoryBarrier() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#if defined(__i386__) || defined(__x86_64__)
+#define YieldProcessor() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define YieldProcessor() __asm__ __volatile__("yield")
+#else
+#define YieldProcessor() ((void)0)
+#endif
+
+// Thread and time functions
+
+inline BOOL SwitchToThread()
+{
+	return sched_yield()==0;
+}
+inline void Sleep(DWORD milliSec)
+{
+	if(milliSec==0)
+	{
+		sched_yield();
+		return;
+	}
+	struct timespec req;
+	req.tv_sec=milliSec/1000;
+	req.tv_nsec=(long)(milliSec%1000)*1000000L;
+	while(nanosleep(&req,&req)!=0 && errno==EINTR)
+		;
+}
+DWORD GetCurrentThreadId();
+DWORD GetCurrentProcessId();
+DWORD GetTickCount();
+BOOL QueryPerformanceCounter(LARGE_INTEGER *retCount);
+BOOL QueryPerformanceFrequency(LARGE_INTEGER *retFrequency);
+void GetSystemInfo(SYSTEM_INFO *retSystemInfo);
+void GetLocalTime(SYSTEMTIME *retSystemTime);
+void GetSystemTime(SYSTEMTIME *retSystemTime);
+BOOL SystemTimeToFileTime(const SYSTEMTIME *systemTime,FILETIME *retFileTime);
+BOOL FileTimeToSystemTime(const FILETIME *fileTime,SYSTEMTIME *retSystemTime);
+inline DWORD GetLastError()
+{
+	return (DWORD)errno;
+}
+inline void SetLastError(DWORD errCode)
+{
+	errno=(int)errCode;
+}
+
+/*!
+Fill the timespec with the absolute CLOCK_REALTIME time after given milli-seconds (for the pthread timed waits)
+@param[in] milliSec the time from now
+@param[out] retTime the absolute time
+*/
+void EpGetAbsTimeAfter(unsigned long milliSec,struct timespec *retTime);
+
+/*!
+Initialize the given pthread mutex as the recursive mutex (as the critical section and the mutex on Windows)
+@param[in] mutex the mutex to initialize
+*/
+void EpInitRecursiveMutex(pthread_mutex_t *mutex);
+
+// Waitable objects
+//
+// The mutex, event, semaphore and thread handles are emulated with the pthread mutex and condition variable,
+// so the classes built on them keep the same semantics as on Windows.
+// The named objects are shared within the process only.
+
+HANDLE CreateMutexA(LPSECURITY_ATTRIBUTES mutexAttributes,BOOL isInitialOwner,const char *name);
+HANDLE CreateMutexW(LPSECURITY_ATTRIBUTES mutexAttributes,BOOL isInitialOwner,const wchar_t *name);
+BOOL ReleaseMutex(HANDLE mutex);
+HANDLE CreateEventA(LPSECURITY_ATTRIBUTES eventAttributes,BOOL isManualReset,BOOL isInitialState,const char *name);
+HANDLE CreateEventW(LPSECURITY_ATTRIBUTES eventAttributes,BOOL isManualReset,BOOL isInitialState,const wchar_t *name);
+BOOL SetEvent(HANDLE event);
+BOOL ResetEvent(HANDLE event);
+HANDLE CreateSemaphoreA(LPSECURITY_ATTRIBUTES semaphoreAttributes,LONG initialCount,LONG maximumCount,const char *name);
+HANDLE CreateSemaphoreW(LPSECURITY_ATTRIBUTES semaphoreAttributes,LONG initialCount,LONG maximumCount,const wchar_t *name);
+BOOL ReleaseSemaphore(HANDLE semaphore,LONG releaseCount,LONG *retPreviousCount);
+BOOL CloseHandle(HANDLE object);
+DWORD WaitForSingleObject(HANDLE object,DWORD milliSec);
+
+// Threads
+
+HANDLE CreateThread(LPSECURITY_ATTRIBUTES threadAttributes,size_t stackSize,LPTHREAD_START_ROUTINE startAddress,LPVOID parameter,DWORD creationFlags,LPDWORD retThreadId);
+uintptr_t _beginthreadex(void *security,unsigned int stackSize,unsigned int (*startAddress)(void *),void *argList,unsigned int initFlag,unsigned int *retThreadId);
+DWORD ResumeThread(HANDLE thread);
+DWORD SuspendThread(HANDLE thread);
+BOOL TerminateThread(HANDLE thread,DWORD exitCode);
+BOOL GetExitCodeThread(HANDLE thread,LPDWORD retExitCode);
+BOOL SetThreadPriority(HANDLE thread,int priority);
+int GetThreadPriority(HANDLE thread);
+DWORD_PTR SetThreadAffinityMask(HANDLE thread,DWORD_PTR threadAffinityMask);
+DWORD GetCurrentProcessorNumber();
+HANDLE GetCurrentThread();
+HANDLE GetCurrentProcess();
+BOOL GetThreadTimes(HANDLE thread,FILETIME *retCreationTime,FILETIME *retExitTime,FILETIME *retKernelTime,FILETIME *retUserTime);
+BOOL GetProcessTimes(HANDLE process,FILETIME *retCreationTime,FILETIME *retExitTime,FILETIME *retKernelTime,FILETIME *retUserTime);
+
+// Thread local storage
+
+inline DWORD TlsAlloc()
+{
+	pthread_key_t key;
+	if(pthread_key_create(&key,NULL)!=0)
+		return TLS_OUT_OF_INDEXES;
+	return (DWORD)key;
+}
+inline BOOL TlsFree(DWORD tlsIndex)
+{
+	return pthread_key_delete((pthread_key_t)tlsIndex)==0;
+}
+inline LPVOID TlsGetValue(DWORD tlsIndex)
+{
+	return pthread_getspecific((pthread_key_t)tlsIndex);
+}
+inline BOOL TlsSetValue(DWORD tlsIndex,LPVOID tlsValue)
+{
+	return pthread_setspecific((pthread_key_t)tlsIndex,tlsValue)==0;
+}
+
+// Fiber local storage
+//
+// Without fibers, the callback is called with the non-NULL value when the thread exits,
+// and before the thread object is signaled for the threads created by CreateThread as on Windows.
+
+DWORD FlsAlloc(PFLS_CALLBACK_FUNCTION callback);
+BOOL FlsFree(DWORD flsIndex);
+LPVOID FlsGetValue(DWORD flsIndex);
+BOOL FlsSetValue(DWORD flsIndex,LPVOID flsValue);
+
+// Aligned allocation
+
+inline void *_aligned_malloc(size_t size,size_t alignment)
+{
+	void *retPtr=NULL;
+	if(alignment<sizeof(void*))
+		alignment=sizeof(void*);
+	if(posix_memalign(&retPtr,alignment,size)!=0)
+		return NULL;
+	return retPtr;
+}
+inline void _aligned_free(void *memblock)
+{
+	free(memblock);
+}
+
+// Date and time formatting (the format of the C locale is used, the locale and the flags are ignored)
+
+int GetDateFormatA(LCID locale,DWORD flags,const SYSTEMTIME *date,const char *format,char *retDateStr,int dateLength);
+int GetDateFormatW(LCID locale,DWORD flags,const SYSTEMTIME *date,const wchar_t *format,wchar_t *retDateStr,int dateLength);
+int GetTimeFormatA(LCID locale,DWORD flags,const SYSTEMTIME *time,const char *format,char *retTimeStr,int timeLength);
+int GetTimeFormatW(LCID locale,DWORD flags,const SYSTEMTIME *time,const wchar_t *format,wchar_t *retTimeStr,int timeLength);
+
+// String conversion functions
+
+int MultiByteToWideChar(UINT codePage,DWORD flags,const char *multiByteStr,int multiByteLength,wchar_t *retWideCharStr,int wideCharLength);
+int WideCharToMultiByte(UINT codePage,DWORD flags,const wchar_t *wideCharStr,int wideCharLength,char *retMultiByteStr,int multiByteLength,const char *defaultChar,BOOL *retUsedDefaultChar);
+inline BOOL IsDBCSLeadByte(BYTE testChar)
+{
+	// UTF-8 lead or trail byte
+	return (testChar&0x80)!=0;
+}
+void OutputDebugStringA(const char *outputString);
+void OutputDebugStringW(const wchar_t *outputString);
+
+// Secure CRT functions
+
+inline errno_t memcpy_s(void *dest,size_t destSize,const void *src,size_t count)
+{
+	if(count==0)
+		return 0;
+	if(dest==NULL || src==NULL || destSize<count)
+		return EINVAL;
+	memcpy(dest,src,count);
+	return 0;
+}
+inline errno_t memmove_s(void *dest,size_t destSize,const void *src,size_t count)
+{
+	if(count==0)
+		return 0;
+	if(dest==NULL || src==NULL || destSize<count)
+		return EINVAL;
+	memmove(dest,src,count);
+	return 0;
+}
+errno_t strcpy_s(char *dest,size_t destSize,const char *src);
+errno_t strcat_s(char *dest,size_t destSize,const char *src);
+errno_t strncpy_s(char *dest,size_t destSize,const char *src,size_t count);
+errno_t wcscpy_s(wchar_t *dest,size_t destSize,const wchar_t *src);
+errno_t wcscat_s(wchar_t *dest,size_t destSize,const wchar_t *src);
+errno_t wcsncpy_s(wchar_t *dest,size_t destSize,const wchar_t *src,size_t count);
+inline char *strtok_s(char *token,const char *delimiters,char **context)
+{
+	return strtok_r(token,delimiters,context);
+}
+inline wchar_t *wcstok_s(wchar_t *token,const wchar_t *delimiters,wchar_t **context)
+{
+	return wcstok(token,delimiters,context);
+}
+inline int stricmp(const char *str1,const char *str2)
+{
+	return strcasecmp(str1,str2);
+}
+inline int _stricmp(const char *str1,const char *str2)
+{
+	return strcasecmp(str1,str2);
+}
+inline int _wcsicmp(const wchar_t *str1,const wchar_t *str2)
+{
+	return wcscasecmp(str1,str2);
+}
+
+inline int _mbsicmp(const unsigned char *str1,const unsigned char *str2)
+{
+	return strcasecmp(reinterpret_cast<const char*>(str1),reinterpret_cast<const char*>(str2));
+}
+inline int _mbscmp(const unsigned char *str1,const unsigned char *str2)
+{
+	return strcmp(reinterpret_cast<const char*>(str1),reinterpret_cast<const char*>(str2));
+}
+inline unsigned char *_mbscpy(unsigned char *dest,const unsigned char *src)
+{
+	return reinterpret_cast<unsigned char*>(strcpy(reinterpret_cast<char*>(dest),reinterpret_cast<const char*>(src)));
+}
+inline const unsigned char *_mbsstr(const unsigned char *source,const unsigned char *subString)
+{
+	return reinterpret_cast<const unsigned char*>(strstr(reinterpret_cast<const char*>(source),reinterpret_cast<const char*>(subString)));
+}
+inline errno_t _mbscat_s(unsigned char *dest,size_t destSize,const unsigned char *src)
+{
+	return strcat_s(reinterpret_cast<char*>(dest),destSize,reinterpret_cast<const char*>(src));
+}
+inline errno_t _mbsncpy_s(unsigned char *dest,size_t destSize,const unsigned char *src,size_t count)
+{
+	return strncpy_s(reinterpret_cast<char*>(dest),destSize,reinterpret_cast<const char*>(src),count);
+}
+inline unsigned char *_mbstok_s(unsigned char *token,const unsigned char *delimiters,unsigned char **context)
+{
+	return reinterpret_cast<unsigned char*>(strtok_r(reinterpret_cast<char*>(token),reinterpret_cast<const char*>(delimiters),reinterpret_cast<char**>(context)));
+}
+
+// the va_list is copied, since the callers reuse the given va_list after the call
+inline int _vscprintf(const char *format,va_list args)
+{
+	va_list argsCopy;
+	va_copy(argsCopy,args);
+	int retVal=vsnprintf(NULL,0,format,argsCopy);
+	va_end(argsCopy);
+	return retVal;
+}
+int _vscwprintf(const wchar_t *format,va_list args);
+inline int _scprintf(const char *format,...)
+{
+	va_list args;
+	va_start(args,format);
+	int retVal=vsnprintf(NULL,0,format,args);
+	va_end(args);
+	return retVal;
+}
+int _scwprintf(const wchar_t *format,...);
+inline int vprintf_s(const char *format,va_list args)
+{
+	va_list argsCopy;
+	va_copy(argsCopy,args);
+	int retVal=vprintf(format,argsCopy);
+	va_end(argsCopy);
+	return retVal;
+}
+inline int vwprintf_s(const wchar_t *format,va_list args)
+{
+	va_list argsCopy;
+	va_copy(argsCopy,args);
+	int retVal=vwprintf(format,argsCopy);
+	va_end(argsCopy);
+	return retVal;
+}
+inline int vsprintf_s(char *dest,size_t destSize,const char *format,va_list args)
+{
+	va_list argsCopy;
+	va_copy(argsCopy,args);
+	int retVal=vsnprintf(dest,destSize,format,argsCopy);
+	va_end(argsCopy);
+	if(retVal>=(int)destSize)
+		return -1;
+	return retVal;
+}
+inline int vswprintf_s(wchar_t *dest,size_t destSize,const wchar_t *format,va_list args)
+{
+	va_list argsCopy;
+	va_copy(argsCopy,args);
+	int retVal=vswprintf(dest,destSize,format,argsCopy);
+	va_end(argsCopy);
+	return retVal;
+}
+inline int sprintf_s(char *dest,size_t destSize,const char *format,...)
+{
+	va_list args;
+	va_start(args,format);
+	int retVal=vsprintf_s(dest,destSize,format,args);
+	va_end(args);
+	return retVal;
+}
+inline int swprintf_s(wchar_t *dest,size_t destSize,const wchar_t *format,...)
+{
+	va_list args;
+	va_start(args,format);
+	int retVal=vswprintf(dest,destSize,format,args);
+	va_end(args);
+	return retVal;
+}
+inline errno_t fopen_s(FILE **retFile,const char *fileName,const char *mode)
+{
+	*retFile=fopen(fileName,mode);
+	return *retFile?0:errno;
+}
+errno_t _wfopen_s(FILE **retFile,const wchar_t *fileName,const wchar_t *mode);
+errno_t _strdate_s(char *buffer,size_t numberOfElements);
+errno_t _strtime_s(char *buffer,size_t numberOfElements);
+errno_t _wstrdate_s(wchar_t *buffer,size_t numberOfElements);
+errno_t _wstrtime_s(wchar_t *buffer,size_t numberOfElements);
+
+// TCHAR mapping
+
+#if defined(_UNICODE) || defined(UNICODE)
+#define CreateMutex CreateMutexW
+#define CreateEvent CreateEventW
+#define CreateSemaphore CreateSemaphoreW
+#define GetDateFormat GetDateFormatW
+#define GetTimeFormat GetTimeFormatW
+#define OutputDebugString OutputDebugStringW
+#define _tcslen wcslen
+#define _tcscmp wcscmp
+#define _tcsicmp _wcsicmp
+#define _tcscpy wcscpy
+#define _tcsstr wcsstr
+#define _tcschr wcschr
+#define _tcsrchr wcsrchr
+#define _tcscat_s wcscat_s
+#define _tcscpy_s wcscpy_s
+#define _tcsncpy_s wcsncpy_s
+#define _tcstok_s wcstok_s
+#define _tcstol wcstol
+#define _tcstoul wcstoul
+#define _tcstod wcstod
+#define _ttoi(str) ((int)wcstol(str,NULL,10))
+#define _stscanf swscanf
+#define _vtprintf_s vwprintf_s
+#define _vstprintf_s vswprintf_s
+#define _vsctprintf _vscwprintf
+#define _sctprintf _scwprintf
+#define _stprintf_s swprintf_s
+#define _vftprintf vfwprintf
+#define _tfopen_s _wfopen_s
+#define _tstrdate_s _wstrdate_s
+#define _tstrtime_s _wstrtime_s
+#define _istalnum iswalnum
+#define _istalpha iswalpha
+#define _istcntrl iswcntrl
+#define _istdigit iswdigit
+#define _istgraph iswgraph
+#define _istlower iswlower
+#define _istpunct iswpunct
+#define _istupper iswupper
+#define _istxdigit iswxdigit
+#define _istspace iswspace
+#define _istprint iswprint
+#define _totlower towlower
+#define _totupper towupper
+#else// defined(_UNICODE) || defined(UNICODE)
+#define CreateMutex CreateMutexA
+#define CreateEvent CreateEventA
+#define CreateSemaphore CreateSemaphoreA
+#define GetDateFormat GetDateFormatA
+#define GetTimeFormat GetTimeFormatA
+#define OutputDebugString OutputDebugStringA
+#define _tcslen strlen
+#define _tcscmp strcmp
+#define _tcsicmp strcasecmp
+#define _tcscpy strcpy
+#define _tcsstr strstr
+#define _tcschr strchr
+#define _tcsrchr strrchr
+#define _tcscat_s strcat_s
+#define _tcscpy_s strcpy_s
+#define _tcsncpy_s strncpy_s
+#define _tcstok_s strtok_s
+#define _tcstol strtol
+#define _tcstoul strtoul
+#define _tcstod strtod
+#define _ttoi atoi
+#define _stscanf sscanf
+#define _vtprintf_s vprintf_s
+#define _vstprintf_s vsprintf_s
+#define _vsctprintf _vscprintf
+#define _sctprintf _scprintf
+#define _stprintf_s sprintf_s
+#define _vftprintf vfprintf
+#define _tfopen_s fopen_s
+#define _tstrdate_s _strdate_s
+#define _tstrtime_s _strtime_s
+#define _istalnum isalnum
+#define _istalpha isalpha
+#define _istcntrl iscntrl
+#define _istdigit isdigit
+#define _istgraph isgraph
+#define _istlower islower
+#define _istpunct ispunct
+#define _istupper isupper
+#define _istxdigit isxdigit
+#define _istspace isspace
+#define _istprint isprint
+#define _totlower tolower
+#define _totupper toupper
+#endif// defined(_UNICODE) || defined(UNICODE)
+
+#endif //!defined(_WIN32) && !defined(_WIN64)
+
+#endif //__EP_PLATFORM_POSIX_H__
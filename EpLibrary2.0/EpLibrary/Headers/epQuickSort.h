@@ -55,6 +55,17 @@ namespace epl
 		QSORT_MODE_LOOP
 	}QSortMode;
 
+	template<typename T>
+	inline void subQuickSortRecursive(T* sortList, size_t low, size_t high,CompResultType (__cdecl *SortFunc)(const void * , const void *), ssize_t minSize);
+	template<typename T>
+	inline size_t partitionWrapper(T* sortList, size_t low, size_t high,CompResultType (__cdecl *SortFunc)(const void * , const void *));
+	template<typename T>
+	inline size_t medianLocation(T* sortList, size_t i, size_t j, size_t k,CompResultType (__cdecl *SortFunc)(const void * , const void *));
+	template<typename T>
+	inline size_t partition(T* sortList, size_t low, size_t high, T &pivot,CompResultType (__cdecl *SortFunc)(const void * , const void *));
+	template<typename T>
+	inline void subQuickSortLoop(T* sortList, size_t iLow, size_t iHigh,CompResultType (__cdecl *SortFunc)(const void *,const void *),ssize_t minSize);
+
 
 	/*!
 	Template Quick Sort Function
@@ -104,7 +115,7 @@ namespace epl
 	{
 		if(high>low+1)
 		{
-			if((high-low)+1<=minSize)
+			if((high-low)+1<=(size_t)minSize)
 			{
 				InsertionSort<T>(sortList,low,high,SortFunc);
 			}
@@ -236,7 +247,7 @@ namespace epl
 
 			if(currentSnaptshot.high>currentSnaptshot.low+1)
 			{
-				if((currentSnaptshot.high-currentSnaptshot.low)+1<=minSize)
+				if((currentSnaptshot.high-currentSnaptshot.low)+1<=(size_t)minSize)
 				{
 					InsertionSort<T>(sortList,currentSnaptshot.low,currentSnaptshot.high,SortFunc);
 				}
@@ -247,19 +258,23 @@ namespace epl
 					size_t k=currentSnaptshot.high;
 					size_t medLoc;
 					if (SortFunc(&sortList[i] , &sortList[j])<COMP_RESULT_GREATERTHAN)
+					{
 						if (SortFunc(&sortList[j] , &sortList[k])<COMP_RESULT_GREATERTHAN)
 							medLoc=j;
 						else if (SortFunc(&sortList[i] , &sortList[k])<COMP_RESULT_GREATERTHAN)
 							medLoc=k;
 						else
 							medLoc=i;
+					}
 					else // sortList[j] < sortList[i]
+					{
 						if (SortFunc(&sortList[i] , &sortList[k])<COMP_RESULT_GREATERTHAN)
 							medLoc=i;
 						else if (SortFunc(&sortList[j] , &sortList[k])<COMP_RESULT_GREATERTHAN)
 							medLoc=k;
 						else
 							medLoc=j;
+					}
 
 						T tmp;
 						tmp=sortList[currentSnaptshot.low];
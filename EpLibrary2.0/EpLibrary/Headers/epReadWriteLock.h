@@ -0,0 +1,167 @@
+/*! 
+@file epReadWriteLock.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief ReadWriteLock Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Reader-Writer Lock Class.
+
+*/
+#ifndef __EP_READ_WRITE_LOCK_H__
+#define __EP_READ_WRITE_LOCK_H__
+#include "epLib.h"
+#include "epSystem.h"
+#include "epBaseLock.h"
+#include "epCriticalSectionEx.h"
+#include "epEventEx.h"
+
+namespace epl
+{
+	/*! 
+	@class ReadWriteLock epReadWriteLock.h
+	@brief A class that handles the reader-writer lock functionality.
+
+	Lock/Unlock obtain the exclusive (writer) access, and LockShared/UnlockShared obtain the shared (reader) access.
+	Once a writer is waiting, the new readers wait until the writer is done (writer-preferring).
+	@remark The exclusive access is recursive, but the shared access is not recursive
+	        (a reader locking the shared access again while a writer is waiting will deadlock),
+	        and the thread holding the exclusive access must not lock the shared access.
+	*/
+	class EP_LIBRARY ReadWriteLock :public BaseLock
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the lock
+		*/
+		ReadWriteLock();
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the ReadWriteLock
+		@param[in] b the second object
+		*/
+		ReadWriteLock(const ReadWriteLock& b);
+
+		/*!
+		Default Destructor
+
+		Deletes the lock
+		*/
+		virtual ~ReadWriteLock();
+
+		/*!	
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		*/
+		ReadWriteLock & operator=(const ReadWriteLock&b);
+
+		/*!
+		Locks for the exclusive access
+		@return true if locked, false otherwise
+		*/
+		virtual bool Lock();
+
+		/*!
+		Try to Lock for the exclusive access
+
+		If other thread holds the lock, it just returns false and continue, otherwise obtain the exclusive access.
+		@return true if the lock is succeeded, otherwise false.
+		*/
+		virtual long TryLock();
+
+		/*!
+		Locks for the exclusive access
+
+		if other thread holds the lock,
+		and if it fails to lock in given time, it returns false, otherwise lock and return true.
+		@param[in] dwMilliSecond the wait time.
+		@return true if the lock is succeeded, otherwise false.
+		*/
+		virtual long TryLockFor(const unsigned int dwMilliSecond);
+
+		/*!
+		Leave the exclusive access
+
+		The Lock and Unlock has to be matched.
+		*/
+		virtual void Unlock();
+
+		/*!
+		Locks for the shared access
+		@return true if locked, false otherwise
+		*/
+		virtual bool LockShared();
+
+		/*!
+		Try to Lock for the shared access
+
+		If other thread holds or waits for the exclusive access, it just returns false and continue, otherwise obtain the shared access.
+		@return true if the lock is succeeded, otherwise false.
+		*/
+		virtual long TryLockShared();
+
+		/*!
+		Leave the shared access
+
+		The LockShared and UnlockShared has to be matched.
+		*/
+		virtual void UnlockShared();
+
+	private:
+		/*!
+		Mark the writer and block the new readers.
+		*/
+		void beginWrite();
+
+		/*!
+		Unmark the writer and release the readers waiting.
+		*/
+		void endWrite();
+
+		/// the number of readers holding the lock, and the writer flag
+		volatile long m_state;
+		/// the recursion count of the writer holding the lock
+		int m_writerRecursion;
+		/// the lock between the writers
+		CriticalSectionEx m_writerLock;
+		/// the event raised when the last reader leaves while a writer waits (auto reset)
+		EventEx m_noReaderEvent;
+		/// the event raised while no writer holds or waits for the lock (manual reset)
+		EventEx m_writerDoneEvent;
+	};
+
+}
+
+#endif //__EP_READ_WRITE_LOCK_H__
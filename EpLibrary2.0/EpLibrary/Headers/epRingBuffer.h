@@ -0,0 +1,471 @@
+/*! 
+@file epRingBuffer.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief RingBuffer Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for growable power-of-two Ring Buffer.
+
+*/
+#ifndef __EP_RING_BUFFER_H__
+#define __EP_RING_BUFFER_H__
+#include "epLib.h"
+#include "epSystem.h"
+#include "epMemory.h"
+#include <new>
+
+namespace epl
+{
+	/*!
+	@class RingBuffer epRingBuffer.h
+	@brief A template class for growable Ring Buffer.
+
+	The capacity is always power of two, so the index wrapping is done by masking.
+	Push/Pop at the both end are O(1), and Insert/Erase in the middle moves the smaller side only.
+	This class is NOT thread safe.
+	*/
+	template <typename DataType>
+	class RingBuffer
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Ring Buffer
+		@param[in] initialCapacity The initial capacity of the buffer (rounded up to power of two)
+		*/
+		RingBuffer(size_t initialCapacity=0);
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the Ring Buffer
+		@param[in] b the second object
+		*/
+		RingBuffer(const RingBuffer& b);
+
+		/*!
+		Default Destructor
+
+		Destroys the Ring Buffer
+		*/
+		virtual ~RingBuffer();
+
+		/*!
+		Assignment Operator Overloading
+
+		the RingBuffer set as given RingBuffer b
+		@param[in] b right side of RingBuffer
+		@return this object
+		*/
+		RingBuffer & operator=(const RingBuffer&b);
+
+		/*!
+		Check if the buffer is empty.
+		@return true if the buffer is empty, otherwise false.
+		*/
+		bool IsEmpty() const
+		{
+			return m_size==0;
+		}
+
+		/*!
+		Return the number of elements in the buffer.
+		@return the number of elements in the buffer.
+		*/
+		size_t Size() const
+		{
+			return m_size;
+		}
+
+		/*!
+		Return the allocated capacity of the buffer.
+		@return the allocated capacity of the buffer.
+		*/
+		size_t GetCapacity() const
+		{
+			return m_capacity;
+		}
+
+		/*!
+		Make sure the buffer can hold at least given number of elements without reallocation.
+		@param[in] capacity the number of elements to reserve.
+		*/
+		void Reserve(size_t capacity);
+
+		/*!
+		Return the element at the given index from the front.
+		@param[in] idx The index to return the element.
+		@return the element at the given index.
+		*/
+		DataType &At(size_t idx)
+		{
+			EP_ASSERT(idx<m_size);
+			return *slot(idx);
+		}
+
+		/*!
+		Return the element at the given index from the front.
+		@param[in] idx The index to return the element.
+		@return the element at the given index.
+		*/
+		const DataType &At(size_t idx) const
+		{
+			EP_ASSERT(idx<m_size);
+			return *slot(idx);
+		}
+
+		/*!
+		Return the element at the given index from the front.
+		@param[in] idx The index to return the element.
+		@return the element at the given index.
+		*/
+		DataType &operator[](size_t idx)
+		{
+			return At(idx);
+		}
+
+		/*!
+		Return the element at the given index from the front.
+		@param[in] idx The index to return the element.
+		@return the element at the given index.
+		*/
+		const DataType &operator[](size_t idx) const
+		{
+			return At(idx);
+		}
+
+		/*!
+		Return the first element of the buffer.
+		@return the first element of the buffer.
+		*/
+		DataType &Front()
+		{
+			return At(0);
+		}
+
+		/*!
+		Return the last element of the buffer.
+		@return the last element of the buffer.
+		*/
+		DataType &Back()
+		{
+			return At(m_size-1);
+		}
+
+		/*!
+		Append the given data at the end of the buffer.
+		@param[in] data The data to append.
+		*/
+		void PushBack(const DataType &data);
+
+		/*!
+		Insert the given data at the front of the buffer.
+		@param[in] data The data to insert.
+		*/
+		void PushFront(const DataType &data);
+
+		/*!
+		Remove the first element of the buffer.
+		*/
+		void PopFront();
+
+		/*!
+		Remove the last element of the buffer.
+		*/
+		void PopBack();
+
+		/*!
+		Insert the given data at the given index.
+		@param[in] idx The index to insert the data. (0 ~ Size())
+		@param[in] data The data to insert.
+		*/
+		void Insert(size_t idx, const DataType &data);
+
+		/*!
+		Erase the element at the given index.
+		@param[in] idx The index of the element to erase.
+		*/
+		void Erase(size_t idx);
+
+		/*!
+		Remove all the elements.
+		(Does Not Free the memory)
+		*/
+		void Clear();
+
+	private:
+		/*!
+		Return the pointer to the slot of given logical index.
+		@param[in] idx the logical index from the front.
+		@return the pointer to the slot.
+		*/
+		DataType *slot(size_t idx) const
+		{
+			return m_buffer+((m_head+idx)&(m_capacity-1));
+		}
+
+		/*!
+		Grow the buffer to hold at least given number of elements.
+		@param[in] capacity the number of elements required.
+		*/
+		void grow(size_t capacity);
+
+		/*!
+		Destroy all elements and free the buffer.
+		*/
+		void deleteBuffer();
+
+		/// the actual buffer
+		DataType *m_buffer;
+		/// the capacity of the buffer (power of two)
+		size_t m_capacity;
+		/// the physical index of the first element
+		size_t m_head;
+		/// the number of elements
+		size_t m_size;
+	};
+
+	template <typename DataType>
+	RingBuffer<DataType>::RingBuffer(size_t initialCapacity)
+	{
+		m_buffer=NULL;
+		m_capacity=0;
+		m_head=0;
+		m_size=0;
+		if(initialCapacity)
+			grow(initialCapacity);
+	}
+
+	template <typename DataType>
+	RingBuffer<DataType>::RingBuffer(const RingBuffer& b)
+	{
+		m_buffer=NULL;
+		m_capacity=0;
+		m_head=0;
+		m_size=0;
+		if(b.m_size)
+		{
+			grow(b.m_size);
+			for(size_t trav=0;trav<b.m_size;trav++)
+			{
+				new(m_buffer+trav) DataType(*b.slot(trav));
+			}
+			m_size=b.m_size;
+		}
+	}
+
+	template <typename DataType>
+	RingBuffer<DataType>::~RingBuffer()
+	{
+		deleteBuffer();
+	}
+
+	template <typename DataType>
+	RingBuffer<DataType> &RingBuffer<DataType>::operator=(const RingBuffer& b)
+	{
+		if(this!=&b)
+		{
+			Clear();
+			Reserve(b.m_size);
+			for(size_t trav=0;trav<b.m_size;trav++)
+			{
+				new(m_buffer+trav) DataType(*b.slot(trav));
+			}
+			m_head=0;
+			m_size=b.m_size;
+		}
+		return *this;
+	}
+
+	template <typename DataType>
+	void RingBuffer<DataType>::Reserve(size_t capacity)
+	{
+		if(m_capacity<capacity)
+			grow(capacity);
+	}
+
+	template <typename DataType>
+	void RingBuffer<DataType>::grow(size_t capacity)
+	{
+		size_t newCapacity=(m_capacity)?m_capacity:16;
+		while(newCapacity<capacity)
+			newCapacity<<=1;
+
+		DataType *newBuffer=reinterpret_cast<DataType*>(EP_Malloc(sizeof(DataType)*newCapacity));
+		EP_ASSERT(newBuffer);
+		for(size_t trav=0;trav<m_size;trav++)
+		{
+			DataType *elem=slot(trav);
+			new(newBuffer+trav) DataType(*elem);
+			elem->~DataType();
+		}
+		if(m_buffer)
+			EP_Free(m_buffer);
+		m_buffer=newBuffer;
+		m_capacity=newCapacity;
+		m_head=0;
+	}
+
+	template <typename DataType>
+	void RingBuffer<DataType>::deleteBuffer()
+	{
+		Clear();
+		if(m_buffer)
+			EP_Free(m_buffer);
+		m_buffer=NULL;
+		m_capacity=0;
+		m_head=0;
+	}
+
+	template <typename DataType>
+	void RingBuffer<DataType>::Clear()
+	{
+		for(size_t trav=0;trav<m_size;trav++)
+		{
+			slot(trav)->~DataType();
+		}
+		m_head=0;
+		m_size=0;
+	}
+
+	template <typename DataType>
+	void RingBuffer<DataType>::PushBack(const DataType &data)
+	{
+		if(m_size==m_capacity)
+		{
+			// data might be one of our own elements
+			DataType copy(data);
+			grow(m_size+1);
+			new(slot(m_size)) DataType(copy);
+		}
+		else
+		{
+			new(slot(m_size)) DataType(data);
+		}
+		m_size++;
+	}
+
+	template <typename DataType>
+	void RingBuffer<DataType>::PushFront(const DataType &data)
+	{
+		if(m_size==m_capacity)
+		{
+			// data might be one of our own elements
+			DataType copy(data);
+			grow(m_size+1);
+			m_head=(m_head-1)&(m_capacity-1);
+			new(slot(0)) DataType(copy);
+		}
+		else
+		{
+			m_head=(m_head-1)&(m_capacity-1);
+			new(slot(0)) DataType(data);
+		}
+		m_size++;
+	}
+
+	template <typename DataType>
+	void RingBuffer<DataType>::PopFront()
+	{
+		EP_ASSERT(m_size);
+		slot(0)->~DataType();
+		m_head=(m_head+1)&(m_capacity-1);
+		m_size--;
+	}
+
+	template <typename DataType>
+	void RingBuffer<DataType>::PopBack()
+	{
+		EP_ASSERT(m_size);
+		slot(m_size-1)->~DataType();
+		m_size--;
+	}
+
+	template <typename DataType>
+	void RingBuffer<DataType>::Insert(size_t idx, const DataType &data)
+	{
+		EP_ASSERT(idx<=m_size);
+		if(idx==0)
+		{
+			PushFront(data);
+			return;
+		}
+		if(idx==m_size)
+		{
+			PushBack(data);
+			return;
+		}
+
+		DataType copy(data);
+		if(m_size==m_capacity)
+			grow(m_size+1);
+
+		if(idx<m_size-idx)
+		{
+			// shift the front part to the left
+			m_head=(m_head-1)&(m_capacity-1);
+			new(slot(0)) DataType(*slot(1));
+			for(size_t trav=1;trav<idx;trav++)
+				*slot(trav)=*slot(trav+1);
+		}
+		else
+		{
+			// shift the back part to the right
+			new(slot(m_size)) DataType(*slot(m_size-1));
+			for(size_t trav=m_size-1;trav>idx;trav--)
+				*slot(trav)=*slot(trav-1);
+		}
+		*slot(idx)=copy;
+		m_size++;
+	}
+
+	template <typename DataType>
+	void RingBuffer<DataType>::Erase(size_t idx)
+	{
+		EP_ASSERT(idx<m_size);
+		if(idx<m_size-idx-1)
+		{
+			// shift the front part to the right
+			for(size_t trav=idx;trav>0;trav--)
+				*slot(trav)=*slot(trav-1);
+			PopFront();
+		}
+		else
+		{
+			// shift the back part to the left
+			for(size_t trav=idx;trav<m_size-1;trav++)
+				*slot(trav)=*slot(trav+1);
+			PopBack();
+		}
+	}
+}
+#endif //__EP_RING_BUFFER_H__
@@ -0,0 +1,157 @@
+/*! 
+@file epRuntimeLock.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief RuntimeLock Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Runtime Lock Holder.
+
+*/
+#ifndef __EP_RUNTIME_LOCK_H__
+#define __EP_RUNTIME_LOCK_H__
+#include "epLib.h"
+#include "epSystem.h"
+#include "epBaseLock.h"
+#include "epStaticLock.h"
+
+namespace epl
+{
+	/*! 
+	@class RuntimeLock epRuntimeLock.h
+	@brief A class that holds the lock chosen by the lock policy at the runtime.
+
+	The default lock type template argument of the containers, which keeps the behavior of the LockPolicy given to the constructor.
+	For LOCK_POLICY_READWRITE, ReadWriteLock is used.
+	@remark StaticLock or NullLock can be given instead to decide the lock at the compile time.
+	*/
+	class EP_LIBRARY RuntimeLock
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Initializes without the lock until Reset is called
+		*/
+		RuntimeLock();
+
+		/*!
+		Default Constructor
+
+		Initializes the lock with the given lock policy
+		@param[in] lockPolicyType The lock policy
+		*/
+		RuntimeLock(LockPolicy lockPolicyType);
+
+		/*!
+		Default Destructor
+
+		Deletes the lock
+		*/
+		~RuntimeLock();
+
+		/*!
+		Delete the current lock and create the new lock with the given lock policy
+		@param[in] lockPolicyType The lock policy
+		*/
+		void Reset(LockPolicy lockPolicyType);
+
+		/*!
+		Locks the lock
+		@return true if locked, false otherwise
+		*/
+		bool Lock()
+		{
+			if(m_lock)
+				return m_lock->Lock();
+			return false;
+		}
+
+		/*!
+		Try to Lock the lock
+		@return true if the lock is succeeded, otherwise false.
+		*/
+		long TryLock()
+		{
+			if(m_lock)
+				return m_lock->TryLock();
+			return 0;
+		}
+
+		/*!
+		Leave the lock
+		*/
+		void Unlock()
+		{
+			if(m_lock)
+				m_lock->Unlock();
+		}
+
+		/*!
+		Locks the lock for the shared access
+		@return true if locked, false otherwise
+		*/
+		bool LockShared()
+		{
+			if(m_lock)
+				return m_lock->LockShared();
+			return false;
+		}
+
+		/*!
+		Leave the shared access of the lock
+		*/
+		void UnlockShared()
+		{
+			if(m_lock)
+				m_lock->UnlockShared();
+		}
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Cannot be Used.
+		*/
+		RuntimeLock(const RuntimeLock & /*b*/){EP_ASSERT(0);}
+
+		/*!
+		Assignment operator overloading
+
+		*Cannot be Used.
+		*/
+		RuntimeLock &operator=(const RuntimeLock & /*b*/){EP_ASSERT(0);return *this;}
+
+		/// the lock
+		BaseLock *m_lock;
+	};
+}
+
+#endif //__EP_RUNTIME_LOCK_H__
@@ -39,6 +39,7 @@ An Interface for the Template Singleton Holder.
 #define __EP_SINGLETON_HOLDER_H__
 
 #include "epLib.h"
+#include "epCriticalSectionEx.h"
 
 namespace epl
 {
@@ -94,6 +95,12 @@ namespace epl
 	template<typename SingletonClass>
 	SingletonClass &SingletonHolder<SingletonClass>::Instance()
 	{
+		// the pointer is statically initialized, so the callers after the construction do not take the lock
+		static SingletonClass * volatile s_instance=NULL;
+		// the pointer is loaded with the acquire semantics, so the holder is seen fully constructed
+		SingletonClass *instance=LoadAcquire(&s_instance);
+		if(instance)
+			return *instance;
 #if (EP_LOCK_POLICY==LOCK_POLICY_CRITICALSECTION)
 		static CriticalSectionEx m_lock;
 #elif (EP_LOCK_POLICY==LOCK_POLICY_MUTEX)
@@ -103,6 +110,8 @@ namespace epl
 #endif //(EP_LOCK_POLICY==LOCK_POLICY_CRITICALSECTION)
 		LockObj lock(&m_lock);
 		static SingletonClass holder;
+		// publish after the construction with the release barrier of the interlocked operation
+		InterlockedExchangePointer(reinterpret_cast<void * volatile *>(&s_instance),&holder);
 		return holder;
 
 	}
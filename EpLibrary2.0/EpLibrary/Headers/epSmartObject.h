@@ -53,6 +53,7 @@ namespace epl
 	@brief This is a base class for Smart Object Classes  
 
 	Implements the System Functions.
+	The reference count is updated with the interlocked operations, so no lock is taken and allocated per object.
 	*/
 	class EP_LIBRARY SmartObject
 	{
@@ -61,6 +62,7 @@ namespace epl
 		Assignment operator overloading
 		@param[in] b the second object
 		@return the new copied object
+		@remark the reference count is not copied.
 		*/
 		SmartObject & operator=(const SmartObject&b);
 
@@ -70,8 +72,7 @@ namespace epl
 		*/
 		int GetReferenceCount()
 		{
-			LockObj lock(m_refCounterLock);
-			return m_refCount;
+			return (int)m_refCount;
 		}
 
 
@@ -91,6 +92,7 @@ namespace epl
 		/*!
 		Default Contructor
 		@param[in] lockPolicyType The lock policy
+		@remark the lock policy is kept for the compatibility, and the reference count is always updated atomically.
 		*/
 		SmartObject(LockPolicy lockPolicyType=EP_LOCK_POLICY);
 		 
@@ -111,9 +113,9 @@ namespace epl
 		*/
 		void RetainObj(TCHAR *fileName, TCHAR *funcName, unsigned int lineNum)
 		{
-			LockObj lock(m_refCounterLock);
-			m_refCount++;
-			//LOG_THIS_MSG(_T("%s::%s(%d) Retained Object : %d (Current Reference Count = %d)"),fileName,funcName,lineNum,this, this->m_refCount);
+			long refCount=InterlockedIncrement(&m_refCount);
+			//LOG_THIS_MSG(_T("%s::%s(%d) Retained Object : %d (Current Reference Count = %d)"),fileName,funcName,lineNum,this, refCount);
+			(void)refCount;
 		}
 
 		/*!
@@ -122,46 +124,27 @@ namespace epl
 		*/
 		void ReleaseObj(TCHAR *fileName, TCHAR *funcName, unsigned int lineNum)
 		{
-			m_refCounterLock->Lock();
-			m_refCount--;
-			//LOG_THIS_MSG(_T("%s::%s(%d) Released Object : %d (Current Reference Count = %d)"),fileName,funcName,lineNum,this, this->m_refCount);
-			if(m_refCount==0)
+			long refCount=InterlockedDecrement(&m_refCount);
+			//LOG_THIS_MSG(_T("%s::%s(%d) Released Object : %d (Current Reference Count = %d)"),fileName,funcName,lineNum,this, refCount);
+			if(refCount==0)
 			{
-				m_refCount++; // this increment is dummy addition to make pair with destructor.
-				m_refCounterLock->Unlock();
-				EP_DELETE this;
+				m_refCount=1; // this increment is dummy addition to make pair with destructor.
+				deleteObj();
 				return;
 			}
-			EP_ASSERT_EXPR(m_refCount>=0, _T("Reference Count is negative Value! Reference Count : %d"),m_refCount);
-			m_refCounterLock->Unlock();
-
+			EP_ASSERT_EXPR(refCount>=0, _T("Reference Count is negative Value! Reference Count : %d"),refCount);
 		}
 
 	protected:
 		/*!
 		Default Contructor
 		@param[in] lockPolicyType The lock policy
+		@remark the lock policy is kept for the compatibility, and the reference count is always updated atomically.
 		*/
 		SmartObject(TCHAR *fileName, TCHAR *funcName, unsigned int lineNum,LockPolicy lockPolicyType=EP_LOCK_POLICY)
 		{
 			m_refCount=1;
 			//LOG_THIS_MSG(_T("%s::%s(%d) Allocated Object : %d (Current Reference Count = %d)"),fileName,funcName,lineNum,this, this->m_refCount);
-			m_lockPolicy=lockPolicyType;
-			switch(lockPolicyType)
-			{
-			case LOCK_POLICY_CRITICALSECTION:
-				m_refCounterLock=EP_NEW CriticalSectionEx();
-				break;
-			case LOCK_POLICY_MUTEX:
-				m_refCounterLock=EP_NEW Mutex();
-				break;
-			case LOCK_POLICY_NONE:
-				m_refCounterLock=EP_NEW NoLock();
-				break;
-			default:
-				m_refCounterLock=NULL;
-				break;
-			}
 		}
 
 		/*!
@@ -172,22 +155,6 @@ namespace epl
 		{
 			m_refCount=1;
 			//LOG_THIS_MSG(_T("%s::%s(%d) Allocated Object : %d (Current Reference Count = %d)"),fileName,funcName,lineNum,this, this->m_refCount);
-			m_lockPolicy=b.m_lockPolicy;
-			switch(m_lockPolicy)
-			{
-			case LOCK_POLICY_CRITICALSECTION:
-				m_refCounterLock=EP_NEW CriticalSectionEx();
-				break;
-			case LOCK_POLICY_MUTEX:
-				m_refCounterLock=EP_NEW Mutex();
-				break;
-			case LOCK_POLICY_NONE:
-				m_refCounterLock=EP_NEW NoLock();
-				break;
-			default:
-				m_refCounterLock=NULL;
-				break;
-			}
 		}
 
 		/*!
@@ -195,28 +162,27 @@ namespace epl
 		*/
 		virtual ~SmartObject()
 		{
-			m_refCounterLock->Lock();
-			m_refCount--;
-			m_refCounterLock->Unlock();
-			//LOG_THIS_MSG(_T("Deleted Object : %d (Current Reference Count = %d)"),this, this->m_refCount);
-			EP_ASSERT_EXPR(m_refCount==0,_T("The Reference Count is not 0!! Reference Count : %d"),m_refCount);
-			if(m_refCounterLock)
-			{
-				EP_DELETE m_refCounterLock;
-			}
+			long refCount=InterlockedDecrement(&m_refCount);
+			//LOG_THIS_MSG(_T("Deleted Object : %d (Current Reference Count = %d)"),this, refCount);
+			EP_ASSERT_EXPR(refCount==0,_T("The Reference Count is not 0!! Reference Count : %d"),refCount);
+			(void)refCount;
 		}
 	#endif //!defined(_DEBUG)
 
+		/*!
+		Called when the reference count reaches 0 to dispose this object.
+		@remark This deletes the object by default.
+		        Subclass can override this to recycle the object instead, and the reference count is 1 again when this is called.
+		*/
+		virtual void deleteObj()
+		{
+			EP_DELETE this;
+		}
 
-		
 	private:
 
 		/// Reference Counter
-		int m_refCount;
-		/// Lock
-		BaseLock *m_refCounterLock;
-		/// Lock Policy
-		LockPolicy m_lockPolicy;
+		volatile long m_refCount;
 	};
 #if defined(_DEBUG)
 #define SmartObject(...) SmartObject(__TFILE__,__TFUNCTION__,__LINE__,__VA_ARGS__)
@@ -224,4 +190,4 @@ namespace epl
 #define RetainObj() RetainObj(__TFILE__,__TFUNCTION__,__LINE__)
 #endif//defined(_DEBUG)
 }
-#endif //__EP_SMART_OBJECT_H__
\ No newline at end of file
+#endif //__EP_SMART_OBJECT_H__
\ No newline at end of file
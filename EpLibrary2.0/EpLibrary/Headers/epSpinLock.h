@@ -0,0 +1,160 @@
+/*! 
+@file epSpinLock.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief SpinLock Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Adaptive Spin-then-block Lock.
+
+*/
+#ifndef __EP_SPIN_LOCK_H__
+#define __EP_SPIN_LOCK_H__
+#include "epLib.h"
+#include "epSystem.h"
+#include "epBaseLock.h"
+#include "epEventEx.h"
+
+/*!
+@def SPIN_LOCK_DEFAULT_SPIN_COUNT
+@brief Default number of the PAUSE spins before the SpinLock parks the thread
+*/
+#define SPIN_LOCK_DEFAULT_SPIN_COUNT 4000
+
+/*!
+@def SPIN_LOCK_MAX_BACKOFF
+@brief Maximum number of the PAUSE between two polls of the SpinLock
+*/
+#define SPIN_LOCK_MAX_BACKOFF 64
+
+namespace epl
+{
+	/*!
+	@class SpinLock epSpinLock.h
+	@brief A class that handles the adaptive spin-then-block lock.
+
+	The waiting thread polls the lock with the plain read (test-and-test-and-set),
+	doubling the PAUSE between the polls, and parks on the event once the spin count is used up.
+	The event is only signaled by Unlock when some thread is parked, so the uncontended Lock/Unlock
+	is a single interlocked operation each.
+	@remark The lock is NOT recursive.
+	*/
+	class EP_LIBRARY SpinLock :public BaseLock
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the lock.
+		@param[in] spinCount the number of the PAUSE spins before parking the thread
+		*/
+		SpinLock(unsigned int spinCount=SPIN_LOCK_DEFAULT_SPIN_COUNT);
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the SpinLock
+		@param[in] b the second object
+		*/
+		SpinLock(const SpinLock& b);
+
+		/*!
+		Default Destructor
+
+		Deletes the lock
+		*/
+		virtual ~SpinLock();
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		*/
+		SpinLock & operator=(const SpinLock&b);
+
+		/*!
+		Locks the Critical Section
+		@return true if locked, false otherwise
+		*/
+		virtual bool Lock();
+
+		/*!
+		Try to Lock the Critical Section
+
+		If other thread is already in the Critical Section, it just returns false and continue, otherwise obtain the Critical Section.
+		@return true if the lock is succeeded, otherwise false.
+		*/
+		virtual long TryLock();
+
+		/*!
+		Locks the Critical Section
+
+		if other thread is already in the Critical Section,
+		and if it fails to lock in given time, it returns false, otherwise lock and return true.
+		@param[in] dwMilliSecond the wait time.
+		@return true if the lock is succeeded, otherwise false.
+		*/
+		virtual long TryLockFor(const unsigned int dwMilliSecond);
+
+		/*!
+		Leave the Critical Section
+
+		The Lock and Unlock has to be matched for each Critical Section.
+		*/
+		virtual void Unlock();
+
+		/*!
+		Return the spin count
+		@return the number of the PAUSE spins before parking the thread
+		*/
+		unsigned int GetSpinCount() const;
+
+	private:
+		/*!
+		Spin with the exponential backoff until the lock is obtained or the spin count is used up
+		@return true if the lock is obtained, otherwise false.
+		*/
+		bool spin();
+
+		/// lock state (0: free, 1: locked, 2: locked and some thread may be parked)
+		volatile long m_state;
+		/// the number of the PAUSE spins before parking
+		unsigned int m_spinCount;
+		/// auto-reset event where the threads park
+		EventEx m_parkEvent;
+#if defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+		/// thread ID that currently holding this lock
+		volatile unsigned long m_threadID;
+#endif //defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	};
+
+}
+
+#endif //__EP_SPIN_LOCK_H__
@@ -0,0 +1,322 @@
+/*! 
+@file epStaticLock.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief StaticLock Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Compile-time Lock Types.
+
+*/
+#ifndef __EP_STATIC_LOCK_H__
+#define __EP_STATIC_LOCK_H__
+#include "epLib.h"
+#include "epSystem.h"
+#include "epBaseLock.h"
+
+namespace epl
+{
+	/*! 
+	@class StaticLock epStaticLock.h
+	@brief A template class that holds the lock of the given type by value.
+
+	Used as the lock type template argument of the containers (i.e. DynamicArray<int,StaticLock<CriticalSectionEx> >),
+	so the lock is chosen at the compile time without the heap allocation,
+	and the lock calls are made on the object of the known type.
+	@remark The lock policy given to the container is ignored.
+	*/
+	template<typename LockType>
+	class StaticLock
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the lock
+		*/
+		StaticLock():m_lock()
+		{
+		}
+
+		/*!
+		Reset the lock with the given lock policy
+
+		*Does nothing since the lock is decided at the compile time.
+		@param[in] lockPolicyType The lock policy
+		*/
+		void Reset(LockPolicy /*lockPolicyType*/)
+		{
+		}
+
+		/*!
+		Locks the lock
+		@return true if locked, false otherwise
+		*/
+		bool Lock()
+		{
+			return m_lock.Lock();
+		}
+
+		/*!
+		Try to Lock the lock
+		@return true if the lock is succeeded, otherwise false.
+		*/
+		long TryLock()
+		{
+			return m_lock.TryLock();
+		}
+
+		/*!
+		Leave the lock
+		*/
+		void Unlock()
+		{
+			m_lock.Unlock();
+		}
+
+		/*!
+		Locks the lock for the shared access
+		@return true if locked, false otherwise
+		*/
+		bool LockShared()
+		{
+			return m_lock.LockShared();
+		}
+
+		/*!
+		Leave the shared access of the lock
+		*/
+		void UnlockShared()
+		{
+			m_lock.UnlockShared();
+		}
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Cannot be Used.
+		*/
+		StaticLock(const StaticLock & b){EP_ASSERT(0);}
+
+		/*!
+		Assignment operator overloading
+
+		*Cannot be Used.
+		*/
+		StaticLock &operator=(const StaticLock & b){EP_ASSERT(0);return *this;}
+
+		/// the lock
+		LockType m_lock;
+	};
+
+	/*! 
+	@class NullLock epStaticLock.h
+	@brief A class that does not lock at all.
+
+	Used as the lock type template argument of the containers (i.e. DynamicArray<int,NullLock>) for the single thread,
+	so all the lock calls are inlined to nothing.
+	@remark The lock policy given to the container is ignored.
+	*/
+	class NullLock
+	{
+	public:
+		/*!
+		Default Constructor
+		*/
+		NullLock()
+		{
+		}
+
+		/*!
+		Reset the lock with the given lock policy
+
+		*Does nothing.
+		@param[in] lockPolicyType The lock policy
+		*/
+		void Reset(LockPolicy /*lockPolicyType*/)
+		{
+		}
+
+		/*!
+		Does nothing
+		@return true always.
+		*/
+		bool Lock()
+		{
+			return true;
+		}
+
+		/*!
+		Does nothing
+		@return true always.
+		*/
+		long TryLock()
+		{
+			return 1;
+		}
+
+		/*!
+		Does nothing
+		*/
+		void Unlock()
+		{
+		}
+
+		/*!
+		Does nothing
+		@return true always.
+		*/
+		bool LockShared()
+		{
+			return true;
+		}
+
+		/*!
+		Does nothing
+		*/
+		void UnlockShared()
+		{
+		}
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Cannot be Used.
+		*/
+		NullLock(const NullLock & /*b*/){EP_ASSERT(0);}
+
+		/*!
+		Assignment operator overloading
+
+		*Cannot be Used.
+		*/
+		NullLock &operator=(const NullLock & /*b*/){EP_ASSERT(0);return *this;}
+	};
+
+	/*! 
+	@class LockGuard epStaticLock.h
+	@brief A template class that locks the given lock within the scope.
+	*/
+	template<typename LockType>
+	class LockGuard
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Locks the given lock
+		@param[in] lock the lock to lock
+		*/
+		LockGuard(LockType &lock):m_lock(lock)
+		{
+			m_lock.Lock();
+		}
+
+		/*!
+		Default Destructor
+
+		Unlocks the lock
+		*/
+		~LockGuard()
+		{
+			m_lock.Unlock();
+		}
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Cannot be Used.
+		*/
+		LockGuard(const LockGuard & b):m_lock(b.m_lock){EP_ASSERT(0);}
+
+		/*!
+		Assignment operator overloading
+
+		*Cannot be Used.
+		*/
+		LockGuard &operator=(const LockGuard & b){EP_ASSERT(0);return *this;}
+
+		/// the lock
+		LockType &m_lock;
+	};
+
+	/*! 
+	@class SharedLockGuard epStaticLock.h
+	@brief A template class that locks the shared access of the given lock within the scope.
+	*/
+	template<typename LockType>
+	class SharedLockGuard
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Locks the shared access of the given lock
+		@param[in] lock the lock to lock
+		*/
+		SharedLockGuard(LockType &lock):m_lock(lock)
+		{
+			m_lock.LockShared();
+		}
+
+		/*!
+		Default Destructor
+
+		Unlocks the shared access of the lock
+		*/
+		~SharedLockGuard()
+		{
+			m_lock.UnlockShared();
+		}
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Cannot be Used.
+		*/
+		SharedLockGuard(const SharedLockGuard & b):m_lock(b.m_lock){EP_ASSERT(0);}
+
+		/*!
+		Assignment operator overloading
+
+		*Cannot be Used.
+		*/
+		SharedLockGuard &operator=(const SharedLockGuard & b){EP_ASSERT(0);return *this;}
+
+		/// the lock
+		LockType &m_lock;
+	};
+}
+
+#endif //__EP_STATIC_LOCK_H__
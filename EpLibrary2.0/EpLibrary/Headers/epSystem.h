@@ -1037,7 +1037,7 @@ namespace epl
 		Output the debug message
 		@param[in] format the string to output
 		*/
-		static void OutputDebugString(TCHAR * format,...);
+		static void OutputDebugString(const TCHAR * format,...);
 
 		/*!
 		Wait for a handle for given time
@@ -38,7 +38,9 @@ A Frame Interface for Thread Class.
 #ifndef __EP_THREAD_H__
 #define __EP_THREAD_H__
 #include "epLib.h"
+#if defined(_WIN32) || defined(_WIN64)
 #include <process.h>
+#endif //defined(_WIN32) || defined(_WIN64)
 #include "epCriticalSectionEx.h"
 #include "epMutex.h"
 #include "epNoLock.h"
@@ -49,7 +51,7 @@ namespace epl
 	/// Thread Priority Enumerator
 	typedef enum _threadPriority
 	{
-#if (_MSC_VER >=MSVC80) && (WINVER>=WINDOWS_XP) // Only for VS2005 and above and Windows XP and above
+#if ((_MSC_VER >=MSVC80) && (WINVER>=WINDOWS_XP)) || defined(EP_PLATFORM_POSIX) // Only for VS2005 and above and Windows XP and above
 		/// Priority 1 point above the priority class.
 		EP_THREAD_PRIORITY_ABOVE_NORMAL=THREAD_PRIORITY_ABOVE_NORMAL,
 		/// Priority 1 point below the priority class.
@@ -123,6 +125,14 @@ namespace epl
 		*/
 		static bool SetPriority(HANDLE threadHandle, ThreadPriority priority);
 
+		/*!
+		Set the processor affinity of the thread
+		@param[in] threadHandle the thread handle to set the affinity
+		@param[in] affinityMask the bit mask of the processors which the thread can run on
+		@return the previous affinity mask if successfully set otherwise 0
+		*/
+		static DWORD_PTR SetAffinityMask(HANDLE threadHandle, DWORD_PTR affinityMask);
+
 		/// Enumerator for Thread Operation Code
 		enum ThreadOpCode{
 			/// The thread is started when it is created.
@@ -234,6 +244,7 @@ namespace epl
 		/*!
 		Suspend the running thread.
 		@return true, if succeeded, otherwise false.
+		@remark On the POSIX platform, the running thread cannot be suspended, so this returns false.
 		*/
 		bool Suspend();
 
@@ -241,6 +252,7 @@ namespace epl
 		Terminate the running or suspended thread.
 		@return true, if succeeded, otherwise false.
 		@remark this function should be use with care! Memory leak might occur!
+		@remark On the POSIX platform, the thread is cancelled at its next cancellation point (i.e. waiting for an event).
 		*/
 		bool Terminate();
 
@@ -335,6 +347,38 @@ namespace epl
 		*/
 		bool SetPriority(ThreadPriority priority);
 
+		/*!
+		Set the processor affinity of the thread
+		@param[in] affinityMask the bit mask of the processors which the thread can run on
+		@return the previous affinity mask if successfully set otherwise 0
+		*/
+		DWORD_PTR SetAffinityMask(DWORD_PTR affinityMask);
+
+		/*!
+		Set the processor affinity which the thread binds itself to when it starts
+		@param[in] affinityMask the bit mask of the processors which the thread can run on (0 for no binding)
+		@remark The thread binds itself before execute() is called,
+		        so the memory first touched by the thread is allocated close to the processors.
+		*/
+		void SetStartAffinityMask(DWORD_PTR affinityMask);
+
+		/*!
+		Return the processor affinity which the thread binds itself to when it starts
+		@return the bit mask of the processors (0 for no binding)
+		*/
+		DWORD_PTR GetStartAffinityMask() const
+		{
+			return m_startAffinityMask;
+		}
+
+		/*!
+		Bind the thread to the processors of the given NUMA node
+		@param[in] nodeIdx the NUMA node index (see CpuTopology)
+		@return true if successfully set otherwise false
+		@remark If the thread is not started, the thread binds itself when it starts.
+		*/
+		bool SetNumaNode(unsigned int nodeIdx);
+
 
 	protected:
 
@@ -398,7 +442,7 @@ namespace epl
 		@param[in] pthis The argument for the thread (this for current case)
 		@return the exit code.
 		*/
-		static unsigned long __stdcall entryPoint2(void* pthis);
+		static DWORD __stdcall entryPoint2(void* pthis);
 
 
 
@@ -408,6 +452,8 @@ namespace epl
 		ThreadHandle m_threadHandle;
 		/// ThreadPriority
 		ThreadPriority m_threadPriority;
+		/// the affinity mask to bind when the thread starts
+		DWORD_PTR m_startAffinityMask;
 		
 		/// Parent Thread ID
 		ThreadID m_parentThreadId;
@@ -0,0 +1,238 @@
+/*! 
+@file epThreadPool.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief ThreadPool Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Work-Stealing Thread Pool.
+
+*/
+#ifndef __EP_THREAD_POOL_H__
+#define __EP_THREAD_POOL_H__
+#include "epLib.h"
+#include "epWorkStealingWorkerThread.h"
+#include "epWorkerThreadFactory.h"
+#include "epBaseJobProcessor.h"
+#include "epSemaphore.h"
+#include "epDistributedReadWriteLock.h"
+
+namespace epl
+{
+	/*!
+	@class ThreadPool epThreadPool.h
+	@brief A class that implements the work-stealing Thread Pool.
+
+	The pool owns the given number of WorkStealingWorkerThread, and each worker has its own local job deque.
+	The jobs pushed to the pool are distributed to the workers in round-robin,
+	and the idle workers steal the jobs from the busy workers.
+	The jobs are processed by BaseJobProcessor::DoJob with the same job status reports as the other worker threads.
+
+	The workers can be bound to the processors by the WorkerThreadFactory::WorkerPlacement.
+	The workers are grouped by their NUMA node, and the workers of a node form the node-local pool:
+	the jobs pushed are given to the workers of the node of the pushing thread,
+	and the idle workers steal from the workers of the same node before the other nodes.
+	*/
+	class EP_LIBRARY ThreadPool
+	{
+	public:
+		friend class WorkStealingWorkerThread;
+
+		/*!
+		Default Constructor
+
+		Initializes and starts the workers of the pool
+		@param[in] jobProcessor the Job Processor for the workers.
+		@param[in] workerCount the number of workers. (0 for the number of cores)
+		@param[in] lockPolicyType The lock policy
+		@param[in] placement the placement policy of the workers.
+		*/
+		ThreadPool(BaseJobProcessor *jobProcessor,unsigned int workerCount=0,LockPolicy lockPolicyType=EP_LOCK_POLICY,WorkerThreadFactory::WorkerPlacement placement=WorkerThreadFactory::WORKER_PLACEMENT_NONE);
+
+		/*!
+		Default Destructor
+
+		Terminates the workers and destroys the pool
+		@remark the jobs which are not processed are reported as JOB_STATUS_INCOMPLETE.
+		*/
+		virtual ~ThreadPool();
+
+		/*!
+		Push in the new work to the pool.
+		@param[in] work the new work to put into the pool.
+		*/
+		void Push(BaseJob * const work);
+
+		/*!
+		Push in the given works to the pool.
+
+		All the works are given to a single worker under a single lock, and the other workers steal them.
+		@param[in] works the array of the new works to put into the pool.
+		@param[in] count the number of the works in the array.
+		*/
+		void PushBatch(BaseJob * const *works,size_t count);
+
+		/*!
+		Push in the new work to the workers of the given NUMA node.
+		@param[in] work the new work to put into the pool.
+		@param[in] nodeIdx the NUMA node index. (see CpuTopology)
+		@remark if the node has no worker, the work is given to any worker.
+		*/
+		void PushToNode(BaseJob * const work,unsigned int nodeIdx);
+
+		/*!
+		Push in the given works to the workers of the given NUMA node.
+		@param[in] works the array of the new works to put into the pool.
+		@param[in] count the number of the works in the array.
+		@param[in] nodeIdx the NUMA node index. (see CpuTopology)
+		@remark if the node has no worker, the works are given to any worker.
+		*/
+		void PushBatchToNode(BaseJob * const *works,size_t count,unsigned int nodeIdx);
+
+		/*!
+		Get job count waiting in the pool.
+		@return the job count waiting in the pool.
+		*/
+		size_t GetJobCount() const;
+
+		/*!
+		Return the number of workers of the pool.
+		@return the number of workers of the pool.
+		*/
+		unsigned int GetWorkerCount() const
+		{
+			return m_workerCount;
+		}
+
+		/*!
+		Return the placement policy of the workers.
+		@return the placement policy of the workers.
+		*/
+		WorkerThreadFactory::WorkerPlacement GetPlacement() const
+		{
+			return m_placement;
+		}
+
+		/*!
+		Return the number of the NUMA nodes which the workers are grouped by.
+		@return the number of the NUMA nodes. (1 if the workers are not placed by node)
+		*/
+		unsigned int GetNumaNodeCount() const
+		{
+			return m_nodeCount;
+		}
+
+		/*!
+		Terminate all the workers of the pool.
+		@param[in] waitTimeInMilliSec the time-out interval for each worker, in milliseconds.
+		@remark the jobs which are not processed are reported as JOB_STATUS_INCOMPLETE.
+		*/
+		void TerminatePool(unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE);
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Cannot be Used.
+		*/
+		ThreadPool(const ThreadPool & /*b*/){EP_ASSERT(0);}
+
+		/*!
+		Assignment operator overloading
+
+		*Cannot be Used.
+		*/
+		ThreadPool &operator=(const ThreadPool & /*b*/){EP_ASSERT(0);return *this;}
+
+		/*!
+		Push in the new work to the local deque of the given worker and wake up a worker.
+		@param[in] worker the worker to push the work.
+		@param[in] work the new work to put into the pool.
+		*/
+		void pushTo(WorkStealingWorkerThread *worker,BaseJob * const work);
+
+		/*!
+		Push in the given works to the local deque of the given worker and wake up the workers.
+		@param[in] worker the worker to push the works.
+		@param[in] works the array of the new works to put into the pool.
+		@param[in] count the number of the works in the array.
+		*/
+		void pushBatchTo(WorkStealingWorkerThread *worker,BaseJob * const *works,size_t count);
+
+		/*!
+		Return the worker to push the next job among the workers of the given NUMA node.
+		@param[in] nodeIdx the NUMA node index.
+		@return the worker to push the next job.
+		*/
+		WorkStealingWorkerThread *nextWorker(unsigned int nodeIdx);
+
+		/*!
+		Build the node groups and the steal orders of the workers.
+		*/
+		void buildNodeGroups();
+
+		/*!
+		Wait until a job is available and take it for the given worker.
+		@param[in] worker the worker which takes the job.
+		@return the job taken, or NULL if the pool is terminating.
+		*/
+		BaseJob *take(WorkStealingWorkerThread *worker);
+
+		/// the workers
+		WorkStealingWorkerThread **m_workers;
+		/// the number of workers
+		unsigned int m_workerCount;
+		/// the placement policy of the workers
+		WorkerThreadFactory::WorkerPlacement m_placement;
+		/// the number of the NUMA nodes
+		unsigned int m_nodeCount;
+		/// the NUMA node of each worker
+		unsigned int *m_workerNodes;
+		/// the indices of the workers sorted by the node
+		unsigned int *m_nodeWorkers;
+		/// the start of each node in m_nodeWorkers (m_nodeCount+1 entries)
+		unsigned int *m_nodeWorkerStart;
+		/// the steal order of each worker, the same node first (m_workerCount-1 entries per worker)
+		unsigned int *m_stealOrders;
+		/// the index of the worker to push the next job
+		volatile long m_nextWorker;
+		/// the number of jobs waiting in the pool
+		volatile long m_jobCount;
+		/// the flag for terminating
+		volatile long m_isTerminating;
+		/// the lock held shared by the pushes, so the termination waits for the pushes in progress
+		DistributedReadWriteLock m_terminateLock;
+		/// the semaphore counting the jobs waiting in the pool
+		Semaphore m_jobSemaphore;
+	};
+
+}
+
+#endif //__EP_THREAD_POOL_H__
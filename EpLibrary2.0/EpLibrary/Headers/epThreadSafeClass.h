@@ -81,6 +81,7 @@ namespace epl
 			switch(lockPolicyType)
 			{
 			case LOCK_POLICY_CRITICALSECTION:
+			case LOCK_POLICY_READWRITE:
 				m_threadSafeLock=EP_NEW CriticalSectionEx();
 				break;
 			case LOCK_POLICY_MUTEX:
@@ -108,6 +109,7 @@ namespace epl
 			switch(m_lockPolicy)
 			{
 			case LOCK_POLICY_CRITICALSECTION:
+			case LOCK_POLICY_READWRITE:
 				m_threadSafeLock=EP_NEW CriticalSectionEx();
 				break;
 			case LOCK_POLICY_MUTEX:
@@ -151,6 +153,7 @@ namespace epl
 				switch(m_lockPolicy)
 				{
 				case LOCK_POLICY_CRITICALSECTION:
+				case LOCK_POLICY_READWRITE:
 					m_threadSafeLock=EP_NEW CriticalSectionEx();
 					break;
 				case LOCK_POLICY_MUTEX:
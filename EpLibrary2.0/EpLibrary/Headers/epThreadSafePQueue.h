@@ -47,8 +47,8 @@ namespace epl
 	@class ThreadSafePQueue epThreadSafePQueue.h
 	@brief A class for Thread Safe Priority Queue.
 	*/
-	template <typename DataType, typename Compare=CompClass<DataType> >
-	class ThreadSafePQueue:public ThreadSafeQueue<DataType>
+	template <typename DataType, typename Compare=CompClass<DataType>, typename LockType=RuntimeLock >
+	class ThreadSafePQueue:public ThreadSafeQueue<DataType,LockType>
 	{
 	public:
 		/*!
@@ -91,45 +91,52 @@ namespace epl
 
 	};
 
-	template <typename DataType, typename Compare>
-	ThreadSafePQueue<DataType,Compare>::ThreadSafePQueue(LockPolicy lockPolicyType) :ThreadSafeQueue<DataType>(lockPolicyType)
+	template <typename DataType, typename Compare, typename LockType>
+	ThreadSafePQueue<DataType,Compare,LockType>::ThreadSafePQueue(LockPolicy lockPolicyType) :ThreadSafeQueue<DataType,LockType>(lockPolicyType)
 	{
 	}
-	template <typename DataType, typename Compare>
-	ThreadSafePQueue<DataType,Compare>::ThreadSafePQueue(const ThreadSafePQueue& b):ThreadSafeQueue<DataType>(b)
+	template <typename DataType, typename Compare, typename LockType>
+	ThreadSafePQueue<DataType,Compare,LockType>::ThreadSafePQueue(const ThreadSafePQueue& b):ThreadSafeQueue<DataType,LockType>(b)
 	{
 	}
-	template <typename DataType, typename Compare>
-	ThreadSafePQueue<DataType,Compare>::~ThreadSafePQueue()
+	template <typename DataType, typename Compare, typename LockType>
+	ThreadSafePQueue<DataType,Compare,LockType>::~ThreadSafePQueue()
 	{
 	}
 	
-	template <typename DataType, typename Compare>
-	ThreadSafePQueue<DataType,Compare> & ThreadSafePQueue<DataType,Compare>::operator=(const ThreadSafePQueue&b)
+	template <typename DataType, typename Compare, typename LockType>
+	ThreadSafePQueue<DataType,Compare,LockType> & ThreadSafePQueue<DataType,Compare,LockType>::operator=(const ThreadSafePQueue&b)
 	{
 		if(this != &b)
 		{
-			ThreadSafeQueue::operator =(b);
+			ThreadSafeQueue<DataType,LockType>::operator =(b);
 		}
 		return *this;
 	}
 
-	template <typename DataType, typename Compare>
-	void ThreadSafePQueue<DataType,Compare>::Push(DataType const & data)
+	template <typename DataType, typename Compare, typename LockType>
+	void ThreadSafePQueue<DataType,Compare,LockType>::Push(DataType const & data)
 	{
-		LockObj lock(m_queueLock);
-		DataType* retVal=NULL;
-		if(m_queue.size())
+		LockGuard<LockType> lock(this->m_queueLock);
+		// binary search on the ring buffer for the insert position
+		size_t low=0;
+		size_t high=this->m_queue.Size();
+		while(low<high)
 		{
-			size_t retIdx;
-			if(BinarySearch(data,&m_queue.at(0),m_queue.size(),Compare::CompFunc,retIdx))
+			size_t med=(low+high)/2;
+			CompResultType ret=Compare::CompFunc(&data,&this->m_queue.At(med));
+			if(ret==COMP_RESULT_EQUAL)
+			{
 				EP_ASSERT_EXPR(0,_T("Same Object already in the Queue!!"));
-			m_queue.insert(m_queue.begin()+retIdx,data);
-		}
-		else
-		{
-			m_queue.push_back(data);
+				low=med;
+				break;
+			}
+			else if(ret==COMP_RESULT_GREATERTHAN)
+				low=med+1;
+			else
+				high=med;
 		}
+		this->m_queue.Insert(low,data);
 
 	}
 }
@@ -39,9 +39,11 @@ An Interface for Thread Safe Queue.
 #define __EP_THREAD_SAFE_QUEUE_H__
 #include "epLib.h"
 #include <vector>
+#include "epRingBuffer.h"
 #include "epCriticalSectionEx.h"
 #include "epMutex.h"
 #include "epNoLock.h"
+#include "epRuntimeLock.h"
 #include "epException.h"
 
 namespace epl
@@ -50,8 +52,11 @@ namespace epl
 	/*! 
 	@class ThreadSafeQueue epThreadSafeQueue.h
 	@brief A class for Thread Safe Queue.
+
+	The elements are stored in the growable ring buffer, so Push/Pop/Front/Back are O(1).
+	LockType decides the lock at the compile time (RuntimeLock follows the lock policy given to the constructor).
 	*/
-	template <typename DataType>
+	template <typename DataType, typename LockType=RuntimeLock>
 	class ThreadSafeQueue
 	{
 	public:
@@ -140,202 +145,162 @@ namespace epl
 		*/
 		void Clear();
 
+		/*!
+		Return the copy of the queue as vector.
+		@return the copy of the queue.
+		*/
 		std::vector<DataType> GetQueue() const;
 
 	protected:
 		/// Actual queue structure
-		std::vector<DataType> m_queue;
+		RingBuffer<DataType> m_queue;
 
 		/// lock
-		BaseLock *m_queueLock;
+		mutable LockType m_queueLock;
 
 		/// Lock Policy
 		LockPolicy m_lockPolicy;
 	};
 
 
-	template <typename DataType>
-	ThreadSafeQueue<DataType>::ThreadSafeQueue(LockPolicy lockPolicyType)
+	template <typename DataType, typename LockType>
+	ThreadSafeQueue<DataType,LockType>::ThreadSafeQueue(LockPolicy lockPolicyType)
 	{
 		m_lockPolicy=lockPolicyType;
-		switch(lockPolicyType)
-		{
-		case LOCK_POLICY_CRITICALSECTION:
-			m_queueLock=EP_NEW CriticalSectionEx();
-			break;
-		case LOCK_POLICY_MUTEX:
-			m_queueLock=EP_NEW Mutex();
-			break;
-		case LOCK_POLICY_NONE:
-			m_queueLock=EP_NEW NoLock();
-			break;
-		default:
-			m_queueLock=NULL;
-			break;
-		}
+		m_queueLock.Reset(lockPolicyType);
 	}
 
-	template <typename DataType>
-	ThreadSafeQueue<DataType>::ThreadSafeQueue(const ThreadSafeQueue& b)
+	template <typename DataType, typename LockType>
+	ThreadSafeQueue<DataType,LockType>::ThreadSafeQueue(const ThreadSafeQueue& b)
 	{
-		m_queue=b.GetQueue();
+		b.m_queueLock.Lock();
+		m_queue=b.m_queue;
+		b.m_queueLock.Unlock();
 		m_lockPolicy=b.m_lockPolicy;
-		switch(m_lockPolicy)
-		{
-		case LOCK_POLICY_CRITICALSECTION:
-			m_queueLock=EP_NEW CriticalSectionEx();
-			break;
-		case LOCK_POLICY_MUTEX:
-			m_queueLock=EP_NEW Mutex();
-			break;
-		case LOCK_POLICY_NONE:
-			m_queueLock=EP_NEW NoLock();
-			break;
-		default:
-			m_queueLock=NULL;
-			break;
-		}
+		m_queueLock.Reset(m_lockPolicy);
 	}
 
-	template <typename DataType>
-	ThreadSafeQueue<DataType>::~ThreadSafeQueue()
+	template <typename DataType, typename LockType>
+	ThreadSafeQueue<DataType,LockType>::~ThreadSafeQueue()
 	{
-		m_queueLock->Lock();
-		m_queue.clear();
-		m_queueLock->Unlock();
-		if(m_queueLock)
-			EP_DELETE m_queueLock;
+		m_queueLock.Lock();
+		m_queue.Clear();
+		m_queueLock.Unlock();
 	}
 
-	template <typename DataType>
-	std::vector<DataType> ThreadSafeQueue<DataType>::GetQueue() const
+	template <typename DataType, typename LockType>
+	std::vector<DataType> ThreadSafeQueue<DataType,LockType>::GetQueue() const
 	{
-		LockObj lock(m_queueLock);
-		return m_queue;
+		LockGuard<LockType> lock(m_queueLock);
+		std::vector<DataType> retQueue;
+		retQueue.reserve(m_queue.Size());
+		for(size_t trav=0;trav<m_queue.Size();trav++)
+		{
+			retQueue.push_back(m_queue.At(trav));
+		}
+		return retQueue;
 	}
 
-	template <typename DataType>
-	bool ThreadSafeQueue<DataType>::IsEmpty() const
+	template <typename DataType, typename LockType>
+	bool ThreadSafeQueue<DataType,LockType>::IsEmpty() const
 	{
-		LockObj lock(m_queueLock);
-		return m_queue.empty();
+		LockGuard<LockType> lock(m_queueLock);
+		return m_queue.IsEmpty();
 	}
 	
-	template <typename DataType>
-	bool ThreadSafeQueue<DataType>::IsExist(DataType const &data) const
+	template <typename DataType, typename LockType>
+	bool ThreadSafeQueue<DataType,LockType>::IsExist(DataType const &data) const
 	{
-		LockObj lock(m_queueLock);
-		if(m_queue.empty())
-			return false;
-
-		std::vector<DataType>::const_iterator iter;
-		for(iter=m_queue.begin();iter!=m_queue.end();iter++)
+		LockGuard<LockType> lock(m_queueLock);
+		for(size_t trav=0;trav<m_queue.Size();trav++)
 		{
-			if((*iter)==data)
+			if(m_queue.At(trav)==data)
 				return true;
 		}
 		return false;
 		
 	}
 
-	template <typename DataType>
-	void ThreadSafeQueue<DataType>::Clear()
+	template <typename DataType, typename LockType>
+	void ThreadSafeQueue<DataType,LockType>::Clear()
 	{
-		LockObj lock(m_queueLock);
-		m_queue.clear();
+		LockGuard<LockType> lock(m_queueLock);
+		m_queue.Clear();
 
 	}
 
-	template <typename DataType>
-	size_t ThreadSafeQueue<DataType>::Size() const
+	template <typename DataType, typename LockType>
+	size_t ThreadSafeQueue<DataType,LockType>::Size() const
 	{
-		LockObj lock(m_queueLock);
-		return m_queue.size();
+		LockGuard<LockType> lock(m_queueLock);
+		return m_queue.Size();
 	}
 
-	template <typename DataType>
-	DataType &ThreadSafeQueue<DataType>::Front()
+	template <typename DataType, typename LockType>
+	DataType &ThreadSafeQueue<DataType,LockType>::Front()
 	{
-		LockObj lock(m_queueLock);
-		if(m_queue.empty())
+		LockGuard<LockType> lock(m_queueLock);
+		if(m_queue.IsEmpty())
 		{
 			EP_ASSERT_EXPR(0,_T("Empty Queue"));
 		}
-		return m_queue.front();
+		return m_queue.Front();
 	}
 
-	template <typename DataType>
-	DataType &ThreadSafeQueue<DataType>::Back()
+	template <typename DataType, typename LockType>
+	DataType &ThreadSafeQueue<DataType,LockType>::Back()
 	{
-		LockObj lock(m_queueLock);
-		if(m_queue.empty())
+		LockGuard<LockType> lock(m_queueLock);
+		if(m_queue.IsEmpty())
 		{
 			EP_ASSERT_EXPR(0,_T("Empty Queue"));
 		}
-		return m_queue.back();
+		return m_queue.Back();
 	}
 
-	template <typename DataType>
-	void ThreadSafeQueue<DataType>::Push(DataType const & data)
+	template <typename DataType, typename LockType>
+	void ThreadSafeQueue<DataType,LockType>::Push(DataType const & data)
 	{
-		LockObj lock(m_queueLock);
-		m_queue.push_back(data);
+		LockGuard<LockType> lock(m_queueLock);
+		m_queue.PushBack(data);
 	}
 
-	template <typename DataType>
-	bool ThreadSafeQueue<DataType>::Erase(DataType const &data)
+	template <typename DataType, typename LockType>
+	bool ThreadSafeQueue<DataType,LockType>::Erase(DataType const &data)
 	{
-		LockObj lock(m_queueLock);
-		std::vector<DataType>::iterator iter;
-		for(iter=m_queue.begin();iter!=m_queue.end();iter++)
+		LockGuard<LockType> lock(m_queueLock);
+		for(size_t trav=0;trav<m_queue.Size();trav++)
 		{
-			if(*iter==data)
+			if(m_queue.At(trav)==data)
 			{
-				m_queue.erase(iter);
+				m_queue.Erase(trav);
 				return true;
 			}
 		}
 		return false;
 	}
 
-	template <typename DataType>
-	void ThreadSafeQueue<DataType>::Pop()
+	template <typename DataType, typename LockType>
+	void ThreadSafeQueue<DataType,LockType>::Pop()
 	{
-		LockObj lock(m_queueLock);
-		if(m_queue.empty())
+		LockGuard<LockType> lock(m_queueLock);
+		if(m_queue.IsEmpty())
 		{
 			EP_ASSERT_EXPR(0,_T("Empty Queue"));
 		}
-		m_queue.erase(m_queue.begin());
+		m_queue.PopFront();
 	}
 
-	template <typename DataType>
-	ThreadSafeQueue<DataType> & ThreadSafeQueue<DataType>::operator=(const ThreadSafeQueue& b)
+	template <typename DataType, typename LockType>
+	ThreadSafeQueue<DataType,LockType> & ThreadSafeQueue<DataType,LockType>::operator=(const ThreadSafeQueue& b)
 	{
 		if(this != &b)
 		{
-			if(m_queueLock)
-			{
-				EP_DELETE m_queueLock;
-				m_queueLock=NULL;
-			}
 			m_lockPolicy=b.m_lockPolicy;
-			switch(m_lockPolicy)
-			{
-			case LOCK_POLICY_CRITICALSECTION:
-				m_queueLock=EP_NEW CriticalSectionEx();
-				break;
-			case LOCK_POLICY_MUTEX:
-				m_queueLock=EP_NEW Mutex();
-				break;
-			case LOCK_POLICY_NONE:
-				m_queueLock=EP_NEW NoLock();
-				break;
-			default:
-				m_queueLock=NULL;
-				break;
-			}
-			m_queue=b.GetQueue();
+			m_queueLock.Reset(m_lockPolicy);
+			b.m_queueLock.Lock();
+			m_queue=b.m_queue;
+			b.m_queueLock.Unlock();
 		}
 		return *this;
 	}
@@ -0,0 +1,165 @@
+/*! 
+@file epTicketLock.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief TicketLock Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Fair Ticket Lock.
+
+*/
+#ifndef __EP_TICKET_LOCK_H__
+#define __EP_TICKET_LOCK_H__
+#include "epLib.h"
+#include "epSystem.h"
+#include "epBaseLock.h"
+#include "epEventEx.h"
+
+/*!
+@def TICKET_LOCK_DEFAULT_SPIN_COUNT
+@brief Default number of the PAUSE spins before the TicketLock parks the waiting thread
+*/
+#define TICKET_LOCK_DEFAULT_SPIN_COUNT 4000
+
+/*!
+@def TICKET_LOCK_BACKOFF_UNIT
+@brief Number of the PAUSE per thread ahead in the line between two polls
+*/
+#define TICKET_LOCK_BACKOFF_UNIT 16
+
+/*!
+@def TICKET_LOCK_PARK_SLOT_COUNT
+@brief Number of the events the TicketLock parks the waiting threads on
+*/
+#define TICKET_LOCK_PARK_SLOT_COUNT 8
+
+namespace epl
+{
+	/*!
+	@class TicketLock epTicketLock.h
+	@brief A class that handles the fair (FIFO) ticket lock.
+
+	Each waiting thread takes a ticket and waits until it is served, so the lock is granted in the arrival order.
+	The backoff between the polls is proportional to the number of the threads ahead,
+	and the thread parks once the spin count is used up.
+	The parked thread waits for the event of its ticket's slot, which Unlock signals when the ticket is served,
+	so only the next thread is woken while no more than TICKET_LOCK_PARK_SLOT_COUNT threads wait.
+	A thread woken for the ticket of another thread on the same slot passes the signal on.
+	@remark The lock is NOT recursive.
+	        Since the lock is handed over in order, a preempted waiter stalls the threads behind it,
+	        so use SpinLock rather than TicketLock when the threads outnumber the processors.
+	*/
+	class EP_LIBRARY TicketLock :public BaseLock
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the lock.
+		@param[in] spinCount the number of the PAUSE spins before parking the waiting thread
+		*/
+		TicketLock(unsigned int spinCount=TICKET_LOCK_DEFAULT_SPIN_COUNT);
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the TicketLock
+		@param[in] b the second object
+		*/
+		TicketLock(const TicketLock& b);
+
+		/*!
+		Default Destructor
+
+		Deletes the lock
+		*/
+		virtual ~TicketLock();
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		*/
+		TicketLock & operator=(const TicketLock&b);
+
+		/*!
+		Locks the Critical Section
+		@return true if locked, false otherwise
+		*/
+		virtual bool Lock();
+
+		/*!
+		Try to Lock the Critical Section
+
+		If other thread is already in the Critical Section, it just returns false and continue, otherwise obtain the Critical Section.
+		@return true if the lock is succeeded, otherwise false.
+		*/
+		virtual long TryLock();
+
+		/*!
+		Locks the Critical Section
+
+		if other thread is already in the Critical Section,
+		and if it fails to lock in given time, it returns false, otherwise lock and return true.
+		@param[in] dwMilliSecond the wait time.
+		@return true if the lock is succeeded, otherwise false.
+		@remark a ticket cannot be given back, so this polls TryLock and does not wait in line.
+		        The thread sleeps between the polls once the spin count is used up.
+		*/
+		virtual long TryLockFor(const unsigned int dwMilliSecond);
+
+		/*!
+		Leave the Critical Section
+
+		The Lock and Unlock has to be matched for each Critical Section.
+		*/
+		virtual void Unlock();
+
+	private:
+		/*!
+		Reset the park events, which are raised when created
+		*/
+		void resetParkEvents();
+
+		/// the ticket given to the next thread
+		volatile long m_nextTicket;
+		/// the ticket currently served
+		volatile long m_nowServing;
+		/// the number of the threads parked or about to park
+		volatile long m_parkedCount;
+		/// the number of the PAUSE spins before parking
+		unsigned int m_spinCount;
+		/// the auto reset events the threads park on, indexed by the ticket modulo TICKET_LOCK_PARK_SLOT_COUNT
+		EventEx m_parkEvents[TICKET_LOCK_PARK_SLOT_COUNT];
+	};
+
+}
+
+#endif //__EP_TICKET_LOCK_H__
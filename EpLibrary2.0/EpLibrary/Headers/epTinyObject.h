@@ -80,24 +80,61 @@ namespace epl {
 #define UCHAR_MAX     0xff      // maximum unsigned char value 
 #endif 
 
+#ifndef USHRT_MAX
+#define USHRT_MAX     0xffff    // maximum unsigned short value
+#endif
+
+// number of blocks moved between the thread cache and the shared pool at once
+#ifndef TINY_OBJECT_CACHE_BATCH_COUNT
+#define TINY_OBJECT_CACHE_BATCH_COUNT 32
+#endif
+
+// size of the header at the beginning of each fragment chunk (holds the fragment index)
+#ifndef TINY_OBJECT_CHUNK_HEADER_SIZE
+#define TINY_OBJECT_CHUNK_HEADER_SIZE 16
+#endif
+
+	// Each fragment is allocated as a chunk aligned to its own power of two size,
+	// and the chunk header holds the index of the fragment, so the fragment owning
+	// a pointer is found by masking the pointer.
 	class EP_LIBRARY StaticAllocator
 	{
 	public:
+		typedef unsigned short BlockIndex;
+
+		struct EP_LIBRARY Report
+		{
+			size_t blockSize;
+			size_t fragmentCount;
+			size_t blockCount;
+			size_t freeBlockCount;
+			size_t reservedBytes;
+			size_t allocCount;
+			size_t deallocCount;
+		};
+
 		class EP_LIBRARY Fragment
 		{
 			friend StaticAllocator;
 
-			void Init(size_t blockSize, unsigned char blocks);
+			void Init(size_t blockSize, BlockIndex blocks, size_t chunkSize, size_t fragmentIdx);
 			void *Allocate(size_t blockSize);
 			void Deallocate(void *p, size_t blockSize);
-			void Reset(size_t blockSize, unsigned char blocks);
+			void Reset(size_t blockSize, BlockIndex blocks);
 			void Clear();
+			void SetIndex(size_t fragmentIdx)
+			{
+				*reinterpret_cast<size_t*>(m_chunk)=fragmentIdx;
+			}
+			static BlockIndex ReadIndex(const unsigned char *block, size_t blockSize);
+			static void WriteIndex(unsigned char *block, size_t blockSize, BlockIndex idx);
+			unsigned char *m_chunk;
 			unsigned char *m_Data;
-			unsigned char firstAvailableBlock;
-			unsigned char numBlocksAvailable;
+			BlockIndex firstAvailableBlock;
+			BlockIndex numBlocksAvailable;
 		};
 
-		StaticAllocator(size_t blockSize = 0);
+		StaticAllocator(size_t blockSize = 0, size_t fragmentSize = DEFAULT_FRAGMENT_SIZE);
 		StaticAllocator(const StaticAllocator& rhs);
 		StaticAllocator& operator=(const StaticAllocator& rhs);
 
@@ -108,6 +145,7 @@ namespace epl {
 		void Clear();
 		void Compress(CacheType type);
 		void Delete();
+		void GetReport(Report &retReport) const;
 
 		size_t GetBlockSize() const
 		{
@@ -128,28 +166,108 @@ namespace epl {
 		}
 	private:
 		void Release(void* p, CacheType type);
-		Fragment* VicinityFind(void* p);
+		Fragment* FindFragment(void* p);
+		void ReIndex(size_t startIdx);
 		size_t m_blockSize;
-		unsigned char m_numBlocks;
+		BlockIndex m_numBlocks;
+		size_t m_chunkSize;
 		typedef std::vector<Fragment> Fragments;
 		Fragments m_fragments;
 		Fragment* m_allocFragment;
 		Fragment* m_deallocFragment;
+		size_t m_allocCount;
+		size_t m_deallocCount;
 	};
 
 
+	class TinyObjAllocator;
+
+	// Per-thread free lists of the blocks for each object size.
+	// Only the owner thread touches the lists, and the blocks are moved from/to
+	// the shared TinyObjAllocator in batches while holding the allocator lock.
+	class EP_LIBRARY TinyObjThreadCache
+	{
+	public:
+		TinyObjThreadCache(size_t maxObjectSize);
+		~TinyObjThreadCache();
+
+		bool IsCacheable(size_t numBytes) const
+		{
+			return numBytes>=sizeof(FreeBlock) && numBytes<=m_maxObjectSize;
+		}
+
+		// returns NULL if the free list is empty
+		void* Allocate(size_t numBytes)
+		{
+			FreeBlock *block=m_freeLists[numBytes];
+			if(!block)
+				return NULL;
+			m_freeLists[numBytes]=block->m_next;
+			--m_counts[numBytes];
+			return block;
+		}
+
+		// returns true if the free list grew over the limit and must be drained
+		bool Deallocate(void* p, size_t numBytes)
+		{
+			FreeBlock *block=reinterpret_cast<FreeBlock*>(p);
+			block->m_next=m_freeLists[numBytes];
+			m_freeLists[numBytes]=block;
+			return ++m_counts[numBytes]>TINY_OBJECT_CACHE_BATCH_COUNT*2;
+		}
+
+		// below must be called while holding the allocator lock
+		void* Refill(TinyObjAllocator &allocator, size_t numBytes);
+		void Drain(TinyObjAllocator &allocator, size_t numBytes, CacheType type);
+		void Flush(TinyObjAllocator &allocator, CacheType type);
+
+	private:
+		TinyObjThreadCache(const TinyObjThreadCache&);
+		TinyObjThreadCache& operator=(const TinyObjThreadCache&);
+
+		void release(TinyObjAllocator &allocator, size_t numBytes, CacheType type, size_t keepCount);
+
+		struct FreeBlock
+		{
+			FreeBlock *m_next;
+		};
+		FreeBlock **m_freeLists;
+		size_t *m_counts;
+		size_t m_maxObjectSize;
+	};
+
 	class EP_LIBRARY TinyObjAllocator
 	{
 	public:
+		// threadExitCallback is called with the thread cache when its thread exits
 		TinyObjAllocator(
 			size_t fragmentSize, 
-			size_t maxObjectSize);
+			size_t maxObjectSize,
+			PFLS_CALLBACK_FUNCTION threadExitCallback=NULL);
 		~TinyObjAllocator();
 
 		void* Allocate(size_t numBytes);
 		void Deallocate(void* p, size_t size, CacheType type);
 		void Compress(CacheType type);
 
+		// returns the calling thread's cache, or NULL if not created yet
+		TinyObjThreadCache* GetThreadCache() const
+		{
+			if(m_threadCacheIdx==FLS_OUT_OF_INDEXES)
+				return NULL;
+			return reinterpret_cast<TinyObjThreadCache*>(FlsGetValue(m_threadCacheIdx));
+		}
+		// below must be called while holding the allocator lock
+		TinyObjThreadCache* CreateThreadCache();
+		void FlushThreadCache(CacheType type);
+		// returns the blocks of the cache to the pool, and deletes the cache
+		void ReleaseThreadCache(TinyObjThreadCache *cache, CacheType type);
+		size_t GetThreadCacheCount() const
+		{
+			return m_threadCaches.size();
+		}
+		// the blocks held by the thread caches are counted as allocated
+		void GetReport(std::vector<StaticAllocator::Report> &retReports) const;
 
 	private:
 		TinyObjAllocator(const TinyObjAllocator&);
@@ -161,8 +279,15 @@ namespace epl {
 		StaticAllocator* m_lastDealloc;
 		size_t m_fragmentSize;
 		size_t m_maxObjectSize;
+		unsigned long m_threadCacheIdx;
+		std::vector<TinyObjThreadCache*> m_threadCaches;
 	};
 
+	// The objects are allocated from the calling thread's cache when the cache type is
+	// CACHE_TYPE_STATIC without CACHE_TYPE_COMPRESS, so the shared allocator lock is taken
+	// only once per TINY_OBJECT_CACHE_BATCH_COUNT allocations.
+	// The blocks cached by a thread are returned to the shared pool by FlushThreadCache,
+	// and the cache itself is released when the thread exits.
 	template
 		<
 		CacheType cacheType = CACHE_TYPE_STATIC|CACHE_TYPE_POOL,
@@ -174,24 +299,66 @@ namespace epl {
 
 		struct EP_LIBRARY MyTinyObjAllocator : public TinyObjAllocator
 		{
-			MyTinyObjAllocator() : TinyObjAllocator(fragmentSize, maxTinyObjectSize)
+			MyTinyObjAllocator() : TinyObjAllocator(fragmentSize, maxTinyObjectSize, USE_THREAD_CACHE?&onThreadExit:NULL)
 			{}
 		};
 		typedef ThreadSafeClass< MyTinyObjAllocator > MyThreadSafeClass;
+		enum { USE_THREAD_CACHE=(cacheType&CACHE_TYPE_STATIC) && !(cacheType&CACHE_TYPE_COMPRESS) };
+		static MyTinyObjAllocator * volatile s_allocator;
+
+		// returns the blocks cached by the exiting thread to the shared pool
+		static void WINAPI onThreadExit(void *cache)
+		{
+			typename MyThreadSafeClass::InstantLock lock;
+			if(s_allocator)
+				s_allocator->ReleaseThreadCache(reinterpret_cast<TinyObjThreadCache*>(cache),cacheType);
+		}
 	public:
 		static void* operator new(size_t size)
 		{
-			typename MyThreadSafeClass::InstantLock lock;
 #if (MAX_TINY_OBJECT_SIZE != 0) && (DEFAULT_FRAGMENT_SIZE != 0)
-			return SingletonHolder<MyTinyObjAllocator>::Instance().Allocate(size);
+			TinyObjThreadCache *cache=NULL;
+			if(USE_THREAD_CACHE && s_allocator)
+			{
+				cache=s_allocator->GetThreadCache();
+				if(cache && cache->IsCacheable(size))
+				{
+					void *ret=cache->Allocate(size);
+					if(ret)
+						return ret;
+				}
+			}
+			typename MyThreadSafeClass::InstantLock lock;
+			MyTinyObjAllocator &allocator=SingletonHolder<MyTinyObjAllocator>::Instance();
+			s_allocator=&allocator;
+			if(USE_THREAD_CACHE)
+			{
+				if(!cache)
+					cache=allocator.CreateThreadCache();
+				if(cache && cache->IsCacheable(size))
+					return cache->Refill(allocator,size);
+			}
+			return allocator.Allocate(size);
 #else
 			return ::operator new(size);
 #endif
 		}
 		static void operator delete(void* p, size_t size)
 		{
-			typename MyThreadSafeClass::InstantLock lock;
 #if (MAX_TINY_OBJECT_SIZE != 0) && (DEFAULT_FRAGMENT_SIZE != 0)
+			if(USE_THREAD_CACHE && s_allocator)
+			{
+				TinyObjThreadCache *cache=s_allocator->GetThreadCache();
+				if(cache && cache->IsCacheable(size))
+				{
+					if(!cache->Deallocate(p,size))
+						return;
+					typename MyThreadSafeClass::InstantLock lock;
+					cache->Drain(*s_allocator,size,cacheType);
+					return;
+				}
+			}
+			typename MyThreadSafeClass::InstantLock lock;
 			SingletonHolder<MyTinyObjAllocator>::Instance().Deallocate(p, size, cacheType);
 #else
 			::operator delete(p, size);
@@ -202,12 +369,48 @@ namespace epl {
 		{
 			typename MyThreadSafeClass::InstantLock lock;
 #if (MAX_TINY_OBJECT_SIZE != 0) && (DEFAULT_FRAGMENT_SIZE != 0)
+			SingletonHolder<MyTinyObjAllocator>::Instance().FlushThreadCache(cacheType);
 			SingletonHolder<MyTinyObjAllocator>::Instance().Compress(cacheType);
 #else
+#endif
+		}
+
+		// fragmentation and throughput report for each object size
+		static void GetReport(std::vector<StaticAllocator::Report> &retReports)
+		{
+			typename MyThreadSafeClass::InstantLock lock;
+#if (MAX_TINY_OBJECT_SIZE != 0) && (DEFAULT_FRAGMENT_SIZE != 0)
+			SingletonHolder<MyTinyObjAllocator>::Instance().GetReport(retReports);
+#else
+			retReports.clear();
+#endif
+		}
+
+		// the number of the thread caches alive
+		static size_t GetThreadCacheCount()
+		{
+			typename MyThreadSafeClass::InstantLock lock;
+#if (MAX_TINY_OBJECT_SIZE != 0) && (DEFAULT_FRAGMENT_SIZE != 0)
+			return SingletonHolder<MyTinyObjAllocator>::Instance().GetThreadCacheCount();
+#else
+			return 0;
+#endif
+		}
+
+		// return the blocks cached by the calling thread to the shared pool
+		static void FlushThreadCache()
+		{
+			typename MyThreadSafeClass::InstantLock lock;
+#if (MAX_TINY_OBJECT_SIZE != 0) && (DEFAULT_FRAGMENT_SIZE != 0)
+			SingletonHolder<MyTinyObjAllocator>::Instance().FlushThreadCache(cacheType);
+#else
 #endif
 		}
 		virtual ~TinyObject() {}
 	};
+
+	template<CacheType cacheType, size_t fragmentSize, size_t maxTinyObjectSize>
+	typename TinyObject<cacheType,fragmentSize,maxTinyObjectSize>::MyTinyObjAllocator * volatile TinyObject<cacheType,fragmentSize,maxTinyObjectSize>::s_allocator=NULL;
 }
 
 #endif //__EP_TINY_OBJECT_H__
\ No newline at end of file
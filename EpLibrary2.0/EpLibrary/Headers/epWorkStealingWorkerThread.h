@@ -0,0 +1,173 @@
+/*! 
+@file epWorkStealingWorkerThread.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eplibrary>
+@date October 18, 2026
+@brief WorkStealingWorkerThread Interface
+@version 2.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Work-Stealing Worker Thread used by ThreadPool.
+
+*/
+#ifndef __EP_WORK_STEALING_WORKER_THREAD_H__
+#define __EP_WORK_STEALING_WORKER_THREAD_H__
+#include "epLib.h"
+#include "epBaseWorkerThread.h"
+#include "epBaseJobProcessor.h"
+#include "epRingBuffer.h"
+
+namespace epl
+{
+	class ThreadPool;
+
+	/*!
+	@class WorkStealingWorkerThread epWorkStealingWorkerThread.h
+	@brief A class that implements the Worker Thread of the ThreadPool.
+
+	Each worker owns a local job deque. The worker processes its own jobs from the back (LIFO),
+	and the other idle workers of the same pool steal from the front (FIFO).
+	The jobs are processed in the order of the deque, so the priority of the job is not considered.
+	@remark The worker is created and owned by the ThreadPool.
+	        Pushing a job to the worker (e.g. within BaseJobProcessor::DoJob) queues the job to its local deque.
+	*/
+	class EP_LIBRARY WorkStealingWorkerThread:public BaseWorkerThread
+	{
+	public:
+		friend class ThreadPool;
+
+		/*!
+		Default Destructor
+
+		Destroy the Thread Class
+		*/
+		virtual ~WorkStealingWorkerThread();
+
+		/*!
+		Push in the new work to the local deque of this worker.
+		@param[in] work the new work to put into the local deque.
+		*/
+		virtual void Push(BaseJob * const  work);
+
+		/*!
+		Push in the given works to the local deque of this worker under a single lock.
+		@param[in] works the array of the new works to put into the local deque.
+		@param[in] count the number of the works in the array.
+		*/
+		virtual void PushBatch(BaseJob * const *works,size_t count);
+
+		/*!
+		Get job count in the local deque.
+		@return the job count in the local deque.
+		*/
+		virtual size_t GetJobCount() const;
+
+		/*!
+		Return the index of this worker within the pool.
+		@return the index of this worker within the pool.
+		*/
+		unsigned int GetWorkerIndex() const
+		{
+			return m_workerIdx;
+		}
+
+	protected:
+		/*!
+		Default Constructor
+
+		Initializes the thread class
+		@param[in] pool the pool which owns this worker.
+		@param[in] workerIdx the index of this worker within the pool.
+		@param[in] lockPolicyType The lock policy
+		*/
+		WorkStealingWorkerThread(ThreadPool *pool,unsigned int workerIdx,LockPolicy lockPolicyType=EP_LOCK_POLICY);
+
+		/*!
+		Actual Worker Thread Code.
+		*/
+		virtual void execute();
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Cannot be Used.
+		*/
+		WorkStealingWorkerThread(const WorkStealingWorkerThread & b):BaseWorkerThread(b){EP_ASSERT(0);}
+
+		/*!
+		Assignment operator overloading
+
+		*Cannot be Used.
+		*/
+		WorkStealingWorkerThread &operator=(const WorkStealingWorkerThread & /*b*/){EP_ASSERT(0);return *this;}
+
+		/*!
+		Insert the given job at the back of the local deque.
+		@param[in] work the job to insert.
+		*/
+		void pushLocal(BaseJob * const work);
+
+		/*!
+		Insert the given jobs at the back of the local deque.
+		@param[in] works the array of the jobs to insert.
+		@param[in] count the number of the jobs in the array.
+		*/
+		void pushBatchLocal(BaseJob * const *works,size_t count);
+
+		/*!
+		Remove the job at the back of the local deque. (owner side)
+		@return the job removed, or NULL if the deque is empty.
+		*/
+		BaseJob *popLocal();
+
+		/*!
+		Remove the job at the front of the local deque. (thief side)
+		@return the job removed, or NULL if the deque is empty.
+		*/
+		BaseJob *stealLocal();
+
+		/*!
+		Process the given job with the job processor.
+		@param[in] work the job to process.
+		*/
+		void processJob(BaseJob * const work);
+
+		/// the pool which owns this worker
+		ThreadPool *m_pool;
+		/// the index of this worker within the pool
+		unsigned int m_workerIdx;
+		/// the local job deque
+		RingBuffer<BaseJob*> m_localJobs;
+		/// the local job deque lock
+		BaseLock *m_localLock;
+	};
+
+}
+
+#endif //__EP_WORK_STEALING_WORKER_THREAD_H__
@@ -40,6 +40,7 @@ An Interface for Worker Thread Delegate.
 #include "epLib.h"
 namespace epl
 {
+	class BaseWorkerThread;
 
 	/*! 
 	@class WorkerThreadDelegate epWorkerThreadDelegate.h
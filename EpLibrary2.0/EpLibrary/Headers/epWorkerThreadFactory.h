@@ -50,12 +50,52 @@ namespace epl
 	class EP_LIBRARY WorkerThreadFactory
 	{
 	public:
+		/// Enumerator for Worker Thread Placement
+		enum WorkerPlacement{
+			/// The workers are not bound, and the scheduler places them.
+			WORKER_PLACEMENT_NONE=0,
+			/// Each worker is bound to a processor, filling the cores of a node before the next node.
+			WORKER_PLACEMENT_COMPACT,
+			/// Each worker is bound to a processor, spreading over the nodes and then over the cores.
+			WORKER_PLACEMENT_SCATTER,
+			/// The workers are divided into the NUMA nodes, and each worker is bound to the processors of its node.
+			WORKER_PLACEMENT_NUMA_NODE,
+		};
+
 		/*!
 		Return the new worker thread object with given life policy.
 		@param[in] policy the life policy of the thread to create.
 		@return Return the new worker thread object with given life policy.
 		*/
 		static	BaseWorkerThread *GetWorkerThread(const BaseWorkerThread::ThreadLifePolicy policy=BaseWorkerThread::THREAD_LIFE_INFINITE);
+
+		/*!
+		Return the new worker thread object with given life policy, bound by the given placement when it starts.
+		@param[in] policy the life policy of the thread to create.
+		@param[in] placement the placement policy of the workers.
+		@param[in] workerIdx the index of the worker to create among the workers.
+		@param[in] workerCount the total number of the workers placed together.
+		@return Return the new worker thread object with given life policy.
+		*/
+		static	BaseWorkerThread *GetWorkerThread(const BaseWorkerThread::ThreadLifePolicy policy,const WorkerPlacement placement,unsigned int workerIdx,unsigned int workerCount);
+
+		/*!
+		Return the affinity mask of the worker for the given placement.
+		@param[in] placement the placement policy of the workers.
+		@param[in] workerIdx the index of the worker among the workers.
+		@param[in] workerCount the total number of the workers placed together.
+		@return the affinity mask of the worker. (0 for no binding)
+		*/
+		static DWORD_PTR GetPlacementAffinityMask(const WorkerPlacement placement,unsigned int workerIdx,unsigned int workerCount);
+
+		/*!
+		Return the NUMA node index of the worker for the given placement.
+		@param[in] placement the placement policy of the workers.
+		@param[in] workerIdx the index of the worker among the workers.
+		@param[in] workerCount the total number of the workers placed together.
+		@return the NUMA node index of the worker. (0 for WORKER_PLACEMENT_NONE)
+		*/
+		static unsigned int GetPlacementNumaNode(const WorkerPlacement placement,unsigned int workerIdx,unsigned int workerCount);
 	};
 
 }
@@ -43,11 +43,24 @@ A Interface for Infinite-looping Worker Thread Class.
 #include "epBaseJobProcessor.h"
 #include "epEventEx.h"
 
+/*!
+@def WORKER_THREAD_MAX_DRAIN_COUNT
+@brief The maximum number of jobs WorkerThreadInfinite takes from the work pool at once.
+*/
+#ifndef WORKER_THREAD_MAX_DRAIN_COUNT
+#define WORKER_THREAD_MAX_DRAIN_COUNT 64
+#endif //WORKER_THREAD_MAX_DRAIN_COUNT
+
 namespace epl
 {
 	/*! 
 	@class WorkerThreadInfinite epWorkerThreadInfinite.h
 	@brief A class that implements infinite-looping Worker Thread Class.
+
+	When the work pool is empty, the thread optionally spins for the given count,
+	and then blocks on the work event until a new job is pushed, so an idle worker does not consume the CPU.
+	When the drain count is greater than 1, the thread takes up to drain count jobs from the work pool under a single lock.
+	@remark the jobs taken at once are not re-ordered by the jobs pushed later, and cannot be erased from the work pool.
 	*/
 	class EP_LIBRARY WorkerThreadInfinite:public BaseWorkerThread
 	{
@@ -57,8 +70,10 @@ namespace epl
 
 		Initializes the thread class
 		@param[in] policy the life policy of this worker thread.
+		@param[in] spinCount the number of times to check the work pool before blocking when idle.
+		@param[in] drainCount the maximum number of jobs to take from the work pool at once.
 		*/
-		WorkerThreadInfinite(const ThreadLifePolicy policy);
+		WorkerThreadInfinite(const ThreadLifePolicy policy,unsigned int spinCount=0,unsigned int drainCount=1);
 
 		/*!
 		Default Copy Constructor
@@ -85,6 +100,8 @@ namespace epl
 			if(this!=&b)
 			{
 				BaseWorkerThread::operator =(b);
+				m_spinCount=b.m_spinCount;
+				m_drainCount=b.m_drainCount;
 			}
 			return *this;
 		}
@@ -96,6 +113,52 @@ namespace epl
 		*/
 		TerminateResult TerminateWorker(unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE);
 
+		/*!
+		Push in the new work to the work pool and wake up the thread.
+		@param[in] work the new work to put into the work pool.
+		*/
+		virtual void Push(BaseJob * const  work);
+
+		/*!
+		Push in the given works to the work pool under a single lock and wake up the thread.
+		@param[in] works the array of the new works to put into the work pool.
+		@param[in] count the number of the works in the array.
+		*/
+		virtual void PushBatch(BaseJob * const *works,size_t count);
+
+		/*!
+		Set the number of times to check the work pool before blocking when idle.
+		@param[in] spinCount the number of times to check the work pool before blocking.
+		*/
+		void SetSpinCount(unsigned int spinCount)
+		{
+			m_spinCount=spinCount;
+		}
+
+		/*!
+		Return the number of times to check the work pool before blocking when idle.
+		@return the number of times to check the work pool before blocking.
+		*/
+		unsigned int GetSpinCount() const
+		{
+			return m_spinCount;
+		}
+
+		/*!
+		Set the maximum number of jobs to take from the work pool at once.
+		@param[in] drainCount the maximum number of jobs to take at once. (1 ~ WORKER_THREAD_MAX_DRAIN_COUNT)
+		*/
+		void SetDrainCount(unsigned int drainCount);
+
+		/*!
+		Return the maximum number of jobs to take from the work pool at once.
+		@return the maximum number of jobs to take at once.
+		*/
+		unsigned int GetDrainCount() const
+		{
+			return m_drainCount;
+		}
+
 	protected:
 		/*!
 		Actual infinite-looping Thread Code.
@@ -103,8 +166,19 @@ namespace epl
 		virtual void execute();
 
 	private:
+		/*!
+		Wait until the work pool is not empty or the termination is requested.
+		*/
+		void waitForWork();
+
 		/// Terminate Signal Event
 		EventEx m_terminateEvent;
+		/// Work Signal Event (auto-reset)
+		EventEx m_workEvent;
+		/// the number of times to check the work pool before blocking
+		volatile unsigned int m_spinCount;
+		/// the maximum number of jobs to take from the work pool at once
+		volatile unsigned int m_drainCount;
 
 	};
 
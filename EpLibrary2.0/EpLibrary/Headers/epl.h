@@ -59,35 +59,50 @@ An Interface for EpLibrary Pre-compiled header
 
 #include "epThreadSafePQueue.h"
 #include "epThreadSafeQueue.h"
+#include "epRingBuffer.h"
+#include "epLockFreeQueue.h"
 
+#if defined(_WIN32) || defined(_WIN64)
 #include "epCoroutine.h"
 #include "epCStringEx.h"
+#endif //defined(_WIN32) || defined(_WIN64)
 #include "epDelegate.h"
 #include "epDynamicArray.h"
 
 //Debugger
 #include "epBaseOutputter.h"
+#if defined(_WIN32) || defined(_WIN64)
 #include "epProfiler.h"
+#include "epMemoryProfiler.h"
 #include "epSimpleLogger.h"
+#endif //defined(_WIN32) || defined(_WIN64)
 
 //File System
 #include "epBinaryFile.h"
 #include "epBaseTextFile.h"
+#if defined(_WIN32) || defined(_WIN64)
 #include "epFolderHelper.h"
+#endif //defined(_WIN32) || defined(_WIN64)
 #include "epPropertiesFile.h"
+#if defined(_WIN32) || defined(_WIN64)
 #include "epXMLFile.h"
 #include "epXMLite.h"
+#endif //defined(_WIN32) || defined(_WIN64)
 #include "epTextFile.h"
+#if defined(_WIN32) || defined(_WIN64)
 #include "epLogWriter.h"
 #include "epLogWorker.h"
+#endif //defined(_WIN32) || defined(_WIN64)
 
 //IPC
+#if defined(_WIN32) || defined(_WIN64)
 #include "epIpcClient.h"
 #include "epIpcClientInterfaces.h"
 #include "epIpcConf.h"
 #include "epIpcPipe.h"
 #include "epIpcServer.h"
 #include "epIpcServerInterfaces.h"
+#endif //defined(_WIN32) || defined(_WIN64)
 
 //Frameworks
 #include "epBaseLock.h"
@@ -96,28 +111,43 @@ An Interface for EpLibrary Pre-compiled header
 #include "epMutex.h"
 #include "epSemaphore.h"
 #include "epNoLock.h"
+#include "epReadWriteLock.h"
+#include "epDistributedReadWriteLock.h"
+#include "epStaticLock.h"
+#include "epRuntimeLock.h"
 #include "epInterlockedEx.h"
+#include "epSpinLock.h"
+#include "epTicketLock.h"
 #include "epCmdLineOptions.h"
 
 #include "epSingletonHolder.h"
 #include "epSmartObject.h"
 #include "epThreadSafeClass.h"
+#if defined(_WIN32) || defined(_WIN64)
 #include "epCrypt.h"
+#endif //defined(_WIN32) || defined(_WIN64)
 
 //GUI
+#if defined(_WIN32) || defined(_WIN64)
 #include "epTaskbarNotifier.h"
 #include "epWinProcessHelper.h"
 #include "epWinResizer.h"
+#endif //defined(_WIN32) || defined(_WIN64)
 
 //System
 #include "epAssert.h"
 #include "epLocale.h"
+#if defined(_WIN32) || defined(_WIN64)
 #include "epConsoleHelper.h"
+#endif //defined(_WIN32) || defined(_WIN64)
 #include "epDateTimeHelper.h"
 #include "epEndian.h"
 #include "epMemory.h"
+#include "epArena.h"
 #include "epPlatform.h"
+#if defined(_WIN32) || defined(_WIN64)
 #include "epRegistryHelper.h"
+#endif //defined(_WIN32) || defined(_WIN64)
 #include "epSystem.h"
 #include "epTinyObject.h"
 #include "epException.h"
@@ -127,13 +157,17 @@ An Interface for EpLibrary Pre-compiled header
 #include "epBaseJobProcessor.h"
 
 #include "epJobScheduleQueue.h"
+#include "epLightJob.h"
 
 #include "epWorkerThreadInfinite.h"
 #include "epWorkerThreadSingle.h"
+#include "epWorkStealingWorkerThread.h"
+#include "epThreadPool.h"
 
 #include "epBaseWorkerThread.h"
 #include "epWorkerThreadDelegate.h"
 #include "epWorkerThreadFactory.h"
 #include "epThread.h"
+#include "epCpuTopology.h"
 
 #endif //__EP_EPL_H__
\ No newline at end of file
@@ -0,0 +1,203 @@
+/*! 
+Arena for the EpLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epArena.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epl;
+
+Arena::Arena(size_t blockSize,LockPolicy lockPolicyType)
+{
+	EP_ASSERT_EXPR(blockSize>0,_T("Block size must be greater than 0!"));
+	m_blockSize=blockSize;
+	m_currentBlock=0;
+	m_currentOffset=0;
+	m_usedSize=0;
+	switch(lockPolicyType)
+	{
+	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
+		m_lock=EP_NEW CriticalSectionEx();
+		break;
+	case LOCK_POLICY_MUTEX:
+		m_lock=EP_NEW Mutex();
+		break;
+	case LOCK_POLICY_NONE:
+		m_lock=EP_NEW NoLock();
+		break;
+	default:
+		m_lock=NULL;
+		break;
+	}
+}
+
+Arena::~Arena()
+{
+	Release();
+	if(m_lock)
+		EP_DELETE m_lock;
+}
+
+void *Arena::Allocate(size_t size)
+{
+	LockObj lock(m_lock);
+	return allocate(size,ARENA_DEFAULT_ALIGNMENT);
+}
+
+void *Arena::Allocate(size_t size,size_t alignment)
+{
+	EP_ASSERT_EXPR(alignment>0 && (alignment&(alignment-1))==0,_T("Alignment must be power of 2! (alignment: %d)"),alignment);
+	LockObj lock(m_lock);
+	return allocate(size,alignment);
+}
+
+void Arena::Deallocate(void * /*ptr*/,size_t /*size*/)
+{
+}
+
+Arena::Marker Arena::GetMarker() const
+{
+	LockObj lock(m_lock);
+	Marker retMarker;
+	retMarker.m_blockIdx=m_currentBlock;
+	retMarker.m_offset=m_currentOffset;
+	retMarker.m_usedSize=m_usedSize;
+	return retMarker;
+}
+
+void Arena::Rewind(const Marker &marker)
+{
+	LockObj lock(m_lock);
+	EP_ASSERT_EXPR(marker.m_usedSize<=m_usedSize,_T("The marker is ahead of the arena!"));
+	m_currentBlock=marker.m_blockIdx;
+	m_currentOffset=marker.m_offset;
+	m_usedSize=marker.m_usedSize;
+}
+
+void Arena::Reset()
+{
+	LockObj lock(m_lock);
+	m_currentBlock=0;
+	m_currentOffset=0;
+	m_usedSize=0;
+}
+
+void Arena::Release()
+{
+	LockObj lock(m_lock);
+	for(size_t trav=0;trav<m_blocks.size();trav++)
+	{
+		EP_Free(m_blocks[trav].m_memory);
+	}
+	m_blocks.clear();
+	m_currentBlock=0;
+	m_currentOffset=0;
+	m_usedSize=0;
+}
+
+size_t Arena::GetUsedSize() const
+{
+	LockObj lock(m_lock);
+	return m_usedSize;
+}
+
+size_t Arena::GetReservedSize() const
+{
+	LockObj lock(m_lock);
+	size_t retSize=0;
+	for(size_t trav=0;trav<m_blocks.size();trav++)
+	{
+		retSize+=m_blocks[trav].m_size;
+	}
+	return retSize;
+}
+
+void *Arena::allocate(size_t size,size_t alignment)
+{
+	// worst case size needed for an empty block
+	size_t blockSizeNeeded=size+alignment-1;
+	if(blockSizeNeeded<size)
+		return NULL;
+	while(true)
+	{
+		if(m_currentBlock<m_blocks.size())
+		{
+			Block &block=m_blocks[m_currentBlock];
+			size_t base=(size_t)block.m_memory;
+			size_t offset=((base+m_currentOffset+alignment-1)&~(alignment-1))-base;
+			if(offset<=block.m_size && size<=block.m_size-offset)
+			{
+				m_usedSize+=offset+size-m_currentOffset;
+				m_currentOffset=offset+size;
+				return block.m_memory+offset;
+			}
+			// reuse the next block kept from before Reset/Rewind if it fits
+			if(m_currentBlock+1<m_blocks.size() && m_blocks[m_currentBlock+1].m_size>=blockSizeNeeded)
+			{
+				m_currentBlock++;
+				m_currentOffset=0;
+				continue;
+			}
+		}
+
+		Block newBlock;
+		newBlock.m_size=(blockSizeNeeded>m_blockSize)?blockSizeNeeded:m_blockSize;
+#if defined(EP_ENABLE_MEMORY_HOOK)
+		// the blocks of the arena must not come from the arena itself through MemoryHook
+		BaseMemoryAllocator *prevAllocator=MemoryHook::SetThreadAllocator(NULL);
+		newBlock.m_memory=reinterpret_cast<char*>(EP_Malloc(newBlock.m_size));
+		MemoryHook::SetThreadAllocator(prevAllocator);
+#else //defined(EP_ENABLE_MEMORY_HOOK)
+		newBlock.m_memory=reinterpret_cast<char*>(EP_Malloc(newBlock.m_size));
+#endif //defined(EP_ENABLE_MEMORY_HOOK)
+		if(!newBlock.m_memory)
+			return NULL;
+		size_t insertIdx=(m_currentBlock<m_blocks.size())?m_currentBlock+1:m_blocks.size();
+		m_blocks.insert(m_blocks.begin()+insertIdx,newBlock);
+		m_currentBlock=insertIdx;
+		m_currentOffset=0;
+	}
+}
+
+ArenaScope::ArenaScope(Arena &arena,bool isThreadAllocator):m_arena(arena)
+{
+	m_marker=m_arena.GetMarker();
+	m_isThreadAllocator=isThreadAllocator;
+	m_prevAllocator=NULL;
+	if(m_isThreadAllocator)
+		m_prevAllocator=MemoryHook::SetThreadAllocator(&m_arena);
+}
+
+ArenaScope::~ArenaScope()
+{
+	if(m_isThreadAllocator)
+		MemoryHook::SetThreadAllocator(m_prevAllocator);
+	m_arena.Rewind(m_marker);
+}
@@ -24,6 +24,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 #include "epBaseJob.h"
+#include "epJobScheduleQueue.h"
 #include "epSystem.h"
 #include "epSingletonHolder.h"
 
@@ -40,6 +41,9 @@ BaseJob::BaseJob(Priority priority,LockPolicy lockPolicyType):SmartObject(lockPo
 	//SingletonHolder<JobPool>::Instance().insert(this);	
 	m_status=JOB_STATUS_NONE;
 	m_priority=priority;
+	m_scheduleQueue=NULL;
+	m_scheduleIdx=0;
+	m_scheduleSeq=0;
 }
 
 BaseJob::~BaseJob(){
@@ -58,7 +62,23 @@ Priority BaseJob::GetPriority() const
 
 void BaseJob::SetPriority(Priority newPrio)
 {
-	m_priority=newPrio;
+	while(true)
+	{
+		JobScheduleQueue *scheduleQueue=LoadAcquire(&m_scheduleQueue);
+		if(scheduleQueue)
+		{
+			// fails if the job left the queue before the queue lock is taken
+			if(scheduleQueue->changePriority(this,newPrio))
+				return;
+		}
+		else
+		{
+			StoreRelease(&m_priority,newPrio);
+			// re-position if the job is pushed while the priority is changed
+			if(!LoadAcquire(&m_scheduleQueue))
+				return;
+		}
+	}
 }
 
 void BaseJob::JobReport(const JobStatus status)
@@ -78,7 +98,7 @@ CompResultType BaseJob::CompFunc(const void *a,const void *b)
 	return COMP_RESULT_GREATERTHAN;
 
 }
-void BaseJob::handleReport(const JobStatus status)
+void BaseJob::handleReport(const JobStatus /*status*/)
 {
 
 }
\ No newline at end of file
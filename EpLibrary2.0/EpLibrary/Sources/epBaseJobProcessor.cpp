@@ -43,7 +43,7 @@ BaseJobProcessor::~BaseJobProcessor(){
 }
 
 
-void BaseJobProcessor::handleReport(const JobProcessorStatus status)
+void BaseJobProcessor::handleReport(const JobProcessorStatus /*status*/)
 {}
 
 void BaseJobProcessor::JobProcessorReport(const JobProcessorStatus status)
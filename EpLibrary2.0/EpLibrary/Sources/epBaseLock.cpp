@@ -45,6 +45,21 @@ BaseLock::~BaseLock()
 {
 }
 
+bool BaseLock::LockShared()
+{
+	return Lock();
+}
+
+long BaseLock::TryLockShared()
+{
+	return TryLock();
+}
+
+void BaseLock::UnlockShared()
+{
+	Unlock();
+}
+
 BaseLock::BaseLockObj::BaseLockObj(BaseLock *lock)
 {
 	EP_ASSERT_EXPR(lock,_T("Lock is NULL!"));
@@ -80,3 +95,23 @@ BaseLock::BaseLockObj::BaseLockObj()
 	m_lock=NULL;
 }
 
+BaseLock::BaseSharedLockObj::BaseSharedLockObj(BaseLock *lock)
+{
+	EP_ASSERT_EXPR(lock,_T("Lock is NULL!"));
+	m_lock=lock;
+	if(m_lock)
+		m_lock->LockShared();
+}
+
+BaseLock::BaseSharedLockObj::~BaseSharedLockObj()
+{
+	if(m_lock)
+	{
+		m_lock->UnlockShared();
+	}
+}
+
+BaseLock::BaseSharedLockObj::BaseSharedLockObj()
+{
+	m_lock=NULL;
+}
@@ -37,7 +37,7 @@ DECLARE_THREAD_SAFE_CLASS(System);
 
 BaseOutputter::OutputNode::OutputNode()
 {}
-BaseOutputter::OutputNode::OutputNode(const OutputNode& b)
+BaseOutputter::OutputNode::OutputNode(const OutputNode& /*b*/)
 {}
 BaseOutputter::OutputNode::~OutputNode()
 {}
@@ -51,6 +51,9 @@ BaseOutputter::BaseOutputter(LockPolicy lockPolicyType)
 	case LOCK_POLICY_CRITICALSECTION:
 		m_nodeListLock=EP_NEW CriticalSectionEx();
 		break;
+	case LOCK_POLICY_READWRITE:
+		m_nodeListLock=EP_NEW ReadWriteLock();
+		break;
 	case LOCK_POLICY_MUTEX:
 		m_nodeListLock=EP_NEW Mutex();
 		break;
@@ -70,6 +73,9 @@ BaseOutputter::BaseOutputter(const BaseOutputter& b)
 	case LOCK_POLICY_CRITICALSECTION:
 		m_nodeListLock=EP_NEW CriticalSectionEx();
 		break;
+	case LOCK_POLICY_READWRITE:
+		m_nodeListLock=EP_NEW ReadWriteLock();
+		break;
 	case LOCK_POLICY_MUTEX:
 		m_nodeListLock=EP_NEW Mutex();
 		break;
@@ -81,7 +87,7 @@ BaseOutputter::BaseOutputter(const BaseOutputter& b)
 		break;
 	}
 	m_fileName=b.m_fileName;
-	LockObj lock(b.m_nodeListLock);
+	SharedLockObj lock(b.m_nodeListLock);
 	m_list=b.m_list;
 }
 BaseOutputter::~BaseOutputter()
@@ -106,6 +112,9 @@ BaseOutputter & BaseOutputter::operator=(const BaseOutputter&b)
 		case LOCK_POLICY_CRITICALSECTION:
 			m_nodeListLock=EP_NEW CriticalSectionEx();
 			break;
+		case LOCK_POLICY_READWRITE:
+			m_nodeListLock=EP_NEW ReadWriteLock();
+			break;
 		case LOCK_POLICY_MUTEX:
 			m_nodeListLock=EP_NEW Mutex();
 			break;
@@ -117,7 +126,7 @@ BaseOutputter & BaseOutputter::operator=(const BaseOutputter&b)
 			break;
 		}
 		m_fileName=b.m_fileName;
-		LockObj lock(b.m_nodeListLock);
+		SharedLockObj lock(b.m_nodeListLock);
 		m_list=b.m_list;
 	}
 	return *this;
@@ -136,7 +145,7 @@ void BaseOutputter::Clear()
 
 void BaseOutputter::Print() const
 {
-	LockObj lock(m_nodeListLock);
+	SharedLockObj lock(m_nodeListLock);
 	std::vector<OutputNode*>::const_iterator iter;
 	for(iter=m_list.begin();iter!=m_list.end();iter++)
 	{
@@ -43,6 +43,9 @@ BaseTextFile::BaseTextFile(FileEncodingType encodingType,LockPolicy lockPolicyTy
 	case LOCK_POLICY_CRITICALSECTION:
 		m_baseTextLock=EP_NEW CriticalSectionEx();
 		break;
+	case LOCK_POLICY_READWRITE:
+		m_baseTextLock=EP_NEW ReadWriteLock();
+		break;
 	case LOCK_POLICY_MUTEX:
 		m_baseTextLock=EP_NEW Mutex();
 		break;
@@ -64,6 +67,9 @@ BaseTextFile::BaseTextFile(const BaseTextFile& b)
 	case LOCK_POLICY_CRITICALSECTION:
 		m_baseTextLock=EP_NEW CriticalSectionEx();
 		break;
+	case LOCK_POLICY_READWRITE:
+		m_baseTextLock=EP_NEW ReadWriteLock();
+		break;
 	case LOCK_POLICY_MUTEX:
 		m_baseTextLock=EP_NEW Mutex();
 		break;
@@ -97,6 +103,9 @@ BaseTextFile & BaseTextFile::operator=(const BaseTextFile&b)
 		case LOCK_POLICY_CRITICALSECTION:
 			m_baseTextLock=EP_NEW CriticalSectionEx();
 			break;
+		case LOCK_POLICY_READWRITE:
+			m_baseTextLock=EP_NEW ReadWriteLock();
+			break;
 		case LOCK_POLICY_MUTEX:
 			m_baseTextLock=EP_NEW Mutex();
 			break;
@@ -40,10 +40,12 @@ BaseWorkerThread::BaseWorkerThread(const ThreadLifePolicy policy,LockPolicy lock
 {
 	m_lifePolicy=policy;
 	m_callBackClass=NULL;
+	m_jobProcessor=NULL;
 	m_lockPolicy=lockPolicyType;
 	switch(lockPolicyType)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_callBackLock=EP_NEW CriticalSectionEx();
 		break;
 	case LOCK_POLICY_MUTEX:
@@ -64,6 +66,7 @@ BaseWorkerThread::BaseWorkerThread(const BaseWorkerThread & b):Thread(b)
 	switch(m_lockPolicy)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_callBackLock=EP_NEW CriticalSectionEx();
 		break;
 	case LOCK_POLICY_MUTEX:
@@ -125,6 +128,7 @@ BaseWorkerThread &BaseWorkerThread::operator=(const BaseWorkerThread & b)
 		switch(m_lockPolicy)
 		{
 		case LOCK_POLICY_CRITICALSECTION:
+		case LOCK_POLICY_READWRITE:
 			m_callBackLock=EP_NEW CriticalSectionEx();
 			break;
 		case LOCK_POLICY_MUTEX:
@@ -157,6 +161,15 @@ void BaseWorkerThread::Push(BaseJob* const  work)
 		Resume();
 }
 
+void BaseWorkerThread::PushBatch(BaseJob * const *works,size_t count)
+{
+	if(count==0)
+		return;
+	m_workPool.PushBatch(works,count);
+	if(m_lifePolicy==THREAD_LIFE_SUSPEND_AFTER_WORK)
+		Resume();
+}
+
 BaseJob * &BaseWorkerThread::Front()
 {
 	return m_workPool.Front();
@@ -166,6 +179,11 @@ void BaseWorkerThread::Pop()
 	m_workPool.Pop();
 }
 
+size_t BaseWorkerThread::PopBatch(BaseJob **retWorks,size_t maxCount)
+{
+	return m_workPool.PopBatch(retWorks,maxCount);
+}
+
 bool BaseWorkerThread::Erase(BaseJob *const work)
 {
 	bool retVal=false;
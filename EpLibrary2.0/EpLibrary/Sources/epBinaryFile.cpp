@@ -40,6 +40,7 @@ BinaryFile::BinaryFile(LockPolicy lockPolicyType)
 	switch(lockPolicyType)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_baseTextLock=EP_NEW CriticalSectionEx();
 		break;
 	case LOCK_POLICY_MUTEX:
@@ -61,6 +62,7 @@ BinaryFile::BinaryFile(const BinaryFile& b)
 	switch(m_lockPolicy)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_baseTextLock=EP_NEW CriticalSectionEx();
 		break;
 	case LOCK_POLICY_MUTEX:
@@ -95,6 +97,7 @@ BinaryFile & BinaryFile::operator=(const BinaryFile&b)
 		switch(m_lockPolicy)
 		{
 		case LOCK_POLICY_CRITICALSECTION:
+		case LOCK_POLICY_READWRITE:
 			m_baseTextLock=EP_NEW CriticalSectionEx();
 			break;
 		case LOCK_POLICY_MUTEX:
@@ -202,11 +205,11 @@ bool BinaryFile::LoadFromFile(const TCHAR *filename)
 	unsigned char *cFileBuf=EP_NEW unsigned char[length];
 	size_t read=System::FRead(cFileBuf,sizeof(unsigned char),length,m_file);
 	System::FClose(m_file);
-	EP_DELETE[] cFileBuf;
 
 	fileLock.Unlock();
 	m_stream.Clear();
-	m_stream.WriteBytes(cFileBuf,length);
+	m_stream.WriteBytes(cFileBuf,read);
+	EP_DELETE[] cFileBuf;
 	m_stream.SetSeek(Stream::STREAM_SEEK_TYPE_SEEK_SET);
 
 	m_file=NULL;
@@ -0,0 +1,378 @@
+/*! 
+epCpuTopology.cpp for the EpLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epCpuTopology.h"
+#include "epSystem.h"
+#include <algorithm>
+#if !defined(_WIN32) && !defined(_WIN64) && defined(__linux__)
+#include <dirent.h>
+#endif //!defined(_WIN32) && !defined(_WIN64) && defined(__linux__)
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epl;
+
+/// the maximum number of the processors which the affinity mask can describe
+#define EP_MAX_MASK_PROCESSORS (sizeof(DWORD_PTR)*8)
+
+/// the placement information of a processor
+struct ProcessorPlace
+{
+	/// the processor number
+	unsigned int m_processor;
+	/// the NUMA node index
+	unsigned int m_node;
+	/// the core identifier
+	unsigned int m_core;
+	/// the index of the hardware thread within the core
+	unsigned int m_smtRank;
+};
+
+static bool compactLess(const ProcessorPlace &a,const ProcessorPlace &b)
+{
+	if(a.m_node!=b.m_node)
+		return a.m_node<b.m_node;
+	if(a.m_core!=b.m_core)
+		return a.m_core<b.m_core;
+	return a.m_processor<b.m_processor;
+}
+
+static bool scatterLess(const ProcessorPlace &a,const ProcessorPlace &b)
+{
+	if(a.m_node!=b.m_node)
+		return a.m_node<b.m_node;
+	if(a.m_smtRank!=b.m_smtRank)
+		return a.m_smtRank<b.m_smtRank;
+	if(a.m_core!=b.m_core)
+		return a.m_core<b.m_core;
+	return a.m_processor<b.m_processor;
+}
+
+#if !defined(_WIN32) && !defined(_WIN64) && defined(__linux__)
+/*!
+Read the first unsigned integer from the given sysfs file.
+@param[in] fileName the file to read
+@param[out] retValue the value read
+@return true if read, otherwise false
+*/
+static bool readSysValue(const char *fileName,unsigned int &retValue)
+{
+	FILE *file=fopen(fileName,"r");
+	if(!file)
+		return false;
+	bool ret=(fscanf(file,"%u",&retValue)==1);
+	fclose(file);
+	return ret;
+}
+
+/*!
+Read the cpu list (i.e. "0-3,8-11") from the given sysfs file.
+@param[in] fileName the file to read
+@return the affinity mask of the cpu list
+*/
+static DWORD_PTR readSysCpuList(const char *fileName)
+{
+	DWORD_PTR retMask=0;
+	FILE *file=fopen(fileName,"r");
+	if(!file)
+		return retMask;
+	unsigned int first=0;
+	while(fscanf(file,"%u",&first)==1)
+	{
+		unsigned int last=first;
+		int delimiter=fgetc(file);
+		if(delimiter=='-')
+		{
+			if(fscanf(file,"%u",&last)!=1)
+				break;
+			delimiter=fgetc(file);
+		}
+		for(unsigned int trav=first;trav<=last && trav<EP_MAX_MASK_PROCESSORS;trav++)
+			retMask|=((DWORD_PTR)1)<<trav;
+		if(delimiter!=',')
+			break;
+	}
+	fclose(file);
+	return retMask;
+}
+#endif //!defined(_WIN32) && !defined(_WIN64) && defined(__linux__)
+
+CpuTopology::CpuTopology()
+{
+	m_processorNode.resize(EP_MAX_MASK_PROCESSORS,0);
+	std::vector<unsigned int> coreIds;
+	readTopology(coreIds);
+	if(m_compactOrder.empty())
+	{
+		// no topology information, so every core is a node 0 processor
+		unsigned int processorCount=(unsigned int)System::GetNumberOfCores();
+		if(processorCount==0)
+			processorCount=1;
+		if(processorCount>EP_MAX_MASK_PROCESSORS)
+			processorCount=EP_MAX_MASK_PROCESSORS;
+		m_nodeMasks.clear();
+		m_nodeMasks.push_back(0);
+		coreIds.clear();
+		for(unsigned int trav=0;trav<processorCount;trav++)
+		{
+			m_compactOrder.push_back(trav);
+			coreIds.push_back(trav);
+			m_processorNode[trav]=0;
+			m_nodeMasks[0]|=((DWORD_PTR)1)<<trav;
+		}
+	}
+	buildOrders(coreIds);
+}
+
+CpuTopology::~CpuTopology()
+{
+}
+
+void CpuTopology::readTopology(std::vector<unsigned int> &retCoreIds)
+{
+#if defined(_WIN32) || defined(_WIN64)
+	DWORD_PTR processMask=0;
+	DWORD_PTR systemMask=0;
+	if(!GetProcessAffinityMask(GetCurrentProcess(),&processMask,&systemMask) || processMask==0)
+		return;
+
+	ULONG highestNode=0;
+	if(!GetNumaHighestNodeNumber(&highestNode))
+		highestNode=0;
+	for(ULONG nodeTrav=0;nodeTrav<=highestNode;nodeTrav++)
+	{
+		ULONGLONG nodeMask=0;
+		if(!GetNumaNodeProcessorMask((UCHAR)nodeTrav,&nodeMask))
+			continue;
+		DWORD_PTR availableMask=((DWORD_PTR)nodeMask)&processMask;
+		if(availableMask)
+			m_nodeMasks.push_back(availableMask);
+	}
+	if(m_nodeMasks.empty())
+		m_nodeMasks.push_back(processMask);
+
+	std::vector<unsigned int> processorCore(EP_MAX_MASK_PROCESSORS,0);
+	for(unsigned int trav=0;trav<EP_MAX_MASK_PROCESSORS;trav++)
+		processorCore[trav]=trav;
+	DWORD bufferSize=0;
+	if(!GetLogicalProcessorInformation(NULL,&bufferSize) && GetLastError()==ERROR_INSUFFICIENT_BUFFER && bufferSize>0)
+	{
+		std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> infos(bufferSize/sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION)+1);
+		if(GetLogicalProcessorInformation(&infos.at(0),&bufferSize))
+		{
+			unsigned int infoCount=bufferSize/sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
+			for(unsigned int infoTrav=0;infoTrav<infoCount;infoTrav++)
+			{
+				if(infos[infoTrav].Relationship!=RelationProcessorCore)
+					continue;
+				for(unsigned int trav=0;trav<EP_MAX_MASK_PROCESSORS;trav++)
+				{
+					if(infos[infoTrav].ProcessorMask&(((ULONG_PTR)1)<<trav))
+						processorCore[trav]=EP_MAX_MASK_PROCESSORS+infoTrav;
+				}
+			}
+		}
+	}
+	for(unsigned int nodeTrav=0;nodeTrav<m_nodeMasks.size();nodeTrav++)
+	{
+		for(unsigned int trav=0;trav<EP_MAX_MASK_PROCESSORS;trav++)
+		{
+			if(m_nodeMasks[nodeTrav]&(((DWORD_PTR)1)<<trav))
+			{
+				m_compactOrder.push_back(trav);
+				retCoreIds.push_back(processorCore[trav]);
+				m_processorNode[trav]=nodeTrav;
+			}
+		}
+	}
+#elif defined(__linux__) //defined(_WIN32) || defined(_WIN64)
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	if(sched_getaffinity(0,sizeof(cpu_set_t),&cpuSet)!=0)
+		return;
+	DWORD_PTR processMask=0;
+	for(unsigned int trav=0;trav<EP_MAX_MASK_PROCESSORS;trav++)
+	{
+		if(CPU_ISSET(trav,&cpuSet))
+			processMask|=((DWORD_PTR)1)<<trav;
+	}
+	if(processMask==0)
+		return;
+
+	// the node directories may be sparse, so collect and sort the node numbers
+	std::vector<unsigned int> nodeIds;
+	DIR *nodeDir=opendir("/sys/devices/system/node");
+	if(nodeDir)
+	{
+		struct dirent *entry;
+		while((entry=readdir(nodeDir))!=NULL)
+		{
+			unsigned int nodeId=0;
+			char tail=0;
+			if(sscanf(entry->d_name,"node%u%c",&nodeId,&tail)==1)
+				nodeIds.push_back(nodeId);
+		}
+		closedir(nodeDir);
+	}
+	std::sort(nodeIds.begin(),nodeIds.end());
+	char fileName[128];
+	for(unsigned int nodeTrav=0;nodeTrav<nodeIds.size();nodeTrav++)
+	{
+		snprintf(fileName,sizeof(fileName),"/sys/devices/system/node/node%u/cpulist",nodeIds[nodeTrav]);
+		DWORD_PTR availableMask=readSysCpuList(fileName)&processMask;
+		if(availableMask)
+			m_nodeMasks.push_back(availableMask);
+	}
+	// the processors which are not listed in any node belong to the first node
+	DWORD_PTR listedMask=0;
+	for(unsigned int nodeTrav=0;nodeTrav<m_nodeMasks.size();nodeTrav++)
+		listedMask|=m_nodeMasks[nodeTrav];
+	if(m_nodeMasks.empty())
+		m_nodeMasks.push_back(processMask);
+	else
+		m_nodeMasks[0]|=processMask&~listedMask;
+
+	for(unsigned int nodeTrav=0;nodeTrav<m_nodeMasks.size();nodeTrav++)
+	{
+		for(unsigned int trav=0;trav<EP_MAX_MASK_PROCESSORS;trav++)
+		{
+			if(!(m_nodeMasks[nodeTrav]&(((DWORD_PTR)1)<<trav)))
+				continue;
+			unsigned int packageId=0;
+			unsigned int coreId=trav;
+			snprintf(fileName,sizeof(fileName),"/sys/devices/system/cpu/cpu%u/topology/physical_package_id",trav);
+			readSysValue(fileName,packageId);
+			snprintf(fileName,sizeof(fileName),"/sys/devices/system/cpu/cpu%u/topology/core_id",trav);
+			readSysValue(fileName,coreId);
+			m_compactOrder.push_back(trav);
+			retCoreIds.push_back((packageId<<16)|(coreId&0xFFFF));
+			m_processorNode[trav]=nodeTrav;
+		}
+	}
+#else //defined(_WIN32) || defined(_WIN64)
+	// no topology information on this platform, so the fallback of the constructor is used
+	(void)retCoreIds;
+#endif //defined(_WIN32) || defined(_WIN64)
+}
+
+void CpuTopology::buildOrders(const std::vector<unsigned int> &coreIds)
+{
+	std::vector<ProcessorPlace> places(m_compactOrder.size());
+	unsigned int trav;
+	for(trav=0;trav<places.size();trav++)
+	{
+		places[trav].m_processor=m_compactOrder[trav];
+		places[trav].m_node=m_processorNode[m_compactOrder[trav]];
+		places[trav].m_core=coreIds[trav];
+		places[trav].m_smtRank=0;
+	}
+	std::sort(places.begin(),places.end(),compactLess);
+	for(trav=1;trav<places.size();trav++)
+	{
+		if(places[trav].m_node==places[trav-1].m_node && places[trav].m_core==places[trav-1].m_core)
+			places[trav].m_smtRank=places[trav-1].m_smtRank+1;
+	}
+	for(trav=0;trav<places.size();trav++)
+		m_compactOrder[trav]=places[trav].m_processor;
+
+	// scatter takes the processors of the nodes in turn
+	std::sort(places.begin(),places.end(),scatterLess);
+	std::vector<unsigned int> nodeStart(m_nodeMasks.size()+1,0);
+	for(trav=0;trav<places.size();trav++)
+		nodeStart[places[trav].m_node+1]++;
+	for(trav=1;trav<nodeStart.size();trav++)
+		nodeStart[trav]+=nodeStart[trav-1];
+	std::vector<unsigned int> nodeTaken(m_nodeMasks.size(),0);
+	m_scatterOrder.clear();
+	while(m_scatterOrder.size()<places.size())
+	{
+		for(unsigned int nodeTrav=0;nodeTrav<m_nodeMasks.size();nodeTrav++)
+		{
+			if(nodeStart[nodeTrav]+nodeTaken[nodeTrav]<nodeStart[nodeTrav+1])
+			{
+				m_scatterOrder.push_back(places[nodeStart[nodeTrav]+nodeTaken[nodeTrav]].m_processor);
+				nodeTaken[nodeTrav]++;
+			}
+		}
+	}
+}
+
+unsigned int CpuTopology::GetProcessorCount() const
+{
+	return (unsigned int)m_compactOrder.size();
+}
+
+unsigned int CpuTopology::GetNumaNodeCount() const
+{
+	return (unsigned int)m_nodeMasks.size();
+}
+
+unsigned int CpuTopology::GetProcessorNumaNode(unsigned int processor) const
+{
+	if(processor>=m_processorNode.size())
+		return 0;
+	return m_processorNode[processor];
+}
+
+DWORD_PTR CpuTopology::GetNumaNodeAffinityMask(unsigned int nodeIdx) const
+{
+	if(nodeIdx>=m_nodeMasks.size())
+		return 0;
+	return m_nodeMasks[nodeIdx];
+}
+
+unsigned int CpuTopology::GetNumaNodeProcessorCount(unsigned int nodeIdx) const
+{
+	unsigned int retCount=0;
+	DWORD_PTR nodeMask=GetNumaNodeAffinityMask(nodeIdx);
+	for(;nodeMask;nodeMask&=nodeMask-1)
+		retCount++;
+	return retCount;
+}
+
+unsigned int CpuTopology::GetCurrentNumaNode() const
+{
+	if(m_nodeMasks.size()<=1)
+		return 0;
+#if (defined(_WIN32) || defined(_WIN64)) && (WINVER<WINDOWS_VISTA)
+	return 0;
+#else //(defined(_WIN32) || defined(_WIN64)) && (WINVER<WINDOWS_VISTA)
+	return GetProcessorNumaNode((unsigned int)GetCurrentProcessorNumber());
+#endif //(defined(_WIN32) || defined(_WIN64)) && (WINVER<WINDOWS_VISTA)
+}
+
+unsigned int CpuTopology::GetCompactProcessor(unsigned int order) const
+{
+	return m_compactOrder[order%m_compactOrder.size()];
+}
+
+unsigned int CpuTopology::GetScatterProcessor(unsigned int order) const
+{
+	return m_scatterOrder[order%m_scatterOrder.size()];
+}
@@ -37,6 +37,7 @@ static char THIS_FILE[] = __FILE__;
 using namespace epl;
 
 
+#if defined(_WIN32) || defined(_WIN64)
 CriticalSectionEx::CriticalSectionEx() :BaseLock()
 {
 	InitializeCriticalSection(&m_criticalSection);
@@ -116,4 +117,68 @@ void CriticalSectionEx::Unlock()
 	EP_ASSERT_EXPR(m_lockCounter>=0,_T("Lock Counter is less than 0!"));
 	LeaveCriticalSection(&m_criticalSection);
 }
+#else //defined(_WIN32) || defined(_WIN64)
 
+CriticalSectionEx::CriticalSectionEx() :BaseLock()
+{
+	EpInitRecursiveMutex(&m_criticalSection);
+	m_lockCounter=0;
+}
+
+CriticalSectionEx::CriticalSectionEx(const CriticalSectionEx& /*b*/):BaseLock()
+{
+	EpInitRecursiveMutex(&m_criticalSection);
+	m_lockCounter=0;
+}
+
+CriticalSectionEx::~CriticalSectionEx()
+{
+	EP_ASSERT_EXPR(m_lockCounter==0,_T("Lock Counter is not 0!"));
+	pthread_mutex_destroy(&m_criticalSection);
+}
+CriticalSectionEx & CriticalSectionEx::operator=(const CriticalSectionEx&b)
+{
+	if(this!=&b)
+	{
+		EP_ASSERT_EXPR(m_lockCounter==0,_T("Lock Counter is not 0!"));
+		pthread_mutex_destroy(&m_criticalSection);
+
+		EpInitRecursiveMutex(&m_criticalSection);
+		m_lockCounter=0;
+	}
+	return *this;
+}
+
+bool CriticalSectionEx::Lock()
+{
+	pthread_mutex_lock(&m_criticalSection);
+	m_lockCounter++;
+	return true;
+}
+
+long CriticalSectionEx::TryLock()
+{
+	if(pthread_mutex_trylock(&m_criticalSection)!=0)
+		return 0;
+	m_lockCounter++;
+	return 1;
+}
+long CriticalSectionEx::TryLockFor(const unsigned int dwMilliSecond)
+{
+	if(pthread_mutex_trylock(&m_criticalSection)!=0)
+	{
+		struct timespec absTime;
+		EpGetAbsTimeAfter(dwMilliSecond,&absTime);
+		if(pthread_mutex_timedlock(&m_criticalSection,&absTime)!=0)
+			return 0;
+	}
+	m_lockCounter++;
+	return 1;
+}
+void CriticalSectionEx::Unlock()
+{
+	m_lockCounter--;
+	EP_ASSERT_EXPR(m_lockCounter>=0,_T("Lock Counter is less than 0!"));
+	pthread_mutex_unlock(&m_criticalSection);
+}
+#endif //defined(_WIN32) || defined(_WIN64)
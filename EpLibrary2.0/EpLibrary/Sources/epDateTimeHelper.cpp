@@ -54,7 +54,7 @@ __int64 DateTimeHelper::Diff(const SYSTEMTIME &time1, const SYSTEMTIME &time2)
 	ft1.fileTime=SystemTimeToFileTime(time1);
 	ft2.fileTime=SystemTimeToFileTime(time2);
 
-	return __int64(ft1.ul.QuadPart) - __int64(ft2.ul.QuadPart); 
+	return (__int64)(ft1.ul.QuadPart) - (__int64)(ft2.ul.QuadPart); 
 }
 
 __int64 DateTimeHelper::AbsDiff(const SYSTEMTIME &time1, const SYSTEMTIME &time2)
@@ -78,22 +78,22 @@ __int64 DateTimeHelper::AbsDiff(const SYSTEMTIME &time1, const SYSTEMTIME &time2
 
 __int64 DateTimeHelper::DiffInMilliSec(const SYSTEMTIME &time1, const SYSTEMTIME &time2)
 {
-	return DateTimeHelper::Diff(time1,time2)/__int64(10000.0); 
+	return DateTimeHelper::Diff(time1,time2)/(__int64)(10000.0); 
 }
 
 __int64 DateTimeHelper::AbsDiffInMilliSec(const SYSTEMTIME &time1, const SYSTEMTIME &time2)
 {
-	return DateTimeHelper::AbsDiff(time1,time2)/__int64(10000.0); 
+	return DateTimeHelper::AbsDiff(time1,time2)/(__int64)(10000.0); 
 }
 
 __int64 DateTimeHelper::DiffInSec(const SYSTEMTIME &time1, const SYSTEMTIME &time2)
 {
-	return DateTimeHelper::Diff(time1,time2)/__int64(10000000.0); 
+	return DateTimeHelper::Diff(time1,time2)/(__int64)(10000000.0); 
 }
 
 __int64 DateTimeHelper::AbsDiffInSec(const SYSTEMTIME &time1, const SYSTEMTIME &time2)
 {
-	return DateTimeHelper::AbsDiff(time1,time2)/__int64(10000000.0); 
+	return DateTimeHelper::AbsDiff(time1,time2)/(__int64)(10000000.0); 
 }
 
 
@@ -219,7 +219,7 @@ __int64 DateTimeHelper::Diff(const FILETIME &time1, const FILETIME &time2)
 	ft1.fileTime=time1;
 	ft2.fileTime=time2;
 
-	return __int64(ft1.ul.QuadPart) - __int64(ft2.ul.QuadPart); 
+	return (__int64)(ft1.ul.QuadPart) - (__int64)(ft2.ul.QuadPart); 
 }
 
 __int64 DateTimeHelper::AbsDiff(const FILETIME &time1, const FILETIME &time2)
@@ -242,22 +242,22 @@ __int64 DateTimeHelper::AbsDiff(const FILETIME &time1, const FILETIME &time2)
 
 __int64 DateTimeHelper::DiffInMilliSec(const FILETIME &time1, const FILETIME &time2)
 {
-	return DateTimeHelper::Diff(time1,time2)/__int64(10000.0); 
+	return DateTimeHelper::Diff(time1,time2)/(__int64)(10000.0); 
 }
 
 __int64 DateTimeHelper::AbsDiffInMilliSec(const FILETIME &time1, const FILETIME &time2)
 {
-	return DateTimeHelper::AbsDiff(time1,time2)/__int64(10000.0); 
+	return DateTimeHelper::AbsDiff(time1,time2)/(__int64)(10000.0); 
 }
 
 __int64 DateTimeHelper::DiffInSec(const FILETIME &time1, const FILETIME &time2)
 {
-	return DateTimeHelper::Diff(time1,time2)/__int64(10000000.0); 
+	return DateTimeHelper::Diff(time1,time2)/(__int64)(10000000.0); 
 }
 
 __int64 DateTimeHelper::AbsDiffInSec(const FILETIME &time1, const FILETIME &time2)
 {
-	return DateTimeHelper::AbsDiff(time1,time2)/__int64(10000000.0); 
+	return DateTimeHelper::AbsDiff(time1,time2)/(__int64)(10000000.0); 
 }
 
 
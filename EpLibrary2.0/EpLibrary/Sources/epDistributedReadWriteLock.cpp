@@ -0,0 +1,223 @@
+/*! 
+DistributedReadWriteLock for the EpLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epDistributedReadWriteLock.h"
+#include "epSystem.h"
+#include "epException.h"
+#include "epDateTimeHelper.h"
+#include "epMemory.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epl;
+
+DistributedReadWriteLock::DistributedReadWriteLock(unsigned int slotCount) :BaseLock(),m_writerLock(),m_noReaderEvent(false,false),m_writerDoneEvent(true,true)
+{
+	m_writerFlag=0;
+	m_writerRecursion=0;
+	createSlots(slotCount);
+}
+
+DistributedReadWriteLock::DistributedReadWriteLock(const DistributedReadWriteLock& b) :BaseLock(),m_writerLock(),m_noReaderEvent(false,false),m_writerDoneEvent(true,true)
+{
+	m_writerFlag=0;
+	m_writerRecursion=0;
+	createSlots(b.m_slotCount);
+}
+
+DistributedReadWriteLock::~DistributedReadWriteLock()
+{
+	EP_ASSERT_EXPR(m_writerFlag==0 && !hasReader(),_T("Lock is still held!"));
+	EP_Free(m_slotBuffer);
+}
+
+DistributedReadWriteLock & DistributedReadWriteLock::operator=(const DistributedReadWriteLock&b)
+{
+	if(this!=&b)
+	{
+		EP_ASSERT_EXPR(m_writerFlag==0 && !hasReader(),_T("Lock is still held!"));
+	}
+	return *this;
+}
+
+unsigned int DistributedReadWriteLock::GetSlotCount() const
+{
+	return m_slotCount;
+}
+
+void DistributedReadWriteLock::createSlots(unsigned int slotCount)
+{
+	if(slotCount==0)
+		slotCount=(unsigned int)System::GetNumberOfCores();
+	if(slotCount>DISTRIBUTED_READ_WRITE_LOCK_MAX_SLOT_COUNT)
+		slotCount=DISTRIBUTED_READ_WRITE_LOCK_MAX_SLOT_COUNT;
+	m_slotCount=1;
+	while(m_slotCount<slotCount)
+		m_slotCount<<=1;
+
+	// one more cache line to align the first slot
+	m_slotBuffer=reinterpret_cast<char*>(EP_Malloc(sizeof(ReaderSlot)*(m_slotCount+1)));
+	size_t alignedAddr=(reinterpret_cast<size_t>(m_slotBuffer)+EP_CACHE_LINE_SIZE-1)&~(size_t)(EP_CACHE_LINE_SIZE-1);
+	m_slots=reinterpret_cast<ReaderSlot*>(alignedAddr);
+	for(unsigned int trav=0;trav<m_slotCount;trav++)
+		m_slots[trav].m_readerCount=0;
+}
+
+DistributedReadWriteLock::ReaderSlot &DistributedReadWriteLock::currentSlot()
+{
+	// the slot is chosen by the thread rather than the processor,
+	// so UnlockShared finds the same slot even if the thread migrated in between.
+	// The thread IDs are multiples of 4 on Windows and sequential on Linux,
+	// so the ID is hashed (Fibonacci hashing), and the top bits of the hash pick the slot.
+	unsigned int hash=(unsigned int)GetCurrentThreadId()*2654435769U;
+	return m_slots[(unsigned int)(((unsigned __int64)hash*m_slotCount)>>32)];
+}
+
+bool DistributedReadWriteLock::hasReader() const
+{
+	for(unsigned int trav=0;trav<m_slotCount;trav++)
+	{
+		if(m_slots[trav].m_readerCount!=0)
+			return true;
+	}
+	return false;
+}
+
+bool DistributedReadWriteLock::Lock()
+{
+	m_writerLock.Lock();
+	if(m_writerRecursion++>0)
+		return true;
+	beginWrite();
+	while(hasReader())
+	{
+		m_noReaderEvent.WaitForEvent();
+	}
+	return true;
+}
+
+long DistributedReadWriteLock::TryLock()
+{
+	if(!m_writerLock.TryLock())
+		return 0;
+	if(m_writerRecursion>0)
+	{
+		m_writerRecursion++;
+		return 1;
+	}
+	beginWrite();
+	if(hasReader())
+	{
+		endWrite();
+		m_writerLock.Unlock();
+		return 0;
+	}
+	m_writerRecursion++;
+	return 1;
+}
+
+long DistributedReadWriteLock::TryLockFor(const unsigned int dwMilliSecond)
+{
+	SYSTEMTIME startTime=DateTimeHelper::GetCurrentDateTime();
+	if(!m_writerLock.TryLockFor(dwMilliSecond))
+		return 0;
+	if(m_writerRecursion++>0)
+		return 1;
+	beginWrite();
+	while(hasReader())
+	{
+		__int64 waitTime=(__int64)dwMilliSecond-DateTimeHelper::AbsDiffInMilliSec(DateTimeHelper::GetCurrentDateTime(),startTime);
+		if(waitTime<0)
+			waitTime=0;
+		if(!m_noReaderEvent.WaitForEvent((unsigned int)waitTime) && hasReader())
+		{
+			m_writerRecursion--;
+			endWrite();
+			m_writerLock.Unlock();
+			return 0;
+		}
+	}
+	return 1;
+}
+
+void DistributedReadWriteLock::Unlock()
+{
+	EP_ASSERT_EXPR(m_writerRecursion>0,_T("Lock is not held!"));
+	if(--m_writerRecursion==0)
+		endWrite();
+	m_writerLock.Unlock();
+}
+
+bool DistributedReadWriteLock::LockShared()
+{
+	ReaderSlot &slot=currentSlot();
+	while(true)
+	{
+		// the interlocked increment orders the slot before the flag read,
+		// as the writer orders the flag before the slot reads
+		InterlockedIncrement(&slot.m_readerCount);
+		if(m_writerFlag==0)
+			return true;
+		if(InterlockedDecrement(&slot.m_readerCount)==0)
+			m_noReaderEvent.SetEvent();
+		m_writerDoneEvent.WaitForEvent();
+	}
+}
+
+long DistributedReadWriteLock::TryLockShared()
+{
+	ReaderSlot &slot=currentSlot();
+	InterlockedIncrement(&slot.m_readerCount);
+	if(m_writerFlag==0)
+		return 1;
+	if(InterlockedDecrement(&slot.m_readerCount)==0)
+		m_noReaderEvent.SetEvent();
+	return 0;
+}
+
+void DistributedReadWriteLock::UnlockShared()
+{
+	long readerCount=InterlockedDecrement(&currentSlot().m_readerCount);
+	EP_ASSERT_EXPR(readerCount>=0,_T("Shared lock is not held!"));
+	// the last reader of the slot wakes the writer waiting, which checks the other slots again
+	if(readerCount==0 && m_writerFlag)
+		m_noReaderEvent.SetEvent();
+}
+
+void DistributedReadWriteLock::beginWrite()
+{
+	m_writerDoneEvent.ResetEvent();
+	InterlockedExchange(&m_writerFlag,1);
+}
+
+void DistributedReadWriteLock::endWrite()
+{
+	InterlockedExchange(&m_writerFlag,0);
+	m_writerDoneEvent.SetEvent();
+}
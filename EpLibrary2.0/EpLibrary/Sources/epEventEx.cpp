@@ -163,7 +163,7 @@ bool EventEx::Lock()
 #endif // defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
 
 	bool returnVal=true;
-	unsigned long res=System::WaitForSingleObject(m_event,WAITTIME_INIFINITE);
+	System::WaitForSingleObject(m_event,WAITTIME_INIFINITE);
 #if defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
 	System::WaitForSingleObject(m_eventDebug,WAITTIME_INIFINITE);
 	m_threadID=threadID;
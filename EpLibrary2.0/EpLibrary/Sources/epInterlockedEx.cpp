@@ -45,7 +45,7 @@ InterlockedEx::InterlockedEx() :BaseLock()
 	m_threadID=0;
 #endif //defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
 }
-InterlockedEx::InterlockedEx(const InterlockedEx& b) :BaseLock()
+InterlockedEx::InterlockedEx(const InterlockedEx& /*b*/) :BaseLock()
 {
 	m_interLock=0;
 #if defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
@@ -79,7 +79,9 @@ bool InterlockedEx::Lock()
 #endif //defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
 	while(InterlockedExchange(&m_interLock, 1)	!= 0)
 	{
-		Sleep(0);
+		// wait on the plain read, so the waiters do not keep bouncing the cache line
+		while(m_interLock!=0)
+			Sleep(0);
 	}
 #if defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
 	while(InterlockedExchange(&m_interLockDebug, 1)	!= 0)
@@ -152,6 +154,7 @@ long InterlockedEx::TryLockFor(const unsigned int dwMilliSecond)
 		else
 		{
 			ret=1;
+			break;
 		}
 	}while(waitTime>0);
 #if defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
@@ -42,6 +42,7 @@ IpcClient::IpcClient(epl::LockPolicy lockPolicyType)
 	switch(lockPolicyType)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_writeQueueLock=EP_NEW CriticalSectionEx();
 		break;
 	case LOCK_POLICY_MUTEX:
@@ -49,6 +49,7 @@ IpcPipe::IpcPipe(EpTString pipeName, IpcServerOps options,epl::LockPolicy lockPo
 	switch(lockPolicyType)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_writeQueueLock=EP_NEW CriticalSectionEx();
 		break;
 	case LOCK_POLICY_MUTEX:
@@ -39,6 +39,7 @@ IpcServer::IpcServer(epl::LockPolicy lockPolicyType):Thread(EP_THREAD_PRIORITY_N
 	switch(m_lockPolicy)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_pipesLock=EP_NEW CriticalSectionEx();
 		break;
 	case LOCK_POLICY_MUTEX:
@@ -33,8 +33,9 @@ static char THIS_FILE[] = __FILE__;
 #endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
 
 using namespace epl;
-JobScheduleQueue::JobScheduleQueue(LockPolicy lockPolicyType) :ThreadSafePQueue<BaseJob*, BaseJob>(lockPolicyType)
+JobScheduleQueue::JobScheduleQueue(LockPolicy lockPolicyType) :ThreadSafeQueue<BaseJob*>(lockPolicyType)
 {
+	m_pushCount=0;
 }
 
 JobScheduleQueue::~JobScheduleQueue()
@@ -48,48 +49,229 @@ JobScheduleQueue::~JobScheduleQueue()
 void JobScheduleQueue::Push(BaseJob* const &data, BaseJob::JobStatus status)
 {
 	data->RetainObj();
-	ThreadSafePQueue::Push(data);
+	m_queueLock.Lock();
+	StoreRelease(&data->m_scheduleQueue,this);
+	data->m_scheduleSeq=m_pushCount++;
+	setAt(m_queue.Size(),data);
+	heapifyUp(data->m_scheduleIdx);
+	m_queueLock.Unlock();
 	if(status!=BaseJob::JOB_STATUS_NONE)
 	{
 		data->JobReport(status);
 	}
 }
+void JobScheduleQueue::PushBatch(BaseJob* const *datas,size_t count,const BaseJob::JobStatus status)
+{
+	size_t trav;
+	for(trav=0;trav<count;trav++)
+	{
+		datas[trav]->RetainObj();
+	}
+	m_queueLock.Lock();
+	m_queue.Reserve(m_queue.Size()+count);
+	for(trav=0;trav<count;trav++)
+	{
+		BaseJob *data=datas[trav];
+		StoreRelease(&data->m_scheduleQueue,this);
+		data->m_scheduleSeq=m_pushCount++;
+		setAt(m_queue.Size(),data);
+		heapifyUp(data->m_scheduleIdx);
+	}
+	m_queueLock.Unlock();
+	if(status!=BaseJob::JOB_STATUS_NONE)
+	{
+		for(trav=0;trav<count;trav++)
+		{
+			datas[trav]->JobReport(status);
+		}
+	}
+}
+
 void JobScheduleQueue::Pop()
 {
-	BaseJob* jobObj=Front();
+	m_queueLock.Lock();
+	if(m_queue.IsEmpty())
+	{
+		m_queueLock.Unlock();
+		EP_ASSERT_EXPR(0,_T("Empty Queue"));
+		return;
+	}
+	BaseJob* jobObj=m_queue.Front();
+	removeAt(0);
+	m_queueLock.Unlock();
 	jobObj->ReleaseObj();
-	ThreadSafePQueue::Pop();
+}
+
+size_t JobScheduleQueue::PopBatch(BaseJob **retDatas,size_t maxCount)
+{
+	LockGuard<RuntimeLock> lock(m_queueLock);
+	size_t retCount=0;
+	while(retCount<maxCount && !m_queue.IsEmpty())
+	{
+		retDatas[retCount++]=m_queue.Front();
+		removeAt(0);
+	}
+	return retCount;
+}
 
+BaseJob* &JobScheduleQueue::Back()
+{
+	LockGuard<RuntimeLock> lock(m_queueLock);
+	if(m_queue.IsEmpty())
+	{
+		EP_ASSERT_EXPR(0,_T("Empty Queue"));
+	}
+	// the last job to pop is one of the leaves
+	size_t lastIdx=m_queue.Size()/2;
+	for(size_t trav=lastIdx+1;trav<m_queue.Size();trav++)
+	{
+		if(isPrior(m_queue.At(lastIdx),m_queue.At(trav)))
+			lastIdx=trav;
+	}
+	return m_queue.At(lastIdx);
+}
+
+void JobScheduleQueue::Clear()
+{
+	m_queueLock.Lock();
+	std::vector<BaseJob*> jobs;
+	jobs.reserve(m_queue.Size());
+	while(!m_queue.IsEmpty())
+	{
+		BaseJob *jobObj=m_queue.Back();
+		m_queue.PopBack();
+		if(jobObj->m_scheduleQueue==this)
+			StoreRelease(&jobObj->m_scheduleQueue,(JobScheduleQueue*)NULL);
+		jobs.push_back(jobObj);
+	}
+	m_queueLock.Unlock();
+	for(size_t trav=0;trav<jobs.size();trav++)
+	{
+		jobs[trav]->ReleaseObj();
+	}
 }
 
 bool JobScheduleQueue::Erase(BaseJob * const object)
 {
-	LockObj lock(m_queueLock);
-	if(m_queue.empty())
-		return false;
-	std::vector<BaseJob*>::iterator iter;
-	for(iter=m_queue.begin();iter!=m_queue.end();iter++)
+	m_queueLock.Lock();
+	size_t idx=findIndex(object);
+	if(idx==m_queue.Size())
 	{
-		if(*iter==object)
-		{
-			(*iter)->JobReport(BaseJob::JOB_STATUS_TIMEOUT);
-			(*iter)->ReleaseObj();
-			m_queue.erase(iter);
-			return true;
-		}
+		m_queueLock.Unlock();
+		return false;
 	}
-	return false;
+	removeAt(idx);
+	m_queueLock.Unlock();
+	object->JobReport(BaseJob::JOB_STATUS_TIMEOUT);
+	object->ReleaseObj();
+	return true;
 }
 
-void JobScheduleQueue::ReportAllJob(const BaseJob::JobStatus status)
+void JobScheduleQueue::ReportAllJob(const BaseJob::JobStatus /*status*/)
 {
 	std::vector<BaseJob *>::iterator iter;
-	m_queueLock->Lock();
-	std::vector<BaseJob *> queue=m_queue;
-	m_queueLock->Unlock();
+	std::vector<BaseJob *> queue=GetQueue();
 	for(iter=queue.begin();iter!=queue.end();iter++)
 	{
 		(*iter)->JobReport(BaseJob::JOB_STATUS_INCOMPLETE);
 	}
 
-}
\ No newline at end of file
+}
+
+bool JobScheduleQueue::changePriority(BaseJob * const object, Priority newPrio)
+{
+	LockGuard<RuntimeLock> lock(m_queueLock);
+	if(object->m_scheduleQueue!=this)
+		return false;
+	StoreRelease(&object->m_priority,newPrio);
+	size_t idx=findIndex(object);
+	if(idx==m_queue.Size())
+		return true;
+	if(heapifyUp(idx)==idx)
+		heapifyDown(idx);
+	return true;
+}
+
+size_t JobScheduleQueue::findIndex(BaseJob * const object) const
+{
+	if(object->m_scheduleQueue==this && object->m_scheduleIdx<m_queue.Size() && m_queue.At(object->m_scheduleIdx)==object)
+		return object->m_scheduleIdx;
+
+	// the job's handle is not for this queue (i.e. the queue is a copy)
+	for(size_t trav=0;trav<m_queue.Size();trav++)
+	{
+		if(m_queue.At(trav)==object)
+			return trav;
+	}
+	return m_queue.Size();
+}
+
+void JobScheduleQueue::removeAt(size_t idx)
+{
+	BaseJob *object=m_queue.At(idx);
+	size_t lastIdx=m_queue.Size()-1;
+	if(idx!=lastIdx)
+		setAt(idx,m_queue.At(lastIdx));
+	m_queue.PopBack();
+	if(idx<m_queue.Size())
+	{
+		if(heapifyUp(idx)==idx)
+			heapifyDown(idx);
+	}
+	if(object->m_scheduleQueue==this)
+		StoreRelease(&object->m_scheduleQueue,(JobScheduleQueue*)NULL);
+}
+
+bool JobScheduleQueue::isPrior(const BaseJob *a, const BaseJob *b)
+{
+	if(a->m_priority!=b->m_priority)
+		return a->m_priority>b->m_priority;
+	return a->m_scheduleSeq<b->m_scheduleSeq;
+}
+
+void JobScheduleQueue::setAt(size_t idx, BaseJob * const object)
+{
+	if(idx==m_queue.Size())
+		m_queue.PushBack(object);
+	else
+		m_queue.At(idx)=object;
+	if(object->m_scheduleQueue==this)
+		object->m_scheduleIdx=idx;
+}
+
+size_t JobScheduleQueue::heapifyUp(size_t idx)
+{
+	BaseJob *object=m_queue.At(idx);
+	while(idx>0)
+	{
+		size_t parentIdx=(idx-1)/2;
+		BaseJob *parent=m_queue.At(parentIdx);
+		if(!isPrior(object,parent))
+			break;
+		setAt(idx,parent);
+		idx=parentIdx;
+	}
+	setAt(idx,object);
+	return idx;
+}
+
+size_t JobScheduleQueue::heapifyDown(size_t idx)
+{
+	BaseJob *object=m_queue.At(idx);
+	size_t size=m_queue.Size();
+	while(true)
+	{
+		size_t childIdx=idx*2+1;
+		if(childIdx>=size)
+			break;
+		if(childIdx+1<size && isPrior(m_queue.At(childIdx+1),m_queue.At(childIdx)))
+			childIdx++;
+		BaseJob *child=m_queue.At(childIdx);
+		if(!isPrior(child,object))
+			break;
+		setAt(idx,child);
+		idx=childIdx;
+	}
+	setAt(idx,object);
+	return idx;
+}
@@ -0,0 +1,235 @@
+/*! 
+epLightJob.cpp for the EpLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epLightJob.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epl;
+
+/// the function pointer and the argument stored in the inline storage of LightJob
+struct LightJobFuncPtr
+{
+	/// the function to run
+	void (*m_func)(void *);
+	/// the argument for the function
+	void *m_arg;
+};
+
+LightJob::LightJob(LightJobPool *pool,LockPolicy lockPolicyType):BaseJob(PRIORITY_NORMAL,lockPolicyType)
+{
+	m_invokeFunc=NULL;
+	m_destroyFunc=NULL;
+	m_statusCallback=NULL;
+	m_callbackUserData=NULL;
+	m_pool=pool;
+	m_nextFree=NULL;
+}
+
+LightJob::~LightJob()
+{
+	resetFunc();
+}
+
+void LightJob::SetFunc(void (*func)(void *),void *arg)
+{
+	resetFunc();
+	LightJobFuncPtr *funcPtr=reinterpret_cast<LightJobFuncPtr*>(m_storage.m_bytes);
+	funcPtr->m_func=func;
+	funcPtr->m_arg=arg;
+	m_invokeFunc=&LightJob::invokeFuncPtr;
+}
+
+void LightJob::SetStatusCallback(StatusCallback callback,void *userData)
+{
+	m_statusCallback=callback;
+	m_callbackUserData=userData;
+}
+
+void LightJob::handleReport(const JobStatus status)
+{
+	if(m_statusCallback)
+		m_statusCallback(this,status,m_callbackUserData);
+}
+
+void LightJob::deleteObj()
+{
+	if(m_pool)
+		m_pool->recycle(this);
+	else
+		EP_DELETE this;
+}
+
+void LightJob::run()
+{
+	if(m_invokeFunc)
+		m_invokeFunc(m_storage.m_bytes);
+}
+
+void LightJob::resetFunc()
+{
+	if(m_destroyFunc)
+		m_destroyFunc(m_storage.m_bytes);
+	m_invokeFunc=NULL;
+	m_destroyFunc=NULL;
+}
+
+void LightJob::resetJob(Priority priority)
+{
+	m_status=JOB_STATUS_NONE;
+	m_priority=priority;
+	m_statusCallback=NULL;
+	m_callbackUserData=NULL;
+	m_nextFree=NULL;
+}
+
+void LightJob::invokeFuncPtr(void *storage)
+{
+	LightJobFuncPtr *funcPtr=reinterpret_cast<LightJobFuncPtr*>(storage);
+	funcPtr->m_func(funcPtr->m_arg);
+}
+
+LightJobPool::LightJobPool(size_t initialCount,LockPolicy lockPolicyType)
+{
+	m_freeList=NULL;
+	m_recycledList=NULL;
+	m_jobCount=0;
+	m_lockPolicy=lockPolicyType;
+	switch(lockPolicyType)
+	{
+	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
+		m_lock=EP_NEW CriticalSectionEx();
+		break;
+	case LOCK_POLICY_MUTEX:
+		m_lock=EP_NEW Mutex();
+		break;
+	case LOCK_POLICY_NONE:
+		m_lock=EP_NEW NoLock();
+		break;
+	default:
+		m_lock=NULL;
+		break;
+	}
+	for(size_t trav=0;trav<initialCount;trav++)
+	{
+		LightJob *job=EP_NEW LightJob(this,m_lockPolicy);
+		job->m_nextFree=m_freeList;
+		m_freeList=job;
+	}
+	m_jobCount=(long)initialCount;
+}
+
+LightJobPool::~LightJobPool()
+{
+	long freeCount=0;
+	LightJob *lists[]={m_freeList,m_recycledList};
+	for(int trav=0;trav<2;trav++)
+	{
+		while(lists[trav])
+		{
+			LightJob *job=lists[trav];
+			lists[trav]=job->m_nextFree;
+			EP_DELETE job;
+			freeCount++;
+		}
+	}
+	EP_ASSERT_EXPR(freeCount==m_jobCount,_T("Some LightJobs are not returned to the pool! Jobs not returned : %d"),(int)(m_jobCount-freeCount));
+	if(m_lock)
+		EP_DELETE m_lock;
+}
+
+LightJob *LightJobPool::Get(Priority priority)
+{
+	LightJob *retJob=NULL;
+	{
+		LockObj lock(m_lock);
+		if(!m_freeList && m_recycledList)
+			m_freeList=reinterpret_cast<LightJob*>(InterlockedExchangePointer(reinterpret_cast<void * volatile *>(&m_recycledList),NULL));
+		if(m_freeList)
+		{
+			retJob=m_freeList;
+			m_freeList=retJob->m_nextFree;
+		}
+	}
+	if(!retJob)
+	{
+		retJob=EP_NEW LightJob(this,m_lockPolicy);
+		InterlockedIncrement(&m_jobCount);
+	}
+	retJob->resetJob(priority);
+	return retJob;
+}
+
+size_t LightJobPool::GetFreeCount() const
+{
+	// the jobs in the recycled list only leave it through Get under the lock, so the lists can be walked safely
+	LockObj lock(m_lock);
+	size_t retCount=0;
+	LightJob *lists[]={m_freeList,m_recycledList};
+	for(int trav=0;trav<2;trav++)
+	{
+		for(LightJob *job=lists[trav];job;job=job->m_nextFree)
+			retCount++;
+	}
+	return retCount;
+}
+
+size_t LightJobPool::GetJobCount() const
+{
+	return (size_t)m_jobCount;
+}
+
+void LightJobPool::recycle(LightJob *job)
+{
+	// the callable is destroyed now, so the resources it holds are not kept while the job is in the free list
+	job->resetFunc();
+	job->m_statusCallback=NULL;
+	job->m_callbackUserData=NULL;
+	// only Get takes the jobs, and it takes the whole list at once, so pushing with compare-exchange is ABA-safe
+	LightJob *head;
+	do
+	{
+		head=m_recycledList;
+		job->m_nextFree=head;
+	}while(InterlockedCompareExchangePointer(reinterpret_cast<void * volatile *>(&m_recycledList),job,head)!=head);
+}
+
+LightJobProcessor::LightJobProcessor(LockPolicy lockPolicyType):BaseJobProcessor(lockPolicyType)
+{
+}
+
+LightJobProcessor::~LightJobProcessor()
+{
+}
+
+void LightJobProcessor::DoJob(BaseWorkerThread * /*workerThread*/,BaseJob* const data)
+{
+	static_cast<LightJob*>(data)->run();
+}
@@ -237,21 +237,33 @@ bool Locale::IsSpace(TCHAR c)
 	return std::isspace(c,loc);
 }
 
+// the predicates for skipping the trailing spaces
+static bool isNotCSpace(char c)
+{
+	return !Locale::IsCSpace(c);
+}
+static bool isNotWSpace(wchar_t c)
+{
+	return !Locale::IsWSpace(c);
+}
+static bool isNotSpace(TCHAR c)
+{
+	return !Locale::IsSpace(c);
+}
+
 EpString Locale::CTrimLeft(const EpString& str) 
 { 
-	EpString middleString;
-	EpString::const_iterator it = find_if(str.begin(), str.end(), std::ptr_fun(Locale::IsCPrint));
-	middleString=EpString(it, str.end());
-	it = find_if(middleString.begin(), middleString.end(), std::not1(std::ptr_fun(Locale::IsCSpace)));
+	EpString::const_iterator it = find_if(str.begin(), str.end(), Locale::IsCPrint);
+	const EpString middleString(it, str.end());
+	it = find_if(middleString.begin(), middleString.end(), isNotCSpace);
 	return EpString(it, middleString.end());
 } 
 
 EpString Locale::CTrimRight(const EpString& str) 
 { 
-	EpString middleString;
-	EpString::const_reverse_iterator it = find_if(str.rbegin(), str.rend(), std::ptr_fun(Locale::IsCPrint));
-	middleString=EpString(str.begin(), it.base());
-	it = find_if(middleString.rbegin(), middleString.rend(), std::not1(std::ptr_fun(Locale::IsCSpace)));
+	EpString::const_reverse_iterator it = find_if(str.rbegin(), str.rend(), Locale::IsCPrint);
+	const EpString middleString(str.begin(), it.base());
+	it = find_if(middleString.rbegin(), middleString.rend(), isNotCSpace);
 	return EpString(middleString.begin(), it.base());
 } 
 
@@ -261,19 +273,17 @@ EpString Locale::CTrim(const EpString& str)
 }
 EpWString Locale::WTrimLeft(const EpWString& str) 
 { 
-	EpWString middleString;
-	EpWString::const_iterator it = find_if(str.begin(), str.end(), std::ptr_fun(Locale::IsWPrint));
-	middleString=EpWString(it, str.end());
-	it = find_if(middleString.begin(), middleString.end(), std::not1(std::ptr_fun(Locale::IsWSpace)));
+	EpWString::const_iterator it = find_if(str.begin(), str.end(), Locale::IsWPrint);
+	const EpWString middleString(it, str.end());
+	it = find_if(middleString.begin(), middleString.end(), isNotWSpace);
 	return EpWString(it, middleString.end());
 } 
 
 EpWString Locale::WTrimRight(const EpWString& str) 
 { 
-	EpWString middleString;
-	EpWString::const_reverse_iterator it = find_if(str.rbegin(), str.rend(), std::ptr_fun(Locale::IsWPrint));
-	middleString=EpWString(str.begin(), it.base());
-	it = find_if(middleString.rbegin(), middleString.rend(), std::not1(std::ptr_fun(Locale::IsWSpace)));
+	EpWString::const_reverse_iterator it = find_if(str.rbegin(), str.rend(), Locale::IsWPrint);
+	const EpWString middleString(str.begin(), it.base());
+	it = find_if(middleString.rbegin(), middleString.rend(), isNotWSpace);
 	return EpWString(middleString.begin(), it.base());
 } 
 
@@ -285,19 +295,17 @@ EpWString Locale::WTrim(const EpWString& str)
 
 EpTString Locale::TrimLeft(const EpTString& str) 
 { 
-	EpTString middleString;
-	EpTString::const_iterator it = find_if(str.begin(), str.end(), std::ptr_fun(Locale::IsPrint));
-	middleString=EpTString(it, str.end());
-	it = find_if(middleString.begin(), middleString.end(), std::not1(std::ptr_fun(Locale::IsSpace)));
+	EpTString::const_iterator it = find_if(str.begin(), str.end(), Locale::IsPrint);
+	const EpTString middleString(it, str.end());
+	it = find_if(middleString.begin(), middleString.end(), isNotSpace);
 	return EpTString(it, middleString.end());
 } 
 
 EpTString Locale::TrimRight(const EpTString& str) 
 { 
-	EpTString middleString;
-	EpTString::const_reverse_iterator it = find_if(str.rbegin(), str.rend(), std::ptr_fun(Locale::IsPrint));
-	middleString=EpTString(str.begin(), it.base());
-	it = find_if(middleString.rbegin(), middleString.rend(), std::not1(std::ptr_fun(Locale::IsSpace)));
+	EpTString::const_reverse_iterator it = find_if(str.rbegin(), str.rend(), Locale::IsPrint);
+	const EpTString middleString(str.begin(), it.base());
+	it = find_if(middleString.rbegin(), middleString.rend(), isNotSpace);
 	return EpTString(middleString.begin(), it.base());
 } 
 
@@ -310,7 +318,7 @@ EpTString Locale::Trim(const EpTString& str)
 EpString Locale::ToCUpper(const EpString& str)
 {
 	EpString retString=str;
-	int stringTrav;
+	size_t stringTrav;
 	for(stringTrav=0;stringTrav!=retString.length();stringTrav++)
 	{
 		Locale::ToCUpper(retString.at(stringTrav));
@@ -320,7 +328,7 @@ EpString Locale::ToCUpper(const EpString& str)
 EpString Locale::ToCLower(const EpString& str)
 {
 	EpString retString=str;
-	int stringTrav;
+	size_t stringTrav;
 	for(stringTrav=0;stringTrav!=retString.length();stringTrav++)
 	{
 		Locale::ToCLower(retString.at(stringTrav));
@@ -330,7 +338,7 @@ EpString Locale::ToCLower(const EpString& str)
 EpWString Locale::ToWUpper(const EpWString& str)
 {
 	EpWString retString=str;
-	int stringTrav;
+	size_t stringTrav;
 	for(stringTrav=0;stringTrav!=retString.length();stringTrav++)
 	{
 		Locale::ToWUpper(retString.at(stringTrav));
@@ -340,7 +348,7 @@ EpWString Locale::ToWUpper(const EpWString& str)
 EpWString Locale::ToWLower(const EpWString& str)
 {
 	EpWString retString=str;
-	int stringTrav;
+	size_t stringTrav;
 	for(stringTrav=0;stringTrav!=retString.length();stringTrav++)
 	{
 		Locale::ToWLower(retString.at(stringTrav));
@@ -350,7 +358,7 @@ EpWString Locale::ToWLower(const EpWString& str)
 EpTString Locale::ToUpper(const EpTString& str)
 {
 	EpTString retString=str;
-	int stringTrav;
+	size_t stringTrav;
 	for(stringTrav=0;stringTrav!=retString.length();stringTrav++)
 	{
 		Locale::ToUpper(retString.at(stringTrav));
@@ -360,7 +368,7 @@ EpTString Locale::ToUpper(const EpTString& str)
 EpTString Locale::ToLower(const EpTString& str)
 {
 	EpTString retString=str;
-	int stringTrav;
+	size_t stringTrav;
 	for(stringTrav=0;stringTrav!=retString.length();stringTrav++)
 	{
 		Locale::ToLower(retString.at(stringTrav));
@@ -39,6 +39,7 @@ LogWorker::LogWorker(EpTString fileName,FileEncodingType encodingType,LockPolicy
 	switch(lockPolicyType)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_logLock=EP_NEW CriticalSectionEx();
 		m_threadLock=EP_NEW CriticalSectionEx();
 		break;
@@ -74,6 +75,7 @@ LogWorker::LogWorker(const LogWorker& b):BaseTextFile(b),Thread(b)
 	switch(BaseTextFile::m_lockPolicy)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_logLock=EP_NEW CriticalSectionEx();
 		m_threadLock=EP_NEW CriticalSectionEx();
 		break;
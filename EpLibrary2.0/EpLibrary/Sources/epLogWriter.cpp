@@ -38,6 +38,7 @@ LogWriter::LogWriter(LockPolicy lockPolicyType):BaseTextFile(FILE_ENCODING_TYPE_
 	switch(lockPolicyType)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_logLock=EP_NEW CriticalSectionEx();
 		break;
 	case LOCK_POLICY_MUTEX:
@@ -65,6 +66,7 @@ LogWriter::LogWriter(const LogWriter& b):BaseTextFile(b)
 	switch(m_lockPolicy)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_logLock=EP_NEW CriticalSectionEx();
 		break;
 	case LOCK_POLICY_MUTEX:
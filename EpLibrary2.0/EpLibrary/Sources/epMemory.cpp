@@ -0,0 +1,423 @@
+/*! 
+MemoryHook for the EpLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epMemory.h"
+#include "epAssert.h"
+#include <string.h>
+#include <vector>
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epl;
+
+/// the header put in front of each memory block (kept 16 bytes to preserve the alignment of malloc)
+struct MemoryHookHeader
+{
+	/// the allocator which owns the block (NULL for the heap)
+	BaseMemoryAllocator *m_allocator;
+	/// the size requested by the user
+	size_t m_size;
+};
+#define MEMORY_HOOK_HEADER_SIZE 16
+
+static MemoryHookHeader *getHeader(void *ptr)
+{
+	return reinterpret_cast<MemoryHookHeader*>(reinterpret_cast<char*>(ptr)-MEMORY_HOOK_HEADER_SIZE);
+}
+
+static DWORD getTlsIdx(volatile long &tlsIdx)
+{
+	// the index is allocated on first use and kept for the lifetime of the process
+	long idx=tlsIdx;
+	if(idx!=(long)TLS_OUT_OF_INDEXES)
+		return (DWORD)idx;
+	DWORD newIdx=TlsAlloc();
+	if(newIdx==TLS_OUT_OF_INDEXES)
+		return newIdx;
+	idx=InterlockedCompareExchange(&tlsIdx,(long)newIdx,(long)TLS_OUT_OF_INDEXES);
+	if(idx!=(long)TLS_OUT_OF_INDEXES)
+	{
+		TlsFree(newIdx);
+		return (DWORD)idx;
+	}
+	return newIdx;
+}
+
+/// the TLS index for the allocator of each thread
+static volatile long s_threadAllocatorIdx=(long)TLS_OUT_OF_INDEXES;
+
+static DWORD getThreadAllocatorIdx()
+{
+	return getTlsIdx(s_threadAllocatorIdx);
+}
+
+void *MemoryHook::Malloc(size_t size)
+{
+	BaseMemoryAllocator *allocator=GetThreadAllocator();
+	void *block;
+	if(allocator)
+		block=allocator->Allocate(size+MEMORY_HOOK_HEADER_SIZE);
+	else
+		block=malloc(size+MEMORY_HOOK_HEADER_SIZE);
+	if(!block)
+		return NULL;
+	MemoryHookHeader *header=reinterpret_cast<MemoryHookHeader*>(block);
+	header->m_allocator=allocator;
+	header->m_size=size;
+	return reinterpret_cast<char*>(block)+MEMORY_HOOK_HEADER_SIZE;
+}
+
+void *MemoryHook::Realloc(void *ptr, size_t size)
+{
+	if(!ptr)
+		return Malloc(size);
+	if(size==0)
+	{
+		Free(ptr);
+		return NULL;
+	}
+	MemoryHookHeader *header=getHeader(ptr);
+	BaseMemoryAllocator *allocator=header->m_allocator;
+	if(!allocator)
+	{
+		void *block=realloc(header,size+MEMORY_HOOK_HEADER_SIZE);
+		if(!block)
+			return NULL;
+		header=reinterpret_cast<MemoryHookHeader*>(block);
+		header->m_size=size;
+		return reinterpret_cast<char*>(block)+MEMORY_HOOK_HEADER_SIZE;
+	}
+
+	// the block stays with the allocator it came from
+	void *block=allocator->Allocate(size+MEMORY_HOOK_HEADER_SIZE);
+	if(!block)
+		return NULL;
+	MemoryHookHeader *newHeader=reinterpret_cast<MemoryHookHeader*>(block);
+	newHeader->m_allocator=allocator;
+	newHeader->m_size=size;
+	void *retPtr=reinterpret_cast<char*>(block)+MEMORY_HOOK_HEADER_SIZE;
+	memcpy(retPtr,ptr,(header->m_size<size)?header->m_size:size);
+	allocator->Deallocate(header,header->m_size+MEMORY_HOOK_HEADER_SIZE);
+	return retPtr;
+}
+
+void MemoryHook::Free(void *ptr)
+{
+	if(!ptr)
+		return;
+	MemoryHookHeader *header=getHeader(ptr);
+	if(header->m_allocator)
+		header->m_allocator->Deallocate(header,header->m_size+MEMORY_HOOK_HEADER_SIZE);
+	else
+		free(header);
+}
+
+BaseMemoryAllocator *MemoryHook::SetThreadAllocator(BaseMemoryAllocator *allocator)
+{
+	DWORD idx=getThreadAllocatorIdx();
+	EP_ASSERT_EXPR(idx!=TLS_OUT_OF_INDEXES,_T("Failed to allocate the thread local storage!"));
+	if(idx==TLS_OUT_OF_INDEXES)
+		return NULL;
+	BaseMemoryAllocator *prevAllocator=reinterpret_cast<BaseMemoryAllocator*>(TlsGetValue(idx));
+	TlsSetValue(idx,allocator);
+	return prevAllocator;
+}
+
+BaseMemoryAllocator *MemoryHook::GetThreadAllocator()
+{
+	DWORD idx=getThreadAllocatorIdx();
+	if(idx==TLS_OUT_OF_INDEXES)
+		return NULL;
+	return reinterpret_cast<BaseMemoryAllocator*>(TlsGetValue(idx));
+}
+
+/// the header put in front of each memory block tracked (kept 16 bytes to preserve the alignment of malloc)
+struct MemoryTrackerHeader
+{
+	/// the index of the call site allocated the block (-1 if not sampled)
+	int m_siteIdx;
+	/// the weight of the block in the statistics
+	int m_weight;
+	/// the size requested by the user
+	size_t m_size;
+};
+#define MEMORY_TRACKER_HEADER_SIZE 16
+
+/// the statistics of a call site
+struct MemoryTrackerSite
+{
+	/// the state of the entry (0: empty, 1: being claimed, 2: claimed)
+	volatile long m_state;
+	/// the file name of the call site
+	const char *m_fileName;
+	/// the line number of the call site
+	unsigned int m_lineNum;
+	/// the number of allocations
+	volatile __int64 m_allocCount;
+	/// the number of deallocations
+	volatile __int64 m_freeCount;
+	/// the total bytes allocated
+	volatile __int64 m_allocBytes;
+	/// the live bytes
+	volatile __int64 m_liveBytes;
+	/// the peak of the live bytes
+	volatile __int64 m_peakLiveBytes;
+};
+
+/// the call sites (the last entry is shared by the call sites which do not fit)
+static MemoryTrackerSite s_trackerSites[MEMORY_TRACKER_MAX_SITE_COUNT+1];
+/// the sample rate
+static volatile long s_trackerSampleRate=1;
+/// the TLS index for the sample countdown of each thread
+static volatile long s_trackerCountdownIdx=(long)TLS_OUT_OF_INDEXES;
+
+static void *trackerBaseMalloc(size_t size)
+{
+#if defined(EP_ENABLE_MEMORY_HOOK)
+	return MemoryHook::Malloc(size);
+#else //defined(EP_ENABLE_MEMORY_HOOK)
+	return malloc(size);
+#endif //defined(EP_ENABLE_MEMORY_HOOK)
+}
+
+static void *trackerBaseRealloc(void *ptr,size_t size)
+{
+#if defined(EP_ENABLE_MEMORY_HOOK)
+	return MemoryHook::Realloc(ptr,size);
+#else //defined(EP_ENABLE_MEMORY_HOOK)
+	return realloc(ptr,size);
+#endif //defined(EP_ENABLE_MEMORY_HOOK)
+}
+
+static void trackerBaseFree(void *ptr)
+{
+#if defined(EP_ENABLE_MEMORY_HOOK)
+	MemoryHook::Free(ptr);
+#else //defined(EP_ENABLE_MEMORY_HOOK)
+	free(ptr);
+#endif //defined(EP_ENABLE_MEMORY_HOOK)
+}
+
+/*!
+Decide whether the allocation of the calling thread is sampled.
+@return the weight of the allocation, or 0 if not sampled.
+*/
+static long trackerSample()
+{
+	long sampleRate=s_trackerSampleRate;
+	if(sampleRate<=1)
+		return 1;
+	DWORD idx=getTlsIdx(s_trackerCountdownIdx);
+	if(idx==TLS_OUT_OF_INDEXES)
+		return 0;
+	long countdown=(long)(LONG_PTR)TlsGetValue(idx)-1;
+	if(countdown<=0)
+	{
+		TlsSetValue(idx,(LPVOID)(LONG_PTR)sampleRate);
+		return sampleRate;
+	}
+	TlsSetValue(idx,(LPVOID)(LONG_PTR)countdown);
+	return 0;
+}
+
+/*!
+Find or claim the entry of the given call site.
+@param[in] fileName the file name of the call site.
+@param[in] lineNum the line number of the call site.
+@return the index of the entry.
+*/
+static long trackerFindSite(const char *fileName,unsigned int lineNum)
+{
+	// __FILE__ has the same address for all the call sites within a translation unit,
+	// so the sites are keyed by the address rather than the contents (GetSiteReports merges the same file names)
+	unsigned long hash=(unsigned long)(((size_t)fileName>>3)^((size_t)lineNum*2654435761UL));
+	hash^=hash>>16;
+
+	for(long probe=0;probe<MEMORY_TRACKER_MAX_SITE_COUNT;probe++)
+	{
+		long siteIdx=(long)((hash+probe)%MEMORY_TRACKER_MAX_SITE_COUNT);
+		MemoryTrackerSite &site=s_trackerSites[siteIdx];
+		if(site.m_state==0 && InterlockedCompareExchange(&site.m_state,1,0)==0)
+		{
+			site.m_fileName=fileName;
+			site.m_lineNum=lineNum;
+			InterlockedExchange(&site.m_state,2);
+			return siteIdx;
+		}
+		while(site.m_state!=2)
+			YieldProcessor();
+		if(site.m_lineNum==lineNum && site.m_fileName==fileName)
+			return siteIdx;
+	}
+	return MEMORY_TRACKER_MAX_SITE_COUNT;
+}
+
+static void trackerAdd(long siteIdx,long weight,size_t size)
+{
+	MemoryTrackerSite &site=s_trackerSites[siteIdx];
+	__int64 bytes=(__int64)size*weight;
+	InterlockedExchangeAdd64(&site.m_allocCount,weight);
+	InterlockedExchangeAdd64(&site.m_allocBytes,bytes);
+	__int64 liveBytes=InterlockedExchangeAdd64(&site.m_liveBytes,bytes)+bytes;
+	__int64 peakLiveBytes=site.m_peakLiveBytes;
+	while(liveBytes>peakLiveBytes)
+	{
+		__int64 prevPeak=InterlockedCompareExchange64(&site.m_peakLiveBytes,liveBytes,peakLiveBytes);
+		if(prevPeak==peakLiveBytes)
+			break;
+		peakLiveBytes=prevPeak;
+	}
+}
+
+static void trackerRemove(long siteIdx,long weight,size_t size)
+{
+	MemoryTrackerSite &site=s_trackerSites[siteIdx];
+	InterlockedExchangeAdd64(&site.m_freeCount,weight);
+	InterlockedExchangeAdd64(&site.m_liveBytes,-(__int64)size*weight);
+}
+
+/*!
+Fill the header of the block and track it.
+@param[in] block the block allocated including the header.
+@param[in] size the size requested by the user.
+@param[in] fileName the file name of the call site.
+@param[in] lineNum the line number of the call site.
+@return the pointer to the memory for the user.
+*/
+static void *trackerTrack(void *block,size_t size,const char *fileName,unsigned int lineNum)
+{
+	MemoryTrackerHeader *header=reinterpret_cast<MemoryTrackerHeader*>(block);
+	header->m_size=size;
+	header->m_weight=trackerSample();
+	header->m_siteIdx=-1;
+	if(header->m_weight)
+	{
+		header->m_siteIdx=trackerFindSite(fileName,lineNum);
+		trackerAdd(header->m_siteIdx,header->m_weight,size);
+	}
+	return reinterpret_cast<char*>(block)+MEMORY_TRACKER_HEADER_SIZE;
+}
+
+void *MemoryTracker::Malloc(size_t size,const char *fileName,unsigned int lineNum)
+{
+	void *block=trackerBaseMalloc(size+MEMORY_TRACKER_HEADER_SIZE);
+	if(!block)
+		return NULL;
+	return trackerTrack(block,size,fileName,lineNum);
+}
+
+void *MemoryTracker::Realloc(void *ptr,size_t size,const char *fileName,unsigned int lineNum)
+{
+	if(!ptr)
+		return Malloc(size,fileName,lineNum);
+	if(size==0)
+	{
+		Free(ptr);
+		return NULL;
+	}
+	MemoryTrackerHeader *header=reinterpret_cast<MemoryTrackerHeader*>(reinterpret_cast<char*>(ptr)-MEMORY_TRACKER_HEADER_SIZE);
+	int prevSiteIdx=header->m_siteIdx;
+	int prevWeight=header->m_weight;
+	size_t prevSize=header->m_size;
+	void *block=trackerBaseRealloc(header,size+MEMORY_TRACKER_HEADER_SIZE);
+	if(!block)
+		return NULL;
+	// the reallocation is tracked as a deallocation followed by an allocation at the call site
+	if(prevSiteIdx>=0)
+		trackerRemove(prevSiteIdx,prevWeight,prevSize);
+	return trackerTrack(block,size,fileName,lineNum);
+}
+
+void MemoryTracker::Free(void *ptr)
+{
+	if(!ptr)
+		return;
+	MemoryTrackerHeader *header=reinterpret_cast<MemoryTrackerHeader*>(reinterpret_cast<char*>(ptr)-MEMORY_TRACKER_HEADER_SIZE);
+	if(header->m_siteIdx>=0)
+		trackerRemove(header->m_siteIdx,header->m_weight,header->m_size);
+	trackerBaseFree(header);
+}
+
+void MemoryTracker::SetSampleRate(unsigned int sampleRate)
+{
+	if(sampleRate==0)
+		sampleRate=1;
+	InterlockedExchange(&s_trackerSampleRate,(long)sampleRate);
+}
+
+unsigned int MemoryTracker::GetSampleRate()
+{
+	return (unsigned int)s_trackerSampleRate;
+}
+
+size_t MemoryTracker::GetSiteReports(SiteReport *retReports,size_t maxCount)
+{
+	std::vector<SiteReport> reports;
+	for(long trav=0;trav<=MEMORY_TRACKER_MAX_SITE_COUNT;trav++)
+	{
+		MemoryTrackerSite &site=s_trackerSites[trav];
+		if(trav<MEMORY_TRACKER_MAX_SITE_COUNT && site.m_state!=2)
+			continue;
+		if(trav==MEMORY_TRACKER_MAX_SITE_COUNT && site.m_allocCount==0)
+			continue;
+		SiteReport report;
+		report.m_fileName=(trav<MEMORY_TRACKER_MAX_SITE_COUNT)?site.m_fileName:"(others)";
+		report.m_lineNum=(trav<MEMORY_TRACKER_MAX_SITE_COUNT)?site.m_lineNum:0;
+		report.m_allocCount=site.m_allocCount;
+		report.m_freeCount=site.m_freeCount;
+		report.m_allocBytes=site.m_allocBytes;
+		report.m_liveCount=report.m_allocCount-report.m_freeCount;
+		report.m_liveBytes=site.m_liveBytes;
+		report.m_peakLiveBytes=site.m_peakLiveBytes;
+
+		// merge the entries of the call site reached from the different translation units (i.e. in a header)
+		size_t reportTrav;
+		for(reportTrav=0;reportTrav<reports.size();reportTrav++)
+		{
+			SiteReport &sameSite=reports[reportTrav];
+			if(trav<MEMORY_TRACKER_MAX_SITE_COUNT && sameSite.m_lineNum==report.m_lineNum && strcmp(sameSite.m_fileName,report.m_fileName)==0)
+			{
+				sameSite.m_allocCount+=report.m_allocCount;
+				sameSite.m_freeCount+=report.m_freeCount;
+				sameSite.m_allocBytes+=report.m_allocBytes;
+				sameSite.m_liveCount+=report.m_liveCount;
+				sameSite.m_liveBytes+=report.m_liveBytes;
+				sameSite.m_peakLiveBytes+=report.m_peakLiveBytes;
+				break;
+			}
+		}
+		if(reportTrav==reports.size())
+			reports.push_back(report);
+	}
+	for(size_t trav=0;trav<reports.size() && trav<maxCount;trav++)
+	{
+		retReports[trav]=reports[trav];
+	}
+	return reports.size();
+}
@@ -0,0 +1,130 @@
+/*! 
+MemoryProfiler for the EpLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epMemoryProfiler.h"
+#include "epFolderHelper.h"
+#include <algorithm>
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epl;
+
+MemoryProfileManager::MemoryProfileNode::MemoryProfileNode(const MemoryTracker::SiteReport &report):OutputNode()
+{
+	m_report=report;
+}
+
+MemoryProfileManager::MemoryProfileNode::MemoryProfileNode(const MemoryProfileNode& b):OutputNode(b)
+{
+	m_report=b.m_report;
+}
+
+MemoryProfileManager::MemoryProfileNode::~MemoryProfileNode()
+{
+}
+
+MemoryProfileManager::MemoryProfileNode & MemoryProfileManager::MemoryProfileNode::operator=(const MemoryProfileManager::MemoryProfileNode&b)
+{
+	if(this!=&b)
+	{
+		BaseOutputter::OutputNode::operator =(b);
+		m_report=b.m_report;
+	}
+	return *this;
+}
+
+void MemoryProfileManager::MemoryProfileNode::Print() const
+{
+	System::TPrintf(_T("%hs(%d) Alloc : %I64d (%I64d bytes) Free : %I64d Live : %I64d (%I64d bytes) Peak : %I64d bytes\n"),m_report.m_fileName,m_report.m_lineNum,m_report.m_allocCount,m_report.m_allocBytes,m_report.m_freeCount,m_report.m_liveCount,m_report.m_liveBytes,m_report.m_peakLiveBytes);
+}
+
+void MemoryProfileManager::MemoryProfileNode::Write(EpFile* const file)
+{
+	EP_ASSERT_EXPR(file,_T("The File Pointer is NULL!"));
+	System::FTPrintf(file,_T("%hs(%d) Alloc : %I64d (%I64d bytes) Free : %I64d Live : %I64d (%I64d bytes) Peak : %I64d bytes\n"),m_report.m_fileName,m_report.m_lineNum,m_report.m_allocCount,m_report.m_allocBytes,m_report.m_freeCount,m_report.m_liveCount,m_report.m_liveBytes,m_report.m_peakLiveBytes);
+}
+
+bool MemoryProfileManager::MemoryProfileNode::IsPrior(const OutputNode *a,const OutputNode *b)
+{
+	const MemoryProfileNode *_a=static_cast<const MemoryProfileNode*>(a);
+	const MemoryProfileNode *_b=static_cast<const MemoryProfileNode*>(b);
+	return _a->m_report.m_peakLiveBytes>_b->m_report.m_peakLiveBytes;
+}
+
+MemoryProfileManager::MemoryProfileManager(LockPolicy lockPolicyType):BaseOutputter(lockPolicyType)
+{
+	m_fileName=FolderHelper::GetModuleFileDirectory();
+	m_fileName.append(_T("memoryprofile.dat"));
+}
+
+MemoryProfileManager::MemoryProfileManager(const MemoryProfileManager& b):BaseOutputter(b)
+{
+	LockObj lock(b.m_nodeListLock);
+	m_fileName=b.m_fileName;
+}
+
+MemoryProfileManager::~MemoryProfileManager()
+{
+	FlushToFile();
+}
+
+MemoryProfileManager & MemoryProfileManager::operator=(const MemoryProfileManager&b)
+{
+	if(this!=&b)
+	{
+		BaseOutputter::operator =(b);
+		LockObj lock(b.m_nodeListLock);
+		m_fileName=b.m_fileName;
+	}
+	return *this;
+}
+
+void MemoryProfileManager::Update()
+{
+	std::vector<MemoryTracker::SiteReport> reports(MEMORY_TRACKER_MAX_SITE_COUNT+1);
+	size_t siteCount=MemoryTracker::GetSiteReports(&(reports.at(0)),reports.size());
+	if(siteCount>reports.size())
+		siteCount=reports.size();
+
+	LockObj lock(m_nodeListLock);
+	Clear();
+	for(size_t trav=0;trav<siteCount;trav++)
+	{
+		m_list.push_back(EP_NEW MemoryProfileNode(reports[trav]));
+	}
+	std::sort(m_list.begin(),m_list.end(),MemoryProfileNode::IsPrior);
+}
+
+void MemoryProfileManager::FlushToFile()
+{
+#if defined(EP_ENABLE_MEMORY_TRACKING)
+	Update();
+	BaseOutputter::FlushToFile();
+#endif //defined(EP_ENABLE_MEMORY_TRACKING)
+}
@@ -114,7 +114,7 @@ size_t NetworkStream::GetReadSeek() const
 	return m_readOffset;
 }
 
-void NetworkStream::SetSeek(const StreamSeekType seekType,size_t offset)
+void NetworkStream::SetSeek(const StreamSeekType /*seekType*/,size_t /*offset*/)
 {
 	return;
 }
@@ -39,13 +39,13 @@ using namespace epl;
 NoLock::NoLock() :BaseLock()
 {
 }
-NoLock::NoLock(const NoLock& b):BaseLock()
+NoLock::NoLock(const NoLock& /*b*/):BaseLock()
 {}
 
 NoLock::~NoLock()
 {
 }
-NoLock & NoLock::operator=(const NoLock&b)
+NoLock & NoLock::operator=(const NoLock&/*b*/)
 {
 	return *this;
 }
@@ -59,7 +59,7 @@ long NoLock::TryLock()
 {
 	return 1;
 }
-long NoLock::TryLockFor(const unsigned int dwMilliSecond)
+long NoLock::TryLockFor(const unsigned int /*dwMilliSecond*/)
 {
 	return 1;	
 }
@@ -0,0 +1,1325 @@
+/*! 
+PlatformPosix for the EpLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epPlatform.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <limits.h>
+#include <string>
+#include <vector>
+#include <map>
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+/// the number of 100-nanosecond intervals from 1601/01/01 to 1970/01/01
+#define EP_FILETIME_UNIX_EPOCH 116444736000000000LL
+
+/// the pseudo handle for the current process as on Windows
+#define EP_CURRENT_PROCESS_HANDLE ((HANDLE)(intptr_t)-1)
+/// the pseudo handle for the current thread as on Windows
+#define EP_CURRENT_THREAD_HANDLE ((HANDLE)(intptr_t)-2)
+
+DWORD GetCurrentThreadId()
+{
+	// the kernel thread ID, which perf and /proc report as well
+	static __thread DWORD s_threadID=0;
+	if(s_threadID==0)
+		s_threadID=(DWORD)syscall(SYS_gettid);
+	return s_threadID;
+}
+
+DWORD GetCurrentProcessId()
+{
+	return (DWORD)getpid();
+}
+
+DWORD GetTickCount()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	return (DWORD)((unsigned long long)now.tv_sec*1000ULL+(unsigned long long)now.tv_nsec/1000000ULL);
+}
+
+BOOL QueryPerformanceCounter(LARGE_INTEGER *retCount)
+{
+	struct timespec now;
+	if(clock_gettime(CLOCK_MONOTONIC,&now)!=0)
+		return FALSE;
+	retCount->QuadPart=(LONGLONG)now.tv_sec*1000000000LL+(LONGLONG)now.tv_nsec;
+	return TRUE;
+}
+
+BOOL QueryPerformanceFrequency(LARGE_INTEGER *retFrequency)
+{
+	retFrequency->QuadPart=1000000000LL;
+	return TRUE;
+}
+
+void GetSystemInfo(SYSTEM_INFO *retSystemInfo)
+{
+	long numberOfProcessors=sysconf(_SC_NPROCESSORS_ONLN);
+	long pageSize=sysconf(_SC_PAGESIZE);
+	retSystemInfo->dwNumberOfProcessors=(DWORD)(numberOfProcessors>0?numberOfProcessors:1);
+	retSystemInfo->dwPageSize=(DWORD)(pageSize>0?pageSize:4096);
+}
+
+static void timeToSystemTime(const struct timespec &time,bool isLocal,SYSTEMTIME *retSystemTime)
+{
+	struct tm brokenTime;
+	time_t seconds=time.tv_sec;
+	if(isLocal)
+		localtime_r(&seconds,&brokenTime);
+	else
+		gmtime_r(&seconds,&brokenTime);
+	retSystemTime->wYear=(WORD)(brokenTime.tm_year+1900);
+	retSystemTime->wMonth=(WORD)(brokenTime.tm_mon+1);
+	retSystemTime->wDayOfWeek=(WORD)brokenTime.tm_wday;
+	retSystemTime->wDay=(WORD)brokenTime.tm_mday;
+	retSystemTime->wHour=(WORD)brokenTime.tm_hour;
+	retSystemTime->wMinute=(WORD)brokenTime.tm_min;
+	retSystemTime->wSecond=(WORD)brokenTime.tm_sec;
+	retSystemTime->wMilliseconds=(WORD)(time.tv_nsec/1000000L);
+}
+
+void GetLocalTime(SYSTEMTIME *retSystemTime)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME,&now);
+	timeToSystemTime(now,true,retSystemTime);
+}
+
+void GetSystemTime(SYSTEMTIME *retSystemTime)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME,&now);
+	timeToSystemTime(now,false,retSystemTime);
+}
+
+BOOL SystemTimeToFileTime(const SYSTEMTIME *systemTime,FILETIME *retFileTime)
+{
+	// SYSTEMTIME is handled as UTC as on Windows, so the difference of two local times is kept
+	struct tm brokenTime;
+	memset(&brokenTime,0,sizeof(brokenTime));
+	brokenTime.tm_year=systemTime->wYear-1900;
+	brokenTime.tm_mon=systemTime->wMonth-1;
+	brokenTime.tm_mday=systemTime->wDay;
+	brokenTime.tm_hour=systemTime->wHour;
+	brokenTime.tm_min=systemTime->wMinute;
+	brokenTime.tm_sec=systemTime->wSecond;
+	time_t seconds=timegm(&brokenTime);
+	if(seconds==(time_t)-1)
+		return FALSE;
+	unsigned long long fileTime=(unsigned long long)((long long)seconds*10000000LL+EP_FILETIME_UNIX_EPOCH)+(unsigned long long)systemTime->wMilliseconds*10000ULL;
+	retFileTime->dwLowDateTime=(DWORD)(fileTime&0xFFFFFFFFULL);
+	retFileTime->dwHighDateTime=(DWORD)(fileTime>>32);
+	return TRUE;
+}
+
+BOOL FileTimeToSystemTime(const FILETIME *fileTime,SYSTEMTIME *retSystemTime)
+{
+	long long time=(long long)(((unsigned long long)fileTime->dwHighDateTime<<32)|(unsigned long long)fileTime->dwLowDateTime);
+	time-=EP_FILETIME_UNIX_EPOCH;
+	struct timespec unixTime;
+	unixTime.tv_sec=(time_t)(time/10000000LL);
+	unixTime.tv_nsec=(long)(time%10000000LL)*100L;
+	if(unixTime.tv_nsec<0)
+	{
+		unixTime.tv_sec--;
+		unixTime.tv_nsec+=1000000000L;
+	}
+	timeToSystemTime(unixTime,false,retSystemTime);
+	return TRUE;
+}
+
+void EpGetAbsTimeAfter(unsigned long milliSec,struct timespec *retTime)
+{
+	clock_gettime(CLOCK_REALTIME,retTime);
+	retTime->tv_sec+=(time_t)(milliSec/1000);
+	retTime->tv_nsec+=(long)(milliSec%1000)*1000000L;
+	if(retTime->tv_nsec>=1000000000L)
+	{
+		retTime->tv_sec++;
+		retTime->tv_nsec-=1000000000L;
+	}
+}
+
+void EpInitRecursiveMutex(pthread_mutex_t *mutex)
+{
+	pthread_mutexattr_t attr;
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr,PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(mutex,&attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+static FILETIME durationToFileTime(unsigned long long nanoSec)
+{
+	unsigned long long fileTime=nanoSec/100ULL;
+	FILETIME retFileTime;
+	retFileTime.dwLowDateTime=(DWORD)(fileTime&0xFFFFFFFFULL);
+	retFileTime.dwHighDateTime=(DWORD)(fileTime>>32);
+	return retFileTime;
+}
+
+static FILETIME timevalToFileTime(const struct timeval &time)
+{
+	return durationToFileTime((unsigned long long)time.tv_sec*1000000000ULL+(unsigned long long)time.tv_usec*1000ULL);
+}
+
+static FILETIME currentFileTime()
+{
+	SYSTEMTIME systemTime;
+	FILETIME fileTime;
+	GetSystemTime(&systemTime);
+	SystemTimeToFileTime(&systemTime,&fileTime);
+	return fileTime;
+}
+
+/// Type of the emulated waitable object
+enum WaitableType
+{
+	WAITABLE_TYPE_MUTEX=0,
+	WAITABLE_TYPE_EVENT,
+	WAITABLE_TYPE_SEMAPHORE,
+	WAITABLE_TYPE_THREAD,
+};
+
+/// The emulated waitable object behind HANDLE
+struct WaitableObject
+{
+	/// type of the object
+	WaitableType m_type;
+	/// lock for the state below
+	pthread_mutex_t m_lock;
+	/// condition signaled when the state changes (CLOCK_MONOTONIC)
+	pthread_cond_t m_cond;
+	/// the number of the handles and the running thread referring to this object
+	volatile long m_refCount;
+	/// the name of the object (empty if unnamed)
+	std::string m_name;
+
+	/// the mutex owner thread ID
+	DWORD m_ownerId;
+	/// the recursion count of the mutex owner
+	long m_recursion;
+
+	/// flag whether the event is manual reset
+	bool m_isManualReset;
+	/// flag whether the event is signaled
+	bool m_isSignaled;
+
+	/// the semaphore count
+	LONG m_count;
+	/// the maximum semaphore count
+	LONG m_maxCount;
+
+	/// the pthread handle
+	pthread_t m_thread;
+	/// the kernel thread ID (0 until the thread publishes it)
+	DWORD m_threadId;
+	/// the suspend count before the thread starts running
+	DWORD m_suspendCount;
+	/// flag whether the thread passed the start gate
+	bool m_isRunning;
+	/// flag whether the thread finished
+	bool m_isFinished;
+	/// flag whether the thread was terminated by TerminateThread
+	bool m_isTerminated;
+	/// the exit code of the thread
+	DWORD m_exitCode;
+	/// the time the thread is created
+	FILETIME m_creationTime;
+	/// the time the thread is finished
+	FILETIME m_exitTime;
+	/// the routine given by CreateThread
+	LPTHREAD_START_ROUTINE m_startRoutine;
+	/// the routine given by _beginthreadex
+	unsigned int (*m_startRoutineEx)(void *);
+	/// the parameter for the thread routine
+	void *m_param;
+
+	WaitableObject(WaitableType type)
+	{
+		m_type=type;
+		pthread_mutex_init(&m_lock,NULL);
+		pthread_condattr_t condAttr;
+		pthread_condattr_init(&condAttr);
+		pthread_condattr_setclock(&condAttr,CLOCK_MONOTONIC);
+		pthread_cond_init(&m_cond,&condAttr);
+		pthread_condattr_destroy(&condAttr);
+		m_refCount=1;
+		m_ownerId=0;
+		m_recursion=0;
+		m_isManualReset=false;
+		m_isSignaled=false;
+		m_count=0;
+		m_maxCount=0;
+		m_threadId=0;
+		m_suspendCount=0;
+		m_isRunning=false;
+		m_isFinished=false;
+		m_isTerminated=false;
+		m_exitCode=0;
+		memset(&m_creationTime,0,sizeof(FILETIME));
+		memset(&m_exitTime,0,sizeof(FILETIME));
+		m_startRoutine=NULL;
+		m_startRoutineEx=NULL;
+		m_param=NULL;
+	}
+	~WaitableObject()
+	{
+		pthread_cond_destroy(&m_cond);
+		pthread_mutex_destroy(&m_lock);
+	}
+};
+
+/// the registry of the named objects, shared within the process
+static std::map<std::string,WaitableObject*> s_namedObjects;
+/// the lock for the registry of the named objects
+static pthread_mutex_t s_namedObjectsLock=PTHREAD_MUTEX_INITIALIZER;
+
+static std::string wideToName(const wchar_t *name)
+{
+	std::string retName;
+	if(name)
+	{
+		std::vector<char> buffer(wcslen(name)*MB_LEN_MAX+1);
+		if(wcstombs(&buffer.at(0),name,buffer.size())!=(size_t)-1)
+			retName=&buffer.at(0);
+	}
+	return retName;
+}
+
+/*!
+Find the named object or register the new object (the new object is deleted if the name exists)
+@return the object to use, NULL if the name is used by the object of other type
+*/
+static WaitableObject *registerObject(WaitableObject *object,const char *name,bool &retIsCreated)
+{
+	retIsCreated=true;
+	if(name==NULL || name[0]=='\0')
+		return object;
+	pthread_mutex_lock(&s_namedObjectsLock);
+	std::map<std::string,WaitableObject*>::iterator iter=s_namedObjects.find(name);
+	if(iter!=s_namedObjects.end())
+	{
+		WaitableObject *existing=iter->second;
+		bool isSameType=(existing->m_type==object->m_type);
+		if(isSameType)
+			InterlockedIncrement(&existing->m_refCount);
+		pthread_mutex_unlock(&s_namedObjectsLock);
+		delete object;
+		retIsCreated=false;
+		if(!isSameType)
+		{
+			errno=EEXIST;
+			return NULL;
+		}
+		return existing;
+	}
+	object->m_name=name;
+	s_namedObjects[object->m_name]=object;
+	pthread_mutex_unlock(&s_namedObjectsLock);
+	return object;
+}
+
+static void releaseObject(WaitableObject *object)
+{
+	if(object->m_name.empty())
+	{
+		if(InterlockedDecrement(&object->m_refCount)==0)
+			delete object;
+		return;
+	}
+	pthread_mutex_lock(&s_namedObjectsLock);
+	bool isLast=(InterlockedDecrement(&object->m_refCount)==0);
+	if(isLast)
+		s_namedObjects.erase(object->m_name);
+	pthread_mutex_unlock(&s_namedObjectsLock);
+	if(isLast)
+		delete object;
+}
+
+static inline WaitableObject *toObject(HANDLE handle)
+{
+	if(handle==NULL || handle==EP_CURRENT_THREAD_HANDLE || handle==EP_CURRENT_PROCESS_HANDLE)
+		return NULL;
+	return reinterpret_cast<WaitableObject*>(handle);
+}
+
+HANDLE CreateMutexA(LPSECURITY_ATTRIBUTES /*mutexAttributes*/,BOOL isInitialOwner,const char *name)
+{
+	WaitableObject *mutex=new WaitableObject(WAITABLE_TYPE_MUTEX);
+	bool isCreated=false;
+	mutex=registerObject(mutex,name,isCreated);
+	if(mutex && isCreated && isInitialOwner)
+	{
+		mutex->m_ownerId=GetCurrentThreadId();
+		mutex->m_recursion=1;
+	}
+	return mutex;
+}
+
+HANDLE CreateMutexW(LPSECURITY_ATTRIBUTES mutexAttributes,BOOL isInitialOwner,const wchar_t *name)
+{
+	std::string mutexName=wideToName(name);
+	return CreateMutexA(mutexAttributes,isInitialOwner,mutexName.c_str());
+}
+
+BOOL ReleaseMutex(HANDLE mutex)
+{
+	WaitableObject *object=toObject(mutex);
+	if(object==NULL || object->m_type!=WAITABLE_TYPE_MUTEX)
+		return FALSE;
+	pthread_mutex_lock(&object->m_lock);
+	if(object->m_recursion==0 || object->m_ownerId!=GetCurrentThreadId())
+	{
+		pthread_mutex_unlock(&object->m_lock);
+		errno=EPERM;
+		return FALSE;
+	}
+	if(--object->m_recursion==0)
+	{
+		object->m_ownerId=0;
+		pthread_cond_signal(&object->m_cond);
+	}
+	pthread_mutex_unlock(&object->m_lock);
+	return TRUE;
+}
+
+HANDLE CreateEventA(LPSECURITY_ATTRIBUTES /*eventAttributes*/,BOOL isManualReset,BOOL isInitialState,const char *name)
+{
+	WaitableObject *event=new WaitableObject(WAITABLE_TYPE_EVENT);
+	event->m_isManualReset=(isManualReset!=FALSE);
+	event->m_isSignaled=(isInitialState!=FALSE);
+	bool isCreated=false;
+	return registerObject(event,name,isCreated);
+}
+
+HANDLE CreateEventW(LPSECURITY_ATTRIBUTES eventAttributes,BOOL isManualReset,BOOL isInitialState,const wchar_t *name)
+{
+	std::string eventName=wideToName(name);
+	return CreateEventA(eventAttributes,isManualReset,isInitialState,eventName.c_str());
+}
+
+BOOL SetEvent(HANDLE event)
+{
+	WaitableObject *object=toObject(event);
+	if(object==NULL || object->m_type!=WAITABLE_TYPE_EVENT)
+		return FALSE;
+	pthread_mutex_lock(&object->m_lock);
+	object->m_isSignaled=true;
+	if(object->m_isManualReset)
+		pthread_cond_broadcast(&object->m_cond);
+	else
+		pthread_cond_signal(&object->m_cond);
+	pthread_mutex_unlock(&object->m_lock);
+	return TRUE;
+}
+
+BOOL ResetEvent(HANDLE event)
+{
+	WaitableObject *object=toObject(event);
+	if(object==NULL || object->m_type!=WAITABLE_TYPE_EVENT)
+		return FALSE;
+	pthread_mutex_lock(&object->m_lock);
+	object->m_isSignaled=false;
+	pthread_mutex_unlock(&object->m_lock);
+	return TRUE;
+}
+
+HANDLE CreateSemaphoreA(LPSECURITY_ATTRIBUTES /*semaphoreAttributes*/,LONG initialCount,LONG maximumCount,const char *name)
+{
+	if(maximumCount<=0 || initialCount<0 || initialCount>maximumCount)
+	{
+		errno=EINVAL;
+		return NULL;
+	}
+	WaitableObject *semaphore=new WaitableObject(WAITABLE_TYPE_SEMAPHORE);
+	semaphore->m_count=initialCount;
+	semaphore->m_maxCount=maximumCount;
+	bool isCreated=false;
+	return registerObject(semaphore,name,isCreated);
+}
+
+HANDLE CreateSemaphoreW(LPSECURITY_ATTRIBUTES semaphoreAttributes,LONG initialCount,LONG maximumCount,const wchar_t *name)
+{
+	std::string semaphoreName=wideToName(name);
+	return CreateSemaphoreA(semaphoreAttributes,initialCount,maximumCount,semaphoreName.c_str());
+}
+
+BOOL ReleaseSemaphore(HANDLE semaphore,LONG releaseCount,LONG *retPreviousCount)
+{
+	WaitableObject *object=toObject(semaphore);
+	if(object==NULL || object->m_type!=WAITABLE_TYPE_SEMAPHORE || releaseCount<=0)
+		return FALSE;
+	pthread_mutex_lock(&object->m_lock);
+	if(object->m_count>object->m_maxCount-releaseCount)
+	{
+		pthread_mutex_unlock(&object->m_lock);
+		errno=EOVERFLOW;
+		return FALSE;
+	}
+	if(retPreviousCount)
+		*retPreviousCount=object->m_count;
+	object->m_count+=releaseCount;
+	if(releaseCount==1)
+		pthread_cond_signal(&object->m_cond);
+	else
+		pthread_cond_broadcast(&object->m_cond);
+	pthread_mutex_unlock(&object->m_lock);
+	return TRUE;
+}
+
+BOOL CloseHandle(HANDLE object)
+{
+	WaitableObject *waitable=toObject(object);
+	if(waitable==NULL)
+		return FALSE;
+	releaseObject(waitable);
+	return TRUE;
+}
+
+/// Try to acquire the object (the lock of the object must be held)
+static bool tryAcquire(WaitableObject *object,DWORD threadId)
+{
+	switch(object->m_type)
+	{
+	case WAITABLE_TYPE_MUTEX:
+		if(object->m_recursion==0 || object->m_ownerId==threadId)
+		{
+			object->m_ownerId=threadId;
+			object->m_recursion++;
+			return true;
+		}
+		return false;
+	case WAITABLE_TYPE_EVENT:
+		if(object->m_isSignaled)
+		{
+			if(!object->m_isManualReset)
+				object->m_isSignaled=false;
+			return true;
+		}
+		return false;
+	case WAITABLE_TYPE_SEMAPHORE:
+		if(object->m_count>0)
+		{
+			object->m_count--;
+			return true;
+		}
+		return false;
+	case WAITABLE_TYPE_THREAD:
+		return object->m_isFinished;
+	}
+	return false;
+}
+
+/// Unlocks the given pthread mutex (the cleanup handler for the waits which the thread cancellation can stop)
+static void unlockMutex(void *mutex)
+{
+	pthread_mutex_unlock(reinterpret_cast<pthread_mutex_t*>(mutex));
+}
+
+DWORD WaitForSingleObject(HANDLE object,DWORD milliSec)
+{
+	WaitableObject *waitable=toObject(object);
+	if(waitable==NULL)
+	{
+		errno=EINVAL;
+		return WAIT_FAILED;
+	}
+	DWORD threadId=(waitable->m_type==WAITABLE_TYPE_MUTEX)?GetCurrentThreadId():0;
+	struct timespec absTime;
+	if(milliSec!=INFINITE && milliSec!=0)
+	{
+		clock_gettime(CLOCK_MONOTONIC,&absTime);
+		absTime.tv_sec+=(time_t)(milliSec/1000);
+		absTime.tv_nsec+=(long)(milliSec%1000)*1000000L;
+		if(absTime.tv_nsec>=1000000000L)
+		{
+			absTime.tv_sec++;
+			absTime.tv_nsec-=1000000000L;
+		}
+	}
+	DWORD retVal=WAIT_OBJECT_0;
+	pthread_mutex_lock(&waitable->m_lock);
+	// TerminateThread cancels the thread within the wait holding the lock, so the lock is released on the cancellation
+	pthread_cleanup_push(unlockMutex,&waitable->m_lock);
+	while(!tryAcquire(waitable,threadId))
+	{
+		if(milliSec==0)
+		{
+			retVal=WAIT_TIMEOUT;
+			break;
+		}
+		if(milliSec==INFINITE)
+			pthread_cond_wait(&waitable->m_cond,&waitable->m_lock);
+		else if(pthread_cond_timedwait(&waitable->m_cond,&waitable->m_lock,&absTime)==ETIMEDOUT)
+		{
+			// the state may have changed together with the timeout
+			if(!tryAcquire(waitable,threadId))
+				retVal=WAIT_TIMEOUT;
+			break;
+		}
+	}
+	pthread_cleanup_pop(1);
+	return retVal;
+}
+
+/// the callbacks of the FLS indices
+static std::map<DWORD,PFLS_CALLBACK_FUNCTION> s_flsCallbacks;
+/// the lock for the callbacks of the FLS indices
+static pthread_mutex_t s_flsCallbacksLock=PTHREAD_MUTEX_INITIALIZER;
+
+DWORD FlsAlloc(PFLS_CALLBACK_FUNCTION callback)
+{
+	pthread_key_t key;
+	// the destructor of the key covers the threads which are not created by CreateThread
+	if(pthread_key_create(&key,callback)!=0)
+		return FLS_OUT_OF_INDEXES;
+	if(callback)
+	{
+		pthread_mutex_lock(&s_flsCallbacksLock);
+		s_flsCallbacks[(DWORD)key]=callback;
+		pthread_mutex_unlock(&s_flsCallbacksLock);
+	}
+	return (DWORD)key;
+}
+
+BOOL FlsFree(DWORD flsIndex)
+{
+	pthread_mutex_lock(&s_flsCallbacksLock);
+	s_flsCallbacks.erase(flsIndex);
+	pthread_mutex_unlock(&s_flsCallbacksLock);
+	return pthread_key_delete((pthread_key_t)flsIndex)==0;
+}
+
+LPVOID FlsGetValue(DWORD flsIndex)
+{
+	return pthread_getspecific((pthread_key_t)flsIndex);
+}
+
+BOOL FlsSetValue(DWORD flsIndex,LPVOID flsValue)
+{
+	return pthread_setspecific((pthread_key_t)flsIndex,flsValue)==0;
+}
+
+/// Calls the FLS callbacks with the values of the exiting thread
+static void callFlsCallbacks()
+{
+	// the callbacks are called without the lock, since they may free the index
+	pthread_mutex_lock(&s_flsCallbacksLock);
+	std::vector<std::pair<DWORD,PFLS_CALLBACK_FUNCTION> > callbacks(s_flsCallbacks.begin(),s_flsCallbacks.end());
+	pthread_mutex_unlock(&s_flsCallbacksLock);
+	for(size_t trav=0;trav<callbacks.size();trav++)
+	{
+		LPVOID value=pthread_getspecific((pthread_key_t)callbacks[trav].first);
+		if(value)
+		{
+			pthread_setspecific((pthread_key_t)callbacks[trav].first,NULL);
+			callbacks[trav].second(value);
+		}
+	}
+}
+
+/// Marks the thread object as finished when the thread routine returns or the thread is cancelled
+struct ThreadExitGuard
+{
+	WaitableObject *m_thread;
+	DWORD m_exitCode;
+	ThreadExitGuard(WaitableObject *thread)
+	{
+		m_thread=thread;
+		m_exitCode=0;
+	}
+	~ThreadExitGuard()
+	{
+		callFlsCallbacks();
+		pthread_mutex_lock(&m_thread->m_lock);
+		m_thread->m_isFinished=true;
+		if(!m_thread->m_isTerminated)
+			m_thread->m_exitCode=m_exitCode;
+		m_thread->m_exitTime=currentFileTime();
+		pthread_cond_broadcast(&m_thread->m_cond);
+		pthread_mutex_unlock(&m_thread->m_lock);
+		releaseObject(m_thread);
+	}
+};
+
+static void *threadEntry(void *param)
+{
+	WaitableObject *thread=reinterpret_cast<WaitableObject*>(param);
+	ThreadExitGuard exitGuard(thread);
+
+	// publish the thread ID, and wait while suspended on creation
+	int oldCancelState=0;
+	pthread_setcancelstate(PTHREAD_CANCEL_DISABLE,&oldCancelState);
+	bool isTerminated=false;
+	pthread_mutex_lock(&thread->m_lock);
+	pthread_cleanup_push(unlockMutex,&thread->m_lock);
+	thread->m_threadId=GetCurrentThreadId();
+	pthread_cond_broadcast(&thread->m_cond);
+	while(thread->m_suspendCount>0 && !thread->m_isTerminated)
+		pthread_cond_wait(&thread->m_cond,&thread->m_lock);
+	isTerminated=thread->m_isTerminated;
+	thread->m_isRunning=true;
+	pthread_cleanup_pop(1);
+	pthread_setcancelstate(oldCancelState,NULL);
+	if(isTerminated)
+		return NULL;
+
+	if(thread->m_startRoutineEx)
+		exitGuard.m_exitCode=thread->m_startRoutineEx(thread->m_param);
+	else
+		exitGuard.m_exitCode=thread->m_startRoutine(thread->m_param);
+	return NULL;
+}
+
+static WaitableObject *createThreadObject(size_t stackSize,LPTHREAD_START_ROUTINE startRoutine,unsigned int (*startRoutineEx)(void *),void *param,DWORD creationFlags)
+{
+	WaitableObject *thread=new WaitableObject(WAITABLE_TYPE_THREAD);
+	// one for the handle and one for the running thread
+	thread->m_refCount=2;
+	thread->m_startRoutine=startRoutine;
+	thread->m_startRoutineEx=startRoutineEx;
+	thread->m_param=param;
+	thread->m_suspendCount=(creationFlags&CREATE_SUSPENDED)?1:0;
+	thread->m_creationTime=currentFileTime();
+
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr,PTHREAD_CREATE_DETACHED);
+	if(stackSize>0)
+	{
+		if(stackSize<(size_t)PTHREAD_STACK_MIN)
+			stackSize=PTHREAD_STACK_MIN;
+		pthread_attr_setstacksize(&attr,stackSize);
+	}
+	int result=pthread_create(&thread->m_thread,&attr,threadEntry,thread);
+	pthread_attr_destroy(&attr);
+	if(result!=0)
+	{
+		delete thread;
+		errno=result;
+		return NULL;
+	}
+
+	// wait for the thread ID, so it is known to the caller as on Windows
+	pthread_mutex_lock(&thread->m_lock);
+	pthread_cleanup_push(unlockMutex,&thread->m_lock);
+	while(thread->m_threadId==0)
+		pthread_cond_wait(&thread->m_cond,&thread->m_lock);
+	pthread_cleanup_pop(1);
+	return thread;
+}
+
+HANDLE CreateThread(LPSECURITY_ATTRIBUTES /*threadAttributes*/,size_t stackSize,LPTHREAD_START_ROUTINE startAddress,LPVOID parameter,DWORD creationFlags,LPDWORD retThreadId)
+{
+	WaitableObject *thread=createThreadObject(stackSize,startAddress,NULL,parameter,creationFlags);
+	if(thread && retThreadId)
+		*retThreadId=thread->m_threadId;
+	return thread;
+}
+
+uintptr_t _beginthreadex(void * /*security*/,unsigned int stackSize,unsigned int (*startAddress)(void *),void *argList,unsigned int initFlag,unsigned int *retThreadId)
+{
+	WaitableObject *thread=createThreadObject(stackSize,NULL,startAddress,argList,initFlag);
+	if(thread && retThreadId)
+		*retThreadId=thread->m_threadId;
+	return reinterpret_cast<uintptr_t>(thread);
+}
+
+DWORD ResumeThread(HANDLE thread)
+{
+	WaitableObject *object=toObject(thread);
+	if(object==NULL || object->m_type!=WAITABLE_TYPE_THREAD)
+		return (DWORD)-1;
+	pthread_mutex_lock(&object->m_lock);
+	DWORD prevSuspendCount=object->m_suspendCount;
+	if(object->m_suspendCount>0 && --object->m_suspendCount==0)
+		pthread_cond_broadcast(&object->m_cond);
+	pthread_mutex_unlock(&object->m_lock);
+	return prevSuspendCount;
+}
+
+DWORD SuspendThread(HANDLE thread)
+{
+	WaitableObject *object=toObject(thread);
+	if(object==NULL || object->m_type!=WAITABLE_TYPE_THREAD)
+		return (DWORD)-1;
+	pthread_mutex_lock(&object->m_lock);
+	DWORD prevSuspendCount=(DWORD)-1;
+	// pthread cannot stop the running thread, so only the thread which is not started yet can be suspended
+	if(!object->m_isRunning)
+		prevSuspendCount=object->m_suspendCount++;
+	else
+		errno=ENOTSUP;
+	pthread_mutex_unlock(&object->m_lock);
+	return prevSuspendCount;
+}
+
+BOOL TerminateThread(HANDLE thread,DWORD exitCode)
+{
+	WaitableObject *object=toObject(thread);
+	if(object==NULL || object->m_type!=WAITABLE_TYPE_THREAD)
+		return FALSE;
+	BOOL retVal=TRUE;
+	pthread_mutex_lock(&object->m_lock);
+	if(!object->m_isFinished && !object->m_isTerminated)
+	{
+		object->m_isTerminated=true;
+		object->m_exitCode=exitCode;
+		if(object->m_isRunning)
+		{
+			// the cancellation is deferred to the next cancellation point (i.e. waiting for the event)
+			int result=pthread_cancel(object->m_thread);
+			if(result!=0)
+			{
+				errno=result;
+				retVal=FALSE;
+			}
+		}
+		else
+			pthread_cond_broadcast(&object->m_cond);
+	}
+	pthread_mutex_unlock(&object->m_lock);
+	return retVal;
+}
+
+BOOL GetExitCodeThread(HANDLE thread,LPDWORD retExitCode)
+{
+	WaitableObject *object=toObject(thread);
+	if(object==NULL || object->m_type!=WAITABLE_TYPE_THREAD || retExitCode==NULL)
+		return FALSE;
+	pthread_mutex_lock(&object->m_lock);
+	// STILL_ACTIVE
+	*retExitCode=object->m_isFinished?object->m_exitCode:259;
+	pthread_mutex_unlock(&object->m_lock);
+	return TRUE;
+}
+
+/*!
+Find the pthread and the kernel thread ID of the given handle
+@return false if the handle is not a thread or the thread is finished
+*/
+static bool getThreadIds(HANDLE thread,pthread_t &retThread,DWORD &retThreadId)
+{
+	if(thread==EP_CURRENT_THREAD_HANDLE)
+	{
+		retThread=pthread_self();
+		retThreadId=GetCurrentThreadId();
+		return true;
+	}
+	WaitableObject *object=toObject(thread);
+	if(object==NULL || object->m_type!=WAITABLE_TYPE_THREAD)
+		return false;
+	pthread_mutex_lock(&object->m_lock);
+	bool isAlive=!object->m_isFinished;
+	retThread=object->m_thread;
+	retThreadId=object->m_threadId;
+	pthread_mutex_unlock(&object->m_lock);
+	return isAlive;
+}
+
+BOOL SetThreadPriority(HANDLE thread,int priority)
+{
+	pthread_t threadHandle;
+	DWORD threadId=0;
+	if(!getThreadIds(thread,threadHandle,threadId))
+		return FALSE;
+	struct sched_param param;
+	memset(&param,0,sizeof(param));
+	if(priority==THREAD_PRIORITY_TIME_CRITICAL)
+	{
+		// the real-time policy needs the privilege (CAP_SYS_NICE)
+		param.sched_priority=sched_get_priority_max(SCHED_RR);
+		return pthread_setschedparam(threadHandle,SCHED_RR,&param)==0;
+	}
+#if defined(__linux__)
+	if(priority==THREAD_PRIORITY_IDLE)
+		return pthread_setschedparam(threadHandle,SCHED_IDLE,&param)==0;
+	if(pthread_setschedparam(threadHandle,SCHED_OTHER,&param)!=0)
+		return FALSE;
+	// the nice value is per thread on Linux, each priority step is 5 nice levels
+	// raising above the normal priority needs the privilege (CAP_SYS_NICE or RLIMIT_NICE)
+	int niceValue=-5*priority;
+	return setpriority(PRIO_PROCESS,(id_t)threadId,niceValue)==0;
+#else //defined(__linux__)
+	if(priority==THREAD_PRIORITY_IDLE)
+		priority=THREAD_PRIORITY_LOWEST;
+	int minPriority=sched_get_priority_min(SCHED_OTHER);
+	int maxPriority=sched_get_priority_max(SCHED_OTHER);
+	param.sched_priority=minPriority+(maxPriority-minPriority)*(priority-THREAD_PRIORITY_LOWEST)/(THREAD_PRIORITY_HIGHEST-THREAD_PRIORITY_LOWEST);
+	return pthread_setschedparam(threadHandle,SCHED_OTHER,&param)==0;
+#endif //defined(__linux__)
+}
+
+int GetThreadPriority(HANDLE thread)
+{
+	pthread_t threadHandle;
+	DWORD threadId=0;
+	if(!getThreadIds(thread,threadHandle,threadId))
+		return THREAD_PRIORITY_ERROR_RETURN;
+	int policy=0;
+	struct sched_param param;
+	if(pthread_getschedparam(threadHandle,&policy,&param)!=0)
+		return THREAD_PRIORITY_ERROR_RETURN;
+	if(policy==SCHED_RR || policy==SCHED_FIFO)
+		return THREAD_PRIORITY_TIME_CRITICAL;
+#if defined(__linux__)
+	if(policy==SCHED_IDLE)
+		return THREAD_PRIORITY_IDLE;
+	errno=0;
+	int niceValue=getpriority(PRIO_PROCESS,(id_t)threadId);
+	if(niceValue==-1 && errno!=0)
+		return THREAD_PRIORITY_ERROR_RETURN;
+	if(niceValue>=10)
+		return THREAD_PRIORITY_LOWEST;
+	if(niceValue>=5)
+		return THREAD_PRIORITY_BELOW_NORMAL;
+	if(niceValue<=-10)
+		return THREAD_PRIORITY_HIGHEST;
+	if(niceValue<=-5)
+		return THREAD_PRIORITY_ABOVE_NORMAL;
+#endif //defined(__linux__)
+	return THREAD_PRIORITY_NORMAL;
+}
+
+DWORD_PTR SetThreadAffinityMask(HANDLE thread,DWORD_PTR threadAffinityMask)
+{
+#if defined(__linux__)
+	pthread_t threadHandle;
+	DWORD threadId=0;
+	if(threadAffinityMask==0 || !getThreadIds(thread,threadHandle,threadId))
+		return 0;
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	if(pthread_getaffinity_np(threadHandle,sizeof(cpu_set_t),&cpuSet)!=0)
+		return 0;
+	DWORD_PTR prevMask=0;
+	for(unsigned int trav=0;trav<sizeof(DWORD_PTR)*8;trav++)
+	{
+		if(CPU_ISSET(trav,&cpuSet))
+			prevMask|=((DWORD_PTR)1)<<trav;
+	}
+	CPU_ZERO(&cpuSet);
+	for(unsigned int trav=0;trav<sizeof(DWORD_PTR)*8;trav++)
+	{
+		if(threadAffinityMask&(((DWORD_PTR)1)<<trav))
+			CPU_SET(trav,&cpuSet);
+	}
+	if(pthread_setaffinity_np(threadHandle,sizeof(cpu_set_t),&cpuSet)!=0)
+		return 0;
+	return prevMask;
+#else //defined(__linux__)
+	errno=ENOTSUP;
+	return 0;
+#endif //defined(__linux__)
+}
+
+DWORD GetCurrentProcessorNumber()
+{
+#if defined(__linux__)
+	int cpu=sched_getcpu();
+	return (cpu<0)?0:(DWORD)cpu;
+#else //defined(__linux__)
+	return 0;
+#endif //defined(__linux__)
+}
+
+HANDLE GetCurrentThread()
+{
+	return EP_CURRENT_THREAD_HANDLE;
+}
+
+HANDLE GetCurrentProcess()
+{
+	return EP_CURRENT_PROCESS_HANDLE;
+}
+
+BOOL GetThreadTimes(HANDLE thread,FILETIME *retCreationTime,FILETIME *retExitTime,FILETIME *retKernelTime,FILETIME *retUserTime)
+{
+	memset(retCreationTime,0,sizeof(FILETIME));
+	memset(retExitTime,0,sizeof(FILETIME));
+	memset(retKernelTime,0,sizeof(FILETIME));
+	memset(retUserTime,0,sizeof(FILETIME));
+	if(thread==EP_CURRENT_THREAD_HANDLE)
+	{
+#if defined(__linux__)
+		struct rusage usage;
+		if(getrusage(RUSAGE_THREAD,&usage)!=0)
+			return FALSE;
+		*retKernelTime=timevalToFileTime(usage.ru_stime);
+		*retUserTime=timevalToFileTime(usage.ru_utime);
+		return TRUE;
+#else //defined(__linux__)
+		struct timespec cpuTime;
+		if(clock_gettime(CLOCK_THREAD_CPUTIME_ID,&cpuTime)!=0)
+			return FALSE;
+		*retUserTime=durationToFileTime((unsigned long long)cpuTime.tv_sec*1000000000ULL+(unsigned long long)cpuTime.tv_nsec);
+		return TRUE;
+#endif //defined(__linux__)
+	}
+	WaitableObject *object=toObject(thread);
+	if(object==NULL || object->m_type!=WAITABLE_TYPE_THREAD)
+		return FALSE;
+	pthread_mutex_lock(&object->m_lock);
+	*retCreationTime=object->m_creationTime;
+	*retExitTime=object->m_exitTime;
+	BOOL retVal=TRUE;
+	if(!object->m_isFinished)
+	{
+		// the kernel and the user time are not separated for other threads
+		clockid_t clockId;
+		struct timespec cpuTime;
+		if(pthread_getcpuclockid(object->m_thread,&clockId)==0 && clock_gettime(clockId,&cpuTime)==0)
+			*retUserTime=durationToFileTime((unsigned long long)cpuTime.tv_sec*1000000000ULL+(unsigned long long)cpuTime.tv_nsec);
+		else
+			retVal=FALSE;
+	}
+	pthread_mutex_unlock(&object->m_lock);
+	return retVal;
+}
+
+BOOL GetProcessTimes(HANDLE process,FILETIME *retCreationTime,FILETIME *retExitTime,FILETIME *retKernelTime,FILETIME *retUserTime)
+{
+	memset(retCreationTime,0,sizeof(FILETIME));
+	memset(retExitTime,0,sizeof(FILETIME));
+	memset(retKernelTime,0,sizeof(FILETIME));
+	memset(retUserTime,0,sizeof(FILETIME));
+	if(process!=EP_CURRENT_PROCESS_HANDLE)
+		return FALSE;
+	struct rusage usage;
+	if(getrusage(RUSAGE_SELF,&usage)!=0)
+		return FALSE;
+	*retKernelTime=timevalToFileTime(usage.ru_stime);
+	*retUserTime=timevalToFileTime(usage.ru_utime);
+	return TRUE;
+}
+
+static int formatSystemTime(const char *format,const SYSTEMTIME *time,char *retStr,int length)
+{
+	struct tm brokenTime;
+	memset(&brokenTime,0,sizeof(brokenTime));
+	if(time)
+	{
+		brokenTime.tm_year=time->wYear-1900;
+		brokenTime.tm_mon=time->wMonth-1;
+		brokenTime.tm_mday=time->wDay;
+		brokenTime.tm_wday=time->wDayOfWeek;
+		brokenTime.tm_hour=time->wHour;
+		brokenTime.tm_min=time->wMinute;
+		brokenTime.tm_sec=time->wSecond;
+	}
+	else
+	{
+		time_t now=::time(NULL);
+		localtime_r(&now,&brokenTime);
+	}
+	char buffer[128];
+	size_t formatLength=strftime(buffer,sizeof(buffer),format,&brokenTime);
+	if(formatLength==0)
+		return 0;
+	// the length includes the terminating null as on Windows
+	if(length==0)
+		return (int)formatLength+1;
+	if(length<(int)formatLength+1)
+		return 0;
+	memcpy(retStr,buffer,formatLength+1);
+	return (int)formatLength+1;
+}
+
+static int formatSystemTimeW(const char *format,const SYSTEMTIME *time,wchar_t *retStr,int length)
+{
+	char buffer[128];
+	int formatLength=formatSystemTime(format,time,buffer,sizeof(buffer));
+	if(formatLength==0)
+		return 0;
+	if(length==0)
+		return formatLength;
+	if(length<formatLength)
+		return 0;
+	return (int)mbstowcs(retStr,buffer,length)+1;
+}
+
+int GetDateFormatA(LCID /*locale*/,DWORD /*flags*/,const SYSTEMTIME *date,const char * /*format*/,char *retDateStr,int dateLength)
+{
+	return formatSystemTime("%x",date,retDateStr,dateLength);
+}
+
+int GetDateFormatW(LCID /*locale*/,DWORD /*flags*/,const SYSTEMTIME *date,const wchar_t * /*format*/,wchar_t *retDateStr,int dateLength)
+{
+	return formatSystemTimeW("%x",date,retDateStr,dateLength);
+}
+
+int GetTimeFormatA(LCID /*locale*/,DWORD /*flags*/,const SYSTEMTIME *time,const char * /*format*/,char *retTimeStr,int timeLength)
+{
+	return formatSystemTime("%X",time,retTimeStr,timeLength);
+}
+
+int GetTimeFormatW(LCID /*locale*/,DWORD /*flags*/,const SYSTEMTIME *time,const wchar_t * /*format*/,wchar_t *retTimeStr,int timeLength)
+{
+	return formatSystemTimeW("%X",time,retTimeStr,timeLength);
+}
+
+int MultiByteToWideChar(UINT /*codePage*/,DWORD /*flags*/,const char *multiByteStr,int multiByteLength,wchar_t *retWideCharStr,int wideCharLength)
+{
+	// the locale of the process decides the encoding (UTF-8 in general), so the code page is ignored
+	std::string source;
+	if(multiByteLength<0)
+		source=multiByteStr;
+	else
+		source.assign(multiByteStr,multiByteLength);
+	mbstate_t state;
+	memset(&state,0,sizeof(state));
+	const char *srcTrav=source.c_str();
+	size_t length=mbsrtowcs(NULL,&srcTrav,0,&state);
+	if(length==(size_t)-1)
+		return 0;
+	// include the terminating null as Windows does when the length is -1
+	size_t retLength=length+((multiByteLength<0)?1:0);
+	if(wideCharLength==0)
+		return (int)retLength;
+	if((size_t)wideCharLength<retLength)
+		return 0;
+	std::vector<wchar_t> buffer(length+1);
+	memset(&state,0,sizeof(state));
+	srcTrav=source.c_str();
+	mbsrtowcs(&buffer.at(0),&srcTrav,length+1,&state);
+	memcpy(retWideCharStr,&buffer.at(0),retLength*sizeof(wchar_t));
+	return (int)retLength;
+}
+
+int WideCharToMultiByte(UINT /*codePage*/,DWORD /*flags*/,const wchar_t *wideCharStr,int wideCharLength,char *retMultiByteStr,int multiByteLength,const char * /*defaultChar*/,BOOL *retUsedDefaultChar)
+{
+	std::wstring source;
+	if(wideCharLength<0)
+		source=wideCharStr;
+	else
+		source.assign(wideCharStr,wideCharLength);
+	if(retUsedDefaultChar)
+		*retUsedDefaultChar=FALSE;
+	mbstate_t state;
+	memset(&state,0,sizeof(state));
+	const wchar_t *srcTrav=source.c_str();
+	size_t length=wcsrtombs(NULL,&srcTrav,0,&state);
+	if(length==(size_t)-1)
+		return 0;
+	size_t retLength=length+((wideCharLength<0)?1:0);
+	if(multiByteLength==0)
+		return (int)retLength;
+	if((size_t)multiByteLength<retLength)
+		return 0;
+	std::vector<char> buffer(length+1);
+	memset(&state,0,sizeof(state));
+	srcTrav=source.c_str();
+	wcsrtombs(&buffer.at(0),&srcTrav,length+1,&state);
+	memcpy(retMultiByteStr,&buffer.at(0),retLength);
+	return (int)retLength;
+}
+
+void OutputDebugStringA(const char *outputString)
+{
+	fputs(outputString,stderr);
+}
+
+void OutputDebugStringW(const wchar_t *outputString)
+{
+	fprintf(stderr,"%ls",outputString);
+}
+
+errno_t strcpy_s(char *dest,size_t destSize,const char *src)
+{
+	if(dest==NULL || src==NULL || destSize==0)
+		return EINVAL;
+	size_t length=strlen(src);
+	if(length>=destSize)
+	{
+		dest[0]='\0';
+		return ERANGE;
+	}
+	memcpy(dest,src,length+1);
+	return 0;
+}
+
+errno_t strcat_s(char *dest,size_t destSize,const char *src)
+{
+	if(dest==NULL || src==NULL || destSize==0)
+		return EINVAL;
+	size_t destLength=strnlen(dest,destSize);
+	if(destLength==destSize)
+		return EINVAL;
+	return strcpy_s(dest+destLength,destSize-destLength,src);
+}
+
+errno_t strncpy_s(char *dest,size_t destSize,const char *src,size_t count)
+{
+	if(dest==NULL || src==NULL || destSize==0)
+		return EINVAL;
+	size_t length=strnlen(src,count);
+	if(length>=destSize)
+	{
+		if(count!=_TRUNCATE)
+		{
+			dest[0]='\0';
+			return ERANGE;
+		}
+		length=destSize-1;
+	}
+	memcpy(dest,src,length);
+	dest[length]='\0';
+	return 0;
+}
+
+errno_t wcscpy_s(wchar_t *dest,size_t destSize,const wchar_t *src)
+{
+	if(dest==NULL || src==NULL || destSize==0)
+		return EINVAL;
+	size_t length=wcslen(src);
+	if(length>=destSize)
+	{
+		dest[0]=L'\0';
+		return ERANGE;
+	}
+	memcpy(dest,src,(length+1)*sizeof(wchar_t));
+	return 0;
+}
+
+errno_t wcscat_s(wchar_t *dest,size_t destSize,const wchar_t *src)
+{
+	if(dest==NULL || src==NULL || destSize==0)
+		return EINVAL;
+	size_t destLength=wcsnlen(dest,destSize);
+	if(destLength==destSize)
+		return EINVAL;
+	return wcscpy_s(dest+destLength,destSize-destLength,src);
+}
+
+errno_t wcsncpy_s(wchar_t *dest,size_t destSize,const wchar_t *src,size_t count)
+{
+	if(dest==NULL || src==NULL || destSize==0)
+		return EINVAL;
+	size_t length=wcsnlen(src,count);
+	if(length>=destSize)
+	{
+		if(count!=_TRUNCATE)
+		{
+			dest[0]=L'\0';
+			return ERANGE;
+		}
+		length=destSize-1;
+	}
+	memcpy(dest,src,length*sizeof(wchar_t));
+	dest[length]=L'\0';
+	return 0;
+}
+
+int _vscwprintf(const wchar_t *format,va_list args)
+{
+	// vswprintf does not count the length with the null buffer, so print to the growing buffer
+	std::vector<wchar_t> buffer(256);
+	while(true)
+	{
+		va_list argsCopy;
+		va_copy(argsCopy,args);
+		int retVal=vswprintf(&buffer.at(0),buffer.size(),format,argsCopy);
+		va_end(argsCopy);
+		if(retVal>=0)
+			return retVal;
+		if(buffer.size()>=(1<<24))
+			return -1;
+		buffer.resize(buffer.size()*2);
+	}
+}
+
+int _scwprintf(const wchar_t *format,...)
+{
+	va_list args;
+	va_start(args,format);
+	int retVal=_vscwprintf(format,args);
+	va_end(args);
+	return retVal;
+}
+
+errno_t _wfopen_s(FILE **retFile,const wchar_t *fileName,const wchar_t *mode)
+{
+	std::vector<char> fileNameBuffer(wcslen(fileName)*MB_LEN_MAX+1);
+	std::vector<char> modeBuffer(wcslen(mode)*MB_LEN_MAX+1);
+	if(wcstombs(&fileNameBuffer.at(0),fileName,fileNameBuffer.size())==(size_t)-1 || wcstombs(&modeBuffer.at(0),mode,modeBuffer.size())==(size_t)-1)
+	{
+		*retFile=NULL;
+		return EINVAL;
+	}
+	return fopen_s(retFile,&fileNameBuffer.at(0),&modeBuffer.at(0));
+}
+
+static errno_t formatCurrentTime(const char *format,char *buffer,size_t numberOfElements)
+{
+	if(buffer==NULL || numberOfElements<9)
+		return EINVAL;
+	time_t now=time(NULL);
+	struct tm brokenTime;
+	localtime_r(&now,&brokenTime);
+	strftime(buffer,numberOfElements,format,&brokenTime);
+	return 0;
+}
+
+errno_t _strdate_s(char *buffer,size_t numberOfElements)
+{
+	return formatCurrentTime("%m/%d/%y",buffer,numberOfElements);
+}
+
+errno_t _strtime_s(char *buffer,size_t numberOfElements)
+{
+	return formatCurrentTime("%H:%M:%S",buffer,numberOfElements);
+}
+
+errno_t _wstrdate_s(wchar_t *buffer,size_t numberOfElements)
+{
+	char dateBuffer[16];
+	errno_t retVal=_strdate_s(dateBuffer,numberOfElements<16?numberOfElements:16);
+	if(retVal==0)
+		mbstowcs(buffer,dateBuffer,numberOfElements);
+	return retVal;
+}
+
+errno_t _wstrtime_s(wchar_t *buffer,size_t numberOfElements)
+{
+	char timeBuffer[16];
+	errno_t retVal=_strtime_s(timeBuffer,numberOfElements<16?numberOfElements:16);
+	if(retVal==0)
+		mbstowcs(buffer,timeBuffer,numberOfElements);
+	return retVal;
+}
+
+#endif //!defined(_WIN32) && !defined(_WIN64)
@@ -183,7 +183,7 @@ ProfileManager::ProfileManager(LockPolicy lockPolicyType):BaseOutputter(lockPoli
 }
 ProfileManager::ProfileManager(const ProfileManager& b):BaseOutputter(b)
 {
-	LockObj lock(b.m_nodeListLock);
+	SharedLockObj lock(b.m_nodeListLock);
 	m_fileName=b.m_fileName;
 }
 
@@ -198,7 +198,7 @@ ProfileManager & ProfileManager::operator=(const ProfileManager&b)
 		FlushToFile();
 
 		BaseOutputter::operator =(b);
-		LockObj lock(b.m_nodeListLock);
+		SharedLockObj lock(b.m_nodeListLock);
 		m_fileName=b.m_fileName;
 
 	}
@@ -235,6 +235,8 @@ bool ProfileManager::isProfileExist(const TCHAR *uniqueName,ProfileNode *&retIte
 
 void ProfileManager::addProfile(const TCHAR *uniqueName, const unsigned __int64 &time)
 {
+	// the counters are read under the shared lock by Print and Write,
+	// so they are only updated under the exclusive lock
 	LockObj lock(m_nodeListLock);
 	ProfileNode *existStruct=NULL;
 	size_t retIdx=-1;
@@ -42,7 +42,7 @@ PropertiesFile::PropertiesFile(FileEncodingType encodingType, LockPolicy lockPol
 PropertiesFile::PropertiesFile(const PropertiesFile& b):BaseTextFile(b)
 {
 	m_nullString=_T("");
-	LockObj lock(b.m_baseTextLock);
+	SharedLockObj lock(b.m_baseTextLock);
 	m_propertyList=b.m_propertyList;
 }
 
@@ -55,7 +55,7 @@ PropertiesFile & PropertiesFile::operator=(const PropertiesFile&b)
 	{
 		BaseTextFile::operator =(b);
 		m_nullString=_T("");
-		LockObj lock(b.m_baseTextLock);
+		SharedLockObj lock(b.m_baseTextLock);
 		m_propertyList=b.m_propertyList;
 
 	}
@@ -81,7 +81,7 @@ bool PropertiesFile::SetProperty(const TCHAR *  key, const TCHAR * val)
 
 bool PropertiesFile::GetProperty(const TCHAR * key,EpTString &retVal) const
 {
-	LockObj lock(m_baseTextLock);
+	SharedLockObj lock(m_baseTextLock);
 	EpTString opKey=Locale::Trim(key);
 	opKey.append(_T("="));
 	vector<Pair<EpTString, EpTString> >::const_iterator iter;
@@ -115,7 +115,7 @@ EpTString &PropertiesFile::GetProperty(const TCHAR * key)
 
 const EpTString &PropertiesFile::GetProperty(const TCHAR * key) const
 {
-	LockObj lock(m_baseTextLock);
+	SharedLockObj lock(m_baseTextLock);
 	EpTString opKey=Locale::Trim(key);
 	opKey.append(_T("="));
 	vector<Pair<EpTString, EpTString> >::const_iterator iter;
@@ -207,7 +207,7 @@ EpTString& PropertiesFile::operator [](const TCHAR * key)
 
 const EpTString& PropertiesFile::operator [](const TCHAR * key) const
 {
-	LockObj lock(m_baseTextLock);
+	SharedLockObj lock(m_baseTextLock);
 	EpTString opKey=Locale::Trim(key);
 	opKey.append(_T("="));
 	vector<Pair<EpTString, EpTString> >::const_iterator iter;
@@ -252,7 +252,7 @@ void PropertiesFile::loadFromFile(const EpTString &lines)
 bool PropertiesFile::getValueKeyFromLine(const EpTString &buf, EpTString &retKey, EpTString &retVal)
 {
 	TCHAR splitChar=0;
-	int bufTrav=0;
+	size_t bufTrav=0;
 	if(buf.length()<=0)
 		return false;
 
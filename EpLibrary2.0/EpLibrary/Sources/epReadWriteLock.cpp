@@ -0,0 +1,178 @@
+/*! 
+ReadWriteLock for the EpLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epReadWriteLock.h"
+#include "epSystem.h"
+#include "epException.h"
+#include "epDateTimeHelper.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epl;
+
+/// the flag of m_state set while a writer holds or waits for the lock (the lower bits count the readers)
+#define READ_WRITE_LOCK_WRITER_FLAG 0x40000000L
+
+ReadWriteLock::ReadWriteLock() :BaseLock(),m_writerLock(),m_noReaderEvent(false,false),m_writerDoneEvent(true,true)
+{
+	m_state=0;
+	m_writerRecursion=0;
+}
+
+ReadWriteLock::ReadWriteLock(const ReadWriteLock& /*b*/):BaseLock(),m_writerLock(),m_noReaderEvent(false,false),m_writerDoneEvent(true,true)
+{
+	m_state=0;
+	m_writerRecursion=0;
+}
+
+ReadWriteLock::~ReadWriteLock()
+{
+	EP_ASSERT_EXPR(m_state==0,_T("Lock is still held!"));
+}
+
+ReadWriteLock & ReadWriteLock::operator=(const ReadWriteLock&b)
+{
+	if(this!=&b)
+	{
+		EP_ASSERT_EXPR(m_state==0,_T("Lock is still held!"));
+	}
+	return *this;
+}
+
+bool ReadWriteLock::Lock()
+{
+	m_writerLock.Lock();
+	if(m_writerRecursion++>0)
+		return true;
+	beginWrite();
+	while((LoadAcquire(&m_state)&~READ_WRITE_LOCK_WRITER_FLAG)!=0)
+	{
+		m_noReaderEvent.WaitForEvent();
+	}
+	return true;
+}
+
+long ReadWriteLock::TryLock()
+{
+	if(!m_writerLock.TryLock())
+		return 0;
+	if(m_writerRecursion>0)
+	{
+		m_writerRecursion++;
+		return 1;
+	}
+	if(InterlockedCompareExchange(&m_state,READ_WRITE_LOCK_WRITER_FLAG,0)!=0)
+	{
+		m_writerLock.Unlock();
+		return 0;
+	}
+	m_writerDoneEvent.ResetEvent();
+	m_writerRecursion++;
+	return 1;
+}
+
+long ReadWriteLock::TryLockFor(const unsigned int dwMilliSecond)
+{
+	SYSTEMTIME startTime=DateTimeHelper::GetCurrentDateTime();
+	if(!m_writerLock.TryLockFor(dwMilliSecond))
+		return 0;
+	if(m_writerRecursion++>0)
+		return 1;
+	beginWrite();
+	while((LoadAcquire(&m_state)&~READ_WRITE_LOCK_WRITER_FLAG)!=0)
+	{
+		__int64 waitTime=(__int64)dwMilliSecond-DateTimeHelper::AbsDiffInMilliSec(DateTimeHelper::GetCurrentDateTime(),startTime);
+		if(waitTime<0)
+			waitTime=0;
+		if(!m_noReaderEvent.WaitForEvent((unsigned int)waitTime) && (LoadAcquire(&m_state)&~READ_WRITE_LOCK_WRITER_FLAG)!=0)
+		{
+			m_writerRecursion--;
+			endWrite();
+			m_writerLock.Unlock();
+			return 0;
+		}
+	}
+	return 1;
+}
+
+void ReadWriteLock::Unlock()
+{
+	EP_ASSERT_EXPR(m_writerRecursion>0,_T("Lock is not held!"));
+	if(--m_writerRecursion==0)
+		endWrite();
+	m_writerLock.Unlock();
+}
+
+bool ReadWriteLock::LockShared()
+{
+	while(true)
+	{
+		long state=LoadAcquire(&m_state);
+		if(state&READ_WRITE_LOCK_WRITER_FLAG)
+		{
+			m_writerDoneEvent.WaitForEvent();
+			continue;
+		}
+		if(InterlockedCompareExchange(&m_state,state+1,state)==state)
+			return true;
+	}
+}
+
+long ReadWriteLock::TryLockShared()
+{
+	while(true)
+	{
+		long state=LoadAcquire(&m_state);
+		if(state&READ_WRITE_LOCK_WRITER_FLAG)
+			return 0;
+		if(InterlockedCompareExchange(&m_state,state+1,state)==state)
+			return 1;
+	}
+}
+
+void ReadWriteLock::UnlockShared()
+{
+	long state=InterlockedDecrement(&m_state);
+	EP_ASSERT_EXPR((state&~READ_WRITE_LOCK_WRITER_FLAG)>=0,_T("Shared lock is not held!"));
+	// the last reader wakes the writer waiting
+	if(state==READ_WRITE_LOCK_WRITER_FLAG)
+		m_noReaderEvent.SetEvent();
+}
+
+void ReadWriteLock::beginWrite()
+{
+	m_writerDoneEvent.ResetEvent();
+	InterlockedExchangeAdd(&m_state,READ_WRITE_LOCK_WRITER_FLAG);
+}
+
+void ReadWriteLock::endWrite()
+{
+	InterlockedExchangeAdd(&m_state,-READ_WRITE_LOCK_WRITER_FLAG);
+	m_writerDoneEvent.SetEvent();
+}
@@ -34,117 +34,46 @@ static char THIS_FILE[] = __FILE__;
 using namespace epl;
 
 
-SmartObject & SmartObject::operator=(const SmartObject&b)
+SmartObject & SmartObject::operator=(const SmartObject&/*b*/)
 {
-	if(this!=&b)
-	{
-		
-		if(m_refCounterLock)
-		{
-			EP_DELETE m_refCounterLock;
-		}
-		m_refCounterLock=NULL;
-
-		m_lockPolicy=b.m_lockPolicy;
-		switch(m_lockPolicy)
-		{
-		case LOCK_POLICY_CRITICALSECTION:
-			m_refCounterLock=EP_NEW CriticalSectionEx();
-			break;
-		case LOCK_POLICY_MUTEX:
-			m_refCounterLock=EP_NEW Mutex();
-			break;
-		case LOCK_POLICY_NONE:
-			m_refCounterLock=EP_NEW NoLock();
-			break;
-		default:
-			m_refCounterLock=NULL;
-			break;
-		}
-	}
-	
-
 	return *this;
 }
 
 #if !defined(_DEBUG)
 void SmartObject::RetainObj()
 {
-	LockObj lock(m_refCounterLock);
-	m_refCount++;
+	InterlockedIncrement(&m_refCount);
 }
 
 void SmartObject::ReleaseObj()
 {
-	m_refCounterLock->Lock();
-	m_refCount--;
-
-	if(m_refCount==0)
+	long refCount=InterlockedDecrement(&m_refCount);
+	if(refCount==0)
 	{
-		m_refCount++; // this increment is dummy addition to make pair with destructor.
-		m_refCounterLock->Unlock();
-		EP_DELETE this;
+		m_refCount=1; // this increment is dummy addition to make pair with destructor.
+		deleteObj();
 		return;
 	}
-	EP_ASSERT_EXPR(m_refCount>=0, _T("Reference Count is negative Value! Reference Count : %d"),m_refCount);
-	m_refCounterLock->Unlock();
+	EP_ASSERT_EXPR(refCount>=0, _T("Reference Count is negative Value! Reference Count : %d"),refCount);
 }
 
-SmartObject::SmartObject(LockPolicy lockPolicyType)
+SmartObject::SmartObject(LockPolicy /*lockPolicyType*/)
 {
 	m_refCount=1;
-	m_lockPolicy=lockPolicyType;
-	switch(lockPolicyType)
-	{
-	case LOCK_POLICY_CRITICALSECTION:
-		m_refCounterLock=EP_NEW CriticalSectionEx();
-		break;
-	case LOCK_POLICY_MUTEX:
-		m_refCounterLock=EP_NEW Mutex();
-		break;
-	case LOCK_POLICY_NONE:
-		m_refCounterLock=EP_NEW NoLock();
-		break;
-	default:
-		m_refCounterLock=NULL;
-		break;
-	}
 }
 
-SmartObject::SmartObject(const SmartObject& b)
+SmartObject::SmartObject(const SmartObject& /*b*/)
 {
 	m_refCount=1;
-	m_lockPolicy=b.m_lockPolicy;
-	switch(m_lockPolicy)
-	{
-	case LOCK_POLICY_CRITICALSECTION:
-		m_refCounterLock=EP_NEW CriticalSectionEx();
-		break;
-	case LOCK_POLICY_MUTEX:
-		m_refCounterLock=EP_NEW Mutex();
-		break;
-	case LOCK_POLICY_NONE:
-		m_refCounterLock=EP_NEW NoLock();
-		break;
-	default:
-		m_refCounterLock=NULL;
-		break;
-	}
 }
 
 
 
 SmartObject::~SmartObject()
 {
-	m_refCounterLock->Lock();
-	m_refCount--;
-	m_refCounterLock->Unlock();
-	EP_ASSERT_EXPR(m_refCount==0,_T("The Reference Count is not 0!! Reference Count : %d"),m_refCount);
-	
-	if(m_refCounterLock)
-	{
-		EP_DELETE m_refCounterLock;
-	}
+	long refCount=InterlockedDecrement(&m_refCount);
+	EP_ASSERT_EXPR(refCount==0,_T("The Reference Count is not 0!! Reference Count : %d"),refCount);
+	(void)refCount;
 }
 
-#endif //!defined(_DEBUG)
+#endif //!defined(_DEBUG)
\ No newline at end of file
@@ -0,0 +1,164 @@
+/*! 
+SpinLock for the EpLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epSpinLock.h"
+#include "epSystem.h"
+#include "epException.h"
+#include "epDateTimeHelper.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epl;
+
+SpinLock::SpinLock(unsigned int spinCount) :BaseLock(),m_parkEvent(false,false)
+{
+	m_state=0;
+	m_spinCount=spinCount;
+#if defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	m_threadID=0;
+#endif //defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+}
+
+SpinLock::SpinLock(const SpinLock& b) :BaseLock(),m_parkEvent(false,false)
+{
+	m_state=0;
+	m_spinCount=b.m_spinCount;
+#if defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	m_threadID=0;
+#endif //defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+}
+
+SpinLock::~SpinLock()
+{
+	EP_ASSERT_EXPR(m_state==0,_T("Lock is still held!"));
+}
+
+SpinLock & SpinLock::operator=(const SpinLock&b)
+{
+	if(this!=&b)
+	{
+		EP_ASSERT_EXPR(m_state==0,_T("Lock is still held!"));
+		m_spinCount=b.m_spinCount;
+	}
+	return *this;
+}
+
+unsigned int SpinLock::GetSpinCount() const
+{
+	return m_spinCount;
+}
+
+bool SpinLock::spin()
+{
+	unsigned int backoff=1;
+	for(unsigned int spinCount=0;spinCount<m_spinCount;spinCount+=backoff)
+	{
+		for(unsigned int trav=0;trav<backoff;trav++)
+			YieldProcessor();
+		if(LoadAcquire(&m_state)==0 && InterlockedCompareExchange(&m_state,1,0)==0)
+			return true;
+		if(backoff<SPIN_LOCK_MAX_BACKOFF)
+			backoff<<=1;
+	}
+	return false;
+}
+
+bool SpinLock::Lock()
+{
+#if defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	unsigned long threadID=GetCurrentThreadId();
+	EP_ASSERT_EXPR(threadID!=m_threadID,_T("Possible Deadlock detected!"));
+#endif //defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	if(InterlockedCompareExchange(&m_state,1,0)!=0 && !spin())
+	{
+		// mark the lock as contended, so the holder signals the event on Unlock
+		while(InterlockedExchange(&m_state,2)!=0)
+		{
+			m_parkEvent.WaitForEvent();
+		}
+	}
+#if defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	m_threadID=threadID;
+#endif //defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	return true;
+}
+
+long SpinLock::TryLock()
+{
+#if defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	unsigned long threadID=GetCurrentThreadId();
+	EP_ASSERT_EXPR(threadID!=m_threadID,_T("Possible Deadlock detected!"));
+#endif //defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	if(InterlockedCompareExchange(&m_state,1,0)!=0)
+		return 0;
+#if defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	m_threadID=threadID;
+#endif //defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	return 1;
+}
+
+long SpinLock::TryLockFor(const unsigned int dwMilliSecond)
+{
+#if defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	unsigned long threadID=GetCurrentThreadId();
+	EP_ASSERT_EXPR(threadID!=m_threadID,_T("Possible Deadlock detected!"));
+#endif //defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	if(InterlockedCompareExchange(&m_state,1,0)!=0)
+	{
+		if(dwMilliSecond==0)
+			return 0;
+		if(!spin())
+		{
+			SYSTEMTIME startTime=DateTimeHelper::GetCurrentDateTime();
+			while(InterlockedExchange(&m_state,2)!=0)
+			{
+				__int64 waitTime=(__int64)dwMilliSecond-DateTimeHelper::AbsDiffInMilliSec(DateTimeHelper::GetCurrentDateTime(),startTime);
+				if(waitTime<=0)
+					return 0;
+				// giving up leaves the state as 2, which only costs the holder a spurious signal
+				m_parkEvent.WaitForEvent((unsigned int)waitTime);
+			}
+		}
+	}
+#if defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	m_threadID=threadID;
+#endif //defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	return 1;
+}
+
+void SpinLock::Unlock()
+{
+#if defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	m_threadID=0;
+#endif //defined(_DEBUG) && defined(ENABLE_POSSIBLE_DEADLOCK_CHECK)
+	long prevState=InterlockedExchange(&m_state,0);
+	EP_ASSERT_EXPR(prevState!=0,_T("Lock is not held!"));
+	if(prevState==2)
+		m_parkEvent.SetEvent();
+}
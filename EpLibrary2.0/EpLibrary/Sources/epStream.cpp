@@ -44,6 +44,7 @@ Stream::Stream(LockPolicy lockPolicyType)
 	switch(lockPolicyType)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_streamLock=EP_NEW CriticalSectionEx();
 		break;
 	case LOCK_POLICY_MUTEX:
@@ -66,6 +67,7 @@ Stream::Stream(const Stream& b)
 	switch(m_lockPolicy)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_streamLock=EP_NEW CriticalSectionEx();
 		break;
 	case LOCK_POLICY_MUTEX:
@@ -347,7 +349,7 @@ bool Stream::ReadFloats(float *retFloatList,size_t listSize)
 bool Stream::ReadDoubles(double *retDoubleList, size_t listSize)
 {
 	LockObj lock(m_streamLock);
-	return read(retDoubleList,sizeof(float)*listSize);
+	return read(retDoubleList,sizeof(double)*listSize);
 }
 bool Stream::ReadBytes(unsigned char* retByteList, size_t listSize)
 {
@@ -25,7 +25,11 @@ THE SOFTWARE.
 */
 #include "epSystem.h"
 #include "epCriticalSectionEx.h"
+#if defined(_WIN32) || defined(_WIN64)
 #include <sys/timeb.h>
+#else //defined(_WIN32) || defined(_WIN64)
+#include <sys/time.h>
+#endif //defined(_WIN32) || defined(_WIN64)
 
 #if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
 #define new DEBUG_NEW
@@ -50,24 +54,42 @@ unsigned long System::GetNumberOfCores()
 	return sysinfo.dwNumberOfProcessors;
 }
 
+/*!
+Get the current time of day.
+@param[out] retSec the seconds since the epoch
+@param[out] retUSec the microseconds within the second
+*/
+static void getTimeOfDay(long &retSec, long &retUSec)
+{
+#if defined(_WIN32) || defined(_WIN64)
+	struct timeb kTB;
+	ftime(&kTB);
+	retSec = static_cast<long>(kTB.time);
+	retUSec = 1000*kTB.millitm;
+#else //defined(_WIN32) || defined(_WIN64)
+	// ftime is deprecated on POSIX
+	struct timeval kTV;
+	gettimeofday(&kTV,NULL);
+	retSec = static_cast<long>(kTV.tv_sec);
+	retUSec = static_cast<long>(kTV.tv_usec);
+#endif //defined(_WIN32) || defined(_WIN64)
+}
+
 EpTime System::GetTime()
 {
 	static long s_lInitialSec = 0;
 	static long s_lInitialUSec = 0;
 	static bool s_bInitializedTime = false;
-	struct timeb kTB;
 
 	if (!s_bInitializedTime)
 	{
 		s_bInitializedTime = true;
-		ftime(&kTB);
-		s_lInitialSec = static_cast<long>(kTB.time);
-		s_lInitialUSec = 1000*kTB.millitm;
+		getTimeOfDay(s_lInitialSec,s_lInitialUSec);
 	}
 
-	ftime(&kTB);
-	long lCurrentSec = static_cast<long>(kTB.time);
-	long lCurrentUSec = 1000*kTB.millitm;
+	long lCurrentSec;
+	long lCurrentUSec;
+	getTimeOfDay(lCurrentSec,lCurrentUSec);
 	long lDeltaSec = lCurrentSec - s_lInitialSec;
 	long lDeltaUSec = lCurrentUSec -s_lInitialUSec;
 	if (lDeltaUSec < 0)
@@ -209,7 +231,7 @@ int System::WStrCmp(const wchar_t * str1, const wchar_t *str2)
 
 int System::Printf(const char * format, ... )
 {
-	va_list args=NULL;
+	va_list args;
 	int retVal=0;
 	va_start(args, format); 
 	retVal=vprintf_s(format,args);
@@ -225,7 +247,7 @@ int System::Printf_V(const char* format, va_list args)
 
 int System::SPrintf(char *dest,size_t dstSizeInCharacter,const char *format,...)
 {
-	va_list args=NULL;
+	va_list args;
 	int retVal=0;
 	va_start(args, format); 
 	retVal=vsprintf_s(dest,dstSizeInCharacter,format,args);
@@ -243,7 +265,7 @@ int System::SPrintf(EpString &retDest,const char *format,...)
 	int length;
 	char *tmpString=NULL;
 	int retVal=0;
-	va_list args=NULL;
+	va_list args;
 	va_start(args, format);
 	length=StrLen_V(format,args);
 	tmpString=EP_NEW char[length+1];
@@ -270,7 +292,7 @@ int System::SPrintf_V(EpString &retDest,const char *format,va_list args)
 
 int System::WPrintf(const wchar_t * format, ... )
 {
-	va_list args=NULL; 
+	va_list args; 
 	int retVal=0;
 	va_start(args, format); 
 	retVal=vwprintf_s(format,args);
@@ -286,7 +308,7 @@ int System::WPrintf_V(const wchar_t* format, va_list args)
 
 int System::SWPrintf(wchar_t *dest,size_t dstSizeInCharacter,const wchar_t *format,...)
 {
-	va_list args=NULL;
+	va_list args;
 	int retVal=0;
 	va_start(args, format); 
 	retVal=vswprintf_s(dest,dstSizeInCharacter,format,args);
@@ -303,7 +325,7 @@ int System::SWPrintf(EpWString &retDest,const wchar_t *format,...)
 	int length;
 	wchar_t *tmpString=NULL;
 	int retVal=0;
-	va_list args=NULL;
+	va_list args;
 	va_start(args, format);
 	length=WcsLen_V(format,args);
 	tmpString=EP_NEW wchar_t[length+1];
@@ -330,7 +352,7 @@ int System::SWPrintf_V(EpWString &retDest,const wchar_t *format,va_list args)
 
 int System::TPrintf(const TCHAR * format, ... )
 {
-	va_list args=NULL;
+	va_list args;
 	int retVal=0;
 	va_start(args, format); 
 	retVal=_vtprintf_s(format,args);
@@ -343,7 +365,7 @@ int System::TPrintf_V(const TCHAR* format, va_list args)
 }
 int System::STPrintf(TCHAR *dest,size_t dstSizeInCharacter,const TCHAR *format,...)
 {
-	va_list args=NULL; 
+	va_list args; 
 	int retVal=0;
 	va_start(args, format); 
 	retVal=_vstprintf_s(dest,dstSizeInCharacter,format,args);
@@ -362,7 +384,7 @@ int System::STPrintf(EpTString &retDest,const TCHAR *format,...)
 	int length;
 	TCHAR *tmpString=NULL;
 	int retVal=0;
-	va_list args=NULL;
+	va_list args;
 	va_start(args, format);
 	length=TcsLen_V(format,args);
 	tmpString=EP_NEW TCHAR[length+1];
@@ -389,7 +411,7 @@ int System::STPrintf_V(EpTString &retDest,const TCHAR *format,va_list args)
 
 int System::StrLen(const char *format,...)
 {
-	va_list args=NULL;
+	va_list args;
 	int retVal; 
 	va_start(args, format); 
 	retVal=_vscprintf(format,args);
@@ -446,7 +468,7 @@ int System::StrLen_V(const char*format, va_list args)
 
 int System::MbsLen(const unsigned char *format,...)
 {
-	va_list args=NULL;
+	va_list args;
 	int retVal; 
 	va_start(args, format); 
 	retVal=_vscprintf(reinterpret_cast<const char*>(format),args);
@@ -501,7 +523,7 @@ int System::MbsLen_V(const unsigned char*format, va_list args)
 
 int System::WcsLen(const wchar_t *format,...)
 {
-	va_list args=NULL;
+	va_list args;
 	int retVal; 
 	va_start(args, format); 
 	retVal=_vscwprintf(format,args);
@@ -557,7 +579,7 @@ int System::WcsLen_V(const wchar_t*format, va_list args)
 
 int System::TcsLen(const TCHAR *format,...)
 {
-	va_list args=NULL; 
+	va_list args; 
 	int retVal; 
 	va_start(args, format); 
 	retVal=_vsctprintf(format,args);
@@ -610,7 +632,7 @@ int System::TcsLen_V(const TCHAR*format, va_list args)
 
 int System::FPrintf(EpFile* const fileStream, const char* format,...)
 {
-	va_list args=NULL;
+	va_list args;
 	int retVal; 
 	va_start(args, format); 
 	retVal=vfprintf(fileStream,format,args);
@@ -626,7 +648,7 @@ int System::FPrintf_V(EpFile* const fileStream, const char* format,va_list args)
 
 int System::FWPrintf(EpFile* const fileStream, const wchar_t* format,...)
 {
-	va_list args=NULL;
+	va_list args;
 	int retVal; 
 	va_start(args, format); 
 	retVal=vfwprintf(fileStream,format,args);
@@ -642,7 +664,7 @@ int System::FWPrintf_V(EpFile* const fileStream, const wchar_t* format,va_list a
 
 int System::FTPrintf(EpFile* const fileStream, const TCHAR* format,...)
 {
-	va_list args=NULL;
+	va_list args;
 	int retVal; 
 	va_start(args, format); 
 	retVal=_vftprintf(fileStream,format,args);
@@ -678,7 +700,7 @@ int System::FClose(EpFile * const fileStream)
 	return fclose(fileStream);
 }
 
-unsigned int System::FWrite(const void* buffer,size_t sizeInByte, size_t count, EpFile * const fileStream)
+size_t System::FWrite(const void* buffer,size_t sizeInByte, size_t count, EpFile * const fileStream)
 {
 	return fwrite(buffer,sizeInByte,count,fileStream);
 }
@@ -692,7 +714,7 @@ long System::FSize(EpFile* const fileStream)
 	return fileSize;
 }
 
-unsigned int System::FRead(void *retBuff,size_t sizeInByte, size_t count,EpFile * const fileStream)
+size_t System::FRead(void *retBuff,size_t sizeInByte, size_t count,EpFile * const fileStream)
 {
 	return fread(retBuff,sizeInByte,count,fileStream);
 }
@@ -708,6 +730,7 @@ unsigned long System::FormatLastErrorMessage(TCHAR *retBuff, unsigned long maxEl
 	if(retErrNo!=NULL)
 		*retErrNo=err;
 
+#if defined(_WIN32) || defined(_WIN64)
 	return FormatMessage(FORMAT_MESSAGE_FROM_SYSTEM|FORMAT_MESSAGE_IGNORE_INSERTS,
 		0,
 		err,
@@ -715,6 +738,17 @@ unsigned long System::FormatLastErrorMessage(TCHAR *retBuff, unsigned long maxEl
 		retBuff,
 		maxElementCount,
 		NULL);
+#else //defined(_WIN32) || defined(_WIN64)
+	if(maxElementCount==0)
+		return 0;
+#if defined(_UNICODE) || defined(UNICODE)
+	EpWString errMsg=System::MultiByteToWideChar(strerror((int)err));
+#else// defined(_UNICODE) || defined(UNICODE)
+	EpString errMsg=strerror((int)err);
+#endif// defined(_UNICODE) || defined(UNICODE)
+	_tcsncpy_s(retBuff,maxElementCount,errMsg.c_str(),_TRUNCATE);
+	return (unsigned long)_tcslen(retBuff);
+#endif //defined(_WIN32) || defined(_WIN64)
 
 }
 
@@ -724,6 +758,7 @@ unsigned long System::FormatLastErrorMessage(EpString &retString,unsigned long *
 	if(retErrNo!=NULL)
 		*retErrNo=err;
 
+#if defined(_WIN32) || defined(_WIN64)
 	TCHAR *errMsg=NULL;
 	unsigned long retVal=FormatMessage(
 		// use system message tables to retrieve error text
@@ -754,6 +789,10 @@ unsigned long System::FormatLastErrorMessage(EpString &retString,unsigned long *
 		errMsg = NULL;
 	}
 	return retVal;
+#else //defined(_WIN32) || defined(_WIN64)
+	retString=strerror((int)err);
+	return (unsigned long)retString.length();
+#endif //defined(_WIN32) || defined(_WIN64)
 }
 
 unsigned long System::FormatLastErrorMessage(EpWString &retString,unsigned long *retErrNo) 
@@ -762,6 +801,7 @@ unsigned long System::FormatLastErrorMessage(EpWString &retString,unsigned long
 	if(retErrNo!=NULL)
 		*retErrNo=err;
 
+#if defined(_WIN32) || defined(_WIN64)
 	TCHAR *errMsg=NULL;
 	unsigned long retVal=FormatMessage(
 		// use system message tables to retrieve error text
@@ -792,6 +832,10 @@ unsigned long System::FormatLastErrorMessage(EpWString &retString,unsigned long
 		errMsg = NULL;
 	}
 	return retVal;
+#else //defined(_WIN32) || defined(_WIN64)
+	retString=System::MultiByteToWideChar(strerror((int)err));
+	return (unsigned long)retString.length();
+#endif //defined(_WIN32) || defined(_WIN64)
 }
 
 int System::NoticeBox(const TCHAR* fileName, const TCHAR* funcName, size_t lineNum,const TCHAR* format,...)
@@ -799,7 +843,7 @@ int System::NoticeBox(const TCHAR* fileName, const TCHAR* funcName, size_t lineN
 	int length,fullLength;
 	TCHAR *tmpString=NULL;
 	TCHAR *tmpSTring2=NULL;
-	va_list args=NULL;
+	va_list args;
 	va_start(args, format);
 	length=TcsLen_V(format,args);
 	tmpString=EP_NEW TCHAR[length+1];
@@ -810,7 +854,12 @@ int System::NoticeBox(const TCHAR* fileName, const TCHAR* funcName, size_t lineN
 	STPrintf(tmpSTring2,fullLength+1,_T("File Name : %s\r\nFunction Name : %s\r\nLine Number : %d\r\n\r\nMessage : %s\r\n"),fileName,funcName,lineNum,tmpString);
 	
 	int retVal=0;
+#if defined(_WIN32) || defined(_WIN64)
 	retVal=MessageBox(NULL,tmpSTring2,_T("Notice"),MB_OK);
+#else //defined(_WIN32) || defined(_WIN64)
+	// no message box on the POSIX platform
+	::OutputDebugString(tmpSTring2);
+#endif //defined(_WIN32) || defined(_WIN64)
 	if(tmpString)
 		EP_DELETE[] tmpString;
 	if(tmpSTring2)
@@ -824,7 +873,7 @@ bool System::StringToHex(const EpTString& input, unsigned char *retHex)
 	if(input.length()%2!=0 || retHex==NULL)
 		return false;
 	const TCHAR *pos=input.c_str();
-	for(int count = 0; count < input.length()/2; count++) {
+	for(size_t count = 0; count < input.length()/2; count++) {
 		_stscanf(pos, _T("%2hhx"), &retHex[count]);
 		pos += 2 * sizeof(TCHAR);
 	}
@@ -960,12 +1009,11 @@ int System::WideCharToMultiByte(const wchar_t* wideCharString, int stringLength,
 
 EpString System::WideCharToMultiByte(const wchar_t *wideCharString, int stringLength)
 {
-	int result;
 	int sizeNeeded=::WideCharToMultiByte(CP_ACP,0,wideCharString,stringLength,NULL,0,NULL,NULL);
 	char *cString=EP_NEW char[sizeNeeded+1];
 	System::Memset(cString,0,sizeof(char)*(sizeNeeded+1));
 	//result=wcstombs(cString,wideCharString,stringLength);
-	result=::WideCharToMultiByte(CP_ACP,0,wideCharString,stringLength,cString,sizeNeeded,NULL,NULL);
+	::WideCharToMultiByte(CP_ACP,0,wideCharString,stringLength,cString,sizeNeeded,NULL,NULL);
 	cString[sizeNeeded]='\0';
 	EpString retString=cString;
 	EP_DELETE[] cString;
@@ -974,12 +1022,11 @@ EpString System::WideCharToMultiByte(const wchar_t *wideCharString, int stringLe
 
 EpString System::WideCharToMultiByte(const wchar_t *wideCharString)
 {
-	int result;
 	int sizeNeeded=::WideCharToMultiByte(CP_ACP,0,wideCharString,-1,NULL,0,NULL,NULL);
 	char *cString=EP_NEW char[sizeNeeded+1];
 	System::Memset(cString,0,sizeof(char)*(sizeNeeded+1));
 	//result=wcstombs(cString,wideCharString,stringLength);
-	result=::WideCharToMultiByte(CP_ACP,0,wideCharString,-1,cString,sizeNeeded,NULL,NULL);
+	::WideCharToMultiByte(CP_ACP,0,wideCharString,-1,cString,sizeNeeded,NULL,NULL);
 	cString[sizeNeeded]='\0';
 	EpString retString=cString;
 	EP_DELETE[] cString;
@@ -1015,11 +1062,10 @@ int  System::UTF16ToUTF8(const wchar_t* utf16String,int stringLength, char *retu
 }
 EpString System::UTF16ToUTF8(const wchar_t *utf16String, int stringLength)
 {
-	int result;
 	int sizeNeeded=::WideCharToMultiByte(CP_UTF8,0,utf16String,stringLength,NULL,0,NULL,NULL);
 	char *cString=EP_NEW char[sizeNeeded+1];
 	System::Memset(cString,0,sizeof(char)*(sizeNeeded+1));
-	result=::WideCharToMultiByte(CP_UTF8,0,utf16String,stringLength,cString,sizeNeeded,NULL,NULL);
+	::WideCharToMultiByte(CP_UTF8,0,utf16String,stringLength,cString,sizeNeeded,NULL,NULL);
 	cString[sizeNeeded]='\0';
 	EpString retString=cString;
 	EP_DELETE[] cString;
@@ -1027,11 +1073,10 @@ EpString System::UTF16ToUTF8(const wchar_t *utf16String, int stringLength)
 }
 EpString System::UTF16ToUTF8(const wchar_t *utf16String)
 {
-	int result;
 	int sizeNeeded=::WideCharToMultiByte(CP_UTF8,0,utf16String,-1,NULL,0,NULL,NULL);
 	char *cString=EP_NEW char[sizeNeeded+1];
 	System::Memset(cString,0,sizeof(char)*(sizeNeeded+1));
-	result=::WideCharToMultiByte(CP_UTF8,0,utf16String,-1,cString,sizeNeeded,NULL,NULL);
+	::WideCharToMultiByte(CP_UTF8,0,utf16String,-1,cString,sizeNeeded,NULL,NULL);
 	cString[sizeNeeded]='\0';
 	EpString retString=cString;
 	EP_DELETE[] cString;
@@ -1090,7 +1135,7 @@ int System::UTF8ToUTF16(const char *utf8String, wchar_t *retUtf16String)
 
 bool System::IsMultiByte(byte *multiByteString,size_t byteLength)
 {
-	for(int stringTrav=0;stringTrav<byteLength;stringTrav++)
+	for(size_t stringTrav=0;stringTrav<byteLength;stringTrav++)
 	{
 		if(IsDBCSLeadByte(multiByteString[stringTrav]))
 			return true;
@@ -1098,16 +1143,15 @@ bool System::IsMultiByte(byte *multiByteString,size_t byteLength)
 	return false;
 }
 
-void System::OutputDebugString(TCHAR * format,...)
+void System::OutputDebugString(const TCHAR * format,...)
 {
 	int length;
 	TCHAR *tmpString=NULL;
-	int retVal=0;
-	va_list args=NULL;
+	va_list args;
 	va_start(args, format);
 	length=TcsLen_V(format,args);
 	tmpString=EP_NEW TCHAR[length+1];
-	retVal=STPrintf_V(tmpString,length+1,format,args);
+	STPrintf_V(tmpString,length+1,format,args);
 	va_end(args);
 	::OutputDebugString(tmpString);
 	if(tmpString)
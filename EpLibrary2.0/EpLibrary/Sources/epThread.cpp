@@ -25,6 +25,7 @@ THE SOFTWARE.
 */
 #include "epThread.h"
 #include "epException.h"
+#include "epCpuTopology.h"
 
 #if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
 #define new DEBUG_NEW
@@ -36,7 +37,7 @@ using namespace epl;
 
 HANDLE Thread::CreateThread(LPTHREAD_START_ROUTINE routineFunc,LPVOID param, ThreadPriority priority)
 {
-	unsigned long threadID=0;
+	DWORD threadID=0;
 	HANDLE retHandle=0;
 	retHandle=::CreateThread(NULL, 0,routineFunc,param,0,&threadID);
 	Thread::SetPriority(retHandle,priority);
@@ -53,6 +54,14 @@ bool Thread::SetPriority(HANDLE threadHandle, ThreadPriority priority)
 	return ret;
 
 }
+DWORD_PTR Thread::SetAffinityMask(HANDLE threadHandle, DWORD_PTR affinityMask)
+{
+	DWORD_PTR ret=0;
+	if(threadHandle!=0)
+		ret=::SetThreadAffinityMask(threadHandle,affinityMask);
+	return ret;
+}
+
 ThreadPriority Thread::GetPriority(HANDLE threadHandle)
 {
 	ThreadPriority ret=EP_THREAD_PRIORITY_ERROR_RETURN;
@@ -72,6 +81,7 @@ Thread::Thread(ThreadPriority priority,LockPolicy lockPolicyType)
 	m_threadId=0;
 	m_threadHandle=0;
 	m_threadPriority=priority;
+	m_startAffinityMask=0;
 	m_parentThreadHandle=0;
 	m_parentThreadId=0;
 	m_type=THREAD_TYPE_UNKNOWN;
@@ -82,6 +92,7 @@ Thread::Thread(ThreadPriority priority,LockPolicy lockPolicyType)
 	switch(lockPolicyType)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_threadLock=EP_NEW CriticalSectionEx();
 		break;
 	case LOCK_POLICY_MUTEX:
@@ -102,6 +113,7 @@ Thread::Thread(void (__cdecl *threadFunc)(), ThreadPriority priority,LockPolicy
 	m_threadId=0;
 	m_threadHandle=0;
 	m_threadPriority=priority;
+	m_startAffinityMask=0;
 	m_parentThreadHandle=0;
 	m_parentThreadId=0;
 	m_status=THREAD_STATUS_TERMINATED;
@@ -111,6 +123,7 @@ Thread::Thread(void (__cdecl *threadFunc)(), ThreadPriority priority,LockPolicy
 	switch(lockPolicyType)
 	{
 	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
 		m_threadLock=EP_NEW CriticalSectionEx();
 		break;
 	case LOCK_POLICY_MUTEX:
@@ -155,6 +168,7 @@ Thread::Thread(const Thread & b)
 		m_parentThreadId=b.m_parentThreadId;
 		m_threadHandle=b.m_threadHandle;
 		m_threadPriority=b.m_threadPriority;
+		m_startAffinityMask=b.m_startAffinityMask;
 		m_threadId=b.m_threadId;
 		m_status=b.m_status;
 		m_exitCode=b.m_exitCode;
@@ -175,6 +189,7 @@ Thread::Thread(const Thread & b)
 		m_threadId=0;
 		m_threadHandle=0;
 		m_threadPriority=b.m_threadPriority;
+		m_startAffinityMask=b.m_startAffinityMask;
 		m_parentThreadHandle=0;
 		m_parentThreadId=0;
 		m_type=THREAD_TYPE_UNKNOWN;
@@ -185,6 +200,7 @@ Thread::Thread(const Thread & b)
 		switch(m_lockPolicy)
 		{
 		case LOCK_POLICY_CRITICALSECTION:
+		case LOCK_POLICY_READWRITE:
 			m_threadLock=EP_NEW CriticalSectionEx();
 			break;
 		case LOCK_POLICY_MUTEX:
@@ -222,6 +238,7 @@ Thread &Thread::operator=(const Thread & b)
 			m_parentThreadId=b.m_parentThreadId;
 			m_threadHandle=b.m_threadHandle;
 			m_threadPriority=b.m_threadPriority;
+			m_startAffinityMask=b.m_startAffinityMask;
 			m_threadId=b.m_threadId;
 			m_status=b.m_status;
 			m_exitCode=b.m_exitCode;
@@ -243,6 +260,7 @@ Thread &Thread::operator=(const Thread & b)
 			m_threadId=0;
 			m_threadHandle=0;
 			m_threadPriority=b.m_threadPriority;
+			m_startAffinityMask=b.m_startAffinityMask;
 			m_parentThreadHandle=0;
 			m_parentThreadId=0;
 			m_type=THREAD_TYPE_UNKNOWN;
@@ -253,6 +271,7 @@ Thread &Thread::operator=(const Thread & b)
 			switch(m_lockPolicy)
 			{
 			case LOCK_POLICY_CRITICALSECTION:
+			case LOCK_POLICY_READWRITE:
 				m_threadLock=EP_NEW CriticalSectionEx();
 				break;
 			case LOCK_POLICY_MUTEX:
@@ -367,7 +386,13 @@ bool Thread::Suspend()
 	{
 		m_status=THREAD_STATUS_SUSPENDED;
 		m_threadLock->Unlock();
-		SuspendThread(m_threadHandle);
+		if(SuspendThread(m_threadHandle)==(DWORD)-1)
+		{
+			m_threadLock->Lock();
+			m_status=THREAD_STATUS_STARTED;
+			m_threadLock->Unlock();
+			return false;
+		}
 		return true;
 	}
 	else
@@ -503,6 +528,8 @@ Thread::TerminateResult Thread::TerminateAfter(const unsigned long tMilliseconds
 
 int Thread::run()
 {
+	if(m_startAffinityMask)
+		::SetThreadAffinityMask(GetCurrentThread(),m_startAffinityMask);
 	execute();
 	successTerminate();
 	return 0;
@@ -518,7 +545,7 @@ unsigned int Thread::entryPoint(void * pthis)
 }
 
 
-unsigned long Thread::entryPoint2(void * pthis)
+DWORD Thread::entryPoint2(void * pthis)
 {
 	Thread * pt = reinterpret_cast<Thread*>(pthis);
 	pt->run();
@@ -537,6 +564,33 @@ bool Thread::SetPriority(ThreadPriority priority)
 	return ret;
 
 }
+DWORD_PTR Thread::SetAffinityMask(DWORD_PTR affinityMask)
+{
+	LockObj lock(m_threadLock);
+	DWORD_PTR ret=0;
+	if(m_threadHandle!=0)
+		ret=::SetThreadAffinityMask(m_threadHandle,affinityMask);
+	return ret;
+}
+
+void Thread::SetStartAffinityMask(DWORD_PTR affinityMask)
+{
+	LockObj lock(m_threadLock);
+	m_startAffinityMask=affinityMask;
+}
+
+bool Thread::SetNumaNode(unsigned int nodeIdx)
+{
+	DWORD_PTR nodeMask=CPU_TOPOLOGY_INSTANCE.GetNumaNodeAffinityMask(nodeIdx);
+	if(nodeMask==0)
+		return false;
+	LockObj lock(m_threadLock);
+	m_startAffinityMask=nodeMask;
+	if(m_threadHandle!=0)
+		return ::SetThreadAffinityMask(m_threadHandle,nodeMask)!=0;
+	return true;
+}
+
 ThreadPriority Thread::GetPriority()
 {
 	LockObj lock(m_threadLock);
@@ -551,7 +605,7 @@ void Thread::execute()
 	// Do any execution here
 	m_threadFunc();
 }
-void Thread::onTerminated(unsigned long exitCode,bool isInDeletion)
+void Thread::onTerminated(unsigned long /*exitCode*/,bool /*isInDeletion*/)
 {
 	// Do any clean up here
 }
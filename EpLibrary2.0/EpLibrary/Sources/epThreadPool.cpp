@@ -0,0 +1,283 @@
+/*! 
+ThreadPool for the EpLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epThreadPool.h"
+#include "epSystem.h"
+#include "epCpuTopology.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epl;
+
+ThreadPool::ThreadPool(BaseJobProcessor *jobProcessor,unsigned int workerCount,LockPolicy lockPolicyType,WorkerThreadFactory::WorkerPlacement placement):m_jobSemaphore(LONG_MAX,0L)
+{
+	EP_ASSERT_EXPR(jobProcessor,_T("Job Processor is NULL!"));
+	if(workerCount==0)
+		workerCount=System::GetNumberOfCores();
+	if(workerCount==0)
+		workerCount=1;
+	m_workerCount=workerCount;
+	m_placement=placement;
+	m_nextWorker=0;
+	m_jobCount=0;
+	m_isTerminating=0;
+
+	m_workers=EP_NEW WorkStealingWorkerThread*[m_workerCount];
+	m_workerNodes=EP_NEW unsigned int[m_workerCount];
+	unsigned int trav;
+	for(trav=0;trav<m_workerCount;trav++)
+	{
+		m_workers[trav]=EP_NEW WorkStealingWorkerThread(this,trav,lockPolicyType);
+		m_workers[trav]->SetJobProcessor(jobProcessor);
+		m_workers[trav]->SetStartAffinityMask(WorkerThreadFactory::GetPlacementAffinityMask(placement,trav,m_workerCount));
+		m_workerNodes[trav]=WorkerThreadFactory::GetPlacementNumaNode(placement,trav,m_workerCount);
+	}
+	buildNodeGroups();
+	// start after all workers are created, since the workers steal from each other
+	for(trav=0;trav<m_workerCount;trav++)
+	{
+		m_workers[trav]->Start();
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	TerminatePool();
+	for(unsigned int trav=0;trav<m_workerCount;trav++)
+	{
+		EP_DELETE m_workers[trav];
+	}
+	EP_DELETE[] m_workers;
+	EP_DELETE[] m_workerNodes;
+	EP_DELETE[] m_nodeWorkers;
+	EP_DELETE[] m_nodeWorkerStart;
+	EP_DELETE[] m_stealOrders;
+}
+
+void ThreadPool::Push(BaseJob * const work)
+{
+	unsigned int nodeIdx=(m_nodeCount>1)?CPU_TOPOLOGY_INSTANCE.GetCurrentNumaNode():0;
+	pushTo(nextWorker(nodeIdx),work);
+}
+
+void ThreadPool::PushBatch(BaseJob * const *works,size_t count)
+{
+	unsigned int nodeIdx=(m_nodeCount>1)?CPU_TOPOLOGY_INSTANCE.GetCurrentNumaNode():0;
+	pushBatchTo(nextWorker(nodeIdx),works,count);
+}
+
+void ThreadPool::PushToNode(BaseJob * const work,unsigned int nodeIdx)
+{
+	pushTo(nextWorker(nodeIdx),work);
+}
+
+void ThreadPool::PushBatchToNode(BaseJob * const *works,size_t count,unsigned int nodeIdx)
+{
+	pushBatchTo(nextWorker(nodeIdx),works,count);
+}
+
+size_t ThreadPool::GetJobCount() const
+{
+	long jobCount=m_jobCount;
+	if(jobCount<0)
+		return 0;
+	return (size_t)jobCount;
+}
+
+void ThreadPool::TerminatePool(unsigned int waitTimeInMilliSec)
+{
+	{
+		// after this, the pushes see the flag, and the jobs pushed before are in the local deques
+		LockObj lock(&m_terminateLock);
+		if(InterlockedExchange(&m_isTerminating,1))
+			return;
+	}
+	m_jobSemaphore.Release((long)m_workerCount);
+	unsigned int trav;
+	for(trav=0;trav<m_workerCount;trav++)
+	{
+		m_workers[trav]->TerminateWorker(waitTimeInMilliSec);
+	}
+	for(trav=0;trav<m_workerCount;trav++)
+	{
+		BaseJob *jobPtr;
+		while((jobPtr=m_workers[trav]->popLocal())!=NULL)
+		{
+			InterlockedDecrement(&m_jobCount);
+			jobPtr->JobReport(BaseJob::JOB_STATUS_INCOMPLETE);
+			jobPtr->ReleaseObj();
+		}
+	}
+}
+
+WorkStealingWorkerThread *ThreadPool::nextWorker(unsigned int nodeIdx)
+{
+	unsigned long workerIdx=(unsigned long)InterlockedIncrement(&m_nextWorker);
+	if(nodeIdx<m_nodeCount)
+	{
+		unsigned int nodeWorkerCount=m_nodeWorkerStart[nodeIdx+1]-m_nodeWorkerStart[nodeIdx];
+		if(nodeWorkerCount)
+			return m_workers[m_nodeWorkers[m_nodeWorkerStart[nodeIdx]+workerIdx%nodeWorkerCount]];
+	}
+	return m_workers[workerIdx%m_workerCount];
+}
+
+void ThreadPool::buildNodeGroups()
+{
+	unsigned int trav;
+	m_nodeCount=1;
+	for(trav=0;trav<m_workerCount;trav++)
+	{
+		if(m_workerNodes[trav]>=m_nodeCount)
+			m_nodeCount=m_workerNodes[trav]+1;
+	}
+
+	// group the workers by the node, keeping the order of the workers within the node
+	m_nodeWorkerStart=EP_NEW unsigned int[m_nodeCount+1];
+	for(trav=0;trav<=m_nodeCount;trav++)
+		m_nodeWorkerStart[trav]=0;
+	for(trav=0;trav<m_workerCount;trav++)
+		m_nodeWorkerStart[m_workerNodes[trav]+1]++;
+	for(trav=1;trav<=m_nodeCount;trav++)
+		m_nodeWorkerStart[trav]+=m_nodeWorkerStart[trav-1];
+	m_nodeWorkers=EP_NEW unsigned int[m_workerCount];
+	unsigned int *nodeFilled=EP_NEW unsigned int[m_nodeCount];
+	for(trav=0;trav<m_nodeCount;trav++)
+		nodeFilled[trav]=m_nodeWorkerStart[trav];
+	for(trav=0;trav<m_workerCount;trav++)
+		m_nodeWorkers[nodeFilled[m_workerNodes[trav]]++]=trav;
+	EP_DELETE[] nodeFilled;
+
+	// each worker steals from the workers next to it within its node, and then from the other nodes
+	unsigned int stealCount=m_workerCount-1;
+	m_stealOrders=EP_NEW unsigned int[m_workerCount*stealCount+1];
+	for(trav=0;trav<m_workerCount;trav++)
+	{
+		unsigned int *stealOrder=m_stealOrders+trav*stealCount;
+		unsigned int orderIdx=0;
+		unsigned int offset;
+		for(offset=1;offset<m_workerCount;offset++)
+		{
+			unsigned int victim=(trav+offset)%m_workerCount;
+			if(m_workerNodes[victim]==m_workerNodes[trav])
+				stealOrder[orderIdx++]=victim;
+		}
+		for(offset=1;offset<m_workerCount;offset++)
+		{
+			unsigned int victim=(trav+offset)%m_workerCount;
+			if(m_workerNodes[victim]!=m_workerNodes[trav])
+				stealOrder[orderIdx++]=victim;
+		}
+	}
+}
+
+void ThreadPool::pushTo(WorkStealingWorkerThread *worker,BaseJob * const work)
+{
+	if(m_isTerminating)
+	{
+		work->JobReport(BaseJob::JOB_STATUS_INCOMPLETE);
+		return;
+	}
+	work->RetainObj();
+	// reported before the lock, so the status handler can push to the pool
+	work->JobReport(BaseJob::JOB_STATUS_IN_QUEUE);
+	m_terminateLock.LockShared();
+	if(m_isTerminating)
+	{
+		m_terminateLock.UnlockShared();
+		work->JobReport(BaseJob::JOB_STATUS_INCOMPLETE);
+		work->ReleaseObj();
+		return;
+	}
+	InterlockedIncrement(&m_jobCount);
+	worker->pushLocal(work);
+	m_jobSemaphore.Release(1);
+	m_terminateLock.UnlockShared();
+}
+
+void ThreadPool::pushBatchTo(WorkStealingWorkerThread *worker,BaseJob * const *works,size_t count)
+{
+	if(count==0)
+		return;
+	size_t trav;
+	if(m_isTerminating)
+	{
+		for(trav=0;trav<count;trav++)
+		{
+			works[trav]->JobReport(BaseJob::JOB_STATUS_INCOMPLETE);
+		}
+		return;
+	}
+	for(trav=0;trav<count;trav++)
+	{
+		works[trav]->RetainObj();
+		works[trav]->JobReport(BaseJob::JOB_STATUS_IN_QUEUE);
+	}
+	m_terminateLock.LockShared();
+	if(m_isTerminating)
+	{
+		m_terminateLock.UnlockShared();
+		for(trav=0;trav<count;trav++)
+		{
+			works[trav]->JobReport(BaseJob::JOB_STATUS_INCOMPLETE);
+			works[trav]->ReleaseObj();
+		}
+		return;
+	}
+	InterlockedExchangeAdd(&m_jobCount,(long)count);
+	worker->pushBatchLocal(works,count);
+	m_jobSemaphore.Release((long)count);
+	m_terminateLock.UnlockShared();
+}
+
+BaseJob *ThreadPool::take(WorkStealingWorkerThread *worker)
+{
+	m_jobSemaphore.Lock();
+	unsigned int spinCount=0;
+	while(!m_isTerminating)
+	{
+		BaseJob *jobPtr=worker->popLocal();
+		const unsigned int *stealOrder=m_stealOrders+worker->m_workerIdx*(m_workerCount-1);
+		for(unsigned int trav=0;!jobPtr && trav<m_workerCount-1;trav++)
+		{
+			jobPtr=m_workers[stealOrder[trav]]->stealLocal();
+		}
+		if(jobPtr)
+		{
+			InterlockedDecrement(&m_jobCount);
+			return jobPtr;
+		}
+		// the job counted by the semaphore is in between the scans of the other workers
+		if(spinCount++<16)
+			YieldProcessor();
+		else
+			SwitchToThread();
+	}
+	return NULL;
+}
@@ -0,0 +1,150 @@
+/*! 
+TicketLock for the EpLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epTicketLock.h"
+#include "epSystem.h"
+#include "epException.h"
+#include "epDateTimeHelper.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epl;
+
+TicketLock::TicketLock(unsigned int spinCount) :BaseLock()
+{
+	m_nextTicket=0;
+	m_nowServing=0;
+	m_parkedCount=0;
+	m_spinCount=spinCount;
+	resetParkEvents();
+}
+
+TicketLock::TicketLock(const TicketLock& b) :BaseLock()
+{
+	m_nextTicket=0;
+	m_nowServing=0;
+	m_parkedCount=0;
+	m_spinCount=b.m_spinCount;
+	resetParkEvents();
+}
+
+TicketLock::~TicketLock()
+{
+	EP_ASSERT_EXPR(m_nextTicket==m_nowServing,_T("Lock is still held!"));
+}
+
+TicketLock & TicketLock::operator=(const TicketLock&b)
+{
+	if(this!=&b)
+	{
+		EP_ASSERT_EXPR(m_nextTicket==m_nowServing,_T("Lock is still held!"));
+		m_spinCount=b.m_spinCount;
+	}
+	return *this;
+}
+
+bool TicketLock::Lock()
+{
+	unsigned long ticket=(unsigned long)InterlockedExchangeAdd(&m_nextTicket,1);
+	unsigned long distance;
+	for(unsigned long spinCount=0;spinCount<m_spinCount;spinCount+=distance*TICKET_LOCK_BACKOFF_UNIT)
+	{
+		// the counters wrap around, so compare the distance rather than the tickets
+		distance=ticket-(unsigned long)LoadAcquire(&m_nowServing);
+		if(distance==0)
+			return true;
+		for(unsigned long trav=0;trav<distance*TICKET_LOCK_BACKOFF_UNIT;trav++)
+			YieldProcessor();
+	}
+
+	// the parked count is raised before the recheck, so Unlock cannot miss this thread
+	InterlockedIncrement(&m_parkedCount);
+	unsigned long slot=ticket%TICKET_LOCK_PARK_SLOT_COUNT;
+	while(ticket!=(unsigned long)LoadAcquire(&m_nowServing))
+	{
+		m_parkEvents[slot].WaitForEvent();
+		unsigned long nowServing=(unsigned long)LoadAcquire(&m_nowServing);
+		if(nowServing!=ticket && nowServing%TICKET_LOCK_PARK_SLOT_COUNT==slot)
+		{
+			// the signal is for the thread served, which is TICKET_LOCK_PARK_SLOT_COUNT or more places ahead on the same slot
+			m_parkEvents[slot].SetEvent();
+			Sleep(1);
+		}
+	}
+	InterlockedDecrement(&m_parkedCount);
+	return true;
+}
+
+long TicketLock::TryLock()
+{
+	long nowServing=LoadAcquire(&m_nowServing);
+	if(m_nextTicket!=nowServing)
+		return 0;
+	if(InterlockedCompareExchange(&m_nextTicket,nowServing+1,nowServing)!=nowServing)
+		return 0;
+	return 1;
+}
+
+long TicketLock::TryLockFor(const unsigned int dwMilliSecond)
+{
+	if(TryLock())
+		return 1;
+	SYSTEMTIME startTime=DateTimeHelper::GetCurrentDateTime();
+	unsigned int spinCount=0;
+	while(DateTimeHelper::AbsDiffInMilliSec(DateTimeHelper::GetCurrentDateTime(),startTime)<(__int64)dwMilliSecond)
+	{
+		if(spinCount<m_spinCount)
+		{
+			spinCount++;
+			YieldProcessor();
+		}
+		else
+			Sleep(1);
+		if(TryLock())
+			return 1;
+	}
+	return 0;
+}
+
+void TicketLock::Unlock()
+{
+	EP_ASSERT_EXPR(m_nextTicket!=m_nowServing,_T("Lock is not held!"));
+	// only the holder writes m_nowServing, the interlocked increment is also the full barrier before reading the parked count
+	unsigned long nowServing=(unsigned long)InterlockedIncrement(&m_nowServing);
+	// the signal is kept by the auto reset event if the next thread has not parked yet
+	if(LoadAcquire(&m_parkedCount)!=0)
+		m_parkEvents[nowServing%TICKET_LOCK_PARK_SLOT_COUNT].SetEvent();
+}
+
+void TicketLock::resetParkEvents()
+{
+	// the events are created raised
+	for(unsigned int trav=0;trav<TICKET_LOCK_PARK_SLOT_COUNT;trav++)
+		m_parkEvents[trav].ResetEvent();
+}
@@ -42,42 +42,63 @@ suitability of this software for any purpose. It is provided "as is"
 */
 #include "epTinyObject.h"
 #include "epException.h"
+#include <malloc.h>
+#include <string.h>
+#include <algorithm>
 
 
 namespace epl
 {
-	void StaticAllocator::Fragment::Init(size_t blockSize, unsigned char blocks)
+	void StaticAllocator::Fragment::Init(size_t blockSize, BlockIndex blocks, size_t chunkSize, size_t fragmentIdx)
 	{
 		EP_ASSERT(blockSize > 0);
 		EP_ASSERT(blocks > 0);
-		EP_ASSERT((blockSize * blocks) / blockSize == blocks);
+		EP_ASSERT(TINY_OBJECT_CHUNK_HEADER_SIZE + blockSize * blocks <= chunkSize);
 
-		m_Data = EP_NEW unsigned char[blockSize * static_cast<size_t>(blocks)];
+		m_chunk = reinterpret_cast<unsigned char*>(_aligned_malloc(chunkSize, chunkSize));
+		EP_ASSERT(m_chunk);
+		m_Data = m_chunk + TINY_OBJECT_CHUNK_HEADER_SIZE;
+		SetIndex(fragmentIdx);
 		Reset(blockSize, blocks);
 
 	}
 
-	void StaticAllocator::Fragment::Reset(size_t blockSize, unsigned char blocks)
+	StaticAllocator::BlockIndex StaticAllocator::Fragment::ReadIndex(const unsigned char *block, size_t blockSize)
+	{
+		if(blockSize < sizeof(BlockIndex))
+			return *block;
+		BlockIndex idx;
+		memcpy(&idx, block, sizeof(BlockIndex));
+		return idx;
+	}
+
+	void StaticAllocator::Fragment::WriteIndex(unsigned char *block, size_t blockSize, BlockIndex idx)
+	{
+		if(blockSize < sizeof(BlockIndex))
+			*block = static_cast<unsigned char>(idx);
+		else
+			memcpy(block, &idx, sizeof(BlockIndex));
+	}
+
+	void StaticAllocator::Fragment::Reset(size_t blockSize, BlockIndex blocks)
 	{
 		EP_ASSERT(blockSize > 0);
 		EP_ASSERT(blocks > 0);
-		EP_ASSERT((blockSize * blocks) / blockSize == blocks);
 		firstAvailableBlock=0;
 		numBlocksAvailable=blocks;
-		unsigned char i=0;
+		BlockIndex i=0;
 		unsigned char* tmp=m_Data;
 		for(;i!=blocks;tmp+=blockSize)
 		{
-			*tmp=++i;
+			WriteIndex(tmp, blockSize, ++i);
 		}
 	}
 	void *StaticAllocator::Fragment::Allocate(size_t blockSize)
 	{
 		if(!numBlocksAvailable)
 			return 0;
-		EP_ASSERT((firstAvailableBlock * blockSize) / blockSize == firstAvailableBlock);
 		unsigned char *result= m_Data+(firstAvailableBlock*blockSize);
-		firstAvailableBlock=*result;
+		firstAvailableBlock=ReadIndex(result, blockSize);
 		--numBlocksAvailable;
 		return result;
 	}
@@ -87,16 +108,17 @@ namespace epl
 		EP_ASSERT(p>=m_Data);
 		unsigned char * releaseData= reinterpret_cast<unsigned char*>(p);
 		EP_ASSERT((releaseData-m_Data)%blockSize==0);
-		*releaseData=firstAvailableBlock;
-		firstAvailableBlock=static_cast<unsigned char>((releaseData-m_Data)/blockSize);
+		WriteIndex(releaseData, blockSize, firstAvailableBlock);
+		firstAvailableBlock=static_cast<BlockIndex>((releaseData-m_Data)/blockSize);
 		EP_ASSERT(firstAvailableBlock==(releaseData-m_Data)/blockSize);
 		++numBlocksAvailable;
 	}
 
 	void StaticAllocator::Fragment::Clear()
 	{
-		if (m_Data)
-			EP_DELETE[] m_Data;
+		if (m_chunk)
+			_aligned_free(m_chunk);
+		m_chunk=NULL;
 		m_Data=NULL;
 		firstAvailableBlock=0;
 		numBlocksAvailable=0;
@@ -104,18 +126,26 @@ namespace epl
 	}
 
 
-	StaticAllocator::StaticAllocator(size_t blockSize)
+	StaticAllocator::StaticAllocator(size_t blockSize, size_t fragmentSize)
 		: m_blockSize(blockSize)
 		, m_allocFragment(0)
 		, m_deallocFragment(0)
+		, m_allocCount(0)
+		, m_deallocCount(0)
 	{
 		EP_ASSERT(m_blockSize > 0);
 
-		size_t numBlocks = DEFAULT_FRAGMENT_SIZE / blockSize;
-		if (numBlocks > UCHAR_MAX) numBlocks = UCHAR_MAX;
-		else if (numBlocks == 0) numBlocks = 8 * blockSize;
+		// the chunk must hold the header and at least 8 blocks
+		size_t chunkSize = TINY_OBJECT_CHUNK_HEADER_SIZE * 2;
+		while (chunkSize < fragmentSize || chunkSize < TINY_OBJECT_CHUNK_HEADER_SIZE + 8 * blockSize)
+			chunkSize <<= 1;
+		m_chunkSize = chunkSize;
+
+		size_t maxBlocks = (blockSize < sizeof(BlockIndex)) ? UCHAR_MAX : USHRT_MAX;
+		size_t numBlocks = (m_chunkSize - TINY_OBJECT_CHUNK_HEADER_SIZE) / blockSize;
+		if (numBlocks > maxBlocks) numBlocks = maxBlocks;
 
-		m_numBlocks = static_cast<unsigned char>(numBlocks);
+		m_numBlocks = static_cast<BlockIndex>(numBlocks);
 		EP_ASSERT(m_numBlocks == numBlocks);
 	}
 
@@ -123,7 +153,10 @@ namespace epl
 	StaticAllocator::StaticAllocator(const StaticAllocator& rhs)
 		: m_blockSize(rhs.m_blockSize)
 		, m_numBlocks(rhs.m_numBlocks)
+		, m_chunkSize(rhs.m_chunkSize)
 		, m_fragments(rhs.m_fragments)
+		, m_allocCount(rhs.m_allocCount)
+		, m_deallocCount(rhs.m_deallocCount)
 	{
 		m_allocFragment = rhs.m_allocFragment
 			? &(m_fragments.front()) + (rhs.m_allocFragment - &(rhs.m_fragments.front()))
@@ -147,54 +180,51 @@ namespace epl
 	void StaticAllocator::Swap(StaticAllocator& rhs)
 	{
 		SwapFunc<size_t>(&m_blockSize, &(rhs.m_blockSize));
-		SwapFunc<unsigned char>(&m_numBlocks, &(rhs.m_numBlocks));
+		SwapFunc<BlockIndex>(&m_numBlocks, &(rhs.m_numBlocks));
+		SwapFunc<size_t>(&m_chunkSize, &(rhs.m_chunkSize));
 		SwapFunc<Fragments>(&m_fragments, &(rhs.m_fragments));
 		SwapFunc<Fragment*>(&m_allocFragment, &(rhs.m_allocFragment));
 		SwapFunc<Fragment*>(&m_deallocFragment, &(rhs.m_deallocFragment));
+		SwapFunc<size_t>(&m_allocCount, &(rhs.m_allocCount));
+		SwapFunc<size_t>(&m_deallocCount, &(rhs.m_deallocCount));
 	}
 
 	void *StaticAllocator::Allocate()
 	{
 		if(m_allocFragment==0 || m_allocFragment->numBlocksAvailable==0)
 		{
-
+			m_allocFragment=0;
 			size_t i;
-			for(i=0;i<=m_fragments.size();i++)
+			for(i=0;i<m_fragments.size();i++)
 			{
-				Fragment* iter=NULL;
-				if(m_fragments.size()>i)
-					iter=&m_fragments.at(i);
-				if(iter==NULL)
-				{
-					Fragment newFragment;
-					newFragment.Init(m_blockSize,m_numBlocks);
-					m_fragments.push_back(newFragment);
-					Fragment *tmpFrag=&(m_fragments.at(m_fragments.size()-1));
-					*tmpFrag=newFragment;
-					m_allocFragment=&(m_fragments.back());
-					m_deallocFragment=&(m_fragments.back());
-					break;
-				}
-				if(iter->numBlocksAvailable>0)
+				if(m_fragments.at(i).numBlocksAvailable>0)
 				{
-					m_allocFragment=iter;
+					m_allocFragment=&m_fragments.at(i);
 					break;
 				}
 			}
+			if(m_allocFragment==0)
+			{
+				Fragment newFragment;
+				newFragment.Init(m_blockSize,m_numBlocks,m_chunkSize,m_fragments.size());
+				m_fragments.push_back(newFragment);
+				m_allocFragment=&(m_fragments.back());
+				m_deallocFragment=&(m_fragments.back());
+			}
 		}
 		EP_ASSERT(m_allocFragment!=0);
 		EP_ASSERT(m_allocFragment->numBlocksAvailable>0);
+		++m_allocCount;
 		return m_allocFragment->Allocate(m_blockSize);
 	}
 
 	void StaticAllocator::Deallocate(void* p, CacheType type)
 	{
 		EP_ASSERT(!m_fragments.empty());
-		EP_ASSERT(&(m_fragments.front()) <= m_deallocFragment);
-		EP_ASSERT(&(m_fragments.back()) >= m_deallocFragment);
 
-		m_deallocFragment  = VicinityFind(p);
+		m_deallocFragment  = FindFragment(p);
 		EP_ASSERT(m_deallocFragment);
+		++m_deallocCount;
 
 		Release(p,type);
 	}
@@ -233,10 +263,14 @@ namespace epl
 					m_fragments.erase(m_fragments.begin()+trav);
 				}
 			}
-			if(m_fragments.empty())
-				m_fragments.clear();
-			m_allocFragment=&(m_fragments.front());
-			m_deallocFragment=&(m_fragments.back());
+			ReIndex(0);
+			m_allocFragment=NULL;
+			m_deallocFragment=NULL;
+			if(!m_fragments.empty())
+			{
+				m_allocFragment=&(m_fragments.front());
+				m_deallocFragment=&(m_fragments.back());
+			}
 		}
 		else
 		{
@@ -245,42 +279,37 @@ namespace epl
 		}
 
 	}
-	StaticAllocator::Fragment* StaticAllocator::VicinityFind(void* p)
+	void StaticAllocator::GetReport(Report &retReport) const
+	{
+		retReport.blockSize=m_blockSize;
+		retReport.fragmentCount=m_fragments.size();
+		retReport.blockCount=m_fragments.size()*m_numBlocks;
+		retReport.freeBlockCount=0;
+		for(size_t trav=0;trav<m_fragments.size();trav++)
+		{
+			retReport.freeBlockCount+=m_fragments.at(trav).numBlocksAvailable;
+		}
+		retReport.reservedBytes=m_fragments.size()*m_chunkSize;
+		retReport.allocCount=m_allocCount;
+		retReport.deallocCount=m_deallocCount;
+	}
+	StaticAllocator::Fragment* StaticAllocator::FindFragment(void* p)
 	{
 		EP_ASSERT(!m_fragments.empty());
-		EP_ASSERT(m_deallocFragment);
-
-		size_t chunkLength = m_numBlocks * m_blockSize;
 
-		Fragment* lo = m_deallocFragment;
-		Fragment* hi = m_deallocFragment + 1;
-		Fragment* loBound = &(m_fragments.front());
-		Fragment* hiBound = &(m_fragments.back()) + 1;
-
-		if (hi == hiBound) hi = 0;
+		unsigned char *chunk = reinterpret_cast<unsigned char*>(reinterpret_cast<size_t>(p) & ~(m_chunkSize-1));
+		size_t fragmentIdx = *reinterpret_cast<size_t*>(chunk);
+		EP_ASSERT(fragmentIdx < m_fragments.size());
+		Fragment *fragment = &(m_fragments.at(fragmentIdx));
+		EP_ASSERT(fragment->m_chunk == chunk);
+		return fragment;
+	}
 
-		for (;;)
+	void StaticAllocator::ReIndex(size_t startIdx)
+	{
+		for(size_t trav=startIdx;trav<m_fragments.size();trav++)
 		{
-			if (lo)
-			{
-				if (p >= lo->m_Data && p < lo->m_Data + chunkLength)
-				{
-					return lo;
-				}
-				if (lo == loBound) 
-					lo = 0;
-				else --lo;
-			}
-
-			if (hi)
-			{
-				if (p >= hi->m_Data && p < hi->m_Data + chunkLength)
-				{
-					return hi;
-				}
-				if (++hi == hiBound) 
-					hi = 0;
-			}
+			m_fragments.at(trav).SetIndex(trav);
 		}
 	}
 
@@ -299,8 +328,10 @@ namespace epl
 		{
 			Fragment * lastFragment =&(m_fragments.back());
 			SwapFunc<Fragment>(m_deallocFragment,lastFragment);
+			m_deallocFragment->SetIndex(m_deallocFragment-&(m_fragments.front()));
 			if(type&CACHE_TYPE_FRAGMENT)
 			{
+				lastFragment->SetIndex(m_fragments.size()-1);
 				lastFragment->Reset(m_blockSize,m_numBlocks);
 			}
 			else
@@ -320,46 +351,84 @@ namespace epl
 			return;
 		}
 		m_allocFragment=m_deallocFragment;
+	}
+
+
+	TinyObjThreadCache::TinyObjThreadCache(size_t maxObjectSize)
+		: m_maxObjectSize(maxObjectSize)
+	{
+		m_freeLists=EP_NEW FreeBlock*[m_maxObjectSize+1];
+		m_counts=EP_NEW size_t[m_maxObjectSize+1];
+		for(size_t trav=0;trav<=m_maxObjectSize;trav++)
+		{
+			m_freeLists[trav]=NULL;
+			m_counts[trav]=0;
+		}
+	}
 
-		// 	if (m_deallocFragment->numBlocksAvailable == m_numBlocks)
-		// 	{
-		// 		Fragment * lastFragment = m_fragments.GetBack();
-		// 
-		// 		if (lastFragment == m_deallocFragment)
-		// 		{
-		// 
-		// 			if (m_fragments.Count() > 1 && 
-		// 				m_deallocFragment->numBlocksAvailable == m_numBlocks)
-		// 			{				
-		// 				m_fragments.Erase(m_fragments.Count()-1);
-		// 				lastFragment->Release();
-		// 				m_allocFragment = m_deallocFragment = m_fragments.GetFront();
-		// 			}
-		// 			return;
-		// 		}
-		// 		if (lastFragment->numBlocksAvailable == m_numBlocks)
-		// 		{			
-		// 			m_fragments.Erase(m_fragments.Count()-1);
-		// 			lastFragment->Release();
-		// 			m_allocFragment = m_deallocFragment;
-		// 		}
-		// 		else
-		// 		{
-		// 			DefaultSwapFunc<Fragment>(m_deallocFragment,lastFragment);
-		// 			m_allocFragment = m_fragments.GetBack();
-		// 		}
-		// 	}
-	}
-
-
-
-	TinyObjAllocator::TinyObjAllocator(size_t fragmentSize,size_t maxObjectSize)
+	TinyObjThreadCache::~TinyObjThreadCache()
+	{
+		// the cached blocks belong to the fragments of the allocator
+		EP_DELETE[] m_freeLists;
+		EP_DELETE[] m_counts;
+	}
+
+	void* TinyObjThreadCache::Refill(TinyObjAllocator &allocator, size_t numBytes)
+	{
+		EP_ASSERT(IsCacheable(numBytes));
+		for(size_t trav=1;trav<TINY_OBJECT_CACHE_BATCH_COUNT;trav++)
+		{
+			FreeBlock *block=reinterpret_cast<FreeBlock*>(allocator.Allocate(numBytes));
+			block->m_next=m_freeLists[numBytes];
+			m_freeLists[numBytes]=block;
+			++m_counts[numBytes];
+		}
+		return allocator.Allocate(numBytes);
+	}
+
+	void TinyObjThreadCache::Drain(TinyObjAllocator &allocator, size_t numBytes, CacheType type)
+	{
+		release(allocator,numBytes,type,TINY_OBJECT_CACHE_BATCH_COUNT);
+	}
+
+	void TinyObjThreadCache::Flush(TinyObjAllocator &allocator, CacheType type)
+	{
+		for(size_t trav=0;trav<=m_maxObjectSize;trav++)
+		{
+			release(allocator,trav,type,0);
+		}
+	}
+
+	void TinyObjThreadCache::release(TinyObjAllocator &allocator, size_t numBytes, CacheType type, size_t keepCount)
+	{
+		while(m_counts[numBytes]>keepCount)
+		{
+			FreeBlock *block=m_freeLists[numBytes];
+			m_freeLists[numBytes]=block->m_next;
+			--m_counts[numBytes];
+			allocator.Deallocate(block,numBytes,type);
+		}
+	}
+
+
+
+	TinyObjAllocator::TinyObjAllocator(size_t fragmentSize,size_t maxObjectSize,PFLS_CALLBACK_FUNCTION threadExitCallback)
 		: m_lastAlloc(0), m_lastDealloc(0), m_fragmentSize(fragmentSize), m_maxObjectSize(maxObjectSize) 
 	{   
+		m_threadCacheIdx=FlsAlloc(threadExitCallback);
 	}
 	TinyObjAllocator::~TinyObjAllocator()
 	{
 		size_t trav;
+		// freeing the index first, so no thread exit callback comes after the caches are deleted
+		if(m_threadCacheIdx!=FLS_OUT_OF_INDEXES)
+			FlsFree(m_threadCacheIdx);
+		for(trav=0;trav<m_threadCaches.size();trav++)
+		{
+			EP_DELETE m_threadCaches.at(trav);
+		}
+		m_threadCaches.clear();
+
 		for(trav=0;trav<m_pool.size();trav++)
 		{
 			StaticAllocator *tmp=&(m_pool.at(trav));
@@ -393,7 +462,7 @@ namespace epl
 
 		if (i ==NULL || i->GetBlockSize() != numBytes)
 		{
-			StaticAllocator tmp=StaticAllocator(numBytes);
+			StaticAllocator tmp=StaticAllocator(numBytes,m_fragmentSize);
 			i = &(*(m_pool.insert(m_pool.begin()+idx,tmp)));
 			m_lastDealloc = &(m_pool.front());
 		}
@@ -452,6 +521,48 @@ namespace epl
 			Compress(type);
 	}
 
+	TinyObjThreadCache* TinyObjAllocator::CreateThreadCache()
+	{
+		if(m_threadCacheIdx==FLS_OUT_OF_INDEXES)
+			return NULL;
+		TinyObjThreadCache *cache=EP_NEW TinyObjThreadCache(m_maxObjectSize);
+		if(!FlsSetValue(m_threadCacheIdx,cache))
+		{
+			EP_DELETE cache;
+			return NULL;
+		}
+		m_threadCaches.push_back(cache);
+		return cache;
+	}
+
+	void TinyObjAllocator::FlushThreadCache(CacheType type)
+	{
+		TinyObjThreadCache *cache=GetThreadCache();
+		if(cache)
+			cache->Flush(*this,type);
+	}
+
+	void TinyObjAllocator::ReleaseThreadCache(TinyObjThreadCache *cache, CacheType type)
+	{
+		std::vector<TinyObjThreadCache*>::iterator iter=std::find(m_threadCaches.begin(),m_threadCaches.end(),cache);
+		if(iter==m_threadCaches.end())
+			return;
+		m_threadCaches.erase(iter);
+		if(GetThreadCache()==cache)
+			FlsSetValue(m_threadCacheIdx,NULL);
+		cache->Flush(*this,type);
+		EP_DELETE cache;
+	}
+
+	void TinyObjAllocator::GetReport(std::vector<StaticAllocator::Report> &retReports) const
+	{
+		retReports.resize(m_pool.size());
+		for(size_t trav=0;trav<m_pool.size();trav++)
+		{
+			m_pool.at(trav).GetReport(retReports.at(trav));
+		}
+	}
+
 	void TinyObjAllocator::Compress(CacheType type)
 	{
 		ssize_t trav;
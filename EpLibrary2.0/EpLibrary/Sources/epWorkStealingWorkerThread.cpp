@@ -0,0 +1,144 @@
+/*! 
+WorkStealingWorkerThread for the EpLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2008-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epWorkStealingWorkerThread.h"
+#include "epThreadPool.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epl;
+
+WorkStealingWorkerThread::WorkStealingWorkerThread(ThreadPool *pool,unsigned int workerIdx,LockPolicy lockPolicyType):BaseWorkerThread(THREAD_LIFE_INFINITE,lockPolicyType)
+{
+	m_pool=pool;
+	m_workerIdx=workerIdx;
+	switch(lockPolicyType)
+	{
+	case LOCK_POLICY_CRITICALSECTION:
+	case LOCK_POLICY_READWRITE:
+		m_localLock=EP_NEW CriticalSectionEx();
+		break;
+	case LOCK_POLICY_MUTEX:
+		m_localLock=EP_NEW Mutex();
+		break;
+	case LOCK_POLICY_NONE:
+		m_localLock=EP_NEW NoLock();
+		break;
+	default:
+		m_localLock=NULL;
+		break;
+	}
+}
+
+WorkStealingWorkerThread::~WorkStealingWorkerThread()
+{
+	BaseJob *jobPtr;
+	while((jobPtr=popLocal())!=NULL)
+	{
+		jobPtr->JobReport(BaseJob::JOB_STATUS_INCOMPLETE);
+		jobPtr->ReleaseObj();
+	}
+	if(m_localLock)
+		EP_DELETE m_localLock;
+}
+
+void WorkStealingWorkerThread::Push(BaseJob * const work)
+{
+	m_pool->pushTo(this,work);
+}
+
+void WorkStealingWorkerThread::PushBatch(BaseJob * const *works,size_t count)
+{
+	m_pool->pushBatchTo(this,works,count);
+}
+
+size_t WorkStealingWorkerThread::GetJobCount() const
+{
+	LockObj lock(m_localLock);
+	return m_localJobs.Size();
+}
+
+void WorkStealingWorkerThread::pushLocal(BaseJob * const work)
+{
+	LockObj lock(m_localLock);
+	m_localJobs.PushBack(work);
+}
+
+void WorkStealingWorkerThread::pushBatchLocal(BaseJob * const *works,size_t count)
+{
+	LockObj lock(m_localLock);
+	m_localJobs.Reserve(m_localJobs.Size()+count);
+	for(size_t trav=0;trav<count;trav++)
+	{
+		m_localJobs.PushBack(works[trav]);
+	}
+}
+
+BaseJob *WorkStealingWorkerThread::popLocal()
+{
+	LockObj lock(m_localLock);
+	if(m_localJobs.IsEmpty())
+		return NULL;
+	BaseJob *retJob=m_localJobs.Back();
+	m_localJobs.PopBack();
+	return retJob;
+}
+
+BaseJob *WorkStealingWorkerThread::stealLocal()
+{
+	LockObj lock(m_localLock);
+	if(m_localJobs.IsEmpty())
+		return NULL;
+	BaseJob *retJob=m_localJobs.Front();
+	m_localJobs.PopFront();
+	return retJob;
+}
+
+void WorkStealingWorkerThread::processJob(BaseJob * const work)
+{
+	work->JobReport(BaseJob::JOB_STATUS_IN_PROCESS);
+	m_jobProcessor->DoJob(this,work);
+	work->JobReport(BaseJob::JOB_STATUS_DONE);
+	work->ReleaseObj();
+}
+
+void WorkStealingWorkerThread::execute()
+{
+	EP_ASSERT_EXPR(m_jobProcessor,_T("Job Processor is NULL!"));
+	if(!m_jobProcessor)
+		return;
+	while(true)
+	{
+		BaseJob *jobPtr=m_pool->take(this);
+		if(!jobPtr)
+			break;
+		processJob(jobPtr);
+	}
+	callCallBack();
+}
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include "epWorkerThreadFactory.h"
 #include "epWorkerThreadInfinite.h"
 #include "epWorkerThreadSingle.h"
+#include "epCpuTopology.h"
 
 #if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
 #define new DEBUG_NEW
@@ -48,4 +49,48 @@ BaseWorkerThread *WorkerThreadFactory::GetWorkerThread(const BaseWorkerThread::T
 		EP_ASSERT_EXPR(0,_T("Unknown Thread Life Policy Input! Thread Life Policy Input : %d"),policy);
 	}
 	return NULL;
-}
\ No newline at end of file
+}
+
+BaseWorkerThread *WorkerThreadFactory::GetWorkerThread(const BaseWorkerThread::ThreadLifePolicy policy,const WorkerPlacement placement,unsigned int workerIdx,unsigned int workerCount)
+{
+	BaseWorkerThread *retWorker=GetWorkerThread(policy);
+	if(retWorker)
+		retWorker->SetStartAffinityMask(GetPlacementAffinityMask(placement,workerIdx,workerCount));
+	return retWorker;
+}
+
+DWORD_PTR WorkerThreadFactory::GetPlacementAffinityMask(const WorkerPlacement placement,unsigned int workerIdx,unsigned int workerCount)
+{
+	switch(placement)
+	{
+	case WORKER_PLACEMENT_COMPACT:
+		return ((DWORD_PTR)1)<<CPU_TOPOLOGY_INSTANCE.GetCompactProcessor(workerIdx);
+	case WORKER_PLACEMENT_SCATTER:
+		return ((DWORD_PTR)1)<<CPU_TOPOLOGY_INSTANCE.GetScatterProcessor(workerIdx);
+	case WORKER_PLACEMENT_NUMA_NODE:
+		return CPU_TOPOLOGY_INSTANCE.GetNumaNodeAffinityMask(GetPlacementNumaNode(placement,workerIdx,workerCount));
+	default:
+		break;
+	}
+	return 0;
+}
+
+unsigned int WorkerThreadFactory::GetPlacementNumaNode(const WorkerPlacement placement,unsigned int workerIdx,unsigned int workerCount)
+{
+	CpuTopology &topology=CPU_TOPOLOGY_INSTANCE;
+	switch(placement)
+	{
+	case WORKER_PLACEMENT_COMPACT:
+		return topology.GetProcessorNumaNode(topology.GetCompactProcessor(workerIdx));
+	case WORKER_PLACEMENT_SCATTER:
+		return topology.GetProcessorNumaNode(topology.GetScatterProcessor(workerIdx));
+	case WORKER_PLACEMENT_NUMA_NODE:
+		// the consecutive workers share a node, so each node gets an equal share of the workers
+		if(workerCount==0 || workerIdx>=workerCount)
+			return workerIdx%topology.GetNumaNodeCount();
+		return (unsigned int)(((unsigned long long)workerIdx*topology.GetNumaNodeCount())/workerCount);
+	default:
+		break;
+	}
+	return 0;
+}
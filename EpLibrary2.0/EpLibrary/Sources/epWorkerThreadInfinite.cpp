@@ -32,19 +32,48 @@ static char THIS_FILE[] = __FILE__;
 #endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
 
 using namespace epl;
-WorkerThreadInfinite::WorkerThreadInfinite(const ThreadLifePolicy policy):BaseWorkerThread(policy)
+WorkerThreadInfinite::WorkerThreadInfinite(const ThreadLifePolicy policy,unsigned int spinCount,unsigned int drainCount):BaseWorkerThread(policy)
 {
 	m_terminateEvent=EventEx(false,false);
+	m_workEvent=EventEx(false,false);
+	m_spinCount=spinCount;
+	m_drainCount=1;
+	SetDrainCount(drainCount);
 }
 
 WorkerThreadInfinite::WorkerThreadInfinite(const WorkerThreadInfinite & b):BaseWorkerThread(b)
 {
 	m_terminateEvent=EventEx(false,false);
+	m_workEvent=EventEx(false,false);
+	m_spinCount=b.m_spinCount;
+	m_drainCount=b.m_drainCount;
+}
+
+void WorkerThreadInfinite::Push(BaseJob * const  work)
+{
+	BaseWorkerThread::Push(work);
+	m_workEvent.SetEvent();
+}
+
+void WorkerThreadInfinite::PushBatch(BaseJob * const *works,size_t count)
+{
+	BaseWorkerThread::PushBatch(works,count);
+	m_workEvent.SetEvent();
+}
+
+void WorkerThreadInfinite::SetDrainCount(unsigned int drainCount)
+{
+	if(drainCount<1)
+		drainCount=1;
+	if(drainCount>WORKER_THREAD_MAX_DRAIN_COUNT)
+		drainCount=WORKER_THREAD_MAX_DRAIN_COUNT;
+	m_drainCount=drainCount;
 }
 
 Thread::TerminateResult WorkerThreadInfinite::TerminateWorker(unsigned int waitTimeInMilliSec)
 {
 	m_terminateEvent.SetEvent();
+	m_workEvent.SetEvent();
 	Resume();
 	return TerminateAfter(waitTimeInMilliSec);
 
@@ -52,6 +81,7 @@ Thread::TerminateResult WorkerThreadInfinite::TerminateWorker(unsigned int waitT
 
 void WorkerThreadInfinite::execute()
 {
+	BaseJob *jobs[WORKER_THREAD_MAX_DRAIN_COUNT];
 	while(true)
 	{
 		if(m_terminateEvent.WaitForEvent(0))
@@ -67,18 +97,43 @@ void WorkerThreadInfinite::execute()
 				continue;
 			}
 			callCallBack();
-			Sleep(0);
+			waitForWork();
 			continue;
 		}
 		EP_ASSERT_EXPR(m_jobProcessor,_T("Job Processor is NULL!"));
 		if(!m_jobProcessor)
 			break;
-		BaseJob * jobPtr=m_workPool.Front();
-		jobPtr->RetainObj();
-		m_workPool.Pop();
-		jobPtr->JobReport(BaseJob::JOB_STATUS_IN_PROCESS);
-		m_jobProcessor->DoJob(this, jobPtr);
-		jobPtr->JobReport(BaseJob::JOB_STATUS_DONE);
-		jobPtr->ReleaseObj();
+		size_t jobCount=m_workPool.PopBatch(jobs,m_drainCount);
+		for(size_t trav=0;trav<jobCount;trav++)
+		{
+			if(trav>0 && m_terminateEvent.WaitForEvent(0))
+			{
+				for(;trav<jobCount;trav++)
+				{
+					jobs[trav]->JobReport(BaseJob::JOB_STATUS_INCOMPLETE);
+					jobs[trav]->ReleaseObj();
+				}
+				return;
+			}
+			BaseJob * jobPtr=jobs[trav];
+			jobPtr->JobReport(BaseJob::JOB_STATUS_IN_PROCESS);
+			m_jobProcessor->DoJob(this, jobPtr);
+			jobPtr->JobReport(BaseJob::JOB_STATUS_DONE);
+			jobPtr->ReleaseObj();
+		}
+	}
+}
+
+void WorkerThreadInfinite::waitForWork()
+{
+	unsigned int spinCount=m_spinCount;
+	for(unsigned int trav=0;trav<spinCount;trav++)
+	{
+		if(!m_workPool.IsEmpty())
+			return;
+		YieldProcessor();
 	}
+	// the event is auto-reset and raised after every push, so a push made after the emptiness check is not missed.
+	if(m_workPool.IsEmpty())
+		m_workEvent.WaitForEvent(WAITTIME_INIFINITE);
 }
\ No newline at end of file
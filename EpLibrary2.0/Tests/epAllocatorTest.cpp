@@ -0,0 +1,169 @@
+#include "epl.h"
+#include <gtest/gtest.h>
+#include <set>
+#include <vector>
+
+using namespace epl;
+
+TEST(ArenaTest, AllocatesAlignedAndRewinds)
+{
+	Arena arena(1024,LOCK_POLICY_NONE);
+	void *first=arena.Allocate(10);
+	ASSERT_TRUE(first!=NULL);
+	Arena::Marker marker=arena.GetMarker();
+	size_t usedSize=arena.GetUsedSize();
+	for(int trav=0;trav<100;trav++)
+	{
+		void *ptr=arena.Allocate(24,64);
+		ASSERT_TRUE(ptr!=NULL);
+		EXPECT_EQ(0u,((size_t)ptr)%64);
+	}
+	EXPECT_GT(arena.GetUsedSize(),usedSize);
+	EXPECT_GE(arena.GetReservedSize(),arena.GetUsedSize());
+	arena.Rewind(marker);
+	EXPECT_EQ(usedSize,arena.GetUsedSize());
+	arena.Reset();
+	EXPECT_EQ(0u,arena.GetUsedSize());
+}
+
+TEST(ArenaTest, BacksStlContainers)
+{
+	Arena arena(4096,LOCK_POLICY_NONE);
+	{
+		std::vector<int,ArenaAllocator<int> > vec((ArenaAllocator<int>(arena)));
+		for(int trav=0;trav<1000;trav++)
+			vec.push_back(trav);
+		EXPECT_EQ(999,vec.back());
+	}
+	EXPECT_GT(arena.GetUsedSize(),1000*sizeof(int));
+}
+
+TEST(ArenaTest, ScopeRoutesThreadAllocator)
+{
+	Arena arena(4096,LOCK_POLICY_NONE);
+	{
+		ArenaScope scope(arena);
+		EXPECT_EQ(&arena,MemoryHook::GetThreadAllocator());
+	}
+	EXPECT_TRUE(MemoryHook::GetThreadAllocator()!=&arena);
+	EXPECT_EQ(0u,arena.GetUsedSize());
+}
+
+static MemoryTracker::SiteReport findSiteReport(const char *fileName,unsigned int lineNum)
+{
+	std::vector<MemoryTracker::SiteReport> reports(MEMORY_TRACKER_MAX_SITE_COUNT+1);
+	size_t siteCount=MemoryTracker::GetSiteReports(&reports.at(0),reports.size());
+	for(size_t trav=0;trav<siteCount && trav<reports.size();trav++)
+	{
+		if(reports[trav].m_lineNum==lineNum && strcmp(reports[trav].m_fileName,fileName)==0)
+			return reports[trav];
+	}
+	MemoryTracker::SiteReport emptyReport;
+	memset(&emptyReport,0,sizeof(emptyReport));
+	return emptyReport;
+}
+
+TEST(MemoryTrackerTest, CountsPerCallSite)
+{
+	const char *fileName="epMemoryTrackerTestSite.cpp";
+	unsigned int sampleRate=MemoryTracker::GetSampleRate();
+	MemoryTracker::SetSampleRate(1);
+	MemoryTracker::SiteReport firstBefore=findSiteReport(fileName,10);
+	MemoryTracker::SiteReport secondBefore=findSiteReport(fileName,20);
+
+	void *ptrs[10];
+	for(int trav=0;trav<10;trav++)
+		ptrs[trav]=MemoryTracker::Malloc(32,fileName,10);
+	for(int trav=0;trav<4;trav++)
+		MemoryTracker::Free(ptrs[trav]);
+	void *other=MemoryTracker::Malloc(100,fileName,20);
+	other=MemoryTracker::Realloc(other,200,fileName,20);
+	// the same file name at another address, as __FILE__ in another translation unit
+	char copiedFileName[]="epMemoryTrackerTestSite.cpp";
+	void *copied=MemoryTracker::Malloc(8,copiedFileName,10);
+
+	MemoryTracker::SiteReport first=findSiteReport(fileName,10);
+	EXPECT_EQ(11,first.m_allocCount-firstBefore.m_allocCount);
+	EXPECT_EQ(4,first.m_freeCount-firstBefore.m_freeCount);
+	EXPECT_EQ(10*32+8,first.m_allocBytes-firstBefore.m_allocBytes);
+	EXPECT_EQ(7,first.m_liveCount-firstBefore.m_liveCount);
+	EXPECT_EQ(6*32+8,first.m_liveBytes-firstBefore.m_liveBytes);
+	EXPECT_GE(first.m_peakLiveBytes,10*32);
+	// the reallocation is a deallocation followed by an allocation
+	MemoryTracker::SiteReport second=findSiteReport(fileName,20);
+	EXPECT_EQ(2,second.m_allocCount-secondBefore.m_allocCount);
+	EXPECT_EQ(1,second.m_liveCount-secondBefore.m_liveCount);
+	EXPECT_EQ(200,second.m_liveBytes-secondBefore.m_liveBytes);
+
+	for(int trav=4;trav<10;trav++)
+		MemoryTracker::Free(ptrs[trav]);
+	MemoryTracker::Free(other);
+	MemoryTracker::Free(copied);
+	EXPECT_EQ(firstBefore.m_liveBytes,findSiteReport(fileName,10).m_liveBytes);
+	MemoryTracker::SetSampleRate(sampleRate);
+}
+
+class TinyTestObject:public TinyObject<>
+{
+public:
+	TinyTestObject(int value):m_value(value){}
+	int m_value;
+	char m_padding[20];
+};
+
+TEST(TinyObjectTest, ReusesFreedBlocks)
+{
+	std::vector<TinyTestObject*> objects;
+	std::set<TinyTestObject*> addresses;
+	for(int trav=0;trav<5000;trav++)
+	{
+		objects.push_back(EP_NEW TinyTestObject(trav));
+		addresses.insert(objects.back());
+	}
+	EXPECT_EQ(objects.size(),addresses.size());
+	for(size_t trav=0;trav<objects.size();trav++)
+	{
+		EXPECT_EQ((int)trav,objects[trav]->m_value);
+		EP_DELETE objects[trav];
+	}
+	// the freed blocks come back from the thread cache or the pool
+	TinyTestObject *object=EP_NEW TinyTestObject(1);
+	EXPECT_TRUE(addresses.find(object)!=addresses.end());
+	EP_DELETE object;
+	TinyTestObject::FlushThreadCache();
+}
+
+class TinyObjectThread:public Thread
+{
+public:
+	TinyObjectThread():Thread(){}
+protected:
+	virtual void execute()
+	{
+		// exits with the blocks still in its thread cache
+		std::vector<TinyTestObject*> objects;
+		for(int trav=0;trav<100;trav++)
+			objects.push_back(EP_NEW TinyTestObject(trav));
+		for(size_t trav=0;trav<objects.size();trav++)
+			EP_DELETE objects[trav];
+	}
+};
+
+TEST(TinyObjectTest, ReleasesCacheOfExitedThread)
+{
+	EP_DELETE EP_NEW TinyTestObject(0);
+	TinyTestObject::FlushThreadCache();
+	size_t cacheCount=TinyTestObject::GetThreadCacheCount();
+	for(int trav=0;trav<16;trav++)
+	{
+		TinyObjectThread thread;
+		thread.Start();
+		thread.WaitFor(WAITTIME_INIFINITE);
+	}
+	EXPECT_EQ(cacheCount,TinyTestObject::GetThreadCacheCount());
+	// the blocks cached by the exited threads are back in the pool
+	std::vector<StaticAllocator::Report> reports;
+	TinyTestObject::GetReport(reports);
+	for(size_t trav=0;trav<reports.size();trav++)
+		EXPECT_EQ(reports[trav].blockCount,reports[trav].freeBlockCount);
+}
@@ -0,0 +1,399 @@
+#include "epl.h"
+#include "epKAryHeap.h"
+#include "epPatriciaTrie.h"
+#include "epPatriciaTrieImage.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+using namespace epl;
+
+TEST(ThreadSafeQueueTest, KeepsFifoOrderWhileGrowing)
+{
+	ThreadSafeQueue<int> queue;
+	for(int trav=0;trav<1000;trav++)
+		queue.Push(trav);
+	EXPECT_EQ(1000u,queue.Size());
+	for(int trav=0;trav<500;trav++)
+	{
+		EXPECT_EQ(trav,queue.Front());
+		queue.Pop();
+	}
+	// wrap around the ring
+	for(int trav=1000;trav<1600;trav++)
+		queue.Push(trav);
+	for(int trav=500;trav<1600;trav++)
+	{
+		EXPECT_EQ(trav,queue.Front());
+		queue.Pop();
+	}
+	EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(ThreadSafeQueueTest, EraseKeepsRemainingOrder)
+{
+	ThreadSafeQueue<int,NullLock> queue;
+	for(int trav=0;trav<10;trav++)
+		queue.Push(trav);
+	EXPECT_TRUE(queue.Erase(4));
+	EXPECT_FALSE(queue.Erase(42));
+	EXPECT_FALSE(queue.IsExist(4));
+	std::vector<int> items=queue.GetQueue();
+	int expected[]={0,1,2,3,5,6,7,8,9};
+	ASSERT_EQ(9u,items.size());
+	EXPECT_TRUE(std::equal(items.begin(),items.end(),expected));
+}
+
+TEST(LockFreeQueueTest, RespectsCapacity)
+{
+	LockFreeQueue<int> queue(4);
+	for(int trav=0;trav<4;trav++)
+		EXPECT_TRUE(queue.TryPush(trav));
+	EXPECT_FALSE(queue.TryPush(4));
+	int value=-1;
+	for(int trav=0;trav<4;trav++)
+	{
+		EXPECT_TRUE(queue.TryPop(value));
+		EXPECT_EQ(trav,value);
+	}
+	EXPECT_FALSE(queue.TryPop(value));
+	EXPECT_TRUE(queue.IsEmpty());
+}
+
+class LockFreeQueueConsumer:public Thread
+{
+public:
+	LockFreeQueueConsumer(LockFreeQueue<int> &queue,int count):Thread(),m_sum(0),m_queue(queue),m_count(count){}
+	long long m_sum;
+protected:
+	virtual void execute()
+	{
+		int value=0;
+		for(int trav=0;trav<m_count;trav++)
+		{
+			m_queue.Pop(value);
+			m_sum+=value;
+		}
+	}
+private:
+	LockFreeQueue<int> &m_queue;
+	int m_count;
+};
+
+TEST(LockFreeQueueTest, DeliversEveryElementAcrossThreads)
+{
+	const int count=100000;
+	LockFreeQueue<int> queue(256);
+	LockFreeQueueConsumer consumer(queue,count);
+	consumer.Start();
+	long long expected=0;
+	for(int trav=0;trav<count;trav++)
+	{
+		queue.Push(trav);
+		expected+=trav;
+	}
+	consumer.WaitFor(WAITTIME_INIFINITE);
+	EXPECT_EQ(expected,consumer.m_sum);
+}
+
+TEST(DynamicArrayTest, AppendAndReserve)
+{
+	DynamicArray<int> arr;
+	arr.Reserve(100);
+	EXPECT_GE(arr.Capacity(),100u);
+	for(int trav=0;trav<1000;trav++)
+		arr.Append(trav);
+	EXPECT_EQ(1000u,arr.Size());
+	EXPECT_GE(arr.Capacity(),arr.Size());
+	for(int trav=0;trav<1000;trav++)
+		EXPECT_EQ(trav,arr[trav]);
+	EXPECT_EQ(999,arr.GetData()[999]);
+	// Resize only grows the storage
+	EXPECT_FALSE(arr.Resize(10));
+	EXPECT_TRUE(arr.Resize(5000));
+	EXPECT_GE(arr.Capacity(),5000u);
+	EXPECT_EQ(1000u,arr.Size());
+	EXPECT_FALSE(arr.IsEmpty());
+	arr.Clear();
+	EXPECT_TRUE(arr.IsEmpty());
+}
+
+TEST(DynamicArrayTest, KeepsElementsWhenGrowthFails)
+{
+	DynamicArray<int> arr;
+	for(int trav=0;trav<10;trav++)
+		EXPECT_TRUE(arr.Append(trav));
+	size_t capacity=arr.Capacity();
+	// no allocator can give three quarters of the address space
+	EXPECT_FALSE(arr.Reserve(((size_t)-1)/sizeof(int)/4*3));
+	EXPECT_EQ(capacity,arr.Capacity());
+	ASSERT_EQ(10u,arr.Size());
+	for(int trav=0;trav<10;trav++)
+		EXPECT_EQ(trav,arr[trav]);
+	EXPECT_TRUE(arr.Reserve(capacity));
+}
+
+TEST(DynamicArrayTest, AppendsArrays)
+{
+	DynamicArray<int> arr;
+	DynamicArray<int> other;
+	for(int trav=0;trav<3;trav++)
+	{
+		arr.Append(trav);
+		other.Append(trav+3);
+	}
+	EXPECT_TRUE(arr.Append(other));
+	EXPECT_TRUE(arr.Append(arr));
+	ASSERT_EQ(12u,arr.Size());
+	for(int trav=0;trav<12;trav++)
+		EXPECT_EQ(trav%6,arr[trav]);
+	EXPECT_EQ(3u,other.Size());
+}
+
+TEST(KAryHeapTest, PopsInKeyOrder)
+{
+	KaryHeapMode modes[]={KARY_HEAP_MODE_RECURSIVE,KARY_HEAP_MODE_LOOP,KARY_HEAP_MODE_INDEXED};
+	for(int modeTrav=0;modeTrav<3;modeTrav++)
+	{
+		KAryHeap<int,int> heap(modes[modeTrav]);
+		std::vector<int> keys;
+		for(int trav=0;trav<2000;trav++)
+		{
+			int key=trav*7919%10007;
+			keys.push_back(key);
+			heap.Push(key,key*2);
+		}
+		std::sort(keys.begin(),keys.end());
+		int key,data;
+		for(size_t trav=0;trav<keys.size();trav++)
+		{
+			ASSERT_TRUE(heap.Pop(key,data));
+			EXPECT_EQ(keys[trav],key);
+			EXPECT_EQ(key*2,data);
+		}
+		EXPECT_TRUE(heap.IsEmpty());
+	}
+}
+
+TEST(KAryHeapTest, IndexedModeChangesKeys)
+{
+	KAryHeap<int,int> heap(KARY_HEAP_MODE_INDEXED);
+	for(int trav=0;trav<100;trav++)
+		heap.Push(trav,trav);
+	EXPECT_TRUE(heap.ChangeKey(50,-1));
+	EXPECT_TRUE(heap.Erase(0));
+	EXPECT_FALSE(heap.Erase(0));
+	int data=0;
+	EXPECT_TRUE(heap.GetData(-1,data));
+	EXPECT_EQ(50,data);
+	int key=0;
+	ASSERT_TRUE(heap.Pop(key,data));
+	EXPECT_EQ(-1,key);
+	ASSERT_TRUE(heap.Pop(key,data));
+	EXPECT_EQ(1,key);
+	EXPECT_EQ(97u,heap.Size());
+}
+
+typedef PatriciaTrie<char,int> TestTrie;
+typedef PatriciaTrieImage<char,int> TestTrieImage;
+
+static void fillTrie(TestTrie &trie)
+{
+	const char *words[]={"romane","romanus","romulus","rubens","ruber","rubicon","rubicundus"};
+	for(int trav=0;trav<7;trav++)
+		EXPECT_TRUE(trie.Insert(words[trav],trav));
+}
+
+TEST(PatriciaTrieTest, InsertFindErase)
+{
+	TestTrie trie;
+	fillTrie(trie);
+	EXPECT_EQ(7u,trie.Size());
+	EXPECT_FALSE(trie.Insert("ruber",100));
+	int data=-1;
+	EXPECT_TRUE(trie.Find("rubicon",data));
+	EXPECT_EQ(5,data);
+	EXPECT_FALSE(trie.Find("rub",data));
+	EXPECT_TRUE(trie.Erase("rubicon"));
+	EXPECT_FALSE(trie.Find("rubicon",data));
+	EXPECT_EQ(6u,trie.Size());
+}
+
+TEST(PatriciaTrieTest, GrowsAndShrinksNodeStorage)
+{
+	// one root child per character moves the root through every capacity and back
+	TestTrie trie;
+	char key[2]={0,0};
+	for(int c=1;c<256;c++)
+	{
+		key[0]=(char)c;
+		ASSERT_TRUE(trie.Insert(key,c));
+	}
+	TestTrie copied(trie);
+	int data=-1;
+	for(int c=1;c<256;c++)
+	{
+		key[0]=(char)c;
+		ASSERT_TRUE(copied.Find(key,data));
+		EXPECT_EQ(c,data);
+	}
+	for(int c=1;c<256;c++)
+	{
+		if(c%64==0)
+			continue;
+		key[0]=(char)c;
+		ASSERT_TRUE(trie.Erase(key));
+	}
+	EXPECT_EQ(3u,trie.Size());
+	for(int c=64;c<256;c+=64)
+	{
+		key[0]=(char)c;
+		ASSERT_TRUE(trie.Find(key,data));
+		EXPECT_EQ(c,data);
+	}
+	key[0]=1;
+	EXPECT_FALSE(trie.Find(key,data));
+}
+
+// writers insert and erase their own keys while readers check the keys that are never erased
+class PatriciaTrieWorker:public Thread
+{
+public:
+	PatriciaTrieWorker(TestTrie &trie,int id,bool isWriter,int keyCount,int rounds):Thread(),m_failed(false),m_trie(trie),m_id(id),m_isWriter(isWriter),m_keyCount(keyCount),m_rounds(rounds){}
+	bool m_failed;
+protected:
+	virtual void execute()
+	{
+		char key[32];
+		int data;
+		for(int round=0;round<m_rounds;round++)
+		{
+			for(int trav=0;trav<m_keyCount;trav++)
+			{
+				if(m_isWriter)
+				{
+					sprintf(key,"w%d_%d",m_id,trav);
+					if(!m_trie.Insert(key,trav))
+						m_failed=true;
+				}
+				else
+				{
+					sprintf(key,"s%d",trav);
+					if(!m_trie.Find(key,data) || data!=trav)
+						m_failed=true;
+					// the key of a writer may or may not be there, but never holds other data
+					sprintf(key,"w0_%d",trav);
+					if(m_trie.Find(key,data) && data!=trav)
+						m_failed=true;
+				}
+			}
+			if(!m_isWriter)
+				continue;
+			for(int trav=0;trav<m_keyCount;trav++)
+			{
+				sprintf(key,"w%d_%d",m_id,trav);
+				if(!m_trie.Erase(key))
+					m_failed=true;
+			}
+		}
+	}
+private:
+	TestTrie &m_trie;
+	int m_id;
+	bool m_isWriter;
+	int m_keyCount;
+	int m_rounds;
+};
+
+TEST(PatriciaTrieTest, ConcurrentFindInsertErase)
+{
+	const int keyCount=200;
+	const int writerCount=2;
+	const int readerCount=4;
+	TestTrie trie(PATRICIA_TRIE_MODE_LOOP,LOCK_POLICY_READWRITE);
+	char key[32];
+	for(int trav=0;trav<keyCount;trav++)
+	{
+		sprintf(key,"s%d",trav);
+		ASSERT_TRUE(trie.Insert(key,trav));
+	}
+	std::vector<PatriciaTrieWorker*> workers;
+	for(int trav=0;trav<writerCount+readerCount;trav++)
+		workers.push_back(EP_NEW PatriciaTrieWorker(trie,trav,trav<writerCount,keyCount,20));
+	for(size_t trav=0;trav<workers.size();trav++)
+		workers[trav]->Start();
+	for(size_t trav=0;trav<workers.size();trav++)
+	{
+		workers[trav]->WaitFor(WAITTIME_INIFINITE);
+		EXPECT_FALSE(workers[trav]->m_failed);
+		EP_DELETE workers[trav];
+	}
+	EXPECT_EQ((size_t)keyCount,trie.Size());
+	int data=-1;
+	EXPECT_FALSE(trie.Find("w0_0",data));
+}
+
+TEST(PatriciaTrieTest, CursorsVisitInOrder)
+{
+	TestTrie trie;
+	fillTrie(trie);
+	TestTrie::Cursor cursor;
+	ASSERT_TRUE(trie.OpenPrefix(cursor,"rub"));
+	std::vector<std::string> found;
+	while(cursor.Next())
+		found.push_back(cursor.GetString());
+	ASSERT_EQ(4u,found.size());
+	EXPECT_EQ("rubens",found[0]);
+	EXPECT_EQ("rubicundus",found[3]);
+
+	ASSERT_TRUE(trie.OpenRange(cursor,"romulus","ruber"));
+	found.clear();
+	while(cursor.Next())
+		found.push_back(cursor.GetString());
+	ASSERT_EQ(2u,found.size());
+	EXPECT_EQ("romulus",found[0]);
+	EXPECT_EQ("rubens",found[1]);
+}
+
+TEST(PatriciaTrieTest, ImageAnswersLikeTrie)
+{
+	TestTrie trie;
+	fillTrie(trie);
+	Stream stream;
+	ASSERT_TRUE(trie.WriteImage(stream));
+	// copy to the aligned buffer
+	std::vector<unsigned long long> buffer((stream.GetStreamSize()+sizeof(unsigned long long)-1)/sizeof(unsigned long long));
+	memcpy(&buffer.at(0),stream.GetBuffer(),stream.GetStreamSize());
+
+	TestTrieImage image;
+	ASSERT_TRUE(image.Attach(&buffer.at(0),stream.GetStreamSize()));
+	EXPECT_EQ(trie.Size(),image.Size());
+	int data=-1;
+	EXPECT_TRUE(image.Find("romulus",data));
+	EXPECT_EQ(2,data);
+	EXPECT_FALSE(image.Find("roman",data));
+	std::vector<Pair<const char*,int> > pairs;
+	EXPECT_TRUE(image.FindAll("rom",pairs));
+	EXPECT_EQ(3u,pairs.size());
+}
+
+TEST(PatriciaTrieTest, ImageIsMappedFromFile)
+{
+	TestTrie trie;
+	fillTrie(trie);
+	{
+		FileStream stream(_T("eplibrary_trie_image_test.bin"));
+		ASSERT_TRUE(trie.WriteImage(stream));
+		ASSERT_TRUE(stream.WriteStreamToFile());
+	}
+	{
+		TestTrieImage image;
+		ASSERT_TRUE(image.LoadFromFile(_T("eplibrary_trie_image_test.bin")));
+		int data=-1;
+		EXPECT_TRUE(image.Find("rubicundus",data));
+		EXPECT_EQ(6,data);
+		image.Close();
+		EXPECT_FALSE(image.IsOpen());
+	}
+	remove("eplibrary_trie_image_test.bin");
+}
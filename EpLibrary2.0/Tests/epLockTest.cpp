@@ -0,0 +1,213 @@
+#include "epl.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace epl;
+
+class LockCounterThread:public Thread
+{
+public:
+	LockCounterThread(BaseLock *lock,volatile long *counter,int count,bool isShared):Thread(),m_readFailed(false),m_lock(lock),m_counter(counter),m_count(count),m_isShared(isShared){}
+	bool m_readFailed;
+protected:
+	virtual void execute()
+	{
+		for(int trav=0;trav<m_count;trav++)
+		{
+			if(m_isShared)
+			{
+				SharedLockObj lock(m_lock);
+				// the writers keep the counter even outside the lock
+				if((*m_counter)&1)
+					m_readFailed=true;
+			}
+			else
+			{
+				LockObj lock(m_lock);
+				// not atomic on purpose, the lock has to serialize it
+				long value=*m_counter;
+				*m_counter=value+1;
+				*m_counter=value+2;
+			}
+		}
+	}
+private:
+	BaseLock *m_lock;
+	volatile long *m_counter;
+	int m_count;
+	bool m_isShared;
+};
+
+static void runCounterThreads(BaseLock *lock,unsigned int writerCount,unsigned int readerCount)
+{
+	const int count=20000;
+	volatile long counter=0;
+	std::vector<LockCounterThread*> threads;
+	for(unsigned int trav=0;trav<writerCount+readerCount;trav++)
+		threads.push_back(EP_NEW LockCounterThread(lock,&counter,count,trav>=writerCount));
+	for(size_t trav=0;trav<threads.size();trav++)
+		threads[trav]->Start();
+	for(size_t trav=0;trav<threads.size();trav++)
+		threads[trav]->WaitFor(WAITTIME_INIFINITE);
+	EXPECT_EQ((long)writerCount*count*2,counter);
+	for(size_t trav=0;trav<threads.size();trav++)
+	{
+		EXPECT_FALSE(threads[trav]->m_readFailed);
+		EP_DELETE threads[trav];
+	}
+}
+
+TEST(LockTest, CriticalSectionExSerializes)
+{
+	CriticalSectionEx lock;
+	runCounterThreads(&lock,4,0);
+}
+
+TEST(LockTest, MutexSerializes)
+{
+	Mutex lock;
+	runCounterThreads(&lock,4,0);
+}
+
+TEST(LockTest, SpinLockSerializes)
+{
+	SpinLock lock;
+	runCounterThreads(&lock,4,0);
+}
+
+TEST(LockTest, TicketLockSerializes)
+{
+	TicketLock lock;
+	runCounterThreads(&lock,4,0);
+}
+
+TEST(LockTest, TicketLockParksWaiters)
+{
+	// no spin, so every waiter parks, and more waiters than the park slots have to share them
+	TicketLock lock(0);
+	runCounterThreads(&lock,TICKET_LOCK_PARK_SLOT_COUNT+4,0);
+}
+
+TEST(LockTest, ReadWriteLockExcludesReaders)
+{
+	ReadWriteLock lock;
+	runCounterThreads(&lock,2,4);
+}
+
+TEST(LockTest, DistributedReadWriteLockExcludesReaders)
+{
+	DistributedReadWriteLock lock;
+	runCounterThreads(&lock,2,4);
+}
+
+TEST(LockTest, RecursiveLocks)
+{
+	CriticalSectionEx criticalSection;
+	Mutex mutex;
+	BaseLock *locks[]={&criticalSection,&mutex};
+	for(int trav=0;trav<2;trav++)
+	{
+		EXPECT_TRUE(locks[trav]->Lock());
+		EXPECT_TRUE(locks[trav]->TryLock()!=0);
+		locks[trav]->Unlock();
+		locks[trav]->Unlock();
+	}
+}
+
+TEST(LockTest, SpinLocksAreNotRecursive)
+{
+	SpinLock spinLock;
+	TicketLock ticketLock;
+	BaseLock *locks[]={&spinLock,&ticketLock};
+	for(int trav=0;trav<2;trav++)
+	{
+		EXPECT_TRUE(locks[trav]->Lock());
+		EXPECT_TRUE(locks[trav]->TryLock()==0);
+		EXPECT_TRUE(locks[trav]->TryLockFor(5)==0);
+		locks[trav]->Unlock();
+		EXPECT_TRUE(locks[trav]->TryLock()!=0);
+		locks[trav]->Unlock();
+	}
+}
+
+TEST(LockTest, EventAndSemaphoreWaitsTimeOut)
+{
+	EventEx event(false,false);
+	unsigned int startTick=GetTickCount();
+	EXPECT_FALSE(event.WaitForEvent(50));
+	EXPECT_GE(GetTickCount()-startTick,40u);
+	event.SetEvent();
+	EXPECT_TRUE(event.WaitForEvent(0));
+	// auto reset
+	EXPECT_FALSE(event.WaitForEvent(0));
+
+	Semaphore semaphore(2,2);
+	EXPECT_TRUE(semaphore.TryLock()!=0);
+	EXPECT_TRUE(semaphore.TryLock()!=0);
+	EXPECT_TRUE(semaphore.TryLockFor(10)==0);
+	semaphore.Unlock();
+	semaphore.Unlock();
+}
+
+// holds the lock until released, so the recursive locks are contended as well
+class LockHolderThread:public Thread
+{
+public:
+	LockHolderThread(BaseLock *lock):Thread(),m_lock(lock),m_lockedEvent(false,true),m_releaseEvent(false,true){}
+	void WaitForLocked()
+	{
+		m_lockedEvent.WaitForEvent();
+	}
+	void Release()
+	{
+		m_releaseEvent.SetEvent();
+	}
+protected:
+	virtual void execute()
+	{
+		m_lock->Lock();
+		m_lockedEvent.SetEvent();
+		m_releaseEvent.WaitForEvent();
+		m_lock->Unlock();
+	}
+private:
+	BaseLock *m_lock;
+	EventEx m_lockedEvent;
+	EventEx m_releaseEvent;
+};
+
+TEST(LockTest, TryLockForTimesOutWhileHeld)
+{
+	CriticalSectionEx criticalSection;
+	Mutex mutex;
+	SpinLock spinLock;
+	TicketLock ticketLock;
+	ReadWriteLock readWriteLock;
+	DistributedReadWriteLock distributedReadWriteLock;
+	BaseLock *locks[]={&criticalSection,&mutex,&spinLock,&ticketLock,&readWriteLock,&distributedReadWriteLock};
+	for(int trav=0;trav<6;trav++)
+	{
+		LockHolderThread holder(locks[trav]);
+		holder.Start();
+		holder.WaitForLocked();
+		unsigned int startTick=GetTickCount();
+		EXPECT_TRUE(locks[trav]->TryLockFor(50)==0);
+		EXPECT_GE(GetTickCount()-startTick,40u);
+		holder.Release();
+		EXPECT_TRUE(locks[trav]->TryLockFor(5000)!=0);
+		locks[trav]->Unlock();
+		holder.WaitFor(WAITTIME_INIFINITE);
+	}
+}
+
+TEST(InterlockedExTest, AtomicOperations)
+{
+	volatile long value=5;
+	EXPECT_EQ(6,InterlockedIncrement(&value));
+	EXPECT_EQ(5,InterlockedDecrement(&value));
+	EXPECT_EQ(5,InterlockedExchange(&value,10));
+	EXPECT_EQ(10,InterlockedCompareExchange(&value,20,10));
+	EXPECT_EQ(20,value);
+	EXPECT_EQ(20,InterlockedExchangeAdd(&value,3));
+	EXPECT_EQ(23,value);
+}
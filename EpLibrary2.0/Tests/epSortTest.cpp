@@ -0,0 +1,69 @@
+#include "epl.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+using namespace epl;
+
+static std::vector<int> makeList(size_t listSize)
+{
+	std::vector<int> list(listSize);
+	// fixed sequence with duplicates
+	unsigned int seed=42;
+	for(size_t trav=0;trav<listSize;trav++)
+	{
+		seed=seed*1103515245+12345;
+		list[trav]=(int)((seed>>16)%2001)-1000;
+	}
+	return list;
+}
+
+TEST(SortTest, QuickSortModes)
+{
+	QSortMode modes[]={QSORT_MODE_STL,QSORT_MODE_RECURSIVE,QSORT_MODE_LOOP};
+	for(int modeTrav=0;modeTrav<3;modeTrav++)
+	{
+		std::vector<int> list=makeList(5000);
+		std::vector<int> expected=list;
+		std::sort(expected.begin(),expected.end());
+		QuickSort<int>(&list.at(0),list.size(),CompClass<int>::CompFunc,modes[modeTrav]);
+		EXPECT_EQ(expected,list);
+	}
+}
+
+TEST(SortTest, MergeSortModes)
+{
+	MSortMode modes[]={MSORT_MODE_RECURSIVE,MSORT_MODE_LOOP};
+	for(int modeTrav=0;modeTrav<2;modeTrav++)
+	{
+		std::vector<int> list=makeList(5000);
+		std::vector<int> expected=list;
+		std::sort(expected.begin(),expected.end());
+		MergeSort<int>(&list.at(0),list.size(),CompClass<int>::CompFunc,modes[modeTrav]);
+		EXPECT_EQ(expected,list);
+	}
+}
+
+TEST(SortTest, InsertionSortRange)
+{
+	std::vector<int> list=makeList(300);
+	std::vector<int> expected=list;
+	std::sort(expected.begin()+10,expected.begin()+200);
+	InsertionSort<int>(&list.at(0),10,199,CompClass<int>::CompFunc);
+	EXPECT_EQ(expected,list);
+}
+
+TEST(SortTest, BinarySearchFindsSortedItems)
+{
+	std::vector<int> list;
+	for(int trav=0;trav<100;trav++)
+		list.push_back(trav*3);
+	size_t idx=0;
+	int key=42;
+	int *found=BinarySearch<int,int>(key,&list.at(0),list.size(),CompClass<int>::CompFunc,idx);
+	ASSERT_TRUE(found!=NULL);
+	EXPECT_EQ(14u,idx);
+	key=43;
+	found=BinarySearch<int,int>(key,&list.at(0),list.size(),CompClass<int>::CompFunc,idx);
+	EXPECT_TRUE(found==NULL);
+}
@@ -0,0 +1,86 @@
+#include "epl.h"
+#include <gtest/gtest.h>
+#include <stdio.h>
+
+using namespace epl;
+
+static void writeSample(Stream &stream)
+{
+	int ints[]={1,-2,3,-4};
+	double doubles[]={0.25,-8.5};
+	EXPECT_TRUE(stream.WriteInt(42));
+	EXPECT_TRUE(stream.WriteDouble(3.5));
+	EXPECT_TRUE(stream.WriteString("hello"));
+	EXPECT_TRUE(stream.WriteInts(ints,4));
+	EXPECT_TRUE(stream.WriteDoubles(doubles,2));
+	EXPECT_TRUE(stream.WriteByte(0xAB));
+}
+
+static void readSample(Stream &stream)
+{
+	int intValue=0;
+	double doubleValue=0.0;
+	EpString stringValue;
+	int ints[4]={0,};
+	double doubles[2]={0.0,};
+	unsigned char byteValue=0;
+	EXPECT_TRUE(stream.ReadInt(intValue));
+	EXPECT_EQ(42,intValue);
+	EXPECT_TRUE(stream.ReadDouble(doubleValue));
+	EXPECT_EQ(3.5,doubleValue);
+	EXPECT_TRUE(stream.ReadString(stringValue));
+	EXPECT_EQ("hello",stringValue);
+	EXPECT_TRUE(stream.ReadInts(ints,4));
+	EXPECT_EQ(-4,ints[3]);
+	EXPECT_TRUE(stream.ReadDoubles(doubles,2));
+	EXPECT_EQ(-8.5,doubles[1]);
+	EXPECT_TRUE(stream.ReadByte(byteValue));
+	EXPECT_EQ(0xAB,byteValue);
+	// nothing left
+	EXPECT_FALSE(stream.ReadByte(byteValue));
+}
+
+TEST(StreamTest, ReadsBackWhatIsWritten)
+{
+	Stream stream;
+	writeSample(stream);
+	stream.SetSeek(Stream::STREAM_SEEK_TYPE_SEEK_SET);
+	readSample(stream);
+}
+
+TEST(StreamTest, SeekAndOverwrite)
+{
+	Stream stream;
+	EXPECT_TRUE(stream.WriteInt(1));
+	EXPECT_TRUE(stream.WriteInt(2));
+	EXPECT_EQ(sizeof(int)*2,stream.GetStreamSize());
+	stream.SetSeek(Stream::STREAM_SEEK_TYPE_SEEK_SET,sizeof(int));
+	EXPECT_TRUE(stream.WriteInt(3));
+	EXPECT_EQ(sizeof(int)*2,stream.GetStreamSize());
+	stream.SetSeek(Stream::STREAM_SEEK_TYPE_SEEK_SET);
+	int value=0;
+	EXPECT_TRUE(stream.ReadInt(value));
+	EXPECT_EQ(1,value);
+	EXPECT_TRUE(stream.ReadInt(value));
+	EXPECT_EQ(3,value);
+	stream.Clear();
+	EXPECT_EQ(0u,stream.GetStreamSize());
+}
+
+TEST(FileStreamTest, RoundTripsThroughFile)
+{
+	const TCHAR *fileName=_T("eplibrary_file_stream_test.bin");
+	{
+		FileStream stream(fileName);
+		writeSample(stream);
+		EXPECT_TRUE(stream.WriteStreamToFile());
+	}
+	{
+		FileStream stream(fileName);
+		EXPECT_TRUE(stream.LoadStreamFromFile());
+		EXPECT_EQ(stream.GetStreamSize(),stream.GetSeek());
+		stream.SetSeek(Stream::STREAM_SEEK_TYPE_SEEK_SET);
+		readSample(stream);
+	}
+	remove("eplibrary_file_stream_test.bin");
+}
@@ -0,0 +1,410 @@
+#include "epl.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace epl;
+
+class CountingJob:public BaseJob
+{
+public:
+	CountingJob(Priority priority=PRIORITY_NORMAL):BaseJob(priority),m_doneCount(0),m_incompleteCount(0){}
+	volatile long m_doneCount;
+	volatile long m_incompleteCount;
+protected:
+	virtual void handleReport(const JobStatus status)
+	{
+		if(status==JOB_STATUS_DONE)
+			InterlockedIncrement(&m_doneCount);
+		else if(status==JOB_STATUS_INCOMPLETE)
+			InterlockedIncrement(&m_incompleteCount);
+	}
+};
+
+class CountingJobProcessor:public BaseJobProcessor
+{
+public:
+	CountingJobProcessor():BaseJobProcessor(),m_processedCount(0){}
+	volatile long m_processedCount;
+	virtual void DoJob(BaseWorkerThread * /*workerThread*/,BaseJob* const /*data*/)
+	{
+		InterlockedIncrement(&m_processedCount);
+	}
+};
+
+static void waitForCount(volatile long &count,long expected)
+{
+	unsigned int startTick=GetTickCount();
+	while(count<expected && GetTickCount()-startTick<30000)
+		Sleep(1);
+}
+
+TEST(JobScheduleQueueTest, PopsByPriorityThenFifo)
+{
+	JobScheduleQueue queue;
+	std::vector<CountingJob*> jobs;
+	Priority priorities[]={PRIORITY_NORMAL,PRIORITY_NORMAL+2,PRIORITY_NORMAL,PRIORITY_NORMAL+1};
+	for(int trav=0;trav<4;trav++)
+	{
+		jobs.push_back(EP_NEW CountingJob(priorities[trav]));
+		queue.Push(jobs.back());
+	}
+	jobs[2]->SetPriority(PRIORITY_NORMAL+3);
+	CountingJob *expected[]={jobs[2],jobs[1],jobs[3],jobs[0]};
+	for(int trav=0;trav<4;trav++)
+	{
+		EXPECT_EQ(expected[trav],queue.Front());
+		queue.Pop();
+	}
+	EXPECT_TRUE(queue.IsEmpty());
+	for(size_t trav=0;trav<jobs.size();trav++)
+		jobs[trav]->ReleaseObj();
+}
+
+TEST(JobScheduleQueueTest, ErasesAndRepositionsJobs)
+{
+	JobScheduleQueue queue;
+	std::vector<CountingJob*> jobs;
+	for(int trav=0;trav<8;trav++)
+	{
+		jobs.push_back(EP_NEW CountingJob(PRIORITY_NORMAL+trav));
+		queue.Push(jobs.back());
+	}
+	EXPECT_TRUE(queue.Erase(jobs[5]));
+	EXPECT_FALSE(queue.Erase(jobs[5]));
+	EXPECT_EQ(BaseJob::JOB_STATUS_TIMEOUT,jobs[5]->GetStatus());
+	// move one job to the top and one to the bottom of the heap
+	jobs[0]->SetPriority(PRIORITY_NORMAL+10);
+	jobs[7]->SetPriority(PRIORITY_NORMAL-1);
+	EXPECT_EQ(jobs[7],queue.Back());
+	CountingJob *expected[]={jobs[0],jobs[6],jobs[4],jobs[3],jobs[2],jobs[1],jobs[7]};
+	for(int trav=0;trav<7;trav++)
+	{
+		EXPECT_EQ(expected[trav],queue.Front());
+		queue.Pop();
+	}
+	EXPECT_TRUE(queue.IsEmpty());
+	// the popped job is no longer re-positioned within the queue
+	jobs[1]->SetPriority(PRIORITY_NORMAL+20);
+	EXPECT_EQ(PRIORITY_NORMAL+20,jobs[1]->GetPriority());
+
+	queue.Push(jobs[2]);
+	queue.Push(jobs[3]);
+	queue.Clear();
+	EXPECT_TRUE(queue.IsEmpty());
+	jobs[2]->SetPriority(PRIORITY_NORMAL+30);
+	EXPECT_EQ(PRIORITY_NORMAL+30,jobs[2]->GetPriority());
+	for(size_t trav=0;trav<jobs.size();trav++)
+		jobs[trav]->ReleaseObj();
+}
+
+TEST(WorkerThreadTest, ProcessesPushedJobs)
+{
+	CountingJobProcessor *processor=EP_NEW CountingJobProcessor();
+	WorkerThreadInfinite worker(BaseWorkerThread::THREAD_LIFE_INFINITE);
+	worker.SetJobProcessor(processor);
+	worker.Start();
+	CountingJob *job=EP_NEW CountingJob();
+	const long count=1000;
+	for(long trav=0;trav<count;trav++)
+		worker.Push(job);
+	waitForCount(job->m_doneCount,count);
+	EXPECT_EQ(count,job->m_doneCount);
+	EXPECT_EQ(count,processor->m_processedCount);
+	worker.TerminateWorker();
+	job->ReleaseObj();
+	processor->ReleaseObj();
+}
+
+TEST(WorkerThreadTest, SignalsAfterTerminatingWaitingWorker)
+{
+	CountingJobProcessor *processor=EP_NEW CountingJobProcessor();
+	WorkerThreadInfinite worker(BaseWorkerThread::THREAD_LIFE_INFINITE);
+	worker.SetJobProcessor(processor);
+	worker.Start();
+	// let the worker park on its work event
+	Sleep(50);
+	EXPECT_TRUE(worker.Terminate());
+	// the cancelled worker must not keep the lock of the work event
+	CountingJob *job=EP_NEW CountingJob();
+	worker.Push(job);
+	worker.TerminateWorker();
+	job->ReleaseObj();
+	processor->ReleaseObj();
+}
+
+TEST(ThreadPoolTest, ProcessesEveryJob)
+{
+	CountingJobProcessor *processor=EP_NEW CountingJobProcessor();
+	CountingJob *job=EP_NEW CountingJob();
+	const long count=50000;
+	{
+		ThreadPool pool(processor,4);
+		EXPECT_EQ(4u,pool.GetWorkerCount());
+		BaseJob *batch[64];
+		for(int trav=0;trav<64;trav++)
+			batch[trav]=job;
+		for(long trav=0;trav<count/2;trav++)
+			pool.Push(job);
+		for(long trav=0;trav<count/2;trav+=64)
+			pool.PushBatch(batch,(size_t)((count/2-trav)<64?(count/2-trav):64));
+		waitForCount(processor->m_processedCount,count);
+		pool.TerminatePool();
+	}
+	EXPECT_EQ(count,processor->m_processedCount);
+	EXPECT_EQ(count,job->m_doneCount);
+	job->ReleaseObj();
+	processor->ReleaseObj();
+}
+
+class PoolPushingThread:public Thread
+{
+public:
+	PoolPushingThread(ThreadPool *pool,BaseJob *job,long count):Thread(),m_pool(pool),m_job(job),m_count(count){}
+protected:
+	virtual void execute()
+	{
+		for(long trav=0;trav<m_count;trav++)
+			m_pool->Push(m_job);
+	}
+private:
+	ThreadPool *m_pool;
+	BaseJob *m_job;
+	long m_count;
+};
+
+TEST(ThreadPoolTest, ReportsEveryJobPushedWhileTerminating)
+{
+	CountingJobProcessor *processor=EP_NEW CountingJobProcessor();
+	CountingJob *job=EP_NEW CountingJob();
+	const long count=20000;
+	{
+		ThreadPool pool(processor,2);
+		std::vector<PoolPushingThread*> pushers;
+		for(int trav=0;trav<2;trav++)
+		{
+			pushers.push_back(EP_NEW PoolPushingThread(&pool,job,count));
+			pushers.back()->Start();
+		}
+		waitForCount(processor->m_processedCount,count/10);
+		pool.TerminatePool();
+		// every job is either processed or reported incomplete once TerminatePool returns and the pushes are done
+		for(size_t trav=0;trav<pushers.size();trav++)
+		{
+			pushers[trav]->WaitFor(WAITTIME_INIFINITE);
+			EP_DELETE pushers[trav];
+		}
+		EXPECT_EQ(2*count,job->m_doneCount+job->m_incompleteCount);
+	}
+	EXPECT_EQ(processor->m_processedCount,job->m_doneCount);
+	job->ReleaseObj();
+	processor->ReleaseObj();
+}
+
+TEST(CpuTopologyTest, NodesCoverTheProcessors)
+{
+	CpuTopology &topology=CPU_TOPOLOGY_INSTANCE;
+	unsigned int processorCount=topology.GetProcessorCount();
+	ASSERT_GT(processorCount,0u);
+	ASSERT_GT(topology.GetNumaNodeCount(),0u);
+	unsigned int nodeProcessorCount=0;
+	DWORD_PTR allMask=0;
+	for(unsigned int nodeTrav=0;nodeTrav<topology.GetNumaNodeCount();nodeTrav++)
+	{
+		DWORD_PTR nodeMask=topology.GetNumaNodeAffinityMask(nodeTrav);
+		EXPECT_NE((DWORD_PTR)0,nodeMask);
+		EXPECT_EQ((DWORD_PTR)0,allMask&nodeMask);
+		allMask|=nodeMask;
+		nodeProcessorCount+=topology.GetNumaNodeProcessorCount(nodeTrav);
+	}
+	EXPECT_EQ(processorCount,nodeProcessorCount);
+	EXPECT_EQ((DWORD_PTR)0,topology.GetNumaNodeAffinityMask(topology.GetNumaNodeCount()));
+
+	// both orders are permutations of the processors
+	DWORD_PTR compactMask=0;
+	DWORD_PTR scatterMask=0;
+	for(unsigned int trav=0;trav<processorCount;trav++)
+	{
+		unsigned int processor=topology.GetCompactProcessor(trav);
+		EXPECT_NE((DWORD_PTR)0,topology.GetNumaNodeAffinityMask(topology.GetProcessorNumaNode(processor))&(((DWORD_PTR)1)<<processor));
+		compactMask|=((DWORD_PTR)1)<<processor;
+		scatterMask|=((DWORD_PTR)1)<<topology.GetScatterProcessor(trav);
+	}
+	EXPECT_EQ(allMask,compactMask);
+	EXPECT_EQ(allMask,scatterMask);
+	EXPECT_EQ(topology.GetCompactProcessor(0),topology.GetCompactProcessor(processorCount));
+	EXPECT_LT(topology.GetCurrentNumaNode(),topology.GetNumaNodeCount());
+}
+
+class ProcessorThread:public Thread
+{
+public:
+	ProcessorThread():Thread(),m_processor(0xFFFFFFFF){}
+	volatile unsigned int m_processor;
+protected:
+	virtual void execute()
+	{
+		m_processor=(unsigned int)GetCurrentProcessorNumber();
+	}
+};
+
+#if defined(__linux__)
+TEST(ThreadTest, BindsToStartAffinity)
+{
+	CpuTopology &topology=CPU_TOPOLOGY_INSTANCE;
+	unsigned int processor=topology.GetScatterProcessor(topology.GetProcessorCount()-1);
+	ProcessorThread thread;
+	thread.SetStartAffinityMask(((DWORD_PTR)1)<<processor);
+	EXPECT_EQ(((DWORD_PTR)1)<<processor,thread.GetStartAffinityMask());
+	ASSERT_TRUE(thread.Start());
+	thread.WaitFor(WAITTIME_INIFINITE);
+	EXPECT_EQ(processor,thread.m_processor);
+
+	ProcessorThread nodeThread;
+	EXPECT_FALSE(nodeThread.SetNumaNode(topology.GetNumaNodeCount()));
+	EXPECT_TRUE(nodeThread.SetNumaNode(0));
+	ASSERT_TRUE(nodeThread.Start());
+	nodeThread.WaitFor(WAITTIME_INIFINITE);
+	EXPECT_EQ(0u,topology.GetProcessorNumaNode(nodeThread.m_processor));
+}
+#endif //defined(__linux__)
+
+TEST(WorkerThreadFactoryTest, PlacesWorkers)
+{
+	CpuTopology &topology=CPU_TOPOLOGY_INSTANCE;
+	EXPECT_EQ((DWORD_PTR)0,WorkerThreadFactory::GetPlacementAffinityMask(WorkerThreadFactory::WORKER_PLACEMENT_NONE,1,4));
+	EXPECT_EQ(((DWORD_PTR)1)<<topology.GetCompactProcessor(1),WorkerThreadFactory::GetPlacementAffinityMask(WorkerThreadFactory::WORKER_PLACEMENT_COMPACT,1,4));
+	EXPECT_EQ(((DWORD_PTR)1)<<topology.GetScatterProcessor(1),WorkerThreadFactory::GetPlacementAffinityMask(WorkerThreadFactory::WORKER_PLACEMENT_SCATTER,1,4));
+	// the first and the last worker are on the first and the last node
+	EXPECT_EQ(0u,WorkerThreadFactory::GetPlacementNumaNode(WorkerThreadFactory::WORKER_PLACEMENT_NUMA_NODE,0,64));
+	EXPECT_EQ(topology.GetNumaNodeCount()-1,WorkerThreadFactory::GetPlacementNumaNode(WorkerThreadFactory::WORKER_PLACEMENT_NUMA_NODE,63,64));
+	EXPECT_EQ(topology.GetNumaNodeAffinityMask(0),WorkerThreadFactory::GetPlacementAffinityMask(WorkerThreadFactory::WORKER_PLACEMENT_NUMA_NODE,0,64));
+
+	BaseWorkerThread *worker=WorkerThreadFactory::GetWorkerThread(BaseWorkerThread::THREAD_LIFE_INFINITE,WorkerThreadFactory::WORKER_PLACEMENT_COMPACT,0,1);
+	ASSERT_TRUE(worker!=NULL);
+	EXPECT_EQ(((DWORD_PTR)1)<<topology.GetCompactProcessor(0),worker->GetStartAffinityMask());
+	EP_DELETE worker;
+}
+
+TEST(ThreadPoolTest, ProcessesEveryJobWithPlacement)
+{
+	WorkerThreadFactory::WorkerPlacement placements[]={
+		WorkerThreadFactory::WORKER_PLACEMENT_COMPACT,
+		WorkerThreadFactory::WORKER_PLACEMENT_SCATTER,
+		WorkerThreadFactory::WORKER_PLACEMENT_NUMA_NODE
+	};
+	for(int placementTrav=0;placementTrav<3;placementTrav++)
+	{
+		CountingJobProcessor *processor=EP_NEW CountingJobProcessor();
+		CountingJob *job=EP_NEW CountingJob();
+		const long count=10000;
+		{
+			ThreadPool pool(processor,3,EP_LOCK_POLICY,placements[placementTrav]);
+			EXPECT_EQ(placements[placementTrav],pool.GetPlacement());
+			EXPECT_GE(pool.GetNumaNodeCount(),1u);
+			for(long trav=0;trav<count/2;trav++)
+				pool.Push(job);
+			// the node without workers falls back to any worker
+			for(long trav=0;trav<count/2;trav++)
+				pool.PushToNode(job,(unsigned int)trav%(pool.GetNumaNodeCount()+1));
+			waitForCount(processor->m_processedCount,count);
+			pool.TerminatePool();
+		}
+		EXPECT_EQ(count,processor->m_processedCount);
+		EXPECT_EQ(count,job->m_doneCount);
+		job->ReleaseObj();
+		processor->ReleaseObj();
+	}
+}
+
+struct CountFunctor
+{
+	CountFunctor(volatile long *count,volatile long *liveCount):m_count(count),m_liveCount(liveCount){InterlockedIncrement(m_liveCount);}
+	CountFunctor(const CountFunctor &b):m_count(b.m_count),m_liveCount(b.m_liveCount){InterlockedIncrement(m_liveCount);}
+	~CountFunctor(){InterlockedDecrement(m_liveCount);}
+	void operator()(){InterlockedIncrement(m_count);}
+	volatile long *m_count;
+	volatile long *m_liveCount;
+};
+
+static void countFunc(void *arg)
+{
+	InterlockedIncrement(reinterpret_cast<volatile long*>(arg));
+}
+
+static void recordStatus(LightJob * /*job*/,const BaseJob::JobStatus status,void *userData)
+{
+	if(status==BaseJob::JOB_STATUS_DONE)
+		InterlockedIncrement(reinterpret_cast<volatile long*>(userData));
+}
+
+static void waitForFreeJobs(LightJobPool &pool)
+{
+	unsigned int startTick=GetTickCount();
+	while(pool.GetFreeCount()<pool.GetJobCount() && GetTickCount()-startTick<30000)
+		Sleep(1);
+}
+
+TEST(LightJobTest, RunsCallablesOnWorker)
+{
+	LightJobPool pool;
+	LightJobProcessor *processor=EP_NEW LightJobProcessor();
+	WorkerThreadInfinite worker(BaseWorkerThread::THREAD_LIFE_INFINITE);
+	worker.SetJobProcessor(processor);
+	worker.Start();
+
+	volatile long count=0;
+	volatile long liveCount=0;
+	volatile long doneCount=0;
+	LightJob *job=pool.Get();
+	job->SetFunc(CountFunctor(&count,&liveCount));
+	job->SetStatusCallback(recordStatus,(void*)&doneCount);
+	EXPECT_EQ(&pool,job->GetPool());
+	EXPECT_EQ(BaseJob::JOB_STATUS_NONE,job->GetStatus());
+	worker.Push(job);
+	job->ReleaseObj();
+
+	job=pool.Get(PRIORITY_NORMAL+1);
+	EXPECT_EQ(PRIORITY_NORMAL+1,job->GetPriority());
+	job->SetFunc(countFunc,(void*)&count);
+	worker.Push(job);
+	job->ReleaseObj();
+
+	waitForCount(count,2);
+	waitForFreeJobs(pool);
+	EXPECT_EQ(2,count);
+	EXPECT_EQ(1,doneCount);
+	// the functor is destroyed when the job returns to the pool
+	EXPECT_EQ(0,liveCount);
+	EXPECT_EQ(pool.GetJobCount(),pool.GetFreeCount());
+	worker.TerminateWorker();
+	processor->ReleaseObj();
+}
+
+TEST(LightJobTest, ReusesJobsInSteadyState)
+{
+	const size_t inFlight=8;
+	LightJobPool pool(inFlight);
+	LightJobProcessor *processor=EP_NEW LightJobProcessor();
+	volatile long count=0;
+	{
+		ThreadPool threadPool(processor,2);
+		for(int round=0;round<500;round++)
+		{
+			LightJob *jobs[inFlight];
+			for(size_t trav=0;trav<inFlight;trav++)
+			{
+				jobs[trav]=pool.Get();
+				jobs[trav]->SetFunc(countFunc,(void*)&count);
+			}
+			threadPool.PushBatch(reinterpret_cast<BaseJob**>(jobs),inFlight);
+			for(size_t trav=0;trav<inFlight;trav++)
+				jobs[trav]->ReleaseObj();
+			waitForFreeJobs(pool);
+		}
+		threadPool.TerminatePool();
+	}
+	EXPECT_EQ(500*(long)inFlight,count);
+	EXPECT_EQ(inFlight,pool.GetJobCount());
+	EXPECT_EQ(inFlight,pool.GetFreeCount());
+	processor->ReleaseObj();
+}